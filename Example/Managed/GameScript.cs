@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
+using MochiSharp.Managed.Core;
 
 namespace GameProject;
 
@@ -11,4 +12,9 @@ public abstract class GameScript
     public abstract void OnAwake();
     public abstract void OnStart();
     public abstract void OnUpdate(float deltaTime);
+
+    // Coroutines started here are stopped when the script instance is destroyed.
+    protected CoroutineHandle StartCoroutine(System.Collections.IEnumerator routine) => ScriptScheduler.StartCoroutine(routine, this);
+    protected bool StopCoroutine(CoroutineHandle handle) => ScriptScheduler.StopCoroutine(handle);
+    protected int StopAllCoroutines() => ScriptScheduler.StopCoroutines(this);
 }
@@ -24,4 +24,38 @@ namespace Example.Managed.Interop
         public Vector3 Rotation;
         public Vector3 Scale;
     }
+
+    // Event ids shared with ExampleEvent in Example.Native.
+    public static class ExampleEvents
+    {
+        public const int Collision = 1;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct CollisionEvent
+    {
+        public ulong OtherInstanceId;
+        public Vector3 Point;
+        public Vector3 Normal;
+    }
+
+    // Component ids shared with ExampleComponent in Example.Native.
+    public static class ExampleComponents
+    {
+        public const int Position = 1;
+        public const int Velocity = 2;
+    }
+
+    // Components stored natively and processed by Systems.MovementSystem.
+    [StructLayout(LayoutKind.Sequential)]
+    public struct Position
+    {
+        public MochiSharp.Managed.Mathf.Vector3 Value;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct Velocity
+    {
+        public MochiSharp.Managed.Mathf.Vector3 Value;
+    }
 }
@@ -1,11 +1,16 @@
 ﻿using GameProject;
 using System;
+using System.Collections;
+using System.Threading.Tasks;
 using Example.Managed.Interop;
+using MochiSharp.Managed.Core;
 
 namespace Example.Managed.Scripts
 {
     internal class Player : GameScript
     {
+        private static readonly WaitForSeconds HalfSecond = new(0.5);
+
         private Transform _transform;
 
         public Player() { }
@@ -18,6 +23,8 @@ namespace Example.Managed.Scripts
         public override void OnStart()
         {
             Console.WriteLine("C# Player On Start");
+            StartCoroutine(Heartbeat());
+            _ = AnnounceAsync();
         }
 
         public override void OnUpdate(float deltaTime)
@@ -25,6 +32,23 @@ namespace Example.Managed.Scripts
             Console.WriteLine($"C# Player On Update dt: {deltaTime}");
         }
 
+        private IEnumerator Heartbeat()
+        {
+            for (int beat = 1; ; beat++)
+            {
+                yield return HalfSecond;
+                Console.WriteLine($"C# Player heartbeat {beat} at {ScriptScheduler.Time:F2}s");
+            }
+        }
+
+        private async Task AnnounceAsync()
+        {
+            await ScriptScheduler.NextFrame();
+            Console.WriteLine($"C# Player first frame done (frame {ScriptScheduler.FrameCount})");
+            await ScriptScheduler.Seconds(0.1);
+            Console.WriteLine($"C# Player 0.1s later (frame {ScriptScheduler.FrameCount})");
+        }
+
         public int AddInt(int a, int b) => a + b;
         public int MulInt(int a, int b) => a * b;
 
@@ -39,5 +63,11 @@ namespace Example.Managed.Scripts
         }
 
         public Transform GetTransform() => _transform;
+
+        [ScriptEvent(ExampleEvents.Collision)]
+        private void OnCollision(in CollisionEvent collision)
+        {
+            Console.WriteLine($"C# Player OnCollision with {collision.OtherInstanceId} at ({collision.Point.X}, {collision.Point.Y}, {collision.Point.Z})");
+        }
     }
 }
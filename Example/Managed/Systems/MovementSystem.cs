@@ -0,0 +1,29 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using Example.Managed.Interop;
+using MochiSharp.Managed.Mathf;
+using MochiSharp.Managed.Scene;
+using Vector3 = MochiSharp.Managed.Mathf.Vector3;
+
+namespace Example.Managed.Systems
+{
+    // Moves every entity of the native world in one call: the query hands out the position and
+    // velocity arrays chunk by chunk and MathBatch integrates them in place.
+    public static class MovementSystem
+    {
+        private static EntityQuery? _movers;
+
+        public static void Update(float deltaTime)
+        {
+            // Created on first use: the host registers the components after loading this assembly.
+            _movers ??= EntityQuery.Create<Position, Velocity>();
+
+            foreach (var chunk in _movers)
+            {
+                Span<Vector3> positions = MemoryMarshal.Cast<Position, Vector3>(chunk.GetColumn<Position>(0));
+                Span<Vector3> velocities = MemoryMarshal.Cast<Velocity, Vector3>(chunk.GetColumn<Velocity>(1));
+                MathBatch.Integrate(positions, velocities, deltaTime);
+            }
+        }
+    }
+}
@@ -15,6 +15,15 @@ project "Example.Managed"
         "MochiSharp.Managed"
     }
 
+    dependson {
+        "MochiSharp.HeaderGen"
+    }
+
+    -- Regenerates the interop header used by Example.Native and the .mochimanifest next to the dll.
+    postbuildcommands {
+        "dotnet \"%{cfg.targetdir}/MochiSharp.HeaderGen.dll\" \"%{cfg.targetdir}/Example.Managed.dll\" --header \"%{wks.location}/Example/Native/Source/Generated/ExampleManaged.h\" --base GameProject.GameScript --map Example.Managed.Interop.Vector3=ExampleInterop::Vector3 --map Example.Managed.Interop.Transform=ExampleInterop::Transform --map Example.Managed.Interop.CollisionEvent=ExampleInterop::CollisionEvent --map Example.Managed.Interop.Position=ExampleInterop::Position --map Example.Managed.Interop.Velocity=ExampleInterop::Velocity"
+    }
+
     filter { "action:vs* or system:windows" }
         vsprops {
             AppendTargetFrameworkToOutputPath = "false",
@@ -1,7 +1,10 @@
 // Copyright (c) 2025 Evangelion Manuhutu
 
 #include "Host.h"
+#include "MathTypes.h"
+#include "ScriptMethod.h"
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
 #include <print>
@@ -22,8 +25,49 @@ namespace ExampleInterop
         Vector3 Rotation;
         Vector3 Scale;
     };
+
+    struct CollisionEvent
+    {
+        uint64_t OtherInstanceId;
+        Vector3 Point;
+        Vector3 Normal;
+    };
+
+    struct Position
+    {
+        MochiSharp::Vector3 Value;
+    };
+
+    struct Velocity
+    {
+        MochiSharp::Vector3 Value;
+    };
 }
 
+// Event ids handled by [ScriptEvent(...)] methods in Example.Managed (see ExampleEvents).
+enum ExampleEvent : int
+{
+    Collision = 1,
+};
+
+// Component ids used by ExampleWorld (see ExampleComponents in Example.Managed).
+enum ExampleComponent : int32_t
+{
+    PositionComponent = 1,
+    VelocityComponent = 2,
+};
+
+// Written by MochiSharp.HeaderGen when Example.Managed is built: checks the structs above against
+// Example.Managed.Interop field by field and registers them with ScriptMethod.
+#if __has_include("Generated/ExampleManaged.h")
+#include "Generated/ExampleManaged.h"
+#else
+MOCHI_SCRIPT_STRUCT(ExampleInterop::Vector3, "Example.Managed.Interop.Vector3, Example.Managed", 12);
+MOCHI_SCRIPT_STRUCT(ExampleInterop::Transform, "Example.Managed.Interop.Transform, Example.Managed", 36);
+MOCHI_SCRIPT_STRUCT(ExampleInterop::Position, "Example.Managed.Interop.Position, Example.Managed", 12);
+MOCHI_SCRIPT_STRUCT(ExampleInterop::Velocity, "Example.Managed.Interop.Velocity, Example.Managed", 12);
+#endif
+
 enum ScriptMethodSig : int
 {
     Void = 0,
@@ -54,11 +98,15 @@ struct ScriptInstance
         if (Host->CreateInstance(typeName, instanceId))
         {
             std::println("[C++] Created instance {} of type {}", instanceId, typeName);
-            OnAwake = Host->BindInstanceMethod(instanceId, "OnAwake", ScriptMethodSig::Void);
-            OnStart = Host->BindInstanceMethod(instanceId, "OnStart", ScriptMethodSig::Void);
-            OnUpdate = Host->BindInstanceMethod(instanceId, "OnUpdate", ScriptMethodSig::Void_Float);
-            SetTransform = Host->BindInstanceMethod(instanceId, "SetTransform", ScriptMethodSig::Void_Transform);
-            GetTransform = Host->BindInstanceMethod(instanceId, "GetTransform", ScriptMethodSig::Transform);
+            const char *names[] = { "OnAwake", "OnStart", "OnUpdate", "SetTransform", "GetTransform" };
+            const int sigs[] = { ScriptMethodSig::Void, ScriptMethodSig::Void, ScriptMethodSig::Void_Float, ScriptMethodSig::Void_Transform, ScriptMethodSig::Transform };
+            int ids[5] = {};
+            Host->BindMethods(instanceId, names, sigs, 5, ids);
+            OnAwake = ids[0];
+            OnStart = ids[1];
+            OnUpdate = ids[2];
+            SetTransform = ids[3];
+            GetTransform = ids[4];
         }
         else
         {
@@ -84,20 +132,75 @@ struct ScriptInstance
     }
 };
 
+// Entities stored as plain arrays, one chunk per ChunkSize entities; scripts iterate them with
+// EntityQuery (Example.Managed.Systems.MovementSystem).
+class ExampleWorld : public MochiSharp::ScriptComponentStorage
+{
+public:
+    static constexpr size_t ChunkSize = 256;
+
+    explicit ExampleWorld(size_t entityCount)
+        : m_EntityIds(entityCount), m_Positions(entityCount), m_Velocities(entityCount)
+    {
+        for (size_t i = 0; i < entityCount; i++)
+        {
+            m_EntityIds[i] = 1000 + i;
+            m_Positions[i] = { { 0.0f, 0.0f, 0.0f } };
+            m_Velocities[i] = { { 1.0f, 0.0f, (float)(i % 8) } };
+        }
+    }
+
+    void QueryChunks(std::span<const int32_t> componentIds, std::vector<MochiSharp::ScriptChunk> &chunks, std::vector<void *> &columns) override
+    {
+        // Every entity has both components; a query for anything else matches nothing.
+        for (int32_t componentId : componentIds)
+        {
+            if (componentId != PositionComponent && componentId != VelocityComponent)
+            {
+                return;
+            }
+        }
+
+        for (size_t start = 0; start < m_Positions.size(); start += ChunkSize)
+        {
+            size_t count = std::min(ChunkSize, m_Positions.size() - start);
+            chunks.push_back({ m_EntityIds.data() + start, (int32_t)count });
+            for (int32_t componentId : componentIds)
+            {
+                columns.push_back(componentId == PositionComponent ? (void *)(m_Positions.data() + start) : (void *)(m_Velocities.data() + start));
+            }
+        }
+    }
+
+    const ExampleInterop::Position &GetPosition(size_t index) const { return m_Positions[index]; }
+
+private:
+    std::vector<uint64_t> m_EntityIds;
+    std::vector<ExampleInterop::Position> m_Positions;
+    std::vector<ExampleInterop::Velocity> m_Velocities;
+};
+
 #ifdef _WIN32
 int __cdecl wmain(int argc, wchar_t *argv[])
 #else
 int main(int argc, char *argv[])
 #endif
 {
-    // MochiSharp::HostSettings settings;
+    // A game client: GC and JIT settings that favor short, even frames over raw throughput.
+    auto settings = MochiSharp::HostSettings::LowLatencyClient();
 
     MochiSharp::DotNetHost host;
-    if (!host.Init(L"MochiSharp.Managed.runtimeconfig.json"))
+    if (!host.Init(L"MochiSharp.Managed.runtimeconfig.json", settings))
     {
         return 1;
     }
 
+    // Example.Native --record session.msrec: capture the script workload for MochiSharp.Replay.
+    if (argc > 2 && std::filesystem::path(argv[1]) == "--record")
+    {
+        host.StartRecording(argv[2]);
+    }
+
     // Load the script assembly
     if (!host.LoadAssembly("Example.Managed.dll"))
     {
@@ -137,6 +240,26 @@ int main(int argc, char *argv[])
         host.RegisterSignature(ScriptMethodSig::Transform, transformType, nullptr, 0);
     }
 
+    // A script that throws 8 frames in a row is switched off instead of failing every frame.
+    host.ConfigureFaultPolicy(8);
+
+    // Name the script that blows the frame budget, even if it never returns.
+    MochiSharp::ScriptWatchdogSettings watchdog;
+    watchdog.CallBudget = std::chrono::milliseconds(2);
+    watchdog.FrameBudget = std::chrono::milliseconds(4);
+    watchdog.OnCallOverBudget = [](const MochiSharp::ScriptCallReport &report)
+    {
+        std::println("[C++] Script method {} over budget: {} us{}", report.MethodId, report.Elapsed.count(), report.StillRunning ? " and still running" : "");
+    };
+    watchdog.OnFrameOverBudget = [](const MochiSharp::ScriptFrameReport &report)
+    {
+        std::println("[C++] Scripts took {} us this frame ({} calls, slowest: method {})", report.ScriptTime.count(), report.Calls, report.SlowestMethodId);
+    };
+    host.StartWatchdog(std::move(watchdog));
+
+    // Scratch memory scripts get from FrameAllocator; released by every EndFrame.
+    host.InitFrameArena();
+
     // Create multiple script instances
     ScriptInstance player1;
     player1.Init(&host, 1, "Example.Managed.Scripts.Player");
@@ -164,6 +287,27 @@ int main(int argc, char *argv[])
     std::println("[C++] Player 1 Pos: {},{},{}", t1_out.Position.X, t1_out.Position.Y, t1_out.Position.Z);
     std::println("[C++] Player 2 Pos: {},{},{}", t2_out.Position.X, t2_out.Position.Y, t2_out.Position.Z);
 
+    // Typed bindings: the signature is derived from the C++ function type and registered on first bind.
+    MochiSharp::ScriptMethod<int(int, int)> mulInt;
+    MochiSharp::ScriptMethod<ExampleInterop::Vector3(ExampleInterop::Vector3, ExampleInterop::Vector3)> addVector;
+    if (mulInt.BindInstance(host, player1.InstanceId, "MulInt") && addVector.BindInstance(host, player1.InstanceId, "AddVector"))
+    {
+        auto sum = addVector({ 1, 2, 3 }, { 10, 20, 30 });
+        std::println("[C++] MulInt(6, 7) = {}, AddVector = {},{},{}", mulInt(6, 7), sum.X, sum.Y, sum.Z);
+    }
+
+    // Events are written straight into memory shared with the scripts and routed once per frame.
+    host.InitEvents();
+    host.PushEvent(ExampleEvent::Collision, player1.InstanceId, ExampleInterop::CollisionEvent{ player2.InstanceId, { 1, 0, 0 }, { -1, 0, 0 } });
+    host.PushEvent(ExampleEvent::Collision, 0, ExampleInterop::CollisionEvent{ 0, { 0, 0, 0 }, { 0, 1, 0 } });
+
+    // Systems-style script: one call per frame moves every entity of the world.
+    ExampleWorld world(1000);
+    host.RegisterComponent<ExampleInterop::Position>(PositionComponent);
+    host.RegisterComponent<ExampleInterop::Velocity>(VelocityComponent);
+    host.SetComponentStorage(&world);
+    int moveEntities = host.BindStaticMethod("Example.Managed.Systems.MovementSystem", "Update", ScriptMethodSig::Void_Float);
+
     bool running = true;
     auto start = std::chrono::steady_clock::now();
 
@@ -174,12 +318,26 @@ int main(int argc, char *argv[])
         float deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() / 1000.0f;
         start = end;
 
+        host.DispatchEvents();
+        host.TickScheduler(deltaTime);
         player1.Update(deltaTime);
         player2.Update(deltaTime);
+        if (moveEntities)
+        {
+            void *args[] = { &deltaTime };
+            host.Invoke(moveEntities, args, 1, nullptr);
+        }
+        host.EndFrame();
         
         std::this_thread::sleep_for(std::chrono::milliseconds(16));
         runningCount++;
     }
 
+    const auto &moved = world.GetPosition(7).Value;
+    std::println("[C++] Entity 1007 moved to {},{},{}", moved.X, moved.Y, moved.Z);
+
+    auto arena = host.GetFrameArenaStats();
+    std::println("[C++] Frame arena: {} frames, peak {} of {} bytes, {} frames overflowed", arena.Frames, arena.HighWaterBytes, arena.Capacity, arena.OverflowFrames);
+
     return 0;
 }
@@ -23,18 +23,19 @@ project "Example.Native"
     }
 
     links {
-        "MochiSharp.Native",
-        "%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/nethost.lib"
-    }
-
-    postbuildcommands {
-        "{COPY} \"%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/nethost.dll\" \"%{cfg.targetdir}\"",
-        "{COPY} \"%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/hostfxr.dll\" \"%{cfg.targetdir}\""
+        "MochiSharp.Native"
     }
 
     filter "system:windows"
         systemversion "latest"
         buildoptions { "/utf-8" }
+        links {
+            "%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/nethost.lib"
+        }
+        postbuildcommands {
+            "{COPY} \"%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/nethost.dll\" \"%{cfg.targetdir}\"",
+            "{COPY} \"%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/hostfxr.dll\" \"%{cfg.targetdir}\""
+        }
         defines {
             "_WINDOWS",
             "WIN32",
@@ -43,6 +44,10 @@ project "Example.Native"
             "_CONSOLE"
         }
 
+    filter "system:linux"
+        libdirs { NETHOST_LINUX_DIR }
+        links { "nethost", "dl", "pthread" }
+
     filter "configurations:Debug"
         runtime "Debug"
         optimize "off"
@@ -0,0 +1,570 @@
+using System;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Metadata;
+using System.Reflection.Metadata.Ecma335;
+using System.Reflection.PortableExecutable;
+using System.Text;
+using MochiSharp.Managed.Core;
+
+namespace MochiSharp.HeaderGen
+{
+	// What the generator knows about a script assembly, read from metadata only.
+	internal sealed class AssemblyModel
+	{
+		public sealed class StructModel
+		{
+			public required string FullName;
+			public required string Namespace;
+			public required string Name;
+			public required int Size;
+			public required int Alignment;
+			public required int Pack;
+			public required bool IsExplicit;
+			public required List<FieldModel> Fields;
+			public string? NativeName;
+		}
+
+		public sealed record FieldModel(string Name, string CppType, int Offset, int Size);
+
+		public sealed class ScriptTypeModel
+		{
+			public required string FullName;
+			public required string Namespace;
+			public required string Name;
+			public required int Token;
+			public required bool IsConcreteClass;
+			public required string[] Ancestors;
+			public readonly List<MethodModel> Methods = new();
+			public readonly List<ManagedFieldModel> Fields = new();
+		}
+
+		public sealed record TypeModel(int Token, string FullName, bool IsConcreteClass, string[] Ancestors);
+		public sealed record MethodModel(string Name, int Token, bool IsStatic, int SignatureId, string ReturnManagedName, string[] ParameterManagedNames, string ReturnCppType, string[] ParameterCppTypes);
+		public sealed record ManagedFieldModel(string Name, int Token, int Handle, bool IsPublic, bool HasSerializeFieldAttribute, string FieldTypeName);
+
+		// Shape of a type as it appears in a signature.
+		private readonly record struct TypeShape(PrimitiveTypeCode? Primitive, TypeDefinitionHandle Definition, string? ExternalName)
+		{
+			public static readonly TypeShape Unsupported = new(null, default, null);
+		}
+
+		private sealed class ShapeProvider : ISignatureTypeProvider<TypeShape, object?>
+		{
+			public TypeShape GetPrimitiveType(PrimitiveTypeCode typeCode) => new(typeCode, default, null);
+			public TypeShape GetTypeFromDefinition(MetadataReader reader, TypeDefinitionHandle handle, byte rawTypeKind) => new(null, handle, null);
+			public TypeShape GetTypeFromReference(MetadataReader reader, TypeReferenceHandle handle, byte rawTypeKind) => new(null, default, GetFullName(reader, handle));
+			public TypeShape GetTypeFromSpecification(MetadataReader reader, object? genericContext, TypeSpecificationHandle handle, byte rawTypeKind) => TypeShape.Unsupported;
+			public TypeShape GetSZArrayType(TypeShape elementType) => TypeShape.Unsupported;
+			public TypeShape GetArrayType(TypeShape elementType, ArrayShape shape) => TypeShape.Unsupported;
+			public TypeShape GetByReferenceType(TypeShape elementType) => TypeShape.Unsupported;
+			public TypeShape GetPointerType(TypeShape elementType) => TypeShape.Unsupported;
+			public TypeShape GetPinnedType(TypeShape elementType) => TypeShape.Unsupported;
+			public TypeShape GetFunctionPointerType(MethodSignature<TypeShape> signature) => TypeShape.Unsupported;
+			public TypeShape GetGenericInstantiation(TypeShape genericType, ImmutableArray<TypeShape> typeArguments) => TypeShape.Unsupported;
+			public TypeShape GetGenericMethodParameter(object? genericContext, int index) => TypeShape.Unsupported;
+			public TypeShape GetGenericTypeParameter(object? genericContext, int index) => TypeShape.Unsupported;
+			public TypeShape GetModifiedType(TypeShape modifier, TypeShape unmodifiedType, bool isRequired) => unmodifiedType;
+		}
+
+		private const int DefaultPack = 8;
+
+		// MochiSharp.Managed.Mathf structs, declared and registered by MathTypes.h rather than generated.
+		private static readonly Dictionary<string, (string CppType, int Size)> MathTypes = new(StringComparer.Ordinal)
+		{
+			["MochiSharp.Managed.Mathf.Vector2"] = ("MochiSharp::Vector2", 8),
+			["MochiSharp.Managed.Mathf.Vector3"] = ("MochiSharp::Vector3", 12),
+			["MochiSharp.Managed.Mathf.Vector4"] = ("MochiSharp::Vector4", 16),
+			["MochiSharp.Managed.Mathf.Quaternion"] = ("MochiSharp::Quaternion", 16),
+			["MochiSharp.Managed.Mathf.Matrix4x4"] = ("MochiSharp::Matrix4x4", 64),
+			["MochiSharp.Managed.Mathf.Transform"] = ("MochiSharp::Transform", 40)
+		};
+
+		public string AssemblyName = string.Empty;
+		public Guid Mvid;
+		public readonly List<TypeModel> Types = new();
+		public readonly List<StructModel> Structs = new();
+		public readonly List<ScriptTypeModel> ScriptTypes = new();
+		public readonly List<string> Warnings = new();
+		// True when a signature or struct uses a MochiSharp.Managed.Mathf type (the header includes MathTypes.h).
+		public bool UsesMathTypes;
+
+		private readonly MetadataReader _reader;
+		private readonly ShapeProvider _provider = new();
+		private readonly Dictionary<TypeDefinitionHandle, StructModel?> _layouts = new();
+		private readonly Dictionary<string, string> _nativeTypeMap;
+
+		private AssemblyModel(MetadataReader reader, Dictionary<string, string> nativeTypeMap)
+		{
+			_reader = reader;
+			_nativeTypeMap = nativeTypeMap;
+		}
+
+		public static AssemblyModel Read(string assemblyPath, string? scriptBaseType, string serializeFieldAttributeTypeName, Dictionary<string, string> nativeTypeMap)
+		{
+			var ancestors = MetadataTypeScanner.GetAncestors(assemblyPath);
+
+			using var stream = new FileStream(assemblyPath, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete);
+			using var peReader = new PEReader(stream);
+			var reader = peReader.GetMetadataReader();
+
+			var model = new AssemblyModel(reader, nativeTypeMap)
+			{
+				AssemblyName = reader.GetString(reader.GetAssemblyDefinition().Name),
+				Mvid = reader.GetGuid(reader.GetModuleDefinition().Mvid)
+			};
+
+			foreach (var handle in reader.TypeDefinitions)
+			{
+				if (model.IsValueType(handle) && !model.IsEnum(handle))
+				{
+					model.GetLayout(handle);
+				}
+			}
+
+			foreach (var handle in reader.TypeDefinitions)
+			{
+				model.ReadScriptType(handle, ancestors, scriptBaseType, serializeFieldAttributeTypeName);
+			}
+
+			return model;
+		}
+
+		public string GetManagedTypeName(StructModel model) => $"{model.FullName}, {AssemblyName}";
+
+		public static int ComputeSignatureId(string returnTypeName, IEnumerable<string> parameterTypeNames)
+		{
+			// Must match MochiSharp::Detail::ComputeSignatureId in ScriptMethod.h.
+			uint hash = Fnv1a(returnTypeName, 2166136261u);
+			foreach (var parameterTypeName in parameterTypeNames)
+			{
+				hash = Fnv1a(parameterTypeName, Fnv1a("|", hash));
+			}
+			return (int)((hash & 0x3FFFFFFFu) | 0x40000000u);
+		}
+
+		private static uint Fnv1a(string text, uint hash)
+		{
+			foreach (byte b in Encoding.UTF8.GetBytes(text))
+			{
+				hash ^= b;
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
+		private void ReadScriptType(TypeDefinitionHandle handle, Dictionary<string, string[]> ancestors, string? scriptBaseType, string serializeFieldAttributeTypeName)
+		{
+			var definition = _reader.GetTypeDefinition(handle);
+			var attributes = definition.Attributes;
+			string fullName = GetFullName(_reader, handle);
+			if ((attributes & TypeAttributes.Interface) != 0 || IsValueType(handle) || definition.BaseType.IsNil || fullName.Contains('<'))
+			{
+				return;
+			}
+
+			string[] typeAncestors = ancestors.GetValueOrDefault(fullName) ?? Array.Empty<string>();
+			bool isConcreteClass = (attributes & TypeAttributes.Abstract) == 0;
+			Types.Add(new TypeModel(MetadataTokens.GetToken(handle), fullName, isConcreteClass, typeAncestors));
+
+			if (!string.IsNullOrEmpty(scriptBaseType) && !typeAncestors.Contains(scriptBaseType, StringComparer.Ordinal))
+			{
+				return;
+			}
+
+			var scriptType = new ScriptTypeModel
+			{
+				FullName = fullName,
+				Namespace = GetNamespace(handle),
+				Name = GetNestedName(handle),
+				Token = MetadataTokens.GetToken(handle),
+				IsConcreteClass = isConcreteClass,
+				Ancestors = typeAncestors
+			};
+
+			foreach (var methodHandle in definition.GetMethods())
+			{
+				var method = _reader.GetMethodDefinition(methodHandle);
+				if ((method.Attributes & (MethodAttributes.SpecialName | MethodAttributes.RTSpecialName)) != 0
+					|| (method.Attributes & MethodAttributes.Abstract) != 0
+					|| method.GetGenericParameters().Count > 0)
+				{
+					continue;
+				}
+
+				string name = _reader.GetString(method.Name);
+				if (name.Contains('<'))
+				{
+					continue;
+				}
+
+				var signature = method.DecodeSignature(_provider, null);
+				if (!TryGetSignatureType(signature.ReturnType, out string returnManaged, out string returnCpp))
+				{
+					continue;
+				}
+
+				var parameterManaged = new string[signature.ParameterTypes.Length];
+				var parameterCpp = new string[signature.ParameterTypes.Length];
+				bool supported = true;
+				for (int i = 0; supported && i < parameterManaged.Length; i++)
+				{
+					supported = TryGetSignatureType(signature.ParameterTypes[i], out parameterManaged[i], out parameterCpp[i]);
+				}
+
+				if (!supported)
+				{
+					continue;
+				}
+
+				scriptType.Methods.Add(new MethodModel(
+					name,
+					MetadataTokens.GetToken(methodHandle),
+					(method.Attributes & MethodAttributes.Static) != 0,
+					ComputeSignatureId(returnManaged, parameterManaged),
+					returnManaged,
+					parameterManaged,
+					returnCpp,
+					parameterCpp));
+			}
+
+			foreach (var fieldHandle in definition.GetFields())
+			{
+				var field = _reader.GetFieldDefinition(fieldHandle);
+				var fieldAttributes = field.Attributes;
+				string name = _reader.GetString(field.Name);
+#pragma warning disable SYSLIB0050 // NotSerialized mirrors FieldInfo.IsNotSerialized in ScriptContext.
+				if ((fieldAttributes & (FieldAttributes.Static | FieldAttributes.Literal | FieldAttributes.InitOnly | FieldAttributes.SpecialName | FieldAttributes.NotSerialized)) != 0
+					|| name.StartsWith('<'))
+				{
+					continue;
+				}
+#pragma warning restore SYSLIB0050
+
+				bool isPublic = (fieldAttributes & FieldAttributes.FieldAccessMask) == FieldAttributes.Public;
+				bool hasSerializeField = !string.IsNullOrEmpty(serializeFieldAttributeTypeName) && HasAttribute(field.GetCustomAttributes(), serializeFieldAttributeTypeName);
+				if (!isPublic && !hasSerializeField)
+				{
+					continue;
+				}
+
+				scriptType.Fields.Add(new ManagedFieldModel(
+					name,
+					MetadataTokens.GetToken(fieldHandle),
+					scriptType.Fields.Count,
+					isPublic,
+					hasSerializeField,
+					GetDisplayName(field.DecodeSignature(_provider, null))));
+			}
+
+			if (scriptType.Methods.Count > 0 || scriptType.Fields.Count > 0)
+			{
+				ScriptTypes.Add(scriptType);
+			}
+		}
+
+		// Names match MochiSharp::ScriptTypeTraits so generated signature ids line up with ScriptMethod<>.
+		private bool TryGetSignatureType(TypeShape shape, out string managedName, out string cppType)
+		{
+			managedName = string.Empty;
+			cppType = string.Empty;
+			switch (shape.Primitive)
+			{
+				case PrimitiveTypeCode.Void: managedName = "System.Void"; cppType = "void"; return true;
+				case PrimitiveTypeCode.Boolean: managedName = "System.Boolean"; cppType = "bool"; return true;
+				case PrimitiveTypeCode.Int32: managedName = "System.Int32"; cppType = "int32_t"; return true;
+				case PrimitiveTypeCode.UInt32: managedName = "System.UInt32"; cppType = "uint32_t"; return true;
+				case PrimitiveTypeCode.Int64: managedName = "System.Int64"; cppType = "int64_t"; return true;
+				case PrimitiveTypeCode.UInt64: managedName = "System.UInt64"; cppType = "uint64_t"; return true;
+				case PrimitiveTypeCode.Single: managedName = "System.Single"; cppType = "float"; return true;
+				case PrimitiveTypeCode.Double: managedName = "System.Double"; cppType = "double"; return true;
+				case null: break;
+				default: return false;
+			}
+
+			if (TryGetMathType(shape, out cppType, out _))
+			{
+				managedName = $"{shape.ExternalName}, MochiSharp.Managed";
+				return true;
+			}
+
+			if (shape.Definition.IsNil || GetLayout(shape.Definition) is not StructModel layout)
+			{
+				return false;
+			}
+
+			managedName = GetManagedTypeName(layout);
+			cppType = layout.NativeName ?? $"{ToCppNamespace(layout.Namespace)}::{layout.Name}";
+			return true;
+		}
+
+		private StructModel? GetLayout(TypeDefinitionHandle handle)
+		{
+			if (_layouts.TryGetValue(handle, out var cached))
+			{
+				return cached;
+			}
+
+			// Recursive structs are invalid anyway; this also stops cycles.
+			_layouts[handle] = null;
+			var layout = ComputeLayout(handle);
+			_layouts[handle] = layout;
+			if (layout != null)
+			{
+				Structs.Add(layout);
+			}
+			return layout;
+		}
+
+		private StructModel? ComputeLayout(TypeDefinitionHandle handle)
+		{
+			var definition = _reader.GetTypeDefinition(handle);
+			string fullName = GetFullName(_reader, handle);
+			if (!IsValueType(handle) || IsEnum(handle) || definition.GetGenericParameters().Count > 0 || fullName.Contains('<'))
+			{
+				return null;
+			}
+
+			var layoutKind = definition.Attributes & TypeAttributes.LayoutMask;
+			if (layoutKind == TypeAttributes.AutoLayout)
+			{
+				Warnings.Add($"{fullName}: auto layout, skipped");
+				return null;
+			}
+
+			bool isExplicit = layoutKind == TypeAttributes.ExplicitLayout;
+			var typeLayout = definition.GetLayout();
+			int pack = typeLayout.PackingSize == 0 ? DefaultPack : typeLayout.PackingSize;
+
+			var fields = new List<FieldModel>();
+			int offset = 0;
+			int size = 0;
+			int alignment = 1;
+			foreach (var fieldHandle in definition.GetFields())
+			{
+				var field = _reader.GetFieldDefinition(fieldHandle);
+				if ((field.Attributes & FieldAttributes.Static) != 0)
+				{
+					continue;
+				}
+
+				string fieldName = _reader.GetString(field.Name);
+				if (!TryGetFieldLayout(field.DecodeSignature(_provider, null), out string cppType, out int fieldSize, out int fieldAlignment))
+				{
+					// bool/char/reference fields are not blittable: their native layout depends on the marshaller.
+					Warnings.Add($"{fullName}.{fieldName}: field type is not blittable, struct skipped");
+					return null;
+				}
+
+				int effectiveAlignment = Math.Min(fieldAlignment, pack);
+				if (isExplicit)
+				{
+					offset = field.GetOffset();
+				}
+				else
+				{
+					offset = Align(offset, effectiveAlignment);
+				}
+
+				fields.Add(new FieldModel(fieldName, cppType, offset, fieldSize));
+				alignment = Math.Max(alignment, effectiveAlignment);
+				offset += fieldSize;
+				size = Math.Max(size, offset);
+			}
+
+			size = Math.Max(Align(Math.Max(size, 1), alignment), typeLayout.Size);
+
+			return new StructModel
+			{
+				FullName = fullName,
+				Namespace = GetNamespace(handle),
+				Name = GetNestedName(handle),
+				Size = size,
+				Alignment = alignment,
+				Pack = typeLayout.PackingSize,
+				IsExplicit = isExplicit,
+				Fields = fields,
+				NativeName = _nativeTypeMap.GetValueOrDefault(fullName)
+			};
+		}
+
+		private bool TryGetFieldLayout(TypeShape shape, out string cppType, out int size, out int alignment)
+		{
+			(cppType, size) = shape.Primitive switch
+			{
+				PrimitiveTypeCode.SByte => ("int8_t", 1),
+				PrimitiveTypeCode.Byte => ("uint8_t", 1),
+				PrimitiveTypeCode.Int16 => ("int16_t", 2),
+				PrimitiveTypeCode.UInt16 => ("uint16_t", 2),
+				PrimitiveTypeCode.Int32 => ("int32_t", 4),
+				PrimitiveTypeCode.UInt32 => ("uint32_t", 4),
+				PrimitiveTypeCode.Int64 => ("int64_t", 8),
+				PrimitiveTypeCode.UInt64 => ("uint64_t", 8),
+				PrimitiveTypeCode.Single => ("float", 4),
+				PrimitiveTypeCode.Double => ("double", 8),
+				PrimitiveTypeCode.IntPtr => ("intptr_t", IntPtr.Size),
+				PrimitiveTypeCode.UIntPtr => ("uintptr_t", UIntPtr.Size),
+				_ => (string.Empty, 0)
+			};
+
+			if (size > 0)
+			{
+				alignment = size;
+				return true;
+			}
+
+			if (TryGetMathType(shape, out cppType, out size))
+			{
+				alignment = sizeof(float);
+				return true;
+			}
+
+			alignment = 0;
+			if (shape.Definition.IsNil || GetLayout(shape.Definition) is not StructModel nested)
+			{
+				return false;
+			}
+
+			cppType = nested.NativeName ?? $"{ToCppNamespace(nested.Namespace)}::{nested.Name}";
+			size = nested.Size;
+			alignment = nested.Alignment;
+			return true;
+		}
+
+		private bool TryGetMathType(TypeShape shape, out string cppType, out int size)
+		{
+			if (shape.ExternalName != null && MathTypes.TryGetValue(shape.ExternalName, out var mathType))
+			{
+				(cppType, size) = mathType;
+				UsesMathTypes = true;
+				return true;
+			}
+
+			cppType = string.Empty;
+			size = 0;
+			return false;
+		}
+
+		private bool IsValueType(TypeDefinitionHandle handle)
+		{
+			var baseType = _reader.GetTypeDefinition(handle).BaseType;
+			return baseType.Kind == HandleKind.TypeReference
+				&& GetFullName(_reader, (TypeReferenceHandle)baseType) is "System.ValueType" or "System.Enum";
+		}
+
+		private bool IsEnum(TypeDefinitionHandle handle)
+		{
+			var baseType = _reader.GetTypeDefinition(handle).BaseType;
+			return baseType.Kind == HandleKind.TypeReference && GetFullName(_reader, (TypeReferenceHandle)baseType) == "System.Enum";
+		}
+
+		private bool HasAttribute(CustomAttributeHandleCollection attributes, string attributeTypeName)
+		{
+			foreach (var attributeHandle in attributes)
+			{
+				var constructor = _reader.GetCustomAttribute(attributeHandle).Constructor;
+				string? name = constructor.Kind switch
+				{
+					HandleKind.MethodDefinition => GetFullName(_reader, _reader.GetMethodDefinition((MethodDefinitionHandle)constructor).GetDeclaringType()),
+					HandleKind.MemberReference => _reader.GetMemberReference((MemberReferenceHandle)constructor).Parent is var parent && parent.Kind == HandleKind.TypeReference
+						? GetFullName(_reader, (TypeReferenceHandle)parent)
+						: null,
+					_ => null
+				};
+
+				if (string.Equals(name, attributeTypeName, StringComparison.Ordinal))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		private string GetDisplayName(TypeShape shape)
+		{
+			if (shape.Primitive is PrimitiveTypeCode primitive)
+			{
+				return primitive switch
+				{
+					PrimitiveTypeCode.Boolean => "System.Boolean",
+					PrimitiveTypeCode.Char => "System.Char",
+					PrimitiveTypeCode.SByte => "System.SByte",
+					PrimitiveTypeCode.Byte => "System.Byte",
+					PrimitiveTypeCode.Int16 => "System.Int16",
+					PrimitiveTypeCode.UInt16 => "System.UInt16",
+					PrimitiveTypeCode.Int32 => "System.Int32",
+					PrimitiveTypeCode.UInt32 => "System.UInt32",
+					PrimitiveTypeCode.Int64 => "System.Int64",
+					PrimitiveTypeCode.UInt64 => "System.UInt64",
+					PrimitiveTypeCode.Single => "System.Single",
+					PrimitiveTypeCode.Double => "System.Double",
+					PrimitiveTypeCode.String => "System.String",
+					PrimitiveTypeCode.IntPtr => "System.IntPtr",
+					PrimitiveTypeCode.UIntPtr => "System.UIntPtr",
+					_ => "System.Object"
+				};
+			}
+
+			if (!shape.Definition.IsNil)
+			{
+				return GetFullName(_reader, shape.Definition);
+			}
+
+			return shape.ExternalName ?? "?";
+		}
+
+		private string GetNamespace(TypeDefinitionHandle handle)
+		{
+			var definition = _reader.GetTypeDefinition(handle);
+			var declaringType = definition.GetDeclaringType();
+			return declaringType.IsNil ? _reader.GetString(definition.Namespace) : GetNamespace(declaringType);
+		}
+
+		// Nested types are flattened into their namespace as Outer_Inner.
+		private string GetNestedName(TypeDefinitionHandle handle)
+		{
+			var definition = _reader.GetTypeDefinition(handle);
+			string name = _reader.GetString(definition.Name);
+			var declaringType = definition.GetDeclaringType();
+			return declaringType.IsNil ? name : $"{GetNestedName(declaringType)}_{name}";
+		}
+
+		public static string ToCppNamespace(string managedNamespace)
+		{
+			return managedNamespace.Length == 0 ? string.Empty : managedNamespace.Replace(".", "::", StringComparison.Ordinal);
+		}
+
+		private static int Align(int value, int alignment) => (value + alignment - 1) / alignment * alignment;
+
+		private static string GetFullName(MetadataReader reader, TypeDefinitionHandle handle)
+		{
+			var definition = reader.GetTypeDefinition(handle);
+			string name = reader.GetString(definition.Name);
+			var declaringType = definition.GetDeclaringType();
+			if (!declaringType.IsNil)
+			{
+				return $"{GetFullName(reader, declaringType)}+{name}";
+			}
+
+			string ns = reader.GetString(definition.Namespace);
+			return ns.Length == 0 ? name : $"{ns}.{name}";
+		}
+
+		private static string GetFullName(MetadataReader reader, TypeReferenceHandle handle)
+		{
+			var reference = reader.GetTypeReference(handle);
+			string name = reader.GetString(reference.Name);
+			if (reference.ResolutionScope.Kind == HandleKind.TypeReference)
+			{
+				return $"{GetFullName(reader, (TypeReferenceHandle)reference.ResolutionScope)}+{name}";
+			}
+
+			string ns = reader.GetString(reference.Namespace);
+			return ns.Length == 0 ? name : $"{ns}.{name}";
+		}
+	}
+}
@@ -0,0 +1,235 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Linq;
+using System.Text;
+
+namespace MochiSharp.HeaderGen
+{
+	// Emits the C++ side of an AssemblyModel:
+	//  - struct definitions for blittable value types (or only layout checks for --map'ed types),
+	//  - static_asserts on sizeof/alignof/offsetof so a layout drift fails the native build,
+	//  - MOCHI_SCRIPT_STRUCT registrations so the structs can be used with ScriptMethod<>,
+	//  - one <Name>Script descriptor per script class with method signature ids and field handles.
+	internal static class HeaderWriter
+	{
+		private static readonly HashSet<string> CppKeywords = new(StringComparer.Ordinal)
+		{
+			"alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "class", "const",
+			"constexpr", "continue", "default", "delete", "do", "double", "else", "enum", "explicit", "export",
+			"extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable",
+			"namespace", "new", "noexcept", "not", "nullptr", "operator", "or", "private", "protected", "public",
+			"register", "requires", "return", "short", "signed", "sizeof", "static", "struct", "switch",
+			"template", "this", "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned",
+			"using", "virtual", "void", "volatile", "while", "xor"
+		};
+
+		private static readonly HashSet<string> ReservedMemberNames = new(StringComparer.Ordinal)
+		{
+			"TypeName", "Fields", "FieldCount"
+		};
+
+		public static string Write(AssemblyModel model, string sourceFileName)
+		{
+			var builder = new StringBuilder();
+			builder.Append("// <auto-generated>\n");
+			builder.Append(CultureInfo.InvariantCulture, $"// Generated by MochiSharp.HeaderGen from {sourceFileName} (MVID {model.Mvid:D}).\n");
+			builder.Append("// Do not edit: changes are overwritten when the script assembly is rebuilt.\n");
+			builder.Append("// </auto-generated>\n\n");
+			builder.Append("#pragma once\n\n");
+			builder.Append(model.UsesMathTypes ? "#include \"MathTypes.h\"\n\n" : "#include \"ScriptMethod.h\"\n\n");
+			builder.Append("#include <cstddef>\n");
+			builder.Append("#include <cstdint>\n");
+
+			foreach (var s in model.Structs)
+			{
+				if (s.NativeName == null)
+				{
+					WriteStructDefinition(builder, s);
+				}
+			}
+
+			foreach (var s in model.Structs)
+			{
+				WriteLayoutChecks(builder, model, s);
+			}
+
+			foreach (var t in model.ScriptTypes)
+			{
+				WriteScriptType(builder, t);
+			}
+
+			return builder.ToString();
+		}
+
+		private static void WriteStructDefinition(StringBuilder builder, AssemblyModel.StructModel s)
+		{
+			builder.Append('\n');
+			OpenNamespace(builder, s.Namespace);
+			string indent = s.Namespace.Length == 0 ? string.Empty : "    ";
+
+			// Explicit layouts are written byte-exact with explicit padding, so they are packed to 1.
+			int pack = s.IsExplicit ? 1 : s.Pack;
+			if (pack != 0)
+			{
+				builder.Append(CultureInfo.InvariantCulture, $"#pragma pack(push, {pack})\n");
+			}
+
+			builder.Append(CultureInfo.InvariantCulture, $"{indent}// {s.FullName}\n");
+			builder.Append(CultureInfo.InvariantCulture, $"{indent}struct {s.Name}\n{indent}{{\n");
+
+			int position = 0;
+			int padIndex = 0;
+			foreach (var field in s.IsExplicit ? s.Fields.OrderBy(f => f.Offset).ToList() : s.Fields)
+			{
+				if (s.IsExplicit && field.Offset > position)
+				{
+					builder.Append(CultureInfo.InvariantCulture, $"{indent}    uint8_t _Padding{padIndex++}[{field.Offset - position}];\n");
+				}
+
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}    {field.CppType} {ToIdentifier(field.Name)};\n");
+				position = s.IsExplicit ? field.Offset + field.Size : position;
+			}
+
+			if (s.IsExplicit && s.Size > position)
+			{
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}    uint8_t _Padding{padIndex}[{s.Size - position}];\n");
+			}
+
+			builder.Append(CultureInfo.InvariantCulture, $"{indent}}};\n");
+
+			if (pack != 0)
+			{
+				builder.Append("#pragma pack(pop)\n");
+			}
+
+			CloseNamespace(builder, s.Namespace);
+		}
+
+		private static void WriteLayoutChecks(StringBuilder builder, AssemblyModel model, AssemblyModel.StructModel s)
+		{
+			string cppName = GetCppName(s);
+			builder.Append(CultureInfo.InvariantCulture, $"\n// Layout of {s.FullName}\n");
+			builder.Append(CultureInfo.InvariantCulture, $"static_assert(std::is_trivially_copyable_v<{cppName}>, \"{cppName} must be trivially copyable\");\n");
+			builder.Append(CultureInfo.InvariantCulture, $"static_assert(sizeof({cppName}) == {s.Size}, \"sizeof({cppName}) does not match {s.FullName}\");\n");
+			if (!s.IsExplicit)
+			{
+				builder.Append(CultureInfo.InvariantCulture, $"static_assert(alignof({cppName}) == {s.Alignment}, \"alignof({cppName}) does not match {s.FullName}\");\n");
+			}
+
+			foreach (var field in s.Fields)
+			{
+				string fieldName = ToIdentifier(field.Name);
+				builder.Append(CultureInfo.InvariantCulture, $"static_assert(offsetof({cppName}, {fieldName}) == {field.Offset}, \"{cppName}::{fieldName} is not at offset {field.Offset} as in {s.FullName}\");\n");
+			}
+
+			builder.Append(CultureInfo.InvariantCulture, $"MOCHI_SCRIPT_STRUCT({cppName}, \"{model.GetManagedTypeName(s)}\", {s.Size});\n");
+		}
+
+		private static void WriteScriptType(StringBuilder builder, AssemblyModel.ScriptTypeModel t)
+		{
+			builder.Append('\n');
+			OpenNamespace(builder, t.Namespace);
+			string indent = t.Namespace.Length == 0 ? string.Empty : "    ";
+			string structName = $"{t.Name}Script";
+
+			builder.Append(CultureInfo.InvariantCulture, $"{indent}struct {structName}\n{indent}{{\n");
+			builder.Append(CultureInfo.InvariantCulture, $"{indent}    static constexpr const char *TypeName = \"{t.FullName}\";\n");
+
+			var usedNames = new HashSet<string>(ReservedMemberNames, StringComparer.Ordinal) { structName };
+			var methodNames = new List<string>(t.Methods.Count);
+			foreach (var method in t.Methods)
+			{
+				string memberName = MakeUnique(usedNames, ToIdentifier(method.Name));
+				methodNames.Add(memberName);
+
+				string parameters = string.Join(", ", method.ParameterCppTypes);
+				builder.Append('\n');
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}    struct {memberName}\n{indent}    {{\n");
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}        static constexpr const char *Name = \"{method.Name}\";\n");
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}        static constexpr bool IsStatic = {(method.IsStatic ? "true" : "false")};\n");
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}        static constexpr int SignatureId = 0x{method.SignatureId:X8};\n");
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}        using Signature = {method.ReturnCppType}({parameters});\n");
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}    }};\n");
+			}
+
+			if (t.Fields.Count > 0)
+			{
+				builder.Append('\n');
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}    static constexpr int FieldCount = {t.Fields.Count};\n\n");
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}    struct Fields\n{indent}    {{\n");
+				var fieldNames = new HashSet<string>(StringComparer.Ordinal) { "Fields" };
+				foreach (var field in t.Fields)
+				{
+					string memberName = MakeUnique(fieldNames, ToIdentifier(field.Name));
+					builder.Append(CultureInfo.InvariantCulture, $"{indent}        struct {memberName}\n{indent}        {{\n");
+					builder.Append(CultureInfo.InvariantCulture, $"{indent}            static constexpr const char *Name = \"{field.Name}\";\n");
+					builder.Append(CultureInfo.InvariantCulture, $"{indent}            static constexpr const char *TypeName = \"{field.FieldTypeName}\";\n");
+					builder.Append(CultureInfo.InvariantCulture, $"{indent}            static constexpr int Handle = {field.Handle};\n");
+					builder.Append(CultureInfo.InvariantCulture, $"{indent}        }};\n");
+				}
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}    }};\n");
+			}
+
+			builder.Append(CultureInfo.InvariantCulture, $"{indent}}};\n");
+
+			// The ids above come from the managed signature; these fail if ScriptTypeTraits maps a
+			// native type to a different managed name than the one the method really uses.
+			foreach (string memberName in methodNames)
+			{
+				string member = $"{structName}::{memberName}";
+				builder.Append(CultureInfo.InvariantCulture, $"{indent}static_assert(MochiSharp::ScriptMethod<{member}::Signature>::SignatureId == {member}::SignatureId, \"{t.FullName}: signature of {member} does not match ScriptTypeTraits\");\n");
+			}
+
+			CloseNamespace(builder, t.Namespace);
+		}
+
+		private static string GetCppName(AssemblyModel.StructModel s)
+		{
+			return s.NativeName ?? $"{AssemblyModel.ToCppNamespace(s.Namespace)}::{s.Name}";
+		}
+
+		private static void OpenNamespace(StringBuilder builder, string managedNamespace)
+		{
+			if (managedNamespace.Length > 0)
+			{
+				builder.Append(CultureInfo.InvariantCulture, $"namespace {AssemblyModel.ToCppNamespace(managedNamespace)}\n{{\n");
+			}
+		}
+
+		private static void CloseNamespace(StringBuilder builder, string managedNamespace)
+		{
+			if (managedNamespace.Length > 0)
+			{
+				builder.Append("}\n");
+			}
+		}
+
+		private static string MakeUnique(HashSet<string> usedNames, string name)
+		{
+			string candidate = name;
+			for (int i = 1; !usedNames.Add(candidate); i++)
+			{
+				candidate = $"{name}_{i}";
+			}
+			return candidate;
+		}
+
+		private static string ToIdentifier(string name)
+		{
+			var builder = new StringBuilder(name.Length);
+			foreach (char c in name)
+			{
+				builder.Append(char.IsAsciiLetterOrDigit(c) || c == '_' ? c : '_');
+			}
+
+			if (builder.Length == 0 || char.IsAsciiDigit(builder[0]))
+			{
+				builder.Insert(0, '_');
+			}
+
+			string identifier = builder.ToString();
+			return CppKeywords.Contains(identifier) ? identifier + "_" : identifier;
+		}
+	}
+}
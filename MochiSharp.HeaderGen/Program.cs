@@ -0,0 +1,172 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using MochiSharp.Managed.Core;
+
+namespace MochiSharp.HeaderGen
+{
+	// Build-time generator: reads a script assembly's metadata (without loading it) and writes
+	//  - a C++ header with matching struct layouts, signature ids and field handles, and
+	//  - a <assembly>.mochimanifest that ScriptContext loads to skip reflection-based discovery.
+	internal static class Program
+	{
+		private const string Usage =
+			"Usage: MochiSharp.HeaderGen <assembly.dll> --header <out.h> [options]\n" +
+			"  --manifest <path>               Manifest output (default: <assembly>.mochimanifest)\n" +
+			"  --base <Type.FullName>          Only describe script classes deriving from this type\n" +
+			"  --serialize-attribute <Type>    Attribute that marks non-public serialized fields\n" +
+			"  --map <Managed.Type>=<Native::Type>\n" +
+			"                                  Use an existing native struct instead of generating one;\n" +
+			"                                  only its layout is checked (field names must match)\n";
+
+		private static int Main(string[] args)
+		{
+			string? assemblyPath = null;
+			string? headerPath = null;
+			string? manifestPath = null;
+			string? scriptBaseType = null;
+			string serializeFieldAttributeTypeName = string.Empty;
+			var nativeTypeMap = new Dictionary<string, string>(StringComparer.Ordinal);
+
+			for (int i = 0; i < args.Length; i++)
+			{
+				string arg = args[i];
+				if (!arg.StartsWith("--", StringComparison.Ordinal))
+				{
+					assemblyPath = arg;
+					continue;
+				}
+
+				if (i + 1 >= args.Length)
+				{
+					Console.Error.Write(Usage);
+					return 2;
+				}
+
+				string value = args[++i];
+				switch (arg)
+				{
+					case "--header":
+						headerPath = value;
+						break;
+					case "--manifest":
+						manifestPath = value;
+						break;
+					case "--base":
+						scriptBaseType = value;
+						break;
+					case "--serialize-attribute":
+						serializeFieldAttributeTypeName = value;
+						break;
+					case "--map":
+						int separator = value.IndexOf('=');
+						if (separator <= 0)
+						{
+							Console.Error.WriteLine($"Invalid --map value: {value}");
+							return 2;
+						}
+						nativeTypeMap[value[..separator]] = value[(separator + 1)..];
+						break;
+					default:
+						Console.Error.WriteLine($"Unknown option: {arg}");
+						Console.Error.Write(Usage);
+						return 2;
+				}
+			}
+
+			if (assemblyPath == null || headerPath == null)
+			{
+				Console.Error.Write(Usage);
+				return 2;
+			}
+
+			try
+			{
+				assemblyPath = Path.GetFullPath(assemblyPath);
+				var model = AssemblyModel.Read(assemblyPath, scriptBaseType, serializeFieldAttributeTypeName, nativeTypeMap);
+				foreach (var warning in model.Warnings)
+				{
+					Console.WriteLine($"MochiSharp.HeaderGen: warning: {warning}");
+				}
+
+				foreach (var managedName in nativeTypeMap.Keys.Where(name => model.Structs.All(s => s.FullName != name)))
+				{
+					Console.WriteLine($"MochiSharp.HeaderGen: warning: --map {managedName} does not name a blittable struct in {Path.GetFileName(assemblyPath)}");
+				}
+
+				WriteIfChanged(headerPath, HeaderWriter.Write(model, Path.GetFileName(assemblyPath)));
+
+				var manifest = BuildManifest(model, serializeFieldAttributeTypeName);
+				manifest.Write(manifestPath ?? ScriptManifest.GetDefaultPath(assemblyPath));
+
+				Console.WriteLine($"MochiSharp.HeaderGen: {model.Structs.Count} structs, {model.ScriptTypes.Count} script types -> {headerPath}");
+				return 0;
+			}
+			catch (Exception ex)
+			{
+				Console.Error.WriteLine($"MochiSharp.HeaderGen: error: {ex.Message}");
+				return 1;
+			}
+		}
+
+		private static ScriptManifest BuildManifest(AssemblyModel model, string serializeFieldAttributeTypeName)
+		{
+			var manifest = new ScriptManifest
+			{
+				AssemblyName = model.AssemblyName,
+				Mvid = model.Mvid,
+				SerializeFieldAttributeTypeName = serializeFieldAttributeTypeName
+			};
+
+			foreach (var t in model.Types)
+			{
+				manifest.Types.Add(new ScriptManifest.TypeEntry(t.Token, t.FullName, t.IsConcreteClass, t.Ancestors));
+			}
+
+			foreach (var s in model.Structs)
+			{
+				manifest.Structs.Add(new ScriptManifest.StructEntry(s.FullName, s.Size, s.Alignment, s.Fields.Select(f => (f.Name, f.Offset)).ToArray()));
+			}
+
+			var signatureIds = new HashSet<int>();
+			foreach (var t in model.ScriptTypes)
+			{
+				foreach (var m in t.Methods)
+				{
+					if (signatureIds.Add(m.SignatureId))
+					{
+						manifest.Signatures.Add(new ScriptManifest.SignatureEntry(m.SignatureId, m.ReturnManagedName, m.ParameterManagedNames));
+					}
+					manifest.Methods.Add(new ScriptManifest.MethodEntry(t.FullName, m.Name, m.SignatureId, m.Token, m.IsStatic));
+				}
+
+				foreach (var f in t.Fields)
+				{
+					manifest.Fields.Add(new ScriptManifest.FieldEntry(t.FullName, f.Name, f.Token, f.Handle, f.IsPublic, f.HasSerializeFieldAttribute, f.FieldTypeName));
+				}
+			}
+
+			return manifest;
+		}
+
+		// Leaves the file untouched when nothing changed so native projects are not rebuilt.
+		private static void WriteIfChanged(string path, string contents)
+		{
+			string fullPath = Path.GetFullPath(path);
+			if (File.Exists(fullPath) && File.ReadAllText(fullPath) == contents)
+			{
+				return;
+			}
+
+			string? directory = Path.GetDirectoryName(fullPath);
+			if (!string.IsNullOrEmpty(directory))
+			{
+				Directory.CreateDirectory(directory);
+			}
+
+			File.WriteAllText(fullPath, contents, new UTF8Encoding(encoderShouldEmitUTF8Identifier: false));
+		}
+	}
+}
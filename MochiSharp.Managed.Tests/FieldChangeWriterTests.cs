@@ -0,0 +1,73 @@
+using System;
+using System.Runtime.InteropServices;
+using MochiSharp.Managed.Core;
+
+namespace MochiSharp.Managed.Tests
+{
+	internal static class FieldChangeWriterTests
+	{
+		[Test]
+		private static void RecordsAreWrittenOnEightByteBoundaries()
+		{
+			IntPtr buffer = Marshal.AllocHGlobal(64);
+			try
+			{
+				var writer = new FieldChangeWriter(buffer, 64);
+				IntPtr first = writer.Begin(ulong.MaxValue, 3, 5);
+				Test.Check(first == buffer + FieldChangeWriter.HeaderSize);
+				Test.Check(writer.Offset == 24 && writer.Count == 1);
+
+				IntPtr second = writer.Begin(42, 7, 8);
+				Test.Check(second == buffer + 24 + FieldChangeWriter.HeaderSize);
+				Test.Check(writer.Offset == 48 && writer.Count == 2);
+
+				Test.Check(Marshal.ReadInt64(buffer, 0) == -1L);
+				Test.Check(Marshal.ReadInt32(buffer, 8) == 3 && Marshal.ReadInt32(buffer, 12) == 5);
+				Test.Check(Marshal.ReadInt64(buffer, 24) == 42L);
+				Test.Check(Marshal.ReadInt32(buffer, 32) == 7 && Marshal.ReadInt32(buffer, 36) == 8);
+			}
+			finally
+			{
+				Marshal.FreeHGlobal(buffer);
+			}
+		}
+
+		[Test]
+		private static void RecordThatDoesNotFitIsLeftPending()
+		{
+			IntPtr buffer = Marshal.AllocHGlobal(48);
+			try
+			{
+				var writer = new FieldChangeWriter(buffer, 48);
+				Test.Check(writer.Begin(1, 1, 4) != IntPtr.Zero);
+				Test.Check(writer.Begin(2, 1, 17) == IntPtr.Zero);
+				Test.Check(writer.Offset == 24 && writer.Count == 1);
+
+				// A smaller record still fits exactly into the rest of the buffer.
+				Test.Check(writer.Begin(3, 1, 8) != IntPtr.Zero);
+				Test.Check(writer.Offset == 48 && writer.Count == 2);
+				Test.Check(writer.Begin(4, 1, 0) == IntPtr.Zero);
+			}
+			finally
+			{
+				Marshal.FreeHGlobal(buffer);
+			}
+		}
+
+		[Test]
+		private static void FirstRecordThatDoesNotFitThrows()
+		{
+			IntPtr buffer = Marshal.AllocHGlobal(32);
+			try
+			{
+				Test.Throws<ArgumentException>(() => new FieldChangeWriter(buffer, 32).Begin(1, 1, 17));
+				Test.Throws<ArgumentException>(() => new FieldChangeWriter(buffer, FieldChangeWriter.HeaderSize - 1));
+				Test.Throws<ArgumentException>(() => new FieldChangeWriter(IntPtr.Zero, 32));
+			}
+			finally
+			{
+				Marshal.FreeHGlobal(buffer);
+			}
+		}
+	}
+}
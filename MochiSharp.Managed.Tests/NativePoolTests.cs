@@ -0,0 +1,83 @@
+using System;
+using MochiSharp.Managed.Core;
+
+namespace MochiSharp.Managed.Tests
+{
+	internal static class NativePoolTests
+	{
+		private const int LargeLength = (1 << 20) + 1; // one byte past the largest size class
+
+		[Test]
+		private static void RentedBufferIsClearedAndReturned()
+		{
+			long before = NativePool.BytesInUse;
+			var buffer = NativePool.Rent<int>(100);
+			Test.Check(buffer.Length == 100 && buffer.AsSpan().IndexOfAnyExcept(0) == -1);
+			Test.Check(NativePool.BytesInUse == before + 512);
+
+			buffer.AsSpan().Fill(7);
+			NativePool.Return(ref buffer);
+			Test.Check(buffer.IsEmpty);
+			Test.Check(NativePool.BytesInUse == before);
+
+			NativePool.Return(ref buffer); // an empty buffer is ignored
+		}
+
+		[Test]
+		private static void SmallBufferReturnedTwiceThrows()
+		{
+			var buffer = NativePool.Rent<byte>(64);
+			var copy = buffer;
+			NativePool.Return(ref buffer);
+			Test.Throws<InvalidOperationException>(() => NativePool.Return(ref copy));
+
+			// The block is live again for a new renter; the stale copy still cannot return it.
+			var next = NativePool.Rent<byte>(64);
+			Test.Check(next.Address == copy.Address);
+			Test.Throws<InvalidOperationException>(() => NativePool.Return(ref copy));
+			Test.Check(!next.IsEmpty);
+			NativePool.Return(ref next);
+		}
+
+		[Test]
+		private static void LargeBufferReturnedTwiceThrows()
+		{
+			long before = NativePool.BytesInUse;
+			var buffer = NativePool.Rent<byte>(LargeLength);
+			buffer.AsSpan()[^1] = 1;
+			var copy = buffer;
+			NativePool.Return(ref buffer);
+			Test.Check(NativePool.BytesInUse == before);
+
+			// The block was freed on the first return; the second must not read it.
+			Test.Throws<InvalidOperationException>(() => NativePool.Return(ref copy));
+			Test.Check(NativePool.BytesInUse == before);
+		}
+
+		[Test]
+		private static void BufferReturnedBeforeTrimThrowsOnSecondReturn()
+		{
+			var small = NativePool.Rent<long>(16);
+			var smallCopy = small;
+			NativePool.Return(ref small);
+			NativePool.Trim();
+			Test.Throws<InvalidOperationException>(() => NativePool.Return(ref smallCopy));
+
+			var fresh = NativePool.Rent<long>(16);
+			Test.Check(fresh.AsSpan().IndexOfAnyExcept(0L) == -1);
+			NativePool.Return(ref fresh);
+			NativePool.Trim();
+		}
+
+#if DEBUG
+		[Test]
+		private static void SpanOfReturnedBufferThrows()
+		{
+			var buffer = NativePool.Rent<int>(8);
+			var copy = buffer;
+			NativePool.Return(ref buffer);
+			Test.Throws<InvalidOperationException>(() => copy.AsSpan());
+		}
+#endif
+	}
+}
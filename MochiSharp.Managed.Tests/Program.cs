@@ -0,0 +1,45 @@
+using System;
+using System.Linq;
+using System.Reflection;
+
+namespace MochiSharp.Managed.Tests
+{
+	// Runs the managed unit tests without a native host: MochiSharp.Managed.Tests [name filter]
+	//
+	// Every static [Test] method of this assembly runs on the main thread, which also becomes the
+	// scheduler's game thread. Exits with 1 if a test failed or none matched the filter.
+	internal static class Program
+	{
+		private static int Main(string[] args)
+		{
+			string filter = args.Length > 0 ? args[0] : "";
+			var tests = typeof(Program).Assembly.GetTypes()
+				.SelectMany(type => type.GetMethods(BindingFlags.Static | BindingFlags.Public | BindingFlags.NonPublic))
+				.Where(method => method.GetCustomAttribute<TestAttribute>() != null && method.Name.Contains(filter, StringComparison.Ordinal))
+				.OrderBy(method => method.DeclaringType!.Name, StringComparer.Ordinal)
+				.ThenBy(method => method.MetadataToken);
+
+			int run = 0, failed = 0;
+			foreach (var test in tests)
+			{
+				int failuresBefore = Test.Failures;
+				try
+				{
+					test.Invoke(null, null);
+				}
+				catch (TargetInvocationException ex) when (ex.InnerException != null)
+				{
+					Test.Fail($"threw {ex.InnerException.GetType().FullName}: {ex.InnerException.Message}");
+				}
+
+				bool passed = Test.Failures == failuresBefore;
+				Console.WriteLine($"[{(passed ? "PASS" : "FAIL")}] {test.Name}");
+				run++;
+				failed += passed ? 0 : 1;
+			}
+
+			Console.WriteLine($"{run} tests, {failed} failed");
+			return failed == 0 && run > 0 ? 0 : 1;
+		}
+	}
+}
@@ -0,0 +1,118 @@
+using System;
+using System.Runtime.InteropServices;
+using MochiSharp.Managed.Core;
+
+namespace MochiSharp.Managed.Tests
+{
+	// Script types for the tests below, loaded from this assembly as a plugin module.
+	public sealed class OpenGenericScript
+	{
+		// Binds by parameter types, but reflection cannot call an open generic method: every call
+		// is rejected by MethodInfo.Invoke itself (a string return always takes the reflection path).
+		public string Describe<T>()
+		{
+			return typeof(T).Name;
+		}
+	}
+
+	public sealed class HitScript
+	{
+		[ScriptEvent(ScriptContextTests.HitEvent)]
+		private void OnHit(ref int hits)
+		{
+			hits++;
+		}
+	}
+
+	public sealed class SilentScript
+	{
+	}
+
+	internal static class ScriptContextTests
+	{
+		public const int HitEvent = 7;
+		private const int StringSignature = 9001;
+
+		[Test]
+		private static void CallRejectedByReflectionTripsTheBreaker()
+		{
+			var context = new ScriptContext(typeof(ScriptContextTests).Assembly.Location);
+			try
+			{
+				context.MaxConsecutiveFaults = 3;
+				context.RegisterSignature(StringSignature, "System.String", Array.Empty<string>());
+				context.CreateInstance(1, typeof(OpenGenericScript).FullName!);
+				int methodId = context.BindInstanceMethod(1, "Describe", StringSignature);
+
+				IntPtr result = Marshal.AllocHGlobal(IntPtr.Size);
+				try
+				{
+					for (int i = 0; i < 3; i++)
+					{
+						var status = context.TryInvoke(methodId, IntPtr.Zero, 0, result, out var error);
+						Test.Check(status == InvokeStatus.BadArguments && error is InvalidOperationException);
+					}
+
+					Test.Check(context.TryInvoke(methodId, IntPtr.Zero, 0, result, out _) == InvokeStatus.Disabled);
+					Test.Check(context.TryGetMethodFaults(methodId, out var faults) && faults.TotalFaults == 3);
+				}
+				finally
+				{
+					Marshal.FreeHGlobal(result);
+				}
+			}
+			finally
+			{
+				context.Unload(null);
+			}
+		}
+
+		[Test]
+		private static void BroadcastReachesOnlySubscribedInstances()
+		{
+			var context = new ScriptContext(typeof(ScriptContextTests).Assembly.Location);
+			IntPtr ids = Marshal.AllocHGlobal(3 * sizeof(ulong));
+			IntPtr bitmap = Marshal.AllocHGlobal(1);
+			IntPtr hits = Marshal.AllocHGlobal(sizeof(int));
+			try
+			{
+				for (int i = 0; i < 3; i++)
+				{
+					Marshal.WriteInt64(ids, i * sizeof(ulong), i + 1);
+				}
+
+				Test.Check(context.CreateInstances(typeof(HitScript).FullName!, ids, 3, bitmap, null) == 3);
+				context.CreateInstance(10, typeof(SilentScript).FullName!);
+				context.CreateInstance(11, typeof(SilentScript).FullName!);
+
+				int Dispatch(int eventTypeId, ulong target)
+				{
+					Marshal.WriteInt32(hits, 0);
+					int handled = context.DispatchEvent(eventTypeId, target, hits, sizeof(int), ex => Test.Fail(ex.Message));
+					Test.Check(handled == Marshal.ReadInt32(hits));
+					return handled;
+				}
+
+				Test.Check(Dispatch(HitEvent, 0) == 3);
+				Test.Check(Dispatch(HitEvent + 1, 0) == 0);
+
+				context.DestroyInstance(1);
+				Test.Check(Dispatch(HitEvent, 0) == 2);
+				Test.Check(Dispatch(HitEvent, 3) == 1);
+				Test.Check(Dispatch(HitEvent, 1) == 0);
+				Test.Check(Dispatch(HitEvent, 10) == 0);
+
+				context.CreateInstance(1, typeof(HitScript).FullName!);
+				context.DestroyInstance(3);
+				Test.Check(Dispatch(HitEvent, 0) == 2);
+			}
+			finally
+			{
+				Marshal.FreeHGlobal(hits);
+				Marshal.FreeHGlobal(bitmap);
+				Marshal.FreeHGlobal(ids);
+				context.Unload(null);
+			}
+		}
+	}
+}
@@ -0,0 +1,166 @@
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using MochiSharp.Managed.Core;
+
+namespace MochiSharp.Managed.Tests
+{
+	internal static class ScriptSchedulerTests
+	{
+		private sealed class Owner
+		{
+		}
+
+		[Test]
+		private static void CoroutineStoppingItselfByHandleEnds()
+		{
+			var errors = CaptureErrors();
+			var handle = default(CoroutineHandle);
+			int steps = 0;
+
+			IEnumerator Routine()
+			{
+				yield return null;
+				ScriptScheduler.StopCoroutine(handle);
+				steps++;
+				yield return null;
+				steps++;
+			}
+
+			int others = 0;
+			var other = ScriptScheduler.StartCoroutine(Count(() => others++));
+			handle = ScriptScheduler.StartCoroutine(Routine());
+			Tick(3);
+
+			Test.Check(steps == 1);
+			Test.Check(others == 3);
+			Test.Check(!ScriptScheduler.StopCoroutine(handle));
+			Test.Check(ScriptScheduler.StopCoroutine(other));
+			Test.Check(errors.Count == 0);
+			Tick(1);
+		}
+
+		[Test]
+		private static void NestedCoroutineStoppingItsOwnerEnds()
+		{
+			var errors = CaptureErrors();
+			var owner = new Owner();
+			int stopped = -1, outerSteps = 0;
+
+			IEnumerator Inner()
+			{
+				yield return null;
+				stopped = ScriptScheduler.StopCoroutines(owner);
+				yield return null;
+			}
+
+			IEnumerator Outer()
+			{
+				yield return Inner();
+				outerSteps++;
+			}
+
+			int others = 0;
+			var otherOwner = new Owner();
+			ScriptScheduler.StartCoroutine(Count(() => others++), otherOwner);
+			ScriptScheduler.StartCoroutine(Outer(), owner);
+			ScriptScheduler.StartCoroutine(Count(() => { }), owner);
+			Tick(3);
+
+			Test.Check(stopped == 2);
+			Test.Check(outerSteps == 0);
+			Test.Check(others == 3);
+			Test.Check(ScriptScheduler.StopCoroutines(owner) == 0);
+			Test.Check(ScriptScheduler.StopCoroutines(otherOwner) == 1);
+			Test.Check(errors.Count == 0);
+			Tick(1);
+		}
+
+		[Test]
+		private static void CoroutineStoppingItselfOnItsLastStepEnds()
+		{
+			var errors = CaptureErrors();
+			var owner = new Owner();
+			int steps = 0;
+
+			IEnumerator Routine()
+			{
+				yield return null;
+				steps++;
+				ScriptScheduler.StopCoroutines(owner);
+			}
+
+			ScriptScheduler.StartCoroutine(Routine(), owner);
+			Tick(2);
+
+			Test.Check(steps == 1);
+			Test.Check(errors.Count == 0);
+		}
+
+		[Test]
+		private static void ThrowingCoroutineIsReportedAndRemoved()
+		{
+			var errors = CaptureErrors();
+			var owner = new Owner();
+
+			IEnumerator Routine()
+			{
+				yield return null;
+				throw new InvalidOperationException("boom");
+			}
+
+			ScriptScheduler.StartCoroutine(Routine(), owner);
+			Tick(2);
+
+			Test.Check(errors.Count == 1 && errors[0] is InvalidOperationException);
+			Test.Check(ScriptScheduler.StopCoroutines(owner) == 0);
+		}
+
+		[Test]
+		private static void WaitForSecondsResumesAfterTheDelay()
+		{
+			var errors = CaptureErrors();
+			double resumedAt = -1.0;
+
+			IEnumerator Routine()
+			{
+				double start = ScriptScheduler.Time;
+				yield return new WaitForSeconds(0.5);
+				resumedAt = ScriptScheduler.Time - start;
+			}
+
+			ScriptScheduler.StartCoroutine(Routine());
+			for (int i = 0; i < 4; i++)
+			{
+				ScriptScheduler.Tick(0.2);
+			}
+
+			Test.Check(resumedAt >= 0.5 && resumedAt < 0.7);
+			Test.Check(errors.Count == 0);
+		}
+
+		private static IEnumerator Count(Action step)
+		{
+			while (true)
+			{
+				yield return null;
+				step();
+			}
+		}
+
+		private static List<Exception> CaptureErrors()
+		{
+			var errors = new List<Exception>();
+			ScriptScheduler.ErrorHandler = errors.Add;
+			return errors;
+		}
+
+		private static void Tick(int frames)
+		{
+			for (int i = 0; i < frames; i++)
+			{
+				ScriptScheduler.Tick(1.0 / 60.0);
+			}
+		}
+	}
+}
@@ -0,0 +1,60 @@
+using System;
+using System.Runtime.CompilerServices;
+
+namespace MochiSharp.Managed.Tests
+{
+	// Marks a static, parameterless method as a test:
+	//
+	//   [Test]
+	//   private static void SchedulerStopsItself() { Test.Check(count == 1); }
+	//
+	// A failed check is reported and the test keeps running; an exception fails the test.
+	[AttributeUsage(AttributeTargets.Method)]
+	internal sealed class TestAttribute : Attribute
+	{
+	}
+
+	internal static class Test
+	{
+		public static int Failures { get; private set; }
+
+		public static void Check(bool condition,
+			[CallerArgumentExpression(nameof(condition))] string expression = "",
+			[CallerFilePath] string file = "",
+			[CallerLineNumber] int line = 0)
+		{
+			if (!condition)
+			{
+				Fail($"{file}({line}): check failed: {expression}");
+			}
+		}
+
+		public static void Throws<TException>(Action action,
+			[CallerArgumentExpression(nameof(action))] string expression = "",
+			[CallerFilePath] string file = "",
+			[CallerLineNumber] int line = 0) where TException : Exception
+		{
+			try
+			{
+				action();
+			}
+			catch (TException)
+			{
+				return;
+			}
+			catch (Exception ex)
+			{
+				Fail($"{file}({line}): {expression} threw {ex.GetType().Name} instead of {typeof(TException).Name}");
+				return;
+			}
+
+			Fail($"{file}({line}): {expression} did not throw {typeof(TException).Name}");
+		}
+
+		public static void Fail(string message)
+		{
+			Console.WriteLine($"  {message}");
+			Failures++;
+		}
+	}
+}
@@ -2,17 +2,20 @@
 using System.IO;
 using System.Linq;
 using System.Reflection;
+using System.Runtime;
 using System.Runtime.InteropServices;
 using System.Runtime.Loader;
+using MochiSharp.Managed.Scene;
 
 namespace MochiSharp.Managed.Core
 {
     public static class Bootstrap
     {
         private static HostHook? _hostHook;
-        private static ScriptContext? _scriptContext;
+        private static readonly ScriptModuleRegistry _modules = new();
         private static string _serializeFieldAttributeTypeName = string.Empty;
         private static string _entityTypeName = string.Empty;
+        private static ScriptEventRing? _eventRing;
 
         private static void SafeLog(string message)
         {
@@ -25,24 +28,18 @@ namespace MochiSharp.Managed.Core
             }
         }
 
+        // Returns the module handle (> 0), or 0 on error.
         private static int LoadAssemblyCore(string path)
         {
-            if (_scriptContext != null)
-            {
-                _scriptContext.Unload();
-                _scriptContext = null;
-
-                GC.Collect();
-                GC.WaitForPendingFinalizers();
-            }
-
             try
             {
                 string fullPath = System.IO.Path.GetFullPath(path);
-                _scriptContext = new ScriptContext(fullPath);
-                _scriptContext.ConfigureSerializationTypeNames(_serializeFieldAttributeTypeName, _entityTypeName);
-                _hostHook?.Log($"Loaded Script Assembly: {fullPath}");
-                return 1;
+                int handle = _modules.Load(fullPath, SafeLog);
+                var module = _modules.GetModule(handle);
+                _hostHook?.Log(module.HasManifest
+                    ? $"Loaded Script Assembly: {fullPath} as module {handle} (with {ScriptManifest.FileExtension})"
+                    : $"Loaded Script Assembly: {fullPath} as module {handle}");
+                return handle;
             }
             catch (Exception ex)
             {
@@ -59,10 +56,7 @@ namespace MochiSharp.Managed.Core
                 _serializeFieldAttributeTypeName = Marshal.PtrToStringUTF8(serializeFieldAttributeTypeNamePtr) ?? string.Empty;
                 _entityTypeName = Marshal.PtrToStringUTF8(entityTypeNamePtr) ?? string.Empty;
 
-                if (_scriptContext != null)
-                {
-                    _scriptContext.ConfigureSerializationTypeNames(_serializeFieldAttributeTypeName, _entityTypeName);
-                }
+                _modules.ConfigureSerializationTypeNames(_serializeFieldAttributeTypeName, _entityTypeName);
 
                 _hostHook?.Log($"Configured serialization types: attr={_serializeFieldAttributeTypeName}, entity={_entityTypeName}");
                 return 1;
@@ -80,7 +74,7 @@ namespace MochiSharp.Managed.Core
             try
             {
                 string typeName = Marshal.PtrToStringUTF8(typeNamePtr) ?? string.Empty;
-                string result = GetContextOrThrow().GetTypeFields(typeName);
+                string result = _modules.GetByTypeName(typeName).GetTypeFields(typeName);
                 return Marshal.StringToCoTaskMemUTF8(result);
             }
             catch (Exception ex)
@@ -96,7 +90,7 @@ namespace MochiSharp.Managed.Core
             try
             {
                 string fieldName = Marshal.PtrToStringUTF8(fieldNamePtr) ?? string.Empty;
-                bool ok = GetContextOrThrow().GetInstanceFieldValue(instanceId, fieldName, bufferPtr, bufferSize);
+                bool ok = _modules.GetByInstance(instanceId).GetInstanceFieldValue(instanceId, fieldName, bufferPtr, bufferSize);
                 return ok ? 1 : 0;
             }
             catch (Exception ex)
@@ -112,7 +106,7 @@ namespace MochiSharp.Managed.Core
             try
             {
                 string fieldName = Marshal.PtrToStringUTF8(fieldNamePtr) ?? string.Empty;
-                bool ok = GetContextOrThrow().SetInstanceFieldValue(instanceId, fieldName, bufferPtr, bufferSize);
+                bool ok = _modules.GetByInstance(instanceId).SetInstanceFieldValue(instanceId, fieldName, bufferPtr, bufferSize);
                 return ok ? 1 : 0;
             }
             catch (Exception ex)
@@ -122,69 +116,111 @@ namespace MochiSharp.Managed.Core
             }
         }
 
-        private static string GetDerivedTypesCore(string asmPath, string baseTypeFullName)
+        // Returns the number of tracked fields of the type, or -1 on error.
+        [UnmanagedCallersOnly]
+        public static int ConfigureFieldTracking(IntPtr typeNamePtr, int enabled)
         {
             try
             {
-                string fullPath = Path.GetFullPath(asmPath);
-                if (_scriptContext != null && string.Equals(_scriptContext.PluginPath, fullPath, StringComparison.OrdinalIgnoreCase))
-                {
-                    return _scriptContext.GetDerivedTypes(baseTypeFullName);
-                }
-
-                var asm = Assembly.LoadFrom(asmPath);
+                string typeName = Marshal.PtrToStringUTF8(typeNamePtr) ?? string.Empty;
+                return _modules.ConfigureFieldTracking(typeName, enabled != 0);
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"ConfigureFieldTracking failed: {ex.Message}");
+                return -1;
+            }
+        }
 
-                string asmDir = Path.GetDirectoryName(asm.Location) ?? string.Empty;
-                foreach (var reference in asm.GetReferencedAssemblies())
+        // Fills the buffer with the field changes since the previous call (MochiSharp::ScriptFieldChange
+        // records) and stores the bytes used at bytesWrittenPtr. Returns the record count, or -1 on error.
+        [UnmanagedCallersOnly]
+        public static int CollectDirtyFields(IntPtr bufferPtr, int bufferSize, IntPtr bytesWrittenPtr)
+        {
+            try
+            {
+                int count = _modules.CollectDirtyFields(bufferPtr, bufferSize, out int bytesWritten);
+                if (bytesWrittenPtr != IntPtr.Zero)
                 {
-                    _ = AppDomain.CurrentDomain.GetAssemblies()
-                        .FirstOrDefault(a => string.Equals(a.GetName().Name, reference.Name, StringComparison.OrdinalIgnoreCase))
-                        ?? TryLoadReference(reference, asmDir);
+                    Marshal.WriteInt32(bytesWrittenPtr, bytesWritten);
                 }
+                return count;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"CollectDirtyFields failed: {ex.Message}");
+                return -1;
+            }
+        }
 
-                var baseType = Type.GetType(baseTypeFullName, throwOnError: false)
-                    ?? AppDomain.CurrentDomain.GetAssemblies()
-                        .Select(a => a.GetType(baseTypeFullName, throwOnError: false))
-                        .FirstOrDefault(t => t != null)
-                    ?? throw new Exception($"Base type not found: {baseTypeFullName}");
-
-                var derived = asm.GetTypes()
-                    .Where(t => t.IsClass && !t.IsAbstract && baseType.IsAssignableFrom(t))
-                    .Select(t => t.FullName)
-                    .Where(n => !string.IsNullOrEmpty(n))
-                    .ToArray();
+        // Selects replicated fields by this attribute instead of MochiSharp.Managed.Core.ReplicatedAttribute.
+        [UnmanagedCallersOnly]
+        public static int ConfigureReplication(IntPtr attributeTypeNamePtr)
+        {
+            try
+            {
+                _modules.ConfigureReplication(Marshal.PtrToStringUTF8(attributeTypeNamePtr) ?? string.Empty);
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"ConfigureReplication failed: {ex.Message}");
+                return 0;
+            }
+        }
 
-                return string.Join("|", derived);
+        // Returns the size of the snapshot, which is only written when it fits in bufferSize, or -1 on error.
+        [UnmanagedCallersOnly]
+        public static int CaptureSnapshot(IntPtr bufferPtr, int bufferSize)
+        {
+            try
+            {
+                return _modules.CaptureSnapshot(bufferPtr, bufferSize);
             }
             catch (Exception ex)
             {
-                _hostHook?.Log($"GetDerivedTypes failed for {asmPath}: {ex.Message}");
-                return string.Empty;
+                _hostHook?.Log($"CaptureSnapshot failed: {ex.Message}");
+                return -1;
             }
         }
 
-        private static Assembly? TryLoadReference(AssemblyName reference, string asmDir)
+        // previousPtr (optional) is the snapshot applied last; entries it already had are skipped.
+        // Returns the number of instances updated, or -1 on error.
+        [UnmanagedCallersOnly]
+        public static int ApplySnapshot(IntPtr snapshotPtr, int snapshotSize, IntPtr previousPtr, int previousSize)
         {
             try
             {
-                return Assembly.Load(reference);
+                return _modules.ApplySnapshot(snapshotPtr, snapshotSize, previousPtr, previousSize);
             }
-            catch
+            catch (Exception ex)
             {
-                try
-                {
-                    string candidate = Path.Combine(asmDir, $"{reference.Name}.dll");
-                    if (File.Exists(candidate))
-                    {
-                        return Assembly.LoadFrom(candidate);
-                    }
-                }
-                catch
+                _hostHook?.Log($"ApplySnapshot failed: {ex.Message}");
+                return -1;
+            }
+        }
+
+        private static string GetDerivedTypesCore(string asmPath, string baseTypeFullName)
+        {
+            try
+            {
+                string fullPath = Path.GetFullPath(asmPath);
+                var module = _modules.FindByPath(fullPath);
+                if (module != null)
                 {
+                    return module.GetDerivedTypes(baseTypeFullName);
                 }
-            }
 
-            return null;
+                // Read the type hierarchy from metadata instead of loading the assembly into the
+                // default (non-collectible) context.
+                var derived = MetadataTypeScanner.GetDerivedTypes(fullPath, baseTypeFullName);
+                return string.Join("|", derived);
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"GetDerivedTypes failed for {asmPath}: {ex.Message}");
+                return string.Empty;
+            }
         }
 
         [UnmanagedCallersOnly]
@@ -197,31 +233,44 @@ namespace MochiSharp.Managed.Core
             return Marshal.StringToCoTaskMemUTF8(result);
         }
 
+        // Metadata-only variant of GetDerivedTypes. Returns a CoTaskMem block laid out as
+        // int32 totalBytes, int32 count, then count x (int32 byteLength, UTF-8 name bytes),
+        // or IntPtr.Zero on error. Results are cached per assembly file (timestamp/MVID).
         [UnmanagedCallersOnly]
-        public static IntPtr GetInstanceFields(ulong instanceId)
+        public static IntPtr GetDerivedTypeList(IntPtr asmPathPtr, IntPtr baseTypeFullNamePtr)
         {
+            string asmPath = Marshal.PtrToStringUTF8(asmPathPtr) ?? string.Empty;
             try
             {
-                Console.WriteLine($"GetInstanceFields for instance: {instanceId}");
+                string baseTypeFullName = Marshal.PtrToStringUTF8(baseTypeFullNamePtr) ?? string.Empty;
+                byte[] payload = MetadataTypeScanner.EncodeNameList(MetadataTypeScanner.GetDerivedTypes(asmPath, baseTypeFullName));
 
-                string result = _scriptContext!.GetInstanceFields(instanceId);
-                return Marshal.StringToCoTaskMemUTF8(result);
+                IntPtr result = Marshal.AllocCoTaskMem(payload.Length);
+                Marshal.Copy(payload, 0, result, payload.Length);
+                return result;
             }
             catch (Exception ex)
             {
-                Console.WriteLine($"GetInstanceFields failed for instance: {instanceId}: {ex.Message}");
+                _hostHook?.Log($"GetDerivedTypeList failed for {asmPath}: {ex.Message}");
                 return IntPtr.Zero;
             }
         }
 
-        private static ScriptContext GetContextOrThrow()
+        [UnmanagedCallersOnly]
+        public static IntPtr GetInstanceFields(ulong instanceId)
         {
-            if (_scriptContext == null)
+            try
             {
-                throw new InvalidOperationException("No ScriptContext loaded. Call LoadAssembly first.");
-            }
+                Console.WriteLine($"GetInstanceFields for instance: {instanceId}");
 
-            return _scriptContext;
+                string result = _modules.GetByInstance(instanceId).GetInstanceFields(instanceId);
+                return Marshal.StringToCoTaskMemUTF8(result);
+            }
+            catch (Exception ex)
+            {
+                Console.WriteLine($"GetInstanceFields failed for instance: {instanceId}: {ex.Message}");
+                return IntPtr.Zero;
+            }
         }
 
         // Structure to hold C++ function pointers (Engine API)
@@ -239,12 +288,28 @@ namespace MochiSharp.Managed.Core
             var engineApi = Marshal.PtrToStructure<EngineInterface>(engineArgs);
 
             _hostHook = new HostHook(engineApi);
+            ScriptScheduler.ErrorHandler = LogSchedulerError;
+            ScriptScheduler.InstallOnCurrentThread();
             _hostHook.Log("C# Managed Core Initialized successfully");
+            _hostHook.Log(DescribeRuntime());
 
             return 0;
         }
 
-        // Load/Reload a plugin assembly into a collectible context.
+        // What the runtime actually started with: runtimeconfig.json plus the host's HostSettings.
+        private static string DescribeRuntime()
+        {
+            static string Setting(string name) => AppContext.GetData(name)?.ToString() ?? "default";
+
+            return $"{RuntimeInformation.FrameworkDescription}: {(GCSettings.IsServerGC ? "server" : "workstation")} GC " +
+                $"({GCSettings.LatencyMode}, {GC.GetGCMemoryInfo().TotalAvailableMemoryBytes >> 20} MB available), " +
+                $"tiered compilation {Setting("System.Runtime.TieredCompilation")}, QuickJitForLoops {Setting("System.Runtime.TieredCompilation.QuickJitForLoops")}, " +
+                $"TieredPGO {Setting("System.Runtime.TieredPGO")}, ReadyToRun {Environment.GetEnvironmentVariable("DOTNET_ReadyToRun") ?? "default"}";
+        }
+
+        // Load a plugin assembly as a script module with its own collectible context, next to the
+        // modules already loaded. Loading a path that is already loaded reloads that module.
+        // Returns the module handle (> 0), or 0 on error.
         [UnmanagedCallersOnly]
         public static int LoadAssembly(IntPtr assemblyPathPtr)
         {
@@ -252,6 +317,159 @@ namespace MochiSharp.Managed.Core
             return LoadAssemblyCore(path);
         }
 
+        // Load a script module from an image the host holds in memory (e.g. read from a package).
+        // The name identifies the module: loading the same name again replaces it. The symbols (PDB)
+        // are optional. Returns the module handle (> 0), or 0 on error.
+        [UnmanagedCallersOnly]
+        public static int LoadAssemblyFromMemory(IntPtr modulePathPtr, IntPtr image, int imageSize, IntPtr symbols, int symbolsSize)
+        {
+            try
+            {
+                string path = System.IO.Path.GetFullPath(Marshal.PtrToStringUTF8(modulePathPtr)!);
+                if (image == IntPtr.Zero || imageSize <= 0)
+                {
+                    throw new ArgumentException("An assembly image is required", nameof(image));
+                }
+
+                byte[] imageBytes = new byte[imageSize];
+                Marshal.Copy(image, imageBytes, 0, imageSize);
+
+                byte[]? symbolBytes = null;
+                if (symbols != IntPtr.Zero && symbolsSize > 0)
+                {
+                    symbolBytes = new byte[symbolsSize];
+                    Marshal.Copy(symbols, symbolBytes, 0, symbolsSize);
+                }
+
+                int handle = _modules.LoadFromMemory(path, imageBytes, symbolBytes, SafeLog);
+                _hostHook?.Log($"Loaded Script Assembly from memory: {path} as module {handle} ({imageSize} bytes)");
+                return handle;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"Failed to load script assembly from memory: {ex}");
+                return 0;
+            }
+        }
+
+        // Reload one module from its path. Its instances and method handles are invalidated; other
+        // modules keep their state. Returns 1 on success, 0 on error (the previous copy stays loaded).
+        [UnmanagedCallersOnly]
+        public static int ReloadModule(int moduleHandle)
+        {
+            try
+            {
+                _modules.Reload(moduleHandle, SafeLog);
+                _hostHook?.Log($"Reloaded module {moduleHandle}: {_modules.GetModule(moduleHandle).PluginPath}");
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"ReloadModule {moduleHandle} failed: {ex}");
+                return 0;
+            }
+        }
+
+        [UnmanagedCallersOnly]
+        public static int UnloadModule(int moduleHandle)
+        {
+            try
+            {
+                _modules.Unload(moduleHandle, SafeLog);
+                _hostHook?.Log($"Unloaded module {moduleHandle}");
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"UnloadModule {moduleHandle} failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        // After every unload or reload, up to maxCollections blocking GCs check that the old load
+        // context is collected (0 skips them). With diagnostics != 0, a context that survives is searched
+        // for the static roots keeping it alive; that walks the heap and is meant for development.
+        [UnmanagedCallersOnly]
+        public static int ConfigureUnloadTracking(int maxCollections, int diagnostics)
+        {
+            try
+            {
+                _modules.ConfigureUnloadTracking(maxCollections, diagnostics != 0);
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                SafeLog($"ConfigureUnloadTracking failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        // The module's last unload: fills reportPtr (ScriptUnloadReport, optional) and returns the roots
+        // found by diagnostics, one per line, as a UTF-8 CoTaskMem string (empty if none were searched
+        // for), or IntPtr.Zero if the module was never unloaded.
+        [UnmanagedCallersOnly]
+        public static IntPtr GetUnloadReport(int moduleHandle, IntPtr reportPtr)
+        {
+            try
+            {
+                if (!_modules.TryGetUnloadReport(moduleHandle, out var report, out string roots))
+                {
+                    return IntPtr.Zero;
+                }
+
+                if (reportPtr != IntPtr.Zero)
+                {
+                    Marshal.StructureToPtr(report, reportPtr, false);
+                }
+
+                return Marshal.StringToCoTaskMemUTF8(roots);
+            }
+            catch (Exception ex)
+            {
+                SafeLog($"GetUnloadReport failed: {ex.Message}");
+                return IntPtr.Zero;
+            }
+        }
+
+        // Files that make up a module (its assembly first, then privately loaded dependencies), for
+        // the native file watcher. Same layout as GetDerivedTypeList; IntPtr.Zero on error.
+        [UnmanagedCallersOnly]
+        public static IntPtr GetModuleFiles(int moduleHandle)
+        {
+            try
+            {
+                byte[] payload = MetadataTypeScanner.EncodeNameList(_modules.GetModule(moduleHandle).GetModuleFiles().ToArray());
+
+                IntPtr result = Marshal.AllocCoTaskMem(payload.Length);
+                Marshal.Copy(payload, 0, result, payload.Length);
+                return result;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"GetModuleFiles {moduleHandle} failed: {ex.Message}");
+                return IntPtr.Zero;
+            }
+        }
+
+        // Load an assembly that several modules reference into the shared parent context, so its
+        // types are the same for every module. Must happen before the modules that use it are loaded.
+        [UnmanagedCallersOnly]
+        public static int LoadSharedAssembly(IntPtr assemblyPathPtr)
+        {
+            try
+            {
+                string path = Marshal.PtrToStringUTF8(assemblyPathPtr)!;
+                var assembly = ScriptContext.LoadSharedAssembly(path);
+                _hostHook?.Log($"Loaded shared assembly: {assembly.GetName().Name}");
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"LoadSharedAssembly failed: {ex}");
+                return 0;
+            }
+        }
+
         // Create a script instance with a caller-supplied instance key.
         // Returns 1 on success, 0 on error.
         [UnmanagedCallersOnly]
@@ -261,31 +479,68 @@ namespace MochiSharp.Managed.Core
             {
                 string typeName = Marshal.PtrToStringUTF8(typeNamePtr)!;
 
-                bool created = GetContextOrThrow().CreateInstance(instanceId, typeName);
-                if (created)
-                {
-                    _hostHook?.Log($"Created instance {instanceId}: {typeName}");
-                }
-                else
+                _modules.CreateInstance(instanceId, typeName);
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"CreateInstance failed: {ex}");
+                return 0;
+            }
+        }
+
+        // Create one script instance per caller-supplied id, resolving the type once.
+        // resultBitmapPtr receives (count + 7) / 8 bytes; bit i is set when ids[i] succeeded.
+        // Returns the number of successful ids, or -1 if the batch could not run at all.
+        [UnmanagedCallersOnly]
+        public static int CreateInstances(IntPtr typeNamePtr, IntPtr instanceIdsPtr, int count, IntPtr resultBitmapPtr)
+        {
+            try
+            {
+                string typeName = Marshal.PtrToStringUTF8(typeNamePtr)!;
+                int succeeded = _modules.CreateInstances(typeName, instanceIdsPtr, count, resultBitmapPtr, LogCreateError);
+                if (succeeded != count)
                 {
-                    _hostHook?.Log($"Reusing existing instance {instanceId}: {typeName}");
+                    _hostHook?.Log($"CreateInstances: {count - succeeded} of {count} instances of {typeName} failed");
                 }
+                return succeeded;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"CreateInstances failed: {ex}");
+                return -1;
+            }
+        }
+
+        private static void LogCreateError(Exception ex)
+        {
+            SafeLog($"Creating script instance failed: {ex.GetType().FullName}: {ex.Message}");
+        }
+
+        // Keep up to capacity destroyed instances of a type for reuse (0 disables pooling).
+        [UnmanagedCallersOnly]
+        public static int ConfigureInstancePool(IntPtr typeNamePtr, int capacity)
+        {
+            try
+            {
+                string typeName = Marshal.PtrToStringUTF8(typeNamePtr)!;
+                _modules.ConfigureInstancePool(typeName, capacity, LogDestroyError);
+                _hostHook?.Log($"Configured instance pool: {typeName} (capacity={capacity})");
                 return 1;
             }
             catch (Exception ex)
             {
-                _hostHook?.Log($"CreateInstance failed: {ex}");
+                _hostHook?.Log($"ConfigureInstancePool failed: {ex}");
                 return 0;
             }
         }
 
         [UnmanagedCallersOnly]
-        public static void DestroyInstance(UIntPtr instanceIdPtr)
+        public static void DestroyInstance(ulong instanceId)
         {
             try
             {
-                ulong instanceKey = instanceIdPtr.ToUInt64()!;
-                GetContextOrThrow().DestroyInstance(instanceKey);
+                _modules.DestroyInstance(instanceId);
             }
             catch (Exception ex)
             {
@@ -293,6 +548,28 @@ namespace MochiSharp.Managed.Core
             }
         }
 
+        // Destroy a batch of instances in one transition. Disposal runs until budgetMilliseconds
+        // is spent (0 = unbounded); the rest continues on later calls (count may be 0).
+        // Returns the number of instances still waiting for disposal, or -1 on error.
+        [UnmanagedCallersOnly]
+        public static int DestroyInstances(IntPtr instanceIdsPtr, int count, double budgetMilliseconds)
+        {
+            try
+            {
+                return _modules.DestroyInstances(instanceIdsPtr, count, budgetMilliseconds, LogDestroyError);
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"DestroyInstances failed: {ex}");
+                return -1;
+            }
+        }
+
+        private static void LogDestroyError(Exception ex)
+        {
+            SafeLog($"Destroying script instance failed: {ex.GetType().FullName}: {ex.Message}");
+        }
+
         // Bind an instance method and return a method handle.
         [UnmanagedCallersOnly]
         public static int BindInstanceMethod(ulong instanceId, IntPtr methodNamePtr, int signature)
@@ -300,9 +577,8 @@ namespace MochiSharp.Managed.Core
             try
             {
                 string methodName = Marshal.PtrToStringUTF8(methodNamePtr)!;
-                int id = GetContextOrThrow().BindInstanceMethod(instanceId, methodName, signature);
-                _hostHook?.Log($"Bound instance method {id}: instance {instanceId}.{methodName} (sig={signature})");
-                return id;
+                // Called for every spawned instance: only failures are logged.
+                return _modules.GetByInstance(instanceId).BindInstanceMethod(instanceId, methodName, signature);
             }
             catch (Exception ex)
             {
@@ -311,56 +587,87 @@ namespace MochiSharp.Managed.Core
             }
         }
 
+        // Bind several instance methods of one instance at once.
+        // outMethodIdsPtr receives one method handle per name (0 where binding failed).
+        // Returns the number of methods bound, or -1 if the batch could not run at all.
+        [UnmanagedCallersOnly]
+        public static int BindMethods(ulong instanceId, IntPtr methodNamePtrs, IntPtr signaturesPtr, int count, IntPtr outMethodIdsPtr)
+        {
+            try
+            {
+                int bound = _modules.GetByInstance(instanceId).BindMethods(instanceId, methodNamePtrs, signaturesPtr, count, outMethodIdsPtr, SafeLog);
+                if (bound != count)
+                {
+                    _hostHook?.Log($"BindMethods: {count - bound} of {count} methods of instance {instanceId} could not be bound");
+                }
+                return bound;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"BindMethods failed: {ex}");
+                return -1;
+            }
+        }
+
         // Bind a static method and return a method handle.
         [UnmanagedCallersOnly]
         public static int BindStaticMethod(IntPtr typeNamePtr, IntPtr methodNamePtr, int signature)
         {
+            string typeName = string.Empty;
             try
             {
-                string typeName = Marshal.PtrToStringUTF8(typeNamePtr)!;
+                typeName = Marshal.PtrToStringUTF8(typeNamePtr)!;
                 string methodName = Marshal.PtrToStringUTF8(methodNamePtr)!;
-                // Diagnostic: verify whether the requested type is present in any loaded assembly
-                try
+                int id = _modules.GetByTypeName(typeName).BindStaticMethod(typeName, methodName, signature);
+                _hostHook?.Log($"Bound static method {id}: {typeName}.{methodName} (sig={signature})");
+                return id;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"BindStaticMethod failed: {ex}");
+                if (ex is TypeLoadException)
+                {
+                    LogTypeSearchDiagnostic(typeName);
+                }
+                return 0;
+            }
+        }
+
+        // Diagnostic: report whether the requested type is present in any loaded assembly.
+        // Only used after a failed lookup; successful binds go through the ScriptContext type index.
+        private static void LogTypeSearchDiagnostic(string typeName)
+        {
+            try
+            {
+                var assemblies = AppDomain.CurrentDomain.GetAssemblies();
+                _hostHook?.Log($"Searching for type '{typeName}' in {assemblies.Length} loaded assemblies...");
+                bool found = false;
+                foreach (var asm in assemblies)
                 {
-                    var assemblies = AppDomain.CurrentDomain.GetAssemblies();
-                    _hostHook?.Log($"Searching for type '{typeName}' in {assemblies.Length} loaded assemblies...");
-                    bool found = false;
-                    foreach (var asm in assemblies)
+                    try
                     {
-                        try
+                        var t = asm.GetType(typeName, throwOnError: false);
+                        if (t != null)
                         {
-                            var t = asm.GetType(typeName, throwOnError: false);
-                            if (t != null)
-                            {
-                                _hostHook?.Log($"Type '{typeName}' found in assembly: {asm.GetName().Name} (Location='{asm.Location}')");
-                                found = true;
-                                break;
-                            }
-                        }
-                        catch (Exception ex)
-                        {
-                            _hostHook?.Log($"Warning while inspecting assembly {asm.GetName().Name}: {ex.Message}");
+                            _hostHook?.Log($"Type '{typeName}' found in assembly: {asm.GetName().Name} (Location='{asm.Location}')");
+                            found = true;
+                            break;
                         }
                     }
-
-                    if (!found)
+                    catch (Exception ex)
                     {
-                        _hostHook?.Log($"Type '{typeName}' was NOT found in loaded assemblies.");
+                        _hostHook?.Log($"Warning while inspecting assembly {asm.GetName().Name}: {ex.Message}");
                     }
                 }
-                catch (Exception ex)
+
+                if (!found)
                 {
-                    _hostHook?.Log($"Type search diagnostic failed: {ex}");
+                    _hostHook?.Log($"Type '{typeName}' was NOT found in loaded assemblies.");
                 }
-
-                int id = GetContextOrThrow().BindStaticMethod(typeName, methodName, signature);
-                _hostHook?.Log($"Bound static method {id}: {typeName}.{methodName} (sig={signature})");
-                return id;
             }
             catch (Exception ex)
             {
-                _hostHook?.Log($"BindStaticMethod failed: {ex}");
-                return 0;
+                _hostHook?.Log($"Type search diagnostic failed: {ex}");
             }
         }
 
@@ -377,7 +684,7 @@ namespace MochiSharp.Managed.Core
                     paramNames[i] = Marshal.PtrToStringUTF8(p)!;
                 }
 
-                GetContextOrThrow().RegisterSignature(signatureId, returnTypeName, paramNames);
+                _modules.RegisterSignature(signatureId, returnTypeName, paramNames, null, null);
                 _hostHook?.Log($"Registered signature {signatureId}: {returnTypeName}({string.Join(",", paramNames)})");
                 return 1;
             }
@@ -388,6 +695,187 @@ namespace MochiSharp.Managed.Core
             }
         }
 
+        // Same as RegisterSignature, plus the native sizeof/alignof of the return type (index 0) and of
+        // each parameter, as parameterCount + 1 int32 entries (0 = unchecked; nativeAlignments may be null).
+        // Returns 0 if a size or alignment does not match the managed layout.
+        [UnmanagedCallersOnly]
+        public static int RegisterSignatureChecked(int signatureId, IntPtr returnTypeNamePtr, IntPtr parameterTypeNamePtrs, int parameterCount, IntPtr nativeSizesPtr, IntPtr nativeAlignmentsPtr)
+        {
+            try
+            {
+                string returnTypeName = Marshal.PtrToStringUTF8(returnTypeNamePtr)!;
+                var paramNames = parameterCount == 0 ? Array.Empty<string>() : new string[parameterCount];
+                for (int i = 0; i < paramNames.Length; i++)
+                {
+                    IntPtr p = Marshal.ReadIntPtr(parameterTypeNamePtrs, i * IntPtr.Size);
+                    paramNames[i] = Marshal.PtrToStringUTF8(p)!;
+                }
+
+                int[]? nativeSizes = null;
+                if (nativeSizesPtr != IntPtr.Zero)
+                {
+                    nativeSizes = new int[parameterCount + 1];
+                    Marshal.Copy(nativeSizesPtr, nativeSizes, 0, nativeSizes.Length);
+                }
+
+                int[]? nativeAlignments = null;
+                if (nativeAlignmentsPtr != IntPtr.Zero)
+                {
+                    nativeAlignments = new int[parameterCount + 1];
+                    Marshal.Copy(nativeAlignmentsPtr, nativeAlignments, 0, nativeAlignments.Length);
+                }
+
+                _modules.RegisterSignature(signatureId, returnTypeName, paramNames, nativeSizes, nativeAlignments);
+                _hostHook?.Log($"Registered signature {signatureId}: {returnTypeName}({string.Join(",", paramNames)})");
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"RegisterSignatureChecked failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        // Registers the native event ring (see ScriptEvents.h). It outlives script reloads.
+        // Returns 1 on success, 0 on error.
+        [UnmanagedCallersOnly]
+        public static int ConfigureEventRing(IntPtr buffer, int bufferSize)
+        {
+            try
+            {
+                _eventRing = new ScriptEventRing(buffer, bufferSize);
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"ConfigureEventRing failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        // Drains the event ring and calls the [ScriptEvent] handlers. Events are consumed even when no
+        // script assembly is loaded. Returns the number of handler calls, or -1 on error.
+        [UnmanagedCallersOnly]
+        public static int DispatchEvents()
+        {
+            try
+            {
+                return _eventRing?.Drain(_modules, LogEventHandlerError) ?? -1;
+            }
+            catch (Exception ex)
+            {
+                SafeLog($"DispatchEvents failed: {ex.GetType().FullName}: {ex.Message}");
+                return -1;
+            }
+        }
+
+        private static void LogEventHandlerError(Exception ex)
+        {
+            SafeLog($"Event handler failed: {ex.GetType().FullName}: {ex.Message}");
+        }
+
+        // Maps a component struct (assembly-qualified or full name) to the id the native storage uses.
+        // Returns 1, or 0 on error.
+        [UnmanagedCallersOnly]
+        public static int RegisterComponent(int componentId, IntPtr typeName, int size)
+        {
+            try
+            {
+                ComponentStorage.Register(componentId, Marshal.PtrToStringUTF8(typeName) ?? string.Empty, size);
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"RegisterComponent {componentId} failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        // Attaches the native chunk query (ScriptComponentBridge::QueryChunks) used by EntityQuery; a
+        // null function detaches it. Returns 1, or 0 on error.
+        [UnmanagedCallersOnly]
+        public static int ConfigureComponentStorage(IntPtr queryFunction, IntPtr context)
+        {
+            try
+            {
+                ComponentStorage.Attach(queryFunction, context);
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"ConfigureComponentStorage failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        // Shares the host's per-frame arena (ScriptArena.h) with FrameAllocator; native pool stats are
+        // published into its header from then on.
+        [UnmanagedCallersOnly]
+        public static int ConfigureFrameArena(IntPtr buffer, int bufferSize)
+        {
+            try
+            {
+                FrameAllocator.Attach(buffer, bufferSize);
+                NativePool.PublishStats();
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                _hostHook?.Log($"ConfigureFrameArena failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        // Advances the script scheduler by one frame on the calling (game) thread: posted
+        // continuations, NextFrame/Seconds awaits and coroutines. Returns the amount of work
+        // still pending, or -1 on error.
+        [UnmanagedCallersOnly]
+        public static int TickScheduler(double deltaSeconds)
+        {
+            try
+            {
+                return ScriptScheduler.Tick(deltaSeconds);
+            }
+            catch (Exception ex)
+            {
+                SafeLog($"TickScheduler failed: {ex.GetType().FullName}: {ex.Message}");
+                return -1;
+            }
+        }
+
+        private static void LogSchedulerError(Exception ex)
+        {
+            SafeLog($"Scheduled script code failed: {ex.GetType().FullName}: {ex.Message}");
+        }
+
+        // Writes the native byte size of the return value (index 0) and of each parameter of a
+        // registered signature to sizes (up to capacity entries). Returns the number of entries
+        // (parameter count + 1), or -1 if no module knows the signature.
+        [UnmanagedCallersOnly]
+        public static int GetSignatureLayout(int signatureId, IntPtr sizes, int capacity)
+        {
+            try
+            {
+                var layout = _modules.GetSignatureLayout(signatureId);
+                if (layout == null)
+                {
+                    return -1;
+                }
+
+                if (sizes != IntPtr.Zero && capacity > 0)
+                {
+                    Marshal.Copy(layout, 0, sizes, Math.Min(capacity, layout.Length));
+                }
+
+                return layout.Length;
+            }
+            catch (Exception ex)
+            {
+                SafeLog($"GetSignatureLayout failed: {ex.Message}");
+                return -1;
+            }
+        }
+
         // Generic invoke.
         // argsPtr points to an array of IntPtr, each element points to the value for that argument.
         // - int: pointer to int32
@@ -399,26 +887,187 @@ namespace MochiSharp.Managed.Core
         // - int/bool: pointer to int32
         // - float: pointer to float32
         // - struct: pointer to struct bytes
+        // Returns an InvokeStatus: 1 on success, 0 if the script threw, negative for other failures.
+        // Details of the last failure are kept for GetLastInvokeError; only the first fault of a
+        // streak is logged, so a script that throws every frame does not also format and log every frame.
         [UnmanagedCallersOnly]
         public static int Invoke(int methodId, IntPtr argsPtr, int argCount, IntPtr returnPtr)
+        {
+            ScriptContext? module = null;
+            try
+            {
+                module = _modules.FindByMethodId(methodId);
+                Exception? error = null;
+                var status = module != null
+                    ? module.TryInvoke(methodId, argsPtr, argCount, returnPtr, out error)
+                    : InvokeStatus.UnknownMethod;
+
+                if (status != InvokeStatus.Ok)
+                {
+                    RecordInvokeFailure(module, methodId, status, error);
+                }
+
+                return (int)status;
+            }
+            catch (Exception ex)
+            {
+                RecordInvokeFailure(module, methodId, InvokeStatus.InternalError, ex);
+                return (int)InvokeStatus.InternalError;
+            }
+        }
+
+        private static void RecordInvokeFailure(ScriptContext? module, int methodId, InvokeStatus status, Exception? error)
+        {
+            // A skipped call says nothing new; keep the fault that disabled the method.
+            if (status == InvokeStatus.Disabled)
+            {
+                return;
+            }
+
+            _modules.RecordInvokeError(methodId, status, error);
+
+            MethodFaults? faults = null;
+            if (module != null && module.TryGetMethodFaults(methodId, out var methodFaults))
+            {
+                faults = methodFaults;
+            }
+
+            if (faults == null || faults.ConsecutiveFaults <= 1)
+            {
+                SafeLog($"Invoke {methodId} failed ({status}): {FormatInvokeError(status, error)}");
+            }
+
+            // Disabled calls return before faulting, so a disabled method that just faulted was tripped by this call.
+            if (faults != null && faults.Disabled)
+            {
+                SafeLog($"Method {methodId} disabled after {faults.ConsecutiveFaults} consecutive faults ({faults.TotalFaults} total); EnableMethod re-enables it");
+            }
+        }
+
+        private static string FormatInvokeError(InvokeStatus status, Exception? error)
+        {
+            return error != null ? $"{error.GetType().FullName}: {error.Message}" : status.ToString();
+        }
+
+        // Circuit breaker for all modules: a method is disabled after this many consecutive faults
+        // and then returns InvokeStatus.Disabled without running. 0 (the default) never disables.
+        [UnmanagedCallersOnly]
+        public static int ConfigureFaultPolicy(int maxConsecutiveFaults)
+        {
+            try
+            {
+                _modules.ConfigureFaultPolicy(maxConsecutiveFaults);
+                return 1;
+            }
+            catch (Exception ex)
+            {
+                SafeLog($"ConfigureFaultPolicy failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        // Re-enables a method disabled by the circuit breaker and clears its consecutive faults.
+        [UnmanagedCallersOnly]
+        public static int EnableMethod(int methodId)
+        {
+            try
+            {
+                var module = _modules.FindByMethodId(methodId);
+                return module != null && module.EnableMethod(methodId) ? 1 : 0;
+            }
+            catch (Exception ex)
+            {
+                SafeLog($"EnableMethod failed: {ex.Message}");
+                return 0;
+            }
+        }
+
+        [UnmanagedCallersOnly]
+        public static int DisableMethod(int methodId)
         {
             try
             {
-                GetContextOrThrow().Invoke(methodId, argsPtr, argCount, returnPtr);
+                var module = _modules.FindByMethodId(methodId);
+                if (module == null || !module.DisableMethod(methodId))
+                {
+                    return 0;
+                }
+
+                SafeLog($"Method {methodId} disabled by the host");
                 return 1;
             }
-            catch (TargetInvocationException ex) when (ex.InnerException != null)
+            catch (Exception ex)
             {
-                SafeLog($"Invoke failed: {ex.InnerException.GetType().FullName}: {ex.InnerException.Message}");
+                SafeLog($"DisableMethod failed: {ex.Message}");
                 return 0;
             }
+        }
+
+        // Shares the native watchdog's call slot (ScriptWatchdog.h) for ScriptWatchdog.IsAbortRequested.
+        [UnmanagedCallersOnly]
+        public static int ConfigureWatchdog(IntPtr sharedState)
+        {
+            ScriptWatchdog.Attach(sharedState);
+            return 1;
+        }
+
+        // Writes the method's fault counters (InvokeFaultInfo) to infoPtr. Returns 0 for unknown ids.
+        [UnmanagedCallersOnly]
+        public static int GetMethodFaults(int methodId, IntPtr infoPtr)
+        {
+            try
+            {
+                var module = _modules.FindByMethodId(methodId);
+                if (infoPtr == IntPtr.Zero || module == null || !module.TryGetMethodFaults(methodId, out var faults))
+                {
+                    return 0;
+                }
+
+                var status = faults.Disabled ? InvokeStatus.Disabled : InvokeStatus.Ok;
+                Marshal.StructureToPtr(faults.ToInfo(methodId, status), infoPtr, false);
+                return 1;
+            }
             catch (Exception ex)
             {
-                SafeLog($"Invoke failed: {ex.GetType().FullName}: {ex.Message}");
+                SafeLog($"GetMethodFaults failed: {ex.Message}");
                 return 0;
             }
         }
 
+        // The most recent failed Invoke: fills infoPtr (InvokeFaultInfo, optional) and returns the
+        // error message as a UTF-8 CoTaskMem string, or IntPtr.Zero if no call has failed yet.
+        // The message is only formatted here, never on the failing call itself.
+        [UnmanagedCallersOnly]
+        public static IntPtr GetLastInvokeError(IntPtr infoPtr)
+        {
+            try
+            {
+                if (!_modules.TryGetLastInvokeError(out int methodId, out var status, out string message))
+                {
+                    return IntPtr.Zero;
+                }
+
+                if (infoPtr != IntPtr.Zero)
+                {
+                    var info = new InvokeFaultInfo { MethodId = methodId, Status = (int)status };
+                    var module = _modules.FindByMethodId(methodId);
+                    if (module != null && module.TryGetMethodFaults(methodId, out var faults))
+                    {
+                        info = faults.ToInfo(methodId, status);
+                    }
+
+                    Marshal.StructureToPtr(info, infoPtr, false);
+                }
+
+                return Marshal.StringToCoTaskMemUTF8(message);
+            }
+            catch (Exception ex)
+            {
+                SafeLog($"GetLastInvokeError failed: {ex.Message}");
+                return IntPtr.Zero;
+            }
+        }
+
 
         // Back-compat: previous API used by older native hosts.
         [UnmanagedCallersOnly]
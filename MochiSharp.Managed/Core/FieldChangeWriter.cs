@@ -0,0 +1,54 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Core
+{
+	// Fills the host's buffer with field change records (MochiSharp::ScriptFieldChange): a 16-byte header
+	// (uint64 instance id, int32 field handle, int32 value size) followed by the value in the format of
+	// GetInstanceFieldValue, strings as UTF-8 without a terminator. Records start on 8-byte boundaries.
+	internal struct FieldChangeWriter
+	{
+		public const int HeaderSize = 16;
+
+		private readonly IntPtr _buffer;
+		private readonly int _capacity;
+
+		public int Offset { get; private set; }
+		public int Count { get; private set; }
+
+		public FieldChangeWriter(IntPtr buffer, int capacity)
+		{
+			if (buffer == IntPtr.Zero || capacity < HeaderSize)
+			{
+				throw new ArgumentException("A buffer of at least 16 bytes is required", nameof(buffer));
+			}
+
+			_buffer = buffer;
+			_capacity = capacity;
+		}
+
+		// Writes the header and returns where the value goes, or IntPtr.Zero when the record does not fit
+		// (the change then stays pending for the next collection).
+		public IntPtr Begin(ulong instanceId, int fieldHandle, int size)
+		{
+			int recordSize = (HeaderSize + size + 7) & ~7;
+			if (recordSize > _capacity - Offset)
+			{
+				if (Count == 0)
+				{
+					throw new ArgumentException($"A {_capacity}-byte buffer cannot hold the {recordSize}-byte change of field {fieldHandle} of instance {instanceId}");
+				}
+
+				return IntPtr.Zero;
+			}
+
+			IntPtr record = _buffer + Offset;
+			Marshal.WriteInt64(record, 0, unchecked((long)instanceId));
+			Marshal.WriteInt32(record, 8, fieldHandle);
+			Marshal.WriteInt32(record, 12, size);
+			Offset += recordSize;
+			Count++;
+			return record + HeaderSize;
+		}
+	}
+}
@@ -0,0 +1,246 @@
+using System;
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Core
+{
+	// Scratch memory that lives until the end of the current frame (MochiSharp.Native/Source/ScriptArena.h):
+	//
+	//   Span<int> ids = FrameAllocator.Allocate<int>(count);
+	//   var targets = FrameAllocator.CreateList<Target>(32);
+	//
+	// Allocation bumps an offset in memory shared with the host, which releases everything at once
+	// in DotNetHost::EndFrame; nothing is tracked by the GC. When the arena is full (or the host never
+	// called InitFrameArena) requests fall back to ordinary arrays and are counted as overflow in the
+	// host's stats. Data must not be kept past the frame. Game thread only.
+	//
+	// Header (64 bytes): uint64 Capacity, Offset, Frame, OverflowBytes, PoolBytesInUse, PoolBytesPeak.
+	public static class FrameAllocator
+	{
+		public const int Alignment = 16;
+
+		private const int HeaderSize = 64;
+		private const int CapacityOffset = 0;
+		private const int OffsetOffset = 8;
+		private const int FrameOffset = 16;
+		private const int OverflowOffset = 24;
+		internal const int PoolBytesInUseOffset = 32;
+		internal const int PoolBytesPeakOffset = 40;
+
+		private static IntPtr _header;
+		private static IntPtr _data;
+		private static long _capacity;
+
+		public static bool IsAvailable => _header != IntPtr.Zero;
+		public static long Capacity => _capacity;
+		public static long BytesUsed => _header != IntPtr.Zero ? Marshal.ReadInt64(_header, OffsetOffset) : 0;
+		// Advanced by the host every time it ends a frame.
+		public static long Frame => _header != IntPtr.Zero ? Marshal.ReadInt64(_header, FrameOffset) : 0;
+
+		internal static IntPtr Header => _header;
+
+		// count zeroed elements, valid until the end of the frame.
+		public static Span<T> Allocate<T>(int count) where T : unmanaged
+		{
+			var span = AllocateUninitialized<T>(count);
+			span.Clear();
+			return span;
+		}
+
+		public static Span<T> AllocateUninitialized<T>(int count) where T : unmanaged
+		{
+			if (count < 0)
+			{
+				throw new ArgumentOutOfRangeException(nameof(count));
+			}
+
+			if (count == 0)
+			{
+				return Span<T>.Empty;
+			}
+
+			IntPtr memory = TryAllocate((long)count * Unsafe.SizeOf<T>());
+			return memory != IntPtr.Zero ? NativeSpan.Create<T>(memory, count) : GC.AllocateUninitializedArray<T>(count);
+		}
+
+		public static NativeList<T> CreateList<T>(int capacity) where T : unmanaged
+		{
+			return new NativeList<T>(capacity);
+		}
+
+		// Zero when the arena is missing or full; the overflow is recorded for the host.
+		internal static IntPtr TryAllocate(long bytes)
+		{
+			IntPtr header = _header;
+			if (header == IntPtr.Zero)
+			{
+				return IntPtr.Zero;
+			}
+
+			long data = (long)_data;
+			long start = (data + Marshal.ReadInt64(header, OffsetOffset) + (Alignment - 1)) & ~(long)(Alignment - 1);
+			long end = start - data + bytes;
+			if (end > _capacity)
+			{
+				Marshal.WriteInt64(header, OverflowOffset, Marshal.ReadInt64(header, OverflowOffset) + bytes);
+				return IntPtr.Zero;
+			}
+
+			Marshal.WriteInt64(header, OffsetOffset, end);
+			return (IntPtr)start;
+		}
+
+		internal static void Attach(IntPtr buffer, int bufferSize)
+		{
+			if (buffer == IntPtr.Zero || bufferSize < HeaderSize)
+			{
+				throw new ArgumentException("Frame arena buffer is too small", nameof(bufferSize));
+			}
+
+			long capacity = Marshal.ReadInt64(buffer, CapacityOffset);
+			if (capacity <= 0 || HeaderSize + capacity > bufferSize)
+			{
+				throw new ArgumentException("Frame arena header does not describe the buffer", nameof(buffer));
+			}
+
+			_header = buffer;
+			_data = buffer + HeaderSize;
+			_capacity = capacity;
+		}
+	}
+
+	// Growable list in frame memory. Growing copies into a larger block of the arena (the old one is
+	// reclaimed with the frame), so Add is amortized O(1) with no GC allocation. This is a struct:
+	// keep it in one variable or field and pass it by ref; copies share elements but not Count.
+	// Debug builds throw when a list is used after the frame that allocated it.
+	public struct NativeList<T> where T : unmanaged
+	{
+		private IntPtr _items;
+		private T[]? _managedItems; // the arena ran out: the list moved to the GC heap
+		private int _count;
+		private int _capacity;
+		private long _frame;
+
+		public NativeList(int capacity)
+		{
+			if (capacity < 0)
+			{
+				throw new ArgumentOutOfRangeException(nameof(capacity));
+			}
+
+			_items = IntPtr.Zero;
+			_managedItems = null;
+			_count = 0;
+			_capacity = 0;
+			_frame = FrameAllocator.Frame;
+			if (capacity > 0)
+			{
+				Grow(capacity);
+			}
+		}
+
+		public readonly int Count => _count;
+		public readonly int Capacity => _capacity;
+
+		public readonly ref T this[int index]
+		{
+			get
+			{
+				CheckFrame();
+				if ((uint)index >= (uint)_count)
+				{
+					throw new ArgumentOutOfRangeException(nameof(index));
+				}
+
+				return ref Storage[index];
+			}
+		}
+
+		public void Add(T item)
+		{
+			CheckFrame();
+			if (_count == _capacity)
+			{
+				Grow(_count + 1);
+			}
+
+			Storage[_count++] = item;
+		}
+
+		public void AddRange(ReadOnlySpan<T> items)
+		{
+			CheckFrame();
+			if (_count + items.Length > _capacity)
+			{
+				Grow(_count + items.Length);
+			}
+
+			items.CopyTo(Storage.Slice(_count));
+			_count += items.Length;
+		}
+
+		// O(1): the last element takes the removed one's place.
+		public void RemoveAtSwapBack(int index)
+		{
+			CheckFrame();
+			if ((uint)index >= (uint)_count)
+			{
+				throw new ArgumentOutOfRangeException(nameof(index));
+			}
+
+			var storage = Storage;
+			storage[index] = storage[--_count];
+		}
+
+		public void Clear()
+		{
+			_count = 0;
+		}
+
+		public readonly Span<T> AsSpan()
+		{
+			CheckFrame();
+			return Storage.Slice(0, _count);
+		}
+
+		public readonly Span<T>.Enumerator GetEnumerator() => AsSpan().GetEnumerator();
+
+		private readonly Span<T> Storage => _managedItems ?? NativeSpan.Create<T>(_items, _capacity);
+
+		private void Grow(int minimumCapacity)
+		{
+			int capacity = Math.Max(Math.Max(minimumCapacity, _capacity * 2), 4);
+			var existing = Storage.Slice(0, _count);
+			IntPtr memory = FrameAllocator.TryAllocate((long)capacity * Unsafe.SizeOf<T>());
+			if (memory != IntPtr.Zero)
+			{
+				existing.CopyTo(NativeSpan.Create<T>(memory, capacity));
+				_items = memory;
+				_managedItems = null;
+			}
+			else
+			{
+				var array = new T[capacity];
+				existing.CopyTo(array);
+				_items = IntPtr.Zero;
+				_managedItems = array;
+			}
+
+			if (_capacity == 0)
+			{
+				_frame = FrameAllocator.Frame;
+			}
+			_capacity = capacity;
+		}
+
+		[Conditional("DEBUG")]
+		private readonly void CheckFrame()
+		{
+			if (_items != IntPtr.Zero && _frame != FrameAllocator.Frame)
+			{
+				throw new InvalidOperationException($"NativeList<{typeof(T).Name}> used after the frame it was allocated in ended");
+			}
+		}
+	}
+}
@@ -0,0 +1,439 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Reflection.Metadata;
+using System.Reflection.PortableExecutable;
+
+namespace MochiSharp.Managed.Core
+{
+	// Finds types deriving from (or implementing) a base type by reading ECMA-335 metadata straight
+	// from the PE file. Nothing is loaded into any AssemblyLoadContext, so scanning an assembly costs
+	// neither JIT work nor memory that can never be reclaimed.
+	//
+	// Each scanned file keeps a small table of its type definitions (names, base type, interfaces).
+	// Tables are reused while the file's timestamp and size stay the same. When they change but the
+	// module MVID is unchanged, the cached query results are kept as well.
+	public static class MetadataTypeScanner
+	{
+		private readonly record struct TypeLink(string? AssemblyName, string FullName);
+
+		private sealed class TypeRecord
+		{
+			public required string FullName;
+			public required bool IsConcreteClass;
+			public required TypeLink? BaseType;
+			public required TypeLink[] Interfaces;
+		}
+
+		private sealed class AssemblyTypeTable
+		{
+			public required string Path;
+			public required string Name;
+			public required DateTime LastWriteUtc;
+			public required long Length;
+			public required Guid Mvid;
+			public required List<TypeRecord> Types;
+			public required Dictionary<string, TypeRecord> TypesByName;
+			public Dictionary<string, string[]> DerivedByBaseType = new(StringComparer.Ordinal);
+		}
+
+		private const int MaxInheritanceDepth = 64;
+
+		private static readonly object _lock = new();
+		private static readonly Dictionary<string, AssemblyTypeTable> _tables = new(StringComparer.OrdinalIgnoreCase);
+		private static readonly Dictionary<string, string> _pathsByAssemblyName = new(StringComparer.OrdinalIgnoreCase);
+
+		public static string[] GetDerivedTypes(string assemblyPath, string baseTypeFullName)
+		{
+			if (string.IsNullOrWhiteSpace(assemblyPath) || string.IsNullOrWhiteSpace(baseTypeFullName))
+			{
+				return Array.Empty<string>();
+			}
+
+			string fullPath = System.IO.Path.GetFullPath(assemblyPath);
+			string baseName = StripAssemblyName(baseTypeFullName.Trim());
+
+			lock (_lock)
+			{
+				var table = GetTable(fullPath) ?? throw new FileNotFoundException("Assembly not found", fullPath);
+				if (table.DerivedByBaseType.TryGetValue(baseName, out var cached))
+				{
+					return cached;
+				}
+
+				var searchDirectories = GetSearchDirectories(fullPath);
+				var derived = new List<string>();
+				var memo = new Dictionary<TypeLink, bool>();
+				foreach (var type in table.Types)
+				{
+					if (type.IsConcreteClass && IsAssignableTo(new TypeLink(table.Name, type.FullName), baseName, searchDirectories, memo, 0))
+					{
+						derived.Add(type.FullName);
+					}
+				}
+
+				var result = derived.ToArray();
+				table.DerivedByBaseType[baseName] = result;
+				return result;
+			}
+		}
+
+		// Returns, for every type defined in the assembly, the full names of its base types and
+		// implemented interfaces (transitively, as far as the referenced assemblies can be found).
+		public static Dictionary<string, string[]> GetAncestors(string assemblyPath)
+		{
+			string fullPath = System.IO.Path.GetFullPath(assemblyPath);
+			lock (_lock)
+			{
+				var table = GetTable(fullPath) ?? throw new FileNotFoundException("Assembly not found", fullPath);
+				var searchDirectories = GetSearchDirectories(fullPath);
+
+				var result = new Dictionary<string, string[]>(table.Types.Count, StringComparer.Ordinal);
+				var ancestors = new List<string>();
+				var visited = new HashSet<TypeLink>();
+				foreach (var type in table.Types)
+				{
+					ancestors.Clear();
+					visited.Clear();
+					CollectAncestors(type, searchDirectories, ancestors, visited, 0);
+					result[type.FullName] = ancestors.ToArray();
+				}
+
+				return result;
+			}
+		}
+
+		// Layout: int32 total size in bytes, int32 count, then count entries of
+		// (int32 byte length, UTF-8 bytes without terminator).
+		public static byte[] EncodeNameList(string[] names)
+		{
+			int size = sizeof(int) * 2;
+			foreach (var name in names)
+			{
+				size += sizeof(int) + System.Text.Encoding.UTF8.GetByteCount(name);
+			}
+
+			var buffer = new byte[size];
+			var span = buffer.AsSpan();
+			BitConverter.TryWriteBytes(span, size);
+			BitConverter.TryWriteBytes(span[sizeof(int)..], names.Length);
+
+			int offset = sizeof(int) * 2;
+			foreach (var name in names)
+			{
+				int length = System.Text.Encoding.UTF8.GetBytes(name, span[(offset + sizeof(int))..]);
+				BitConverter.TryWriteBytes(span[offset..], length);
+				offset += sizeof(int) + length;
+			}
+
+			return buffer;
+		}
+
+		private static List<string> GetSearchDirectories(string assemblyPath)
+		{
+			var searchDirectories = new List<string>(3);
+			AddSearchDirectory(searchDirectories, System.IO.Path.GetDirectoryName(assemblyPath));
+			AddSearchDirectory(searchDirectories, System.IO.Path.GetDirectoryName(typeof(MetadataTypeScanner).Assembly.Location));
+			AddSearchDirectory(searchDirectories, AppContext.BaseDirectory);
+			return searchDirectories;
+		}
+
+		private static void CollectAncestors(TypeRecord record, List<string> searchDirectories, List<string> ancestors, HashSet<TypeLink> visited, int depth)
+		{
+			if (depth > MaxInheritanceDepth)
+			{
+				return;
+			}
+
+			if (record.BaseType is TypeLink baseType)
+			{
+				VisitAncestor(baseType, searchDirectories, ancestors, visited, depth);
+			}
+
+			foreach (var implemented in record.Interfaces)
+			{
+				VisitAncestor(implemented, searchDirectories, ancestors, visited, depth);
+			}
+		}
+
+		private static void VisitAncestor(TypeLink link, List<string> searchDirectories, List<string> ancestors, HashSet<TypeLink> visited, int depth)
+		{
+			if (!visited.Add(link))
+			{
+				return;
+			}
+
+			ancestors.Add(link.FullName);
+			if (link.AssemblyName != null && FindType(link, searchDirectories) is TypeRecord record)
+			{
+				CollectAncestors(record, searchDirectories, ancestors, visited, depth + 1);
+			}
+		}
+
+		private static void AddSearchDirectory(List<string> directories, string? directory)
+		{
+			if (!string.IsNullOrEmpty(directory) && !directories.Contains(directory, StringComparer.OrdinalIgnoreCase))
+			{
+				directories.Add(directory);
+			}
+		}
+
+		private static string StripAssemblyName(string typeName)
+		{
+			int comma = typeName.IndexOf(',');
+			return comma >= 0 ? typeName[..comma].Trim() : typeName;
+		}
+
+		private static bool IsAssignableTo(TypeLink type, string baseName, List<string> searchDirectories, Dictionary<TypeLink, bool> memo, int depth)
+		{
+			if (string.Equals(type.FullName, baseName, StringComparison.Ordinal))
+			{
+				return true;
+			}
+
+			if (depth > MaxInheritanceDepth || type.AssemblyName == null)
+			{
+				return false;
+			}
+
+			if (memo.TryGetValue(type, out bool known))
+			{
+				return known;
+			}
+
+			// Guard against cycles in malformed metadata while this entry is being computed.
+			memo[type] = false;
+
+			bool result = false;
+			var record = FindType(type, searchDirectories);
+			if (record != null)
+			{
+				if (record.BaseType is TypeLink baseType)
+				{
+					result = IsAssignableTo(baseType, baseName, searchDirectories, memo, depth + 1);
+				}
+
+				for (int i = 0; !result && i < record.Interfaces.Length; i++)
+				{
+					result = IsAssignableTo(record.Interfaces[i], baseName, searchDirectories, memo, depth + 1);
+				}
+			}
+
+			memo[type] = result;
+			return result;
+		}
+
+		private static TypeRecord? FindType(TypeLink type, List<string> searchDirectories)
+		{
+			// Assemblies scanned before are found by name even when the file name differs.
+			if (_pathsByAssemblyName.TryGetValue(type.AssemblyName!, out var knownPath))
+			{
+				var known = GetTable(knownPath);
+				if (known != null && string.Equals(known.Name, type.AssemblyName, StringComparison.OrdinalIgnoreCase))
+				{
+					return known.TypesByName.GetValueOrDefault(type.FullName);
+				}
+			}
+
+			foreach (var directory in searchDirectories)
+			{
+				string candidate = System.IO.Path.Combine(directory, $"{type.AssemblyName}.dll");
+				var table = GetTable(candidate);
+				if (table != null && table.TypesByName.TryGetValue(type.FullName, out var record))
+				{
+					return record;
+				}
+			}
+
+			return null;
+		}
+
+		private static AssemblyTypeTable? GetTable(string path)
+		{
+			var info = new FileInfo(path);
+			if (!info.Exists)
+			{
+				return null;
+			}
+
+			_tables.TryGetValue(path, out var cached);
+			if (cached != null && cached.LastWriteUtc == info.LastWriteTimeUtc && cached.Length == info.Length)
+			{
+				return cached;
+			}
+
+			AssemblyTypeTable? table;
+			try
+			{
+				table = ReadTable(path, info);
+			}
+			catch (BadImageFormatException)
+			{
+				table = null;
+			}
+
+			if (table == null)
+			{
+				_tables.Remove(path);
+				return null;
+			}
+
+			if (cached != null && cached.Mvid == table.Mvid)
+			{
+				table.DerivedByBaseType = cached.DerivedByBaseType;
+			}
+
+			_tables[path] = table;
+			_pathsByAssemblyName[table.Name] = path;
+			return table;
+		}
+
+		private static AssemblyTypeTable? ReadTable(string path, FileInfo info)
+		{
+			// PEReader memory-maps file streams above a small size threshold; sharing read/write/delete
+			// keeps the compiler free to overwrite the file while we read it.
+			using var stream = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete);
+			using var peReader = new PEReader(stream);
+			if (!peReader.HasMetadata)
+			{
+				return null;
+			}
+
+			var reader = peReader.GetMetadataReader();
+			if (!reader.IsAssembly)
+			{
+				return null;
+			}
+
+			var types = new List<TypeRecord>(reader.TypeDefinitions.Count);
+			var typesByName = new Dictionary<string, TypeRecord>(reader.TypeDefinitions.Count, StringComparer.Ordinal);
+			foreach (var handle in reader.TypeDefinitions)
+			{
+				var definition = reader.GetTypeDefinition(handle);
+				var attributes = definition.Attributes;
+				bool isInterface = (attributes & TypeAttributes.Interface) != 0;
+
+				var interfaceHandles = definition.GetInterfaceImplementations();
+				var interfaces = new List<TypeLink>(interfaceHandles.Count);
+				foreach (var implementationHandle in interfaceHandles)
+				{
+					if (TryGetTypeLink(reader, reader.GetInterfaceImplementation(implementationHandle).Interface, out var link))
+					{
+						interfaces.Add(link);
+					}
+				}
+
+				TypeLink? baseType = null;
+				if (!definition.BaseType.IsNil && TryGetTypeLink(reader, definition.BaseType, out var baseLink))
+				{
+					baseType = baseLink;
+				}
+
+				var record = new TypeRecord
+				{
+					FullName = GetFullName(reader, handle),
+					IsConcreteClass = !isInterface && (attributes & TypeAttributes.Abstract) == 0 && IsClassBaseType(baseType),
+					BaseType = baseType,
+					Interfaces = interfaces.ToArray()
+				};
+
+				types.Add(record);
+				typesByName.TryAdd(record.FullName, record);
+			}
+
+			return new AssemblyTypeTable
+			{
+				Path = path,
+				Name = reader.GetString(reader.GetAssemblyDefinition().Name),
+				LastWriteUtc = info.LastWriteTimeUtc,
+				Length = info.Length,
+				Mvid = reader.GetGuid(reader.GetModuleDefinition().Mvid),
+				Types = types,
+				TypesByName = typesByName
+			};
+		}
+
+		// Value types and enums derive from System.ValueType/System.Enum; interfaces and <Module> have no base.
+		private static bool IsClassBaseType(TypeLink? baseType)
+		{
+			return baseType is TypeLink link
+				&& !string.Equals(link.FullName, "System.ValueType", StringComparison.Ordinal)
+				&& !string.Equals(link.FullName, "System.Enum", StringComparison.Ordinal);
+		}
+
+		private static bool TryGetTypeLink(MetadataReader reader, EntityHandle handle, out TypeLink link)
+		{
+			link = default;
+			switch (handle.Kind)
+			{
+				case HandleKind.TypeDefinition:
+					link = new TypeLink(reader.GetString(reader.GetAssemblyDefinition().Name), GetFullName(reader, (TypeDefinitionHandle)handle));
+					return true;
+
+				case HandleKind.TypeReference:
+					var reference = (TypeReferenceHandle)handle;
+					link = new TypeLink(GetResolutionAssemblyName(reader, reference), GetFullName(reader, reference));
+					return true;
+
+				case HandleKind.TypeSpecification:
+					// Generic instantiations (Base<T>) link to their generic type definition (Base`1).
+					var blob = reader.GetBlobReader(reader.GetTypeSpecification((TypeSpecificationHandle)handle).Signature);
+					if (blob.ReadSignatureTypeCode() != SignatureTypeCode.GenericTypeInstance)
+					{
+						return false;
+					}
+
+					blob.ReadSignatureTypeCode();
+					return TryGetTypeLink(reader, blob.ReadTypeHandle(), out link);
+
+				default:
+					return false;
+			}
+		}
+
+		private static string? GetResolutionAssemblyName(MetadataReader reader, TypeReferenceHandle handle)
+		{
+			var scope = reader.GetTypeReference(handle).ResolutionScope;
+			switch (scope.Kind)
+			{
+				case HandleKind.AssemblyReference:
+					return reader.GetString(reader.GetAssemblyReference((AssemblyReferenceHandle)scope).Name);
+				case HandleKind.TypeReference:
+					return GetResolutionAssemblyName(reader, (TypeReferenceHandle)scope);
+				case HandleKind.ModuleDefinition:
+					return reader.GetString(reader.GetAssemblyDefinition().Name);
+				default:
+					return null;
+			}
+		}
+
+		private static string GetFullName(MetadataReader reader, TypeDefinitionHandle handle)
+		{
+			var definition = reader.GetTypeDefinition(handle);
+			string name = reader.GetString(definition.Name);
+			var declaringType = definition.GetDeclaringType();
+			if (!declaringType.IsNil)
+			{
+				return $"{GetFullName(reader, declaringType)}+{name}";
+			}
+
+			string ns = reader.GetString(definition.Namespace);
+			return ns.Length == 0 ? name : $"{ns}.{name}";
+		}
+
+		private static string GetFullName(MetadataReader reader, TypeReferenceHandle handle)
+		{
+			var reference = reader.GetTypeReference(handle);
+			string name = reader.GetString(reference.Name);
+			if (reference.ResolutionScope.Kind == HandleKind.TypeReference)
+			{
+				return $"{GetFullName(reader, (TypeReferenceHandle)reference.ResolutionScope)}+{name}";
+			}
+
+			string ns = reader.GetString(reference.Namespace);
+			return ns.Length == 0 ? name : $"{ns}.{name}";
+		}
+	}
+}
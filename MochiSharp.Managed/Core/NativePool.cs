@@ -0,0 +1,226 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace MochiSharp.Managed.Core
+{
+	// Persistent unmanaged buffers for data that outlives a frame (caches, navigation graphs):
+	//
+	//   var nodes = NativePool.Rent<PathNode>(1024);
+	//   Span<PathNode> span = nodes.AsSpan();
+	//   ...
+	//   NativePool.Return(ref nodes);
+	//
+	// Blocks come in power-of-two size classes from 64 bytes to 1 MiB and are recycled through one
+	// free list per class, so renting in steady state neither allocates nor involves the GC; larger
+	// buffers go straight to the native heap. Live blocks are tracked by address, so returning a
+	// buffer twice always throws without touching the (possibly freed) block. Debug builds also fill
+	// returned blocks with 0xDD and check every AsSpan against the block's owner. Bytes in use and the
+	// peak are published to the host's arena stats (ScriptArenaStats).
+	public static class NativePool
+	{
+		private const int PrefixSize = 16; // int32 unused, int32 size class, int64 block bytes
+		private const int MinClassShift = 6;
+		private const int MaxClassShift = 20;
+		private const int LargeClass = -1;
+
+		private static readonly object _lock = new();
+		private static readonly Stack<IntPtr>[] _freeLists = CreateFreeLists();
+		private static readonly Dictionary<IntPtr, int> _liveBlocks = new(); // block -> generation of its renter
+		private static int _nextGeneration;
+		private static long _bytesInUse;
+		private static long _peakBytes;
+
+		public static long BytesInUse => Interlocked.Read(ref _bytesInUse);
+		public static long PeakBytes => Interlocked.Read(ref _peakBytes);
+
+		public static NativeBuffer<T> Rent<T>(int length) where T : unmanaged
+		{
+			var buffer = RentUninitialized<T>(length);
+			buffer.AsSpan().Clear();
+			return buffer;
+		}
+
+		public static NativeBuffer<T> RentUninitialized<T>(int length) where T : unmanaged
+		{
+			if (length < 0)
+			{
+				throw new ArgumentOutOfRangeException(nameof(length));
+			}
+
+			long bytes = (long)length * Unsafe.SizeOf<T>();
+			int sizeClass = GetSizeClass(bytes);
+			long blockBytes = sizeClass == LargeClass ? bytes : 1L << (sizeClass + MinClassShift);
+			int generation = NextGeneration();
+
+			IntPtr block;
+			lock (_lock)
+			{
+				block = sizeClass != LargeClass && _freeLists[sizeClass].Count > 0
+					? _freeLists[sizeClass].Pop()
+					: Marshal.AllocHGlobal((IntPtr)(PrefixSize + blockBytes));
+				_liveBlocks.Add(block, generation);
+
+				_bytesInUse += blockBytes;
+				_peakBytes = Math.Max(_peakBytes, _bytesInUse);
+				WriteStats();
+			}
+
+			Marshal.WriteInt32(block, 4, sizeClass);
+			Marshal.WriteInt64(block, 8, blockBytes);
+			return new NativeBuffer<T>(block + PrefixSize, length, generation);
+		}
+
+		public static void Return<T>(ref NativeBuffer<T> buffer) where T : unmanaged
+		{
+			if (buffer.Address == IntPtr.Zero)
+			{
+				return;
+			}
+
+			IntPtr block = buffer.Address - PrefixSize;
+			lock (_lock)
+			{
+				// The block is only read once it is known to be live: a returned large block is already freed.
+				if (!_liveBlocks.TryGetValue(block, out int generation) || generation != buffer.Generation)
+				{
+					throw new InvalidOperationException($"NativeBuffer<{typeof(T).Name}> was already returned to the pool");
+				}
+
+				_liveBlocks.Remove(block);
+				int sizeClass = Marshal.ReadInt32(block, 4);
+				long blockBytes = Marshal.ReadInt64(block, 8);
+				Poison(buffer.Address, blockBytes);
+				if (sizeClass == LargeClass)
+				{
+					Marshal.FreeHGlobal(block);
+				}
+				else
+				{
+					_freeLists[sizeClass].Push(block);
+				}
+
+				_bytesInUse -= blockBytes;
+				WriteStats();
+			}
+
+			buffer = default;
+		}
+
+		// Frees the blocks cached in the free lists.
+		public static void Trim()
+		{
+			lock (_lock)
+			{
+				foreach (var freeList in _freeLists)
+				{
+					while (freeList.Count > 0)
+					{
+						Marshal.FreeHGlobal(freeList.Pop());
+					}
+				}
+			}
+		}
+
+		internal static bool IsOwner(IntPtr address, int generation)
+		{
+			lock (_lock)
+			{
+				return address != IntPtr.Zero && _liveBlocks.TryGetValue(address - PrefixSize, out int owner) && owner == generation;
+			}
+		}
+
+		// When the host attaches a new arena.
+		internal static void PublishStats()
+		{
+			lock (_lock)
+			{
+				WriteStats();
+			}
+		}
+
+		private static void WriteStats()
+		{
+			IntPtr header = FrameAllocator.Header;
+			if (header != IntPtr.Zero)
+			{
+				Marshal.WriteInt64(header, FrameAllocator.PoolBytesInUseOffset, _bytesInUse);
+				Marshal.WriteInt64(header, FrameAllocator.PoolBytesPeakOffset, _peakBytes);
+			}
+		}
+
+		private static int GetSizeClass(long bytes)
+		{
+			if (bytes > 1L << MaxClassShift)
+			{
+				return LargeClass;
+			}
+
+			int shift = Math.Max(MinClassShift, 64 - System.Numerics.BitOperations.LeadingZeroCount((ulong)Math.Max(bytes - 1, 1)));
+			return shift - MinClassShift;
+		}
+
+		private static int NextGeneration()
+		{
+			int generation;
+			do
+			{
+				generation = Interlocked.Increment(ref _nextGeneration);
+			}
+			while (generation == 0);
+			return generation;
+		}
+
+		[Conditional("DEBUG")]
+		private static void Poison(IntPtr address, long bytes)
+		{
+			NativeSpan.Create<byte>(address, (int)bytes).Fill(0xDD);
+		}
+
+		private static Stack<IntPtr>[] CreateFreeLists()
+		{
+			var freeLists = new Stack<IntPtr>[MaxClassShift - MinClassShift + 1];
+			for (int i = 0; i < freeLists.Length; i++)
+			{
+				freeLists[i] = new Stack<IntPtr>();
+			}
+			return freeLists;
+		}
+	}
+
+	// A buffer rented from NativePool; give it back with NativePool.Return. Copies refer to the same
+	// memory, so only one of them may be returned.
+	public readonly struct NativeBuffer<T> where T : unmanaged
+	{
+		internal NativeBuffer(IntPtr address, int length, int generation)
+		{
+			Address = address;
+			Length = length;
+			Generation = generation;
+		}
+
+		public IntPtr Address { get; }
+		public int Length { get; }
+		internal int Generation { get; }
+
+		public bool IsEmpty => Address == IntPtr.Zero;
+
+		public Span<T> AsSpan()
+		{
+			CheckOwner();
+			return NativeSpan.Create<T>(Address, Length);
+		}
+
+		[Conditional("DEBUG")]
+		private void CheckOwner()
+		{
+			if (Address != IntPtr.Zero && !NativePool.IsOwner(Address, Generation))
+			{
+				throw new InvalidOperationException($"NativeBuffer<{typeof(T).Name}> used after it was returned to the pool");
+			}
+		}
+	}
+}
@@ -0,0 +1,22 @@
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Core
+{
+	internal static class NativeSpan
+	{
+		// Span over unmanaged memory. The GC never moves native memory, so a ref into it can back a
+		// span without pinning (and without unsafe code).
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static Span<T> Create<T>(IntPtr address, int count) where T : unmanaged
+		{
+			if (address == IntPtr.Zero || count <= 0)
+			{
+				return Span<T>.Empty;
+			}
+
+			return MemoryMarshal.CreateSpan(ref Unsafe.AddByteOffset(ref Unsafe.NullRef<T>(), address), count);
+		}
+	}
+}
@@ -0,0 +1,13 @@
+using System;
+
+namespace MochiSharp.Managed.Core
+{
+	// Marks an instance field for network replication: DotNetHost::CaptureSnapshot writes it and
+	// ApplySnapshot restores it. Primitives, enums, blittable structs and entity references are
+	// replicated; fields of other types are left out. Engines with their own attribute pass its full
+	// name to DotNetHost::ConfigureReplication instead.
+	[AttributeUsage(AttributeTargets.Field, AllowMultiple = false, Inherited = false)]
+	public sealed class ReplicatedAttribute : Attribute
+	{
+	}
+}
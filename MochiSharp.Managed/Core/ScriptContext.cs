@@ -1,13 +1,17 @@
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.IO;
 using System.Linq;
+using System.Numerics;
 using System.Reflection;
 using System.Reflection.Emit;
 using System.Reflection.Metadata;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Runtime.Loader;
 using System.Text;
+using System.Threading;
 
 namespace MochiSharp.Managed.Core
 {
@@ -15,20 +19,50 @@ namespace MochiSharp.Managed.Core
 	{
         private string _serializeFieldAttributeTypeName = string.Empty;
 		private string _entityTypeName = string.Empty;
+		private string _replicatedAttributeTypeName = typeof(ReplicatedAttribute).FullName!;
 
 		private sealed class PluginLoadContext : AssemblyLoadContext
 		{
-			private readonly AssemblyDependencyResolver _resolver;
+			private readonly AssemblyDependencyResolver? _resolver;
+			private readonly string _baseDirectory;
 			private readonly Assembly _coreAssembly;
 
 			public PluginLoadContext(string mainAssemblyPath, Assembly coreAssembly)
 				: base($"MochiSharp.Plugin:{Path.GetFileNameWithoutExtension(mainAssemblyPath)}", isCollectible: true)
 			{
-				_resolver = new AssemblyDependencyResolver(mainAssemblyPath);
+				_baseDirectory = Path.GetDirectoryName(mainAssemblyPath) ?? string.Empty;
 				_coreAssembly = coreAssembly;
+
+				try
+				{
+					_resolver = new AssemblyDependencyResolver(mainAssemblyPath);
+				}
+				catch (InvalidOperationException)
+				{
+					// Modules loaded from memory have no file on disk; their directory is probed instead.
+					_resolver = null;
+				}
+			}
+
+			// Loads from bytes in memory: no temp files, and the original stays unlocked so it can be
+			// rebuilt while the module is running.
+			public Assembly LoadImage(byte[] image, byte[]? symbols)
+			{
+				using var imageStream = new MemoryStream(image, writable: false);
+				using var symbolStream = symbols != null ? new MemoryStream(symbols, writable: false) : null;
+				return LoadFromStream(imageStream, symbolStream);
 			}
 
+			private string? ResolveAssemblyPath(AssemblyName assemblyName)
+			{
+				if (_resolver != null)
+				{
+					return _resolver.ResolveAssemblyToPath(assemblyName);
+				}
 
+				string candidate = Path.Combine(_baseDirectory, $"{assemblyName.Name}.dll");
+				return File.Exists(candidate) ? candidate : null;
+			}
 
 			protected override Assembly? Load(AssemblyName assemblyName)
 			{
@@ -38,7 +72,14 @@ namespace MochiSharp.Managed.Core
 					return _coreAssembly;
 				}
 
-				string assemblyPath = _resolver.ResolveAssemblyToPath(assemblyName)!;
+				// Shared assemblies keep a single identity across all modules.
+				var shared = SharedContext.FindLoaded(assemblyName.Name);
+				if (shared != null)
+				{
+					return shared;
+				}
+
+				string? assemblyPath = ResolveAssemblyPath(assemblyName);
 				if (assemblyPath == null)
 				{
 					return null;
@@ -54,12 +95,39 @@ namespace MochiSharp.Managed.Core
 					}
 				}
 
-				return LoadFromAssemblyPath(assemblyPath);
+				return LoadImage(ReadImage(assemblyPath), ReadSymbols(assemblyPath));
+			}
+
+			// Path of a dependency this context loads itself; null for the core, shared and
+			// default-context assemblies, whose files do not belong to the module.
+			public string? GetPrivateDependencyPath(AssemblyName assemblyName)
+			{
+				if (string.Equals(assemblyName.Name, _coreAssembly.GetName().Name, StringComparison.OrdinalIgnoreCase)
+					|| SharedContext.FindLoaded(assemblyName.Name) != null)
+				{
+					return null;
+				}
+
+				string? assemblyPath = ResolveAssemblyPath(assemblyName);
+				if (assemblyPath == null)
+				{
+					return null;
+				}
+
+				foreach (var asm in AssemblyLoadContext.Default.Assemblies)
+				{
+					if (string.Equals(asm.GetName().Name, assemblyName.Name, StringComparison.OrdinalIgnoreCase))
+					{
+						return null;
+					}
+				}
+
+				return assemblyPath;
 			}
 
 			protected override IntPtr LoadUnmanagedDll(string unmanagedDllName)
 			{
-				string? libraryPath = _resolver.ResolveUnmanagedDllToPath(unmanagedDllName);
+				string? libraryPath = _resolver?.ResolveUnmanagedDllToPath(unmanagedDllName);
 				if (libraryPath == null)
 				{
 					return IntPtr.Zero;
@@ -69,8 +137,71 @@ namespace MochiSharp.Managed.Core
 			}
 		}
 
+		// Non-collectible parent for assemblies that several script modules reference (common gameplay
+		// types, interop structs). Modules resolve those names here instead of loading private copies,
+		// so types compare equal across modules. Shared assemblies live until the process exits.
+		private sealed class SharedLoadContext : AssemblyLoadContext
+		{
+			private readonly List<AssemblyDependencyResolver> _resolvers = new();
+			private readonly Assembly _coreAssembly;
+
+			public SharedLoadContext(Assembly coreAssembly)
+				: base("MochiSharp.Shared", isCollectible: false)
+			{
+				_coreAssembly = coreAssembly;
+			}
+
+			public Assembly LoadShared(string assemblyPath)
+			{
+				var existing = FindLoaded(AssemblyName.GetAssemblyName(assemblyPath).Name);
+				if (existing != null)
+				{
+					return existing;
+				}
+
+				_resolvers.Add(new AssemblyDependencyResolver(assemblyPath));
+				return LoadFromAssemblyPath(assemblyPath);
+			}
+
+			public Assembly? FindLoaded(string? assemblyName)
+			{
+				foreach (var asm in Assemblies)
+				{
+					if (string.Equals(asm.GetName().Name, assemblyName, StringComparison.OrdinalIgnoreCase))
+					{
+						return asm;
+					}
+				}
+
+				return null;
+			}
+
+			protected override Assembly? Load(AssemblyName assemblyName)
+			{
+				if (string.Equals(assemblyName.Name, _coreAssembly.GetName().Name, StringComparison.OrdinalIgnoreCase))
+				{
+					return _coreAssembly;
+				}
+
+				foreach (var resolver in _resolvers)
+				{
+					string? assemblyPath = resolver.ResolveAssemblyToPath(assemblyName);
+					if (assemblyPath != null)
+					{
+						return LoadFromAssemblyPath(assemblyPath);
+					}
+				}
+
+				return null;
+			}
+		}
+
+		private static readonly SharedLoadContext SharedContext = new(typeof(Bootstrap).Assembly);
+
 		private class FieldAccessor
 		{
+			// Position in GetTypeFields / GetInstanceFields; the field handle in field change records.
+			public required int Index;
 			public required FieldInfo Field;
 			public required Func<object, object?> Getter;
 			public required Action<object, object?> Setter;
@@ -78,22 +209,50 @@ namespace MochiSharp.Managed.Core
 			public required bool HasSerializeFieldAttribute;
 		}
 
+		private sealed class InstancePool
+		{
+			public required int Capacity;
+			public required Stack<object> Free;
+			public Action<object>? Reset;
+		}
+
 		private readonly string _pluginPath;
-		private readonly string _shadowDirectory;
-		private readonly string _shadowAssemblyPath;
 		private readonly PluginLoadContext _loadContext;
 		private readonly Assembly _pluginAssembly;
+		private readonly byte[] _contentHash;
+		private readonly bool _isInMemory;
 
 		public string PluginPath => _pluginPath;
 
+		// Method ids carry the module handle in their top bits so calls can be routed without a lookup.
+		public const int MethodIdModuleShift = 24;
+
+		private readonly int _moduleHandle;
+
+		public int ModuleHandle => _moduleHandle;
+
 		private readonly Dictionary<ulong, object> _instances = new();
+		private readonly Dictionary<ulong, List<int>> _instanceMethodIds = new();
+		private readonly Dictionary<Type, Func<object>> _constructorCache = new();
+		private readonly Dictionary<Type, InstancePool> _instancePools = new();
+		private readonly Queue<object> _pendingRelease = new();
 
-		private int _nextMethodId = 1;
+		private int _nextMethodId;
 		private readonly Dictionary<int, MethodBinding> _methods = new();
 		private readonly Dictionary<Type, Dictionary<string, FieldAccessor>> _typeFieldAccessorCache = new();
 
 		private readonly Dictionary<int, Signature> _signatures = new();
 
+		// Type name index. Resolved names map straight to their Type; misses are remembered too and
+		// are forgotten whenever another assembly gets loaded into the process, as they may resolve now.
+		private readonly Dictionary<string, Type> _pluginTypeIndex = new(StringComparer.Ordinal);
+		private readonly Dictionary<string, Type> _signatureTypeIndex = new(StringComparer.Ordinal);
+		private readonly HashSet<string> _missingPluginTypeNames = new(StringComparer.Ordinal);
+		private readonly HashSet<string> _missingSignatureTypeNames = new(StringComparer.Ordinal);
+		private bool _pluginTypeIndexBuilt;
+		private int _assemblyLoadGeneration;
+		private int _missingTypeNamesGeneration;
+
 		private readonly struct Signature
 		{
 			public readonly Type ReturnType;
@@ -106,286 +265,2129 @@ namespace MochiSharp.Managed.Core
 			}
 		}
 
+		// Reads every argument straight from the native argument array, calls the method and writes
+		// the result to returnPtr. Built once per resolved method and shared by all its bindings.
+		private delegate void InvokeThunk(object? target, IntPtr argsPtr, IntPtr returnPtr);
+
+		private readonly record struct MethodKey(Type Type, string Name, int SignatureId, bool IsStatic);
+
+		private sealed class ResolvedMethod
+		{
+			public required MethodInfo Method;
+			public required Signature Signature;
+			public required InvokeThunk? Thunk;
+		}
+
 		private readonly struct MethodBinding
 		{
 			public readonly object Target;
 			public readonly MethodInfo Method;
 			public readonly Signature Signature;
+			public readonly InvokeThunk? Thunk;
+			public readonly MethodFaults Faults;
 
-			public MethodBinding(object target, MethodInfo method, Signature signature)
+			public MethodBinding(object target, ResolvedMethod resolved)
 			{
 				Target = target;
-				Method = method;
-				Signature = signature;
+				Method = resolved.Method;
+				Signature = resolved.Signature;
+				Thunk = resolved.Thunk;
+				Faults = new MethodFaults();
 			}
 		}
 
+		private readonly Dictionary<MethodKey, ResolvedMethod> _resolvedMethods = new();
+
+		// Raw-memory codec for a blittable value type, whose managed layout is also its native layout.
+		private sealed class BlittableLayout
+		{
+			public required int Size;
+			public required int Alignment;
+			public required Func<IntPtr, object> Read;
+			public required Action<IntPtr, object> Write;
+		}
 
+		// Null entries record types that are not blittable and use the Marshal-based path.
+		private readonly Dictionary<Type, BlittableLayout?> _blittableLayouts = new();
 
-		public ScriptContext(string pluginAssemblyPath)
+		// Entity reference fields cross the boundary as the entity id. The ID getter and the (ulong)
+		// constructor are compiled once per entity type, and reads hand out one shared wrapper per id,
+		// held weakly so wrappers nothing points to any more can still be collected.
+		private sealed class EntityMarshaller
 		{
-			if (string.IsNullOrWhiteSpace(pluginAssemblyPath))
-			{
-				throw new ArgumentException("Plugin assembly path is required", nameof(pluginAssemblyPath));
-			}
+			public required Func<object, ulong>? GetId;
+			public required Func<ulong, object>? Create;
+			public readonly Dictionary<ulong, WeakReference<object>> Wrappers = new();
+			public int PruneThreshold = 256;
+		}
 
-			_pluginPath = Path.GetFullPath(pluginAssemblyPath);
-			if (!File.Exists(_pluginPath))
-			{
-				throw new FileNotFoundException("Plugin assembly not found", _pluginPath);
-			}
+		private readonly Dictionary<Type, EntityMarshaller> _entityMarshallers = new();
 
-			_shadowDirectory = Path.Combine(Path.GetTempPath(), "MochiSharp", "shadow", Guid.NewGuid().ToString("N"));
-			Directory.CreateDirectory(_shadowDirectory);
-			_shadowAssemblyPath = Path.Combine(_shadowDirectory, Path.GetFileName(_pluginPath));
-			File.Copy(_pluginPath, _shadowAssemblyPath, overwrite: true);
+		private delegate void EventHandlerThunk(object target, IntPtr payload);
 
-			_loadContext = new PluginLoadContext(_pluginPath, typeof(Bootstrap).Assembly);
-			_pluginAssembly = _loadContext.LoadFromAssemblyPath(_shadowAssemblyPath);
+		private sealed class ScriptEventHandler
+		{
+			public required int PayloadSize;
+			public required EventHandlerThunk Thunk;
 		}
 
-		public void ConfigureSerializationTypeNames(string serializeFieldAttributeTypeName, string entityTypeName)
+		private readonly record struct EventSubscriber(ulong InstanceId, object Target, ScriptEventHandler Handler);
+
+		// The live instances with a handler for one event id, so a broadcast visits only those. Positions
+		// maps an instance id to its entry for swap-removal.
+		private sealed class EventSubscribers
 		{
-			_serializeFieldAttributeTypeName = serializeFieldAttributeTypeName?.Trim() ?? string.Empty;
-			_entityTypeName = entityTypeName?.Trim() ?? string.Empty;
+			public readonly List<EventSubscriber> Entries = new();
+			public readonly Dictionary<ulong, int> Positions = new();
 		}
 
-		public void Unload()
-		{
-			_instances.Clear();
-			_methods.Clear();
-			_signatures.Clear();
-			_loadContext.Unload();
+		// [ScriptEvent] handlers per script type, keyed by event id. Built when CreateInstance(s) first
+		// resolves the type.
+		private readonly Dictionary<Type, Dictionary<int, ScriptEventHandler>> _eventHandlerTables = new();
+		private readonly Dictionary<int, EventSubscribers> _eventSubscribers = new();
+		private readonly List<EventSubscriber> _eventTargets = new();
 
-			try
-			{
-				if (Directory.Exists(_shadowDirectory))
-				{
-					Directory.Delete(_shadowDirectory, recursive: true);
-				}
-			}
-			catch
-			{
-			}
+		// Field change tracking (ConfigureFieldTracking). Raw fields are copied by an emitted snapshot
+		// method into a shadow of the previous collection and compared bytewise; string and entity
+		// fields keep the previous reference. Bit i of an instance's dirty set stands for Fields[i].
+		private sealed class FieldTrackingLayout
+		{
+			public required FieldAccessor[] Fields;
+			public required int[] Offsets;          // in the shadow; -1 for string and entity fields
+			public required int[] Sizes;
+			public required bool[] IsEntity;
+			public required int[] BitByFieldIndex;  // FieldAccessor.Index -> bit, -1 when not tracked
+			public required FieldBlockCopy? Snapshot;
+			public required byte[] Scratch;
 		}
 
-		public string GetDerivedTypes(string baseTypeFullName)
+		private sealed class TrackedInstance
 		{
-			if (string.IsNullOrWhiteSpace(baseTypeFullName))
-			{
-				return string.Empty;
-			}
+			public required ulong InstanceId;
+			public required object Instance;
+			public required FieldTrackingLayout Layout;
+			public required byte[] Shadow;
+			public required object?[] References;
+			public required ulong[] Dirty;
+			public bool HasDirty;
+			public int Slot;
+		}
 
-			var baseType = Type.GetType(baseTypeFullName, throwOnError: false)
-				?? AppDomain.CurrentDomain.GetAssemblies()
-					.Select(a => a.GetType(baseTypeFullName, throwOnError: false))
-					.FirstOrDefault(t => t != null)
-				?? throw new TypeLoadException($"Base type not found: {baseTypeFullName}");
+		private delegate void FieldBlockCopy(object target, ref byte block);
 
-			var derived = _pluginAssembly.GetTypes()
-				.Where(t => t.IsClass && !t.IsAbstract && baseType.IsAssignableFrom(t))
-				.Select(t => t.FullName)
-				.Where(n => !string.IsNullOrEmpty(n))
-				.ToArray();
+		private readonly Dictionary<Type, FieldTrackingLayout> _fieldTracking = new();
+		private readonly Dictionary<ulong, TrackedInstance> _trackedInstances = new();
+		private readonly List<TrackedInstance> _trackedList = new();
+		private int _trackingCursor;
 
-			return string.Join("|", derived);
+		// Replicated fields of a script type, packed in declaration order with base types first. The
+		// hash covers the type and field names and types, so a receiver running different script code
+		// rejects the record instead of misreading it. Null entries record types with no such fields.
+		private sealed class ReplicationLayout
+		{
+			public required uint Hash;
+			public required int Size;
+			public required FieldBlockCopy? Store;
+			public required FieldBlockCopy? Load;
+			public required FieldAccessor[] EntityFields;
+			public required int[] EntityOffsets;
 		}
 
-		public string GetTypeFields(string typeName)
-		{
-			if (string.IsNullOrWhiteSpace(typeName))
-			{
-				return string.Empty;
-			}
+		private readonly Dictionary<Type, ReplicationLayout?> _replicationLayouts = new();
 
-			Type type = ResolvePluginType(typeName);
-			return BuildFieldMetadataPayload(type);
-		}
+		// Populated from <assembly>.mochimanifest when it was generated for this exact build (same MVID).
+		private readonly record struct ManifestMethodKey(string TypeName, string Name, int SignatureId, bool IsStatic);
 
-		public void RegisterSignature(int signatureId, string returnTypeName, string[] parameterTypeNames)
-		{
-			ArgumentOutOfRangeException.ThrowIfNegative(signatureId);
+		private ScriptManifest? _manifest;
+		private readonly Dictionary<string, int> _manifestTypeTokens = new(StringComparer.Ordinal);
+		private readonly Dictionary<ManifestMethodKey, int> _manifestMethodTokens = new();
+		private readonly Dictionary<int, ScriptManifest.SignatureEntry> _manifestSignatures = new();
+		private readonly Dictionary<string, List<ScriptManifest.FieldEntry>> _manifestFields = new(StringComparer.Ordinal);
 
-			Type returnType = ResolveType(returnTypeName);
-			var paramTypes = parameterTypeNames.Length == 0
-				? Array.Empty<Type>()
-				: parameterTypeNames.Select(ResolveType).ToArray();
+		public bool HasManifest => _manifest != null;
 
-			_signatures[signatureId] = new Signature(returnType, paramTypes);
+
+
+		public ScriptContext(string pluginAssemblyPath, int moduleHandle = 0)
+			: this(pluginAssemblyPath, null, null, moduleHandle)
+		{
 		}
 
-		public bool CreateInstance(ulong instanceId, string typeName)
+		// With an image, the module is loaded from memory (e.g. unpacked from an asset archive) and
+		// pluginAssemblyPath only names it and locates its private dependencies; it need not exist.
+		// Without one, the image and its PDB are read from pluginAssemblyPath.
+		public ScriptContext(string pluginAssemblyPath, byte[]? image, byte[]? symbols, int moduleHandle = 0)
 		{
-			if (instanceId == 0)
+			if (string.IsNullOrWhiteSpace(pluginAssemblyPath))
 			{
-				throw new ArgumentException("Instance id is required", nameof(instanceId));
+				throw new ArgumentException("Plugin assembly path is required", nameof(pluginAssemblyPath));
 			}
 
-			if (_instances.TryGetValue(instanceId, out var existingInstance))
+			ArgumentOutOfRangeException.ThrowIfNegative(moduleHandle);
+			ArgumentOutOfRangeException.ThrowIfGreaterThan(moduleHandle, int.MaxValue >> MethodIdModuleShift);
+			_moduleHandle = moduleHandle;
+			_nextMethodId = (moduleHandle << MethodIdModuleShift) + 1;
+
+			_pluginPath = Path.GetFullPath(pluginAssemblyPath);
+			_isInMemory = image != null;
+			if (image == null)
 			{
-				if (!string.Equals(existingInstance.GetType().FullName, typeName, StringComparison.Ordinal))
+				if (!File.Exists(_pluginPath))
 				{
-					throw new InvalidOperationException($"Instance id {instanceId} already exists with type {existingInstance.GetType().FullName}, requested {typeName}");
+					throw new FileNotFoundException("Plugin assembly not found", _pluginPath);
 				}
 
-				return false;
+				// Read once so the hash describes exactly the bytes that get loaded.
+				image = ReadImage(_pluginPath);
+				symbols = ReadSymbols(_pluginPath);
 			}
 
-			Type type = ResolvePluginType(typeName);
-			object instance = Activator.CreateInstance(type)
-				?? throw new InvalidOperationException($"Failed to create instance of {type.FullName}");
+			_loadContext = new PluginLoadContext(_pluginPath, typeof(Bootstrap).Assembly);
+			_pluginAssembly = _loadContext.LoadImage(image, symbols);
+			_contentHash = ComputeContentHash(image, GetDependencyFiles());
 
-			_instances.Add(instanceId, instance);
-			return true;
+			AppDomain.CurrentDomain.AssemblyLoad += OnAssemblyLoad;
+			LoadManifest();
 		}
 
-		public void DestroyInstance(ulong instanceId)
+		// Loads an assembly into the shared parent context. Call before loading the modules that use it;
+		// modules that already loaded a private copy keep it until they are reloaded.
+		public static Assembly LoadSharedAssembly(string assemblyPath)
 		{
-			if (_instances.Remove(instanceId, out var obj))
-			{
-				if (obj is IDisposable d)
-				{
-					d.Dispose();
-				}
-			}
+			return SharedContext.LoadShared(Path.GetFullPath(assemblyPath));
 		}
 
-		public string GetInstanceFields(ulong instanceId)
+		// True when the type is declared by this module's own assembly (not a shared or framework one).
+		public bool DefinesType(string typeName)
 		{
-			if (instanceId == 0)
+			if (string.IsNullOrWhiteSpace(typeName))
 			{
-				throw new ArgumentException("Instance id is required", nameof(instanceId));
+				return false;
 			}
 
-			if (!_instances.TryGetValue(instanceId, out var existingInstance) || existingInstance == null)
+			if (TryResolveManifestType(typeName, out _))
 			{
-				throw new KeyNotFoundException($"Instance id not found: {instanceId}");
+				return true;
 			}
 
-			var type = existingInstance.GetType();
-			return BuildFieldMetadataPayload(type);
+			EnsurePluginTypeIndex();
+			return _pluginTypeIndex.TryGetValue(typeName, out var type) && type.Assembly == _pluginAssembly;
 		}
 
-		public bool GetInstanceFieldValue(ulong instanceId, string fieldName, IntPtr buffer, int bufferSize)
+		public bool HasInstance(ulong instanceId) => _instances.ContainsKey(instanceId);
+
+		public bool IsInMemory => _isInMemory;
+
+		// The plugin assembly followed by the dependencies it loads privately (not shared or framework
+		// ones): the files whose change requires reloading this module. Empty for modules loaded from
+		// memory, which are replaced with a new image instead.
+		public List<string> GetModuleFiles()
 		{
-			if (!_instances.TryGetValue(instanceId, out var instance))
+			if (_isInMemory)
 			{
-				return false;
+				return new List<string>();
 			}
 
-			if (string.IsNullOrWhiteSpace(fieldName) || buffer == IntPtr.Zero || bufferSize <= 0)
-			{
-				return false;
-			}
+			var files = GetDependencyFiles();
+			files.Insert(0, _pluginPath);
+			return files;
+		}
 
-			if (!TryGetFieldAccessor(instance.GetType(), fieldName, out var accessor))
+		private List<string> GetDependencyFiles()
+		{
+			var files = new List<string>();
+			foreach (var reference in _pluginAssembly.GetReferencedAssemblies())
 			{
-				return false;
+				string? path = _loadContext.GetPrivateDependencyPath(reference);
+				if (path != null && !files.Contains(path, StringComparer.OrdinalIgnoreCase) && !string.Equals(path, _pluginPath, StringComparison.OrdinalIgnoreCase))
+				{
+					files.Add(Path.GetFullPath(path));
+				}
 			}
 
-			object? value = accessor.Getter(instance);
-			return TryWriteFieldValueToBuffer(accessor.Field.FieldType, value, buffer, bufferSize);
+			return files;
 		}
 
-		public bool SetInstanceFieldValue(ulong instanceId, string fieldName, IntPtr buffer, int bufferSize)
+		// True when the module files on disk (or the given replacement image) still hash to what was
+		// loaded, e.g. after a rebuild that produced identical (deterministic) output. Such a reload
+		// can be skipped.
+		public bool IsContentUnchanged(byte[]? image = null)
 		{
-			if (!_instances.TryGetValue(instanceId, out var instance))
+			if (image == null)
 			{
-				return false;
+				if (_isInMemory)
+				{
+					return false;
+				}
+
+				try
+				{
+					image = ReadImage(_pluginPath);
+				}
+				catch (IOException)
+				{
+					return false;
+				}
 			}
 
-			if (string.IsNullOrWhiteSpace(fieldName) || buffer == IntPtr.Zero || bufferSize <= 0)
+			return ComputeContentHash(image, GetDependencyFiles()).AsSpan().SequenceEqual(_contentHash);
+		}
+
+		// Shared read/write/delete access: never blocks a compiler that is replacing the file.
+		private static byte[] ReadImage(string path)
+		{
+			using var stream = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete);
+			var image = new byte[stream.Length];
+			stream.ReadExactly(image);
+			return image;
+		}
+
+		private static byte[]? ReadSymbols(string assemblyPath)
+		{
+			string symbolsPath = Path.ChangeExtension(assemblyPath, ".pdb");
+			try
 			{
-				return false;
+				return File.Exists(symbolsPath) ? ReadImage(symbolsPath) : null;
 			}
-
-			if (!TryGetFieldAccessor(instance.GetType(), fieldName, out var accessor))
+			catch (IOException)
 			{
-				return false;
+				return null;
 			}
+		}
 
-			if (!TryReadFieldValueFromBuffer(accessor.Field.FieldType, buffer, bufferSize, out object? value))
+		private static byte[] ComputeContentHash(byte[] pluginImage, IEnumerable<string> dependencyPaths)
+		{
+			using var hash = System.Security.Cryptography.IncrementalHash.CreateHash(System.Security.Cryptography.HashAlgorithmName.SHA256);
+			hash.AppendData(pluginImage);
+			foreach (string path in dependencyPaths)
 			{
-				return false;
+				hash.AppendData(Encoding.UTF8.GetBytes(Path.GetFileName(path)));
+				if (File.Exists(path))
+				{
+					hash.AppendData(ReadImage(path));
+				}
 			}
 
-			accessor.Setter(instance, value);
-			return true;
+			return hash.GetHashAndReset();
 		}
 
-		public int BindInstanceMethod(ulong instanceId, string methodName, int signatureId)
+		// A missing, unreadable or stale manifest is not an error: lookups fall back to reflection.
+		private void LoadManifest()
 		{
-			if (!_instances.TryGetValue(instanceId, out var instance))
+			string manifestPath = ScriptManifest.GetDefaultPath(_pluginPath);
+			if (!File.Exists(manifestPath))
 			{
-				throw new KeyNotFoundException($"Instance id not found: {instanceId}");
+				return;
 			}
 
-			var type = instance.GetType();
-
-			MethodInfo method;
-			Signature sig;
-			if (_signatures.TryGetValue(signatureId, out var registeredSig))
+			ScriptManifest manifest;
+			try
 			{
-				sig = registeredSig;
-				method = FindMethod(type, methodName, sig.ParameterTypes, isStatic: false);
-				EnsureReturnType(method, sig.ReturnType);
+				manifest = ScriptManifest.Read(manifestPath);
 			}
-			else
+			catch (Exception ex) when (ex is IOException or InvalidDataException or FormatException or IndexOutOfRangeException)
 			{
-				method = FindMethodByName(type, methodName, isStatic: false);
-				sig = new Signature(method.ReturnType, method.GetParameters().Select(p => p.ParameterType).ToArray());
+				return;
 			}
 
-			int id = _nextMethodId++;
-			_methods.Add(id, new MethodBinding(instance, method, sig));
-			return id;
-		}
+			if (manifest.Mvid != _pluginAssembly.ManifestModule.ModuleVersionId)
+			{
+				return;
+			}
 
-		public int BindStaticMethod(string typeName, string methodName, int signatureId)
-		{
-			Type type = ResolvePluginType(typeName);
+			_manifest = manifest;
+			foreach (var t in manifest.Types)
+			{
+				_manifestTypeTokens[t.FullName] = t.Token;
+			}
 
-			MethodInfo method;
+			foreach (var s in manifest.Signatures)
+			{
+				_manifestSignatures[s.Id] = s;
+			}
+
+			foreach (var m in manifest.Methods)
+			{
+				_manifestMethodTokens[new ManifestMethodKey(m.TypeName, m.Name, m.SignatureId, m.IsStatic)] = m.Token;
+			}
+
+			foreach (var f in manifest.Fields)
+			{
+				if (!_manifestFields.TryGetValue(f.TypeName, out var fields))
+				{
+					fields = new List<ScriptManifest.FieldEntry>();
+					_manifestFields.Add(f.TypeName, fields);
+				}
+				fields.Add(f);
+			}
+		}
+
+		public void ConfigureSerializationTypeNames(string serializeFieldAttributeTypeName, string entityTypeName)
+		{
+			_serializeFieldAttributeTypeName = serializeFieldAttributeTypeName?.Trim() ?? string.Empty;
+			_entityTypeName = entityTypeName?.Trim() ?? string.Empty;
+			_entityMarshallers.Clear();
+			_replicationLayouts.Clear();
+		}
+
+		// Fields carrying this attribute are the ones CaptureReplicatedFields writes.
+		public void ConfigureReplication(string replicatedAttributeTypeName)
+		{
+			_replicatedAttributeTypeName = replicatedAttributeTypeName?.Trim() ?? string.Empty;
+			_replicationLayouts.Clear();
+		}
+
+		// Drops everything that references plugin types and starts unloading the load context. The
+		// returned weak reference dies once the context has actually been collected. Idle pooled
+		// instances and those still waiting for disposal are disposed first; failures go to onError.
+		public WeakReference Unload(Action<Exception>? onError)
+		{
+			// Pending continuations and coroutines reference plugin code; drop this module's ones first.
+			ScriptScheduler.Release(_loadContext);
+			while (_pendingRelease.TryDequeue(out var pending))
+			{
+				DisposeInstance(pending, onError);
+			}
+			foreach (var pool in _instancePools.Values)
+			{
+				TrimPool(pool, 0, onError);
+			}
+			_instances.Clear();
+			_instanceMethodIds.Clear();
+			_methods.Clear();
+			_typeFieldAccessorCache.Clear();
+			_constructorCache.Clear();
+			_instancePools.Clear();
+			_pendingRelease.Clear();
+			_signatures.Clear();
+			_resolvedMethods.Clear();
+			_blittableLayouts.Clear();
+			_entityMarshallers.Clear();
+			_eventHandlerTables.Clear();
+			_eventSubscribers.Clear();
+			_eventTargets.Clear();
+			_fieldTracking.Clear();
+			_trackedInstances.Clear();
+			_trackedList.Clear();
+			_replicationLayouts.Clear();
+			AppDomain.CurrentDomain.AssemblyLoad -= OnAssemblyLoad;
+			_pluginTypeIndex.Clear();
+			_signatureTypeIndex.Clear();
+			_missingPluginTypeNames.Clear();
+			_missingSignatureTypeNames.Clear();
+			_manifest = null;
+			_manifestTypeTokens.Clear();
+			_manifestMethodTokens.Clear();
+			_manifestSignatures.Clear();
+			_manifestFields.Clear();
+
+			var context = new WeakReference(_loadContext, trackResurrection: true);
+			_loadContext.Unload();
+			return context;
+		}
+
+		public string GetDerivedTypes(string baseTypeFullName)
+		{
+			if (string.IsNullOrWhiteSpace(baseTypeFullName))
+			{
+				return string.Empty;
+			}
+
+			var baseType = ResolvePluginType(baseTypeFullName);
+
+			if (_manifest != null && baseType.FullName != null)
+			{
+				string baseName = baseType.FullName;
+				return string.Join("|", _manifest.Types
+					.Where(t => t.IsConcreteClass && (t.FullName == baseName || t.Ancestors.Contains(baseName, StringComparer.Ordinal)))
+					.Select(t => t.FullName));
+			}
+
+			var derived = _pluginAssembly.GetTypes()
+				.Where(t => t.IsClass && !t.IsAbstract && baseType.IsAssignableFrom(t))
+				.Select(t => t.FullName)
+				.Where(n => !string.IsNullOrEmpty(n))
+				.ToArray();
+
+			return string.Join("|", derived);
+		}
+
+		public string GetTypeFields(string typeName)
+		{
+			if (string.IsNullOrWhiteSpace(typeName))
+			{
+				return string.Empty;
+			}
+
+			Type type = ResolvePluginType(typeName);
+			return BuildFieldMetadataPayload(type);
+		}
+
+		// nativeSizes/nativeAlignments, when given, hold the native sizeof/alignof of the return type
+		// (index 0) and of each parameter; 0 skips the check for that position. A mismatch throws
+		// instead of letting Invoke read or write past the native buffers.
+		public void RegisterSignature(int signatureId, string returnTypeName, string[] parameterTypeNames, int[]? nativeSizes = null, int[]? nativeAlignments = null)
+		{
+			ArgumentOutOfRangeException.ThrowIfNegative(signatureId);
+
+			Type returnType = ResolveType(returnTypeName);
+			var paramTypes = parameterTypeNames.Length == 0
+				? Array.Empty<Type>()
+				: parameterTypeNames.Select(ResolveType).ToArray();
+
+			if (nativeSizes != null)
+			{
+				for (int i = 0; i <= paramTypes.Length && i < nativeSizes.Length; i++)
+				{
+					int nativeAlignment = nativeAlignments != null && i < nativeAlignments.Length ? nativeAlignments[i] : 0;
+					ValidateNativeLayout(signatureId, i == 0 ? returnType : paramTypes[i - 1], i, nativeSizes[i], nativeAlignment);
+				}
+			}
+
+			_signatures[signatureId] = new Signature(returnType, paramTypes);
+
+			// Cached resolutions may have been made against the previous meaning of this id.
+			_resolvedMethods.Clear();
+		}
+
+		private void ValidateNativeLayout(int signatureId, Type type, int position, int nativeSize, int nativeAlignment)
+		{
+			if (type == typeof(void) || !type.IsValueType || nativeSize <= 0)
+			{
+				return;
+			}
+
+			string role = position == 0 ? "return type" : $"parameter {position - 1}";
+			int managedSize = GetNativeSize(type, out int managedAlignment);
+			if (managedSize != nativeSize)
+			{
+				throw new InvalidOperationException($"Signature {signatureId}: {role} {type.FullName} is {managedSize} bytes in managed code but {nativeSize} bytes natively");
+			}
+
+			if (nativeAlignment > 0 && managedAlignment > 0 && managedAlignment != nativeAlignment)
+			{
+				throw new InvalidOperationException($"Signature {signatureId}: {role} {type.FullName} has alignment {managedAlignment} in managed code but {nativeAlignment} natively");
+			}
+		}
+
+		// Bytes Invoke reads or writes for a value of this type; 0 for void.
+		private int GetNativeSize(Type type, out int alignment)
+		{
+			alignment = 0;
+			if (type == typeof(void) || !type.IsValueType)
+			{
+				return 0;
+			}
+
+			if (type == typeof(bool))
+			{
+				// bool crosses the boundary as an int32 (see Invoke).
+				alignment = sizeof(int);
+				return sizeof(int);
+			}
+
+			if (TryGetBlittableLayout(type, out var layout))
+			{
+				alignment = layout.Alignment;
+				return layout.Size;
+			}
+
+			return Marshal.SizeOf(type);
+		}
+
+		// Native size of the return value (index 0) and of each parameter of a registered signature,
+		// e.g. for a native recorder that copies argument bytes. Null if the id is not registered here.
+		public int[]? GetSignatureLayout(int signatureId)
+		{
+			if (!_signatures.TryGetValue(signatureId, out var signature))
+			{
+				return null;
+			}
+
+			var sizes = new int[signature.ParameterTypes.Length + 1];
+			sizes[0] = GetNativeSize(signature.ReturnType, out _);
+			for (int i = 0; i < signature.ParameterTypes.Length; i++)
+			{
+				sizes[i + 1] = GetNativeSize(signature.ParameterTypes[i], out _);
+			}
+
+			return sizes;
+		}
+
+		private bool TryGetBlittableLayout(Type type, out BlittableLayout layout)
+		{
+			if (!_blittableLayouts.TryGetValue(type, out var cached))
+			{
+				cached = IsBlittable(type, 0) ? CreateBlittableLayout(type) : null;
+				_blittableLayouts[type] = cached;
+			}
+
+			layout = cached!;
+			return cached != null;
+		}
+
+		// Stricter than "unmanaged": bool and char are excluded because their native size depends on
+		// the marshaller, and auto-layout structs because the runtime may reorder their fields.
+		private static bool IsBlittable(Type type, int depth)
+		{
+			if (type.IsEnum)
+			{
+				type = Enum.GetUnderlyingType(type);
+			}
+
+			if (type.IsPrimitive)
+			{
+				return type != typeof(bool) && type != typeof(char);
+			}
+
+			if (!type.IsValueType || type.ContainsGenericParameters || depth > 32 || (!type.IsLayoutSequential && !type.IsExplicitLayout))
+			{
+				return false;
+			}
+
+			foreach (var field in type.GetFields(BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic))
+			{
+				if (!IsBlittable(field.FieldType, depth + 1))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		private static BlittableLayout CreateBlittableLayout(Type type)
+		{
+			var readMethod = new DynamicMethod($"MochiSharp_Read_{type.FullName}", typeof(object), new[] { typeof(IntPtr) }, restrictedSkipVisibility: true);
+			ILGenerator il = readMethod.GetILGenerator();
+			il.Emit(OpCodes.Ldarg_0);
+			il.Emit(OpCodes.Unaligned, (byte)1);
+			il.Emit(OpCodes.Ldobj, type);
+			il.Emit(OpCodes.Box, type);
+			il.Emit(OpCodes.Ret);
+
+			var writeMethod = new DynamicMethod($"MochiSharp_Write_{type.FullName}", typeof(void), new[] { typeof(IntPtr), typeof(object) }, restrictedSkipVisibility: true);
+			il = writeMethod.GetILGenerator();
+			il.Emit(OpCodes.Ldarg_0);
+			il.Emit(OpCodes.Ldarg_1);
+			il.Emit(OpCodes.Unbox_Any, type);
+			il.Emit(OpCodes.Unaligned, (byte)1);
+			il.Emit(OpCodes.Stobj, type);
+			il.Emit(OpCodes.Ret);
+
+			return new BlittableLayout
+			{
+				Size = (int)typeof(Unsafe).GetMethod(nameof(Unsafe.SizeOf))!.MakeGenericMethod(type).Invoke(null, null)!,
+				Alignment = GetAlignment(type),
+				Read = (Func<IntPtr, object>)readMethod.CreateDelegate(typeof(Func<IntPtr, object>)),
+				Write = (Action<IntPtr, object>)writeMethod.CreateDelegate(typeof(Action<IntPtr, object>))
+			};
+		}
+
+		// Alignment the equivalent C++ struct has: the largest field alignment, capped by Pack.
+		private static int GetAlignment(Type type)
+		{
+			if (type.IsEnum)
+			{
+				type = Enum.GetUnderlyingType(type);
+			}
+
+			if (type.IsPrimitive)
+			{
+				return Type.GetTypeCode(type) switch
+				{
+					TypeCode.Byte or TypeCode.SByte => 1,
+					TypeCode.Int16 or TypeCode.UInt16 => 2,
+					TypeCode.Int32 or TypeCode.UInt32 or TypeCode.Single => 4,
+					TypeCode.Int64 or TypeCode.UInt64 or TypeCode.Double => 8,
+					_ => IntPtr.Size
+				};
+			}
+
+			int alignment = 1;
+			foreach (var field in type.GetFields(BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic))
+			{
+				alignment = Math.Max(alignment, GetAlignment(field.FieldType));
+			}
+
+			int pack = type.StructLayoutAttribute?.Pack ?? 0;
+			return pack > 0 ? Math.Min(alignment, pack) : alignment;
+		}
+
+		public bool CreateInstance(ulong instanceId, string typeName)
+		{
+			if (instanceId == 0)
+			{
+				throw new ArgumentException("Instance id is required", nameof(instanceId));
+			}
+
+			if (_instances.TryGetValue(instanceId, out var existingInstance))
+			{
+				if (!string.Equals(existingInstance.GetType().FullName, typeName, StringComparison.Ordinal))
+				{
+					throw new InvalidOperationException($"Instance id {instanceId} already exists with type {existingInstance.GetType().FullName}, requested {typeName}");
+				}
+
+				return false;
+			}
+
+			Type type = ResolvePluginType(typeName);
+			var eventHandlers = GetEventHandlers(type);
+			object instance = AcquireInstance(type);
+			_instances.Add(instanceId, instance);
+			SubscribeEvents(instanceId, instance, eventHandlers);
+			if (_fieldTracking.Count > 0 && _fieldTracking.TryGetValue(type, out var tracking))
+			{
+				TrackInstance(instanceId, instance, tracking);
+			}
+			return true;
+		}
+
+		// Creates (or reuses) one instance of typeName per id in instanceIds.
+		// The type and its constructor are resolved once for the whole batch.
+		// Bit i of resultBitmap is set when instanceIds[i] holds an instance of typeName afterwards;
+		// the bitmap must hold at least (count + 7) / 8 bytes. Returns the number of set bits.
+		// The first constructor exception of the batch goes to onError; the others usually repeat it.
+		public int CreateInstances(string typeName, IntPtr instanceIds, int count, IntPtr resultBitmap, Action<Exception>? onError)
+		{
+			ArgumentOutOfRangeException.ThrowIfNegative(count);
+			if (count > 0 && (instanceIds == IntPtr.Zero || resultBitmap == IntPtr.Zero))
+			{
+				throw new ArgumentException("Instance id and result buffers are required");
+			}
+
+			Type type = ResolvePluginType(typeName);
+			Func<object> constructor = GetConstructor(type);
+			var eventHandlers = GetEventHandlers(type);
+			_instancePools.TryGetValue(type, out var pool);
+			_fieldTracking.TryGetValue(type, out var tracking);
+			_instances.EnsureCapacity(_instances.Count + count);
+
+			int succeeded = 0;
+			bool reported = false;
+			byte bits = 0;
+			for (int i = 0; i < count; i++)
+			{
+				ulong instanceId = unchecked((ulong)Marshal.ReadInt64(instanceIds, i * sizeof(ulong)));
+				bool ok = false;
+				if (instanceId != 0)
+				{
+					if (_instances.TryGetValue(instanceId, out var existingInstance))
+					{
+						ok = existingInstance.GetType() == type;
+					}
+					else
+					{
+						try
+						{
+							object instance = pool != null && pool.Free.Count > 0 ? pool.Free.Pop() : constructor();
+							_instances.Add(instanceId, instance);
+							SubscribeEvents(instanceId, instance, eventHandlers);
+							if (tracking != null)
+							{
+								TrackInstance(instanceId, instance, tracking);
+							}
+							ok = true;
+						}
+						catch (Exception ex)
+						{
+							if (!reported)
+							{
+								reported = true;
+								onError?.Invoke(ex);
+							}
+						}
+					}
+				}
+
+				if (ok)
+				{
+					bits |= (byte)(1 << (i & 7));
+					succeeded++;
+				}
+
+				if ((i & 7) == 7 || i == count - 1)
+				{
+					Marshal.WriteByte(resultBitmap, i >> 3, bits);
+					bits = 0;
+				}
+			}
+
+			return succeeded;
+		}
+
+		// Enables recycling of destroyed instances of typeName, keeping at most capacity idle objects.
+		// A parameterless instance method named OnReset is called when an instance is returned to the pool.
+		// A capacity of 0 disables pooling for the type and disposes its idle instances.
+		public void ConfigureInstancePool(string typeName, int capacity, Action<Exception>? onError)
+		{
+			ArgumentOutOfRangeException.ThrowIfNegative(capacity);
+
+			Type type = ResolvePluginType(typeName);
+			if (_instancePools.TryGetValue(type, out var pool))
+			{
+				pool.Capacity = capacity;
+				TrimPool(pool, capacity, onError);
+				if (capacity == 0)
+				{
+					_instancePools.Remove(type);
+				}
+				return;
+			}
+
+			if (capacity == 0)
+			{
+				return;
+			}
+
+			_instancePools.Add(type, new InstancePool
+			{
+				Capacity = capacity,
+				Free = new Stack<object>(capacity),
+				Reset = CreateResetHook(type)
+			});
+		}
+
+		public void DestroyInstance(ulong instanceId)
+		{
+			if (DetachInstance(instanceId, out var obj))
+			{
+				ReleaseInstance(obj);
+			}
+		}
+
+		// Detaches every id in instanceIds right away, so the ids can be reused and their method
+		// bindings are gone, then disposes/recycles detached instances until budgetMilliseconds has
+		// elapsed (0 means no budget). Instances left over are released by later calls, which may
+		// pass count 0 to only continue the pending work. An instance whose Dispose or OnReset throws
+		// is reported to onError and dropped; the rest of the batch continues. Returns the number
+		// still pending.
+		public int DestroyInstances(IntPtr instanceIds, int count, double budgetMilliseconds, Action<Exception>? onError)
+		{
+			ArgumentOutOfRangeException.ThrowIfNegative(count);
+			if (count > 0 && instanceIds == IntPtr.Zero)
+			{
+				throw new ArgumentException("Instance id buffer is required", nameof(instanceIds));
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				ulong instanceId = unchecked((ulong)Marshal.ReadInt64(instanceIds, i * sizeof(ulong)));
+				if (DetachInstance(instanceId, out var obj))
+				{
+					_pendingRelease.Enqueue(obj);
+				}
+			}
+
+			long deadline = budgetMilliseconds > 0.0
+				? Stopwatch.GetTimestamp() + (long)(budgetMilliseconds * Stopwatch.Frequency / 1000.0)
+				: long.MaxValue;
+
+			int released = 0;
+			while (_pendingRelease.TryDequeue(out var pending))
+			{
+				try
+				{
+					ReleaseInstance(pending);
+				}
+				catch (Exception ex)
+				{
+					onError?.Invoke(ex);
+				}
+
+				// Reading the clock is not free; only check the budget every few instances.
+				if ((++released & 15) == 0 && Stopwatch.GetTimestamp() >= deadline)
+				{
+					break;
+				}
+			}
+
+			return _pendingRelease.Count;
+		}
+
+		private bool DetachInstance(ulong instanceId, out object instance)
+		{
+			if (!_instances.Remove(instanceId, out instance!))
+			{
+				return false;
+			}
+
+			if (_instanceMethodIds.Remove(instanceId, out var methodIds))
+			{
+				foreach (int methodId in methodIds)
+				{
+					_methods.Remove(methodId);
+				}
+			}
+
+			if (_trackedInstances.Count > 0)
+			{
+				UntrackInstance(instanceId);
+			}
+
+			if (_eventHandlerTables.TryGetValue(instance.GetType(), out var eventHandlers))
+			{
+				UnsubscribeEvents(instanceId, eventHandlers);
+			}
+
+			// Coroutines started with the instance as owner must not outlive it (or be resumed on a pooled copy).
+			ScriptScheduler.StopCoroutines(instance);
+			return true;
+		}
+
+		private object AcquireInstance(Type type)
+		{
+			if (_instancePools.TryGetValue(type, out var pool) && pool.Free.Count > 0)
+			{
+				return pool.Free.Pop();
+			}
+
+			return GetConstructor(type)();
+		}
+
+		private void ReleaseInstance(object instance)
+		{
+			if (_instancePools.TryGetValue(instance.GetType(), out var pool) && pool.Free.Count < pool.Capacity)
+			{
+				pool.Reset?.Invoke(instance);
+				pool.Free.Push(instance);
+				return;
+			}
+
+			DisposeInstance(instance);
+		}
+
+		private static void DisposeInstance(object instance)
+		{
+			if (instance is IDisposable d)
+			{
+				d.Dispose();
+			}
+		}
+
+		private static void DisposeInstance(object instance, Action<Exception>? onError)
+		{
+			try
+			{
+				DisposeInstance(instance);
+			}
+			catch (Exception ex)
+			{
+				onError?.Invoke(ex);
+			}
+		}
+
+		// Disposes idle instances until at most capacity are left.
+		private static void TrimPool(InstancePool pool, int capacity, Action<Exception>? onError)
+		{
+			while (pool.Free.Count > capacity)
+			{
+				DisposeInstance(pool.Free.Pop(), onError);
+			}
+		}
+
+		private Func<object> GetConstructor(Type type)
+		{
+			if (!_constructorCache.TryGetValue(type, out var constructor))
+			{
+				constructor = CreateConstructor(type);
+				_constructorCache[type] = constructor;
+			}
+
+			return constructor;
+		}
+
+		// Routes one event to the target instance, or to every live instance with a handler when the
+		// target is 0. Handler exceptions go to onError and do not stop delivery to other instances.
+		// Returns the number of handlers called.
+		public int DispatchEvent(int eventTypeId, ulong targetInstanceId, IntPtr payload, int payloadSize, Action<Exception> onError)
+		{
+			if (targetInstanceId != 0)
+			{
+				return _instances.TryGetValue(targetInstanceId, out var target)
+					&& _eventHandlerTables.TryGetValue(target.GetType(), out var handlers)
+					&& handlers.TryGetValue(eventTypeId, out var handler)
+					? InvokeEventHandler(target, handler, eventTypeId, payload, payloadSize, onError)
+					: 0;
+			}
+
+			if (!_eventSubscribers.TryGetValue(eventTypeId, out var subscribers) || subscribers.Entries.Count == 0)
+			{
+				return 0;
+			}
+
+			// Handlers may create or destroy instances while we iterate.
+			_eventTargets.Clear();
+			_eventTargets.AddRange(subscribers.Entries);
+
+			int handled = 0;
+			foreach (var subscriber in _eventTargets)
+			{
+				handled += InvokeEventHandler(subscriber.Target, subscriber.Handler, eventTypeId, payload, payloadSize, onError);
+			}
+
+			_eventTargets.Clear();
+			return handled;
+		}
+
+		private Dictionary<int, ScriptEventHandler> GetEventHandlers(Type type)
+		{
+			if (!_eventHandlerTables.TryGetValue(type, out var handlers))
+			{
+				handlers = BuildEventHandlers(type);
+				_eventHandlerTables.Add(type, handlers);
+			}
+
+			return handlers;
+		}
+
+		private void SubscribeEvents(ulong instanceId, object instance, Dictionary<int, ScriptEventHandler> handlers)
+		{
+			foreach (var (eventTypeId, handler) in handlers)
+			{
+				if (!_eventSubscribers.TryGetValue(eventTypeId, out var subscribers))
+				{
+					subscribers = new EventSubscribers();
+					_eventSubscribers.Add(eventTypeId, subscribers);
+				}
+
+				subscribers.Positions.Add(instanceId, subscribers.Entries.Count);
+				subscribers.Entries.Add(new EventSubscriber(instanceId, instance, handler));
+			}
+		}
+
+		private void UnsubscribeEvents(ulong instanceId, Dictionary<int, ScriptEventHandler> handlers)
+		{
+			foreach (int eventTypeId in handlers.Keys)
+			{
+				if (!_eventSubscribers.TryGetValue(eventTypeId, out var subscribers) || !subscribers.Positions.Remove(instanceId, out int position))
+				{
+					continue;
+				}
+
+				var entries = subscribers.Entries;
+				var last = entries[^1];
+				if (last.InstanceId != instanceId)
+				{
+					entries[position] = last;
+					subscribers.Positions[last.InstanceId] = position;
+				}
+				entries.RemoveAt(entries.Count - 1);
+			}
+		}
+
+		private static int InvokeEventHandler(object target, ScriptEventHandler handler, int eventTypeId, IntPtr payload, int payloadSize, Action<Exception> onError)
+		{
+			if (payloadSize < handler.PayloadSize)
+			{
+				onError(new ArgumentException($"Event {eventTypeId} payload is {payloadSize} bytes, {target.GetType().FullName} expects {handler.PayloadSize}"));
+				return 0;
+			}
+
+			try
+			{
+				handler.Thunk(target, payload);
+				return 1;
+			}
+			catch (Exception ex)
+			{
+				onError(ex);
+				return 0;
+			}
+		}
+
+		private static Dictionary<int, ScriptEventHandler> BuildEventHandlers(Type type)
+		{
+			var handlers = new Dictionary<int, ScriptEventHandler>();
+			const BindingFlags flags = BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.DeclaredOnly;
+			for (Type? current = type; current != null && current != typeof(object); current = current.BaseType)
+			{
+				foreach (var method in current.GetMethods(flags))
+				{
+					foreach (var attribute in method.GetCustomAttributes<ScriptEventAttribute>(inherit: false))
+					{
+						if (!handlers.ContainsKey(attribute.EventTypeId))
+						{
+							handlers.Add(attribute.EventTypeId, CreateEventHandler(method));
+						}
+					}
+				}
+			}
+
+			return handlers;
+		}
+
+		private static ScriptEventHandler CreateEventHandler(MethodInfo method)
+		{
+			var parameters = method.GetParameters();
+			Type? payloadType = parameters.Length == 1 ? parameters[0].ParameterType : null;
+			bool byRef = payloadType?.IsByRef == true;
+			if (byRef)
+			{
+				payloadType = payloadType!.GetElementType();
+			}
+
+			if (method.ReturnType != typeof(void) || method.ContainsGenericParameters || parameters.Length > 1
+				|| (payloadType != null && (parameters[0].IsOut || !IsBlittable(payloadType, 0))))
+			{
+				throw new InvalidOperationException($"[ScriptEvent] handler {method.DeclaringType?.FullName}.{method.Name} must return void and take no parameter or one blittable struct");
+			}
+
+			var dynamicMethod = new DynamicMethod(
+				$"MochiSharp_Event_{method.DeclaringType?.FullName}_{method.Name}",
+				typeof(void),
+				new[] { typeof(object), typeof(IntPtr) },
+				restrictedSkipVisibility: true);
+
+			ILGenerator il = dynamicMethod.GetILGenerator();
+			il.Emit(OpCodes.Ldarg_0);
+			il.Emit(OpCodes.Castclass, method.DeclaringType!);
+			if (payloadType != null)
+			{
+				il.Emit(OpCodes.Ldarg_1);
+				if (!byRef)
+				{
+					il.Emit(OpCodes.Unaligned, (byte)1);
+					il.Emit(OpCodes.Ldobj, payloadType);
+				}
+			}
+			il.Emit(method.IsVirtual ? OpCodes.Callvirt : OpCodes.Call, method);
+			il.Emit(OpCodes.Ret);
+
+			return new ScriptEventHandler
+			{
+				PayloadSize = payloadType == null ? 0 : (int)typeof(Unsafe).GetMethod(nameof(Unsafe.SizeOf))!.MakeGenericMethod(payloadType).Invoke(null, null)!,
+				Thunk = (EventHandlerThunk)dynamicMethod.CreateDelegate(typeof(EventHandlerThunk))
+			};
+		}
+
+		private static Func<object> CreateConstructor(Type type)
+		{
+			if (type.IsAbstract || type.IsValueType || type.ContainsGenericParameters)
+			{
+				throw new InvalidOperationException($"Failed to create instance of {type.FullName}");
+			}
+
+			var ctor = type.GetConstructor(BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic, binder: null, Type.EmptyTypes, modifiers: null)
+				?? throw new MissingMethodException($"No parameterless constructor defined for {type.FullName}");
+
+			var dynamicMethod = new DynamicMethod(
+				$"MochiSharp_New_{type.FullName}",
+				typeof(object),
+				Type.EmptyTypes,
+				restrictedSkipVisibility: true);
+
+			ILGenerator il = dynamicMethod.GetILGenerator();
+			il.Emit(OpCodes.Newobj, ctor);
+			il.Emit(OpCodes.Ret);
+
+			return (Func<object>)dynamicMethod.CreateDelegate(typeof(Func<object>));
+		}
+
+		private static Action<object>? CreateResetHook(Type type)
+		{
+			var method = type.GetMethod("OnReset", BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic, binder: null, Type.EmptyTypes, modifiers: null);
+			if (method == null || method.ReturnType != typeof(void))
+			{
+				return null;
+			}
+
+			var dynamicMethod = new DynamicMethod(
+				$"MochiSharp_Reset_{type.FullName}",
+				typeof(void),
+				new[] { typeof(object) },
+				restrictedSkipVisibility: true);
+
+			ILGenerator il = dynamicMethod.GetILGenerator();
+			il.Emit(OpCodes.Ldarg_0);
+			il.Emit(OpCodes.Castclass, type);
+			il.Emit(method.IsVirtual ? OpCodes.Callvirt : OpCodes.Call, method);
+			il.Emit(OpCodes.Ret);
+
+			return (Action<object>)dynamicMethod.CreateDelegate(typeof(Action<object>));
+		}
+
+		public string GetInstanceFields(ulong instanceId)
+		{
+			if (instanceId == 0)
+			{
+				throw new ArgumentException("Instance id is required", nameof(instanceId));
+			}
+
+			if (!_instances.TryGetValue(instanceId, out var existingInstance) || existingInstance == null)
+			{
+				throw new KeyNotFoundException($"Instance id not found: {instanceId}");
+			}
+
+			var type = existingInstance.GetType();
+			return BuildFieldMetadataPayload(type);
+		}
+
+		public bool GetInstanceFieldValue(ulong instanceId, string fieldName, IntPtr buffer, int bufferSize)
+		{
+			if (!_instances.TryGetValue(instanceId, out var instance))
+			{
+				return false;
+			}
+
+			if (string.IsNullOrWhiteSpace(fieldName) || buffer == IntPtr.Zero || bufferSize <= 0)
+			{
+				return false;
+			}
+
+			if (!TryGetFieldAccessor(instance.GetType(), fieldName, out var accessor))
+			{
+				return false;
+			}
+
+			object? value = accessor.Getter(instance);
+			return TryWriteFieldValueToBuffer(accessor.Field.FieldType, value, buffer, bufferSize);
+		}
+
+		public bool SetInstanceFieldValue(ulong instanceId, string fieldName, IntPtr buffer, int bufferSize)
+		{
+			if (!_instances.TryGetValue(instanceId, out var instance))
+			{
+				return false;
+			}
+
+			if (string.IsNullOrWhiteSpace(fieldName) || buffer == IntPtr.Zero || bufferSize <= 0)
+			{
+				return false;
+			}
+
+			if (!TryGetFieldAccessor(instance.GetType(), fieldName, out var accessor))
+			{
+				return false;
+			}
+
+			if (!TryReadFieldValueFromBuffer(accessor.Field.FieldType, buffer, bufferSize, out object? value))
+			{
+				return false;
+			}
+
+			accessor.Setter(instance, value);
+			if (_trackedInstances.TryGetValue(instanceId, out var tracked))
+			{
+				int bit = tracked.Layout.BitByFieldIndex[accessor.Index];
+				if (bit >= 0)
+				{
+					MarkDirty(tracked, bit);
+				}
+			}
+			return true;
+		}
+
+		// Turns change tracking on or off for instances of exactly typeName, including the ones that
+		// already exist. Only fields GetTypeFields lists are tracked, and of those only strings, entity
+		// references, primitives, enums and blittable structs. Returns the number of tracked fields.
+		public int ConfigureFieldTracking(string typeName, bool enabled)
+		{
+			Type type = ResolvePluginType(typeName);
+			if (!enabled)
+			{
+				if (_fieldTracking.Remove(type))
+				{
+					for (int i = _trackedList.Count - 1; i >= 0; i--)
+					{
+						if (_trackedList[i].Instance.GetType() == type)
+						{
+							UntrackInstance(_trackedList[i].InstanceId);
+						}
+					}
+				}
+				return 0;
+			}
+
+			if (!_fieldTracking.TryGetValue(type, out var layout))
+			{
+				layout = CreateFieldTrackingLayout(type);
+				_fieldTracking.Add(type, layout);
+				foreach (var (instanceId, instance) in _instances)
+				{
+					if (instance.GetType() == type)
+					{
+						TrackInstance(instanceId, instance, layout);
+					}
+				}
+			}
+
+			return layout.Fields.Length;
+		}
+
+		// Writes one record per field that changed since the previous call (see FieldChangeWriter), new
+		// instances reporting all their tracked fields. Changes that do not fit stay pending and the next
+		// call starts with the instance this one stopped at. Returns the number of records written.
+		internal int CollectDirtyFields(ref FieldChangeWriter writer)
+		{
+			int count = _trackedList.Count;
+			if (_trackingCursor >= count)
+			{
+				_trackingCursor = 0;
+			}
+
+			for (int n = 0; n < count; n++)
+			{
+				int slot = (_trackingCursor + n) % count;
+				var tracked = _trackedList[slot];
+				RefreshDirtyFields(tracked);
+				if (tracked.HasDirty && !WriteDirtyFields(tracked, ref writer))
+				{
+					_trackingCursor = slot;
+					return writer.Count;
+				}
+			}
+
+			_trackingCursor = 0;
+			return writer.Count;
+		}
+
+		private FieldTrackingLayout CreateFieldTrackingLayout(Type type)
+		{
+			var fields = new List<FieldAccessor>();
+			var offsets = new List<int>();
+			var sizes = new List<int>();
+			var isEntity = new List<bool>();
+			var bitByFieldIndex = new int[GetFieldAccessors(type).Count];
+			int shadowSize = 0;
+			foreach (var accessor in GetFieldAccessors(type).Values)
+			{
+				Type fieldType = accessor.Field.FieldType;
+				bool entity = IsEntityFieldType(fieldType);
+				int size = entity ? sizeof(ulong) : fieldType == typeof(string) ? 0 : GetRawFieldSize(fieldType);
+				if (size < 0)
+				{
+					bitByFieldIndex[accessor.Index] = -1;
+					continue;
+				}
+
+				bool isReference = entity || fieldType == typeof(string);
+				bitByFieldIndex[accessor.Index] = fields.Count;
+				fields.Add(accessor);
+				offsets.Add(isReference ? -1 : shadowSize);
+				sizes.Add(size);
+				isEntity.Add(entity);
+				shadowSize += isReference ? 0 : size;
+			}
+
+			var fieldArray = fields.ToArray();
+			var offsetArray = offsets.ToArray();
+			return new FieldTrackingLayout
+			{
+				Fields = fieldArray,
+				Offsets = offsetArray,
+				Sizes = sizes.ToArray(),
+				IsEntity = isEntity.ToArray(),
+				BitByFieldIndex = bitByFieldIndex,
+				Snapshot = shadowSize > 0 ? CreateFieldBlockCopy(type, fieldArray.Select(a => a.Field).ToArray(), offsetArray, load: false) : null,
+				Scratch = new byte[shadowSize]
+			};
+		}
+
+		// Bytes the field's value occupies in GetInstanceFieldValue format, -1 when it is not tracked.
+		private int GetRawFieldSize(Type fieldType)
+		{
+			if (fieldType == typeof(bool))
+			{
+				return sizeof(bool);
+			}
+
+			if (fieldType == typeof(char))
+			{
+				return sizeof(char);
+			}
+
+			return fieldType.IsValueType && TryGetBlittableLayout(fieldType, out var layout) ? layout.Size : -1;
+		}
+
+		// Copies fields of an instance of type to their offsets in a block of bytes (store) or back
+		// (load). Fields with a negative offset are skipped.
+		private static FieldBlockCopy CreateFieldBlockCopy(Type type, FieldInfo[] fields, int[] offsets, bool load)
+		{
+			var dynamicMethod = new DynamicMethod(
+				$"MochiSharp_{(load ? "Load" : "Store")}Fields_{type.FullName}",
+				typeof(void),
+				new[] { typeof(object), typeof(byte).MakeByRefType() },
+				restrictedSkipVisibility: true);
+
+			ILGenerator il = dynamicMethod.GetILGenerator();
+			LocalBuilder target = il.DeclareLocal(type);
+			il.Emit(OpCodes.Ldarg_0);
+			il.Emit(OpCodes.Castclass, type);
+			il.Emit(OpCodes.Stloc, target);
+			for (int i = 0; i < fields.Length; i++)
+			{
+				if (offsets[i] < 0)
+				{
+					continue;
+				}
+
+				FieldInfo field = fields[i];
+				if (load)
+				{
+					il.Emit(OpCodes.Ldloc, target);
+				}
+				il.Emit(OpCodes.Ldarg_1);
+				il.Emit(OpCodes.Ldc_I4, offsets[i]);
+				il.Emit(OpCodes.Add);
+				if (load)
+				{
+					il.Emit(OpCodes.Unaligned, (byte)1);
+					il.Emit(OpCodes.Ldobj, field.FieldType);
+					il.Emit(OpCodes.Stfld, field);
+				}
+				else
+				{
+					il.Emit(OpCodes.Ldloc, target);
+					il.Emit(OpCodes.Ldfld, field);
+					il.Emit(OpCodes.Unaligned, (byte)1);
+					il.Emit(OpCodes.Stobj, field.FieldType);
+				}
+			}
+			il.Emit(OpCodes.Ret);
+
+			return (FieldBlockCopy)dynamicMethod.CreateDelegate(typeof(FieldBlockCopy));
+		}
+
+		private void TrackInstance(ulong instanceId, object instance, FieldTrackingLayout layout)
+		{
+			int fieldCount = layout.Fields.Length;
+			var tracked = new TrackedInstance
+			{
+				InstanceId = instanceId,
+				Instance = instance,
+				Layout = layout,
+				Shadow = new byte[layout.Scratch.Length],
+				References = new object?[fieldCount],
+				Dirty = new ulong[(fieldCount + 63) / 64],
+				Slot = _trackedList.Count
+			};
+
+			// Everything is reported once, so the host starts from the full state.
+			for (int bit = 0; bit < fieldCount; bit++)
+			{
+				MarkDirty(tracked, bit);
+			}
+
+			_trackedInstances.Add(instanceId, tracked);
+			_trackedList.Add(tracked);
+		}
+
+		private void UntrackInstance(ulong instanceId)
+		{
+			if (!_trackedInstances.Remove(instanceId, out var tracked))
+			{
+				return;
+			}
+
+			int last = _trackedList.Count - 1;
+			var moved = _trackedList[last];
+			_trackedList[tracked.Slot] = moved;
+			moved.Slot = tracked.Slot;
+			_trackedList.RemoveAt(last);
+		}
+
+		private static void MarkDirty(TrackedInstance tracked, int bit)
+		{
+			tracked.Dirty[bit >> 6] |= 1UL << (bit & 63);
+			tracked.HasDirty = true;
+		}
+
+		private void RefreshDirtyFields(TrackedInstance tracked)
+		{
+			var layout = tracked.Layout;
+			if (layout.Snapshot != null)
+			{
+				// One comparison of the whole shadow in the common case of nothing having changed.
+				layout.Snapshot(tracked.Instance, ref MemoryMarshal.GetArrayDataReference(layout.Scratch));
+				if (!layout.Scratch.AsSpan().SequenceEqual(tracked.Shadow))
+				{
+					for (int i = 0; i < layout.Fields.Length; i++)
+					{
+						int offset = layout.Offsets[i];
+						if (offset >= 0 && !layout.Scratch.AsSpan(offset, layout.Sizes[i]).SequenceEqual(tracked.Shadow.AsSpan(offset, layout.Sizes[i])))
+						{
+							MarkDirty(tracked, i);
+						}
+					}
+
+					Buffer.BlockCopy(layout.Scratch, 0, tracked.Shadow, 0, layout.Scratch.Length);
+				}
+			}
+
+			for (int i = 0; i < layout.Fields.Length; i++)
+			{
+				if (layout.Offsets[i] >= 0)
+				{
+					continue;
+				}
+
+				object? value = layout.Fields[i].Getter(tracked.Instance);
+				object? previous = tracked.References[i];
+				if (ReferenceEquals(value, previous))
+				{
+					continue;
+				}
+
+				bool changed = layout.IsEntity[i]
+					? GetEntityId(layout.Fields[i].Field.FieldType, value) != GetEntityId(layout.Fields[i].Field.FieldType, previous)
+					: !string.Equals(value as string ?? string.Empty, previous as string ?? string.Empty, StringComparison.Ordinal);
+				tracked.References[i] = value;
+				if (changed)
+				{
+					MarkDirty(tracked, i);
+				}
+			}
+		}
+
+		// False when the buffer is full; the fields not written stay dirty.
+		private bool WriteDirtyFields(TrackedInstance tracked, ref FieldChangeWriter writer)
+		{
+			var layout = tracked.Layout;
+			for (int word = 0; word < tracked.Dirty.Length; word++)
+			{
+				while (tracked.Dirty[word] != 0)
+				{
+					int i = (word << 6) + BitOperations.TrailingZeroCount(tracked.Dirty[word]);
+					int fieldHandle = layout.Fields[i].Index;
+					if (layout.Offsets[i] >= 0)
+					{
+						IntPtr value = writer.Begin(tracked.InstanceId, fieldHandle, layout.Sizes[i]);
+						if (value == IntPtr.Zero)
+						{
+							return false;
+						}
+						Marshal.Copy(tracked.Shadow, layout.Offsets[i], value, layout.Sizes[i]);
+					}
+					else if (layout.IsEntity[i])
+					{
+						IntPtr value = writer.Begin(tracked.InstanceId, fieldHandle, sizeof(ulong));
+						if (value == IntPtr.Zero)
+						{
+							return false;
+						}
+						Marshal.WriteInt64(value, unchecked((long)GetEntityId(layout.Fields[i].Field.FieldType, tracked.References[i])));
+					}
+					else
+					{
+						string text = tracked.References[i] as string ?? string.Empty;
+						int size = Encoding.UTF8.GetByteCount(text);
+						IntPtr value = writer.Begin(tracked.InstanceId, fieldHandle, size);
+						if (value == IntPtr.Zero)
+						{
+							return false;
+						}
+						Encoding.UTF8.GetBytes(text, NativeSpan.Create<byte>(value, size));
+					}
+
+					tracked.Dirty[word] &= tracked.Dirty[word] - 1;
+				}
+			}
+
+			tracked.HasDirty = false;
+			return true;
+		}
+
+		private ulong GetEntityId(Type entityType, object? value)
+		{
+			var getId = value != null ? GetEntityMarshaller(entityType).GetId : null;
+			return getId != null ? getId(value!) : 0;
+		}
+
+		// Writes the instance's replicated fields to record and returns their size, 0 when it has none.
+		// Nothing is written when record is smaller than that.
+		internal int CaptureReplicatedFields(ulong instanceId, Span<byte> record, out uint layoutHash)
+		{
+			layoutHash = 0;
+			if (!_instances.TryGetValue(instanceId, out var instance))
+			{
+				return 0;
+			}
+
+			var layout = GetReplicationLayout(instance.GetType());
+			if (layout == null)
+			{
+				return 0;
+			}
+
+			layoutHash = layout.Hash;
+			if (record.Length < layout.Size)
+			{
+				return layout.Size;
+			}
+
+			layout.Store?.Invoke(instance, ref MemoryMarshal.GetReference(record));
+			for (int i = 0; i < layout.EntityFields.Length; i++)
+			{
+				var field = layout.EntityFields[i];
+				ulong id = GetEntityId(field.Field.FieldType, field.Getter(instance));
+				MemoryMarshal.Write(record.Slice(layout.EntityOffsets[i]), in id);
+			}
+
+			return layout.Size;
+		}
+
+		// Restores the instance's replicated fields from a record CaptureReplicatedFields wrote. False
+		// when the instance does not exist here or the record was written for a different layout.
+		internal bool ApplyReplicatedFields(ulong instanceId, uint layoutHash, ReadOnlySpan<byte> record)
+		{
+			if (!_instances.TryGetValue(instanceId, out var instance))
+			{
+				return false;
+			}
+
+			var layout = GetReplicationLayout(instance.GetType());
+			if (layout == null || layout.Hash != layoutHash || layout.Size != record.Length)
+			{
+				return false;
+			}
+
+			layout.Load?.Invoke(instance, ref Unsafe.AsRef(in MemoryMarshal.GetReference(record)));
+			for (int i = 0; i < layout.EntityFields.Length; i++)
+			{
+				var field = layout.EntityFields[i];
+				Type entityType = field.Field.FieldType;
+				ulong id = MemoryMarshal.Read<ulong>(record.Slice(layout.EntityOffsets[i]));
+				if (GetEntityId(entityType, field.Getter(instance)) != id)
+				{
+					field.Setter(instance, id != 0 ? GetEntityWrapper(GetEntityMarshaller(entityType), id) : null);
+				}
+			}
+
+			return true;
+		}
+
+		private ReplicationLayout? GetReplicationLayout(Type type)
+		{
+			if (!_replicationLayouts.TryGetValue(type, out var layout))
+			{
+				layout = CreateReplicationLayout(type);
+				_replicationLayouts[type] = layout;
+			}
+
+			return layout;
+		}
+
+		private ReplicationLayout? CreateReplicationLayout(Type type)
+		{
+			if (string.IsNullOrWhiteSpace(_replicatedAttributeTypeName))
+			{
+				return null;
+			}
+
+			var hierarchy = new List<Type>();
+			for (Type? current = type; current != null && current != typeof(object); current = current.BaseType)
+			{
+				hierarchy.Add(current);
+			}
+			hierarchy.Reverse();
+
+			const BindingFlags flags = BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.DeclaredOnly;
+			var rawFields = new List<FieldInfo>();
+			var rawOffsets = new List<int>();
+			var entityFields = new List<FieldAccessor>();
+			var entityOffsets = new List<int>();
+			uint hash = HashName(2166136261u, type.FullName ?? type.Name);
+			int size = 0;
+			foreach (var declaringType in hierarchy)
+			{
+				foreach (var field in declaringType.GetFields(flags))
+				{
+					if (field.IsInitOnly || field.IsLiteral || !HasAttribute(field, _replicatedAttributeTypeName))
+					{
+						continue;
+					}
+
+					bool entity = IsEntityFieldType(field.FieldType);
+					int fieldSize = entity ? sizeof(ulong) : GetRawFieldSize(field.FieldType);
+					if (fieldSize < 0)
+					{
+						continue;
+					}
+
+					if (entity)
+					{
+						entityFields.Add(new FieldAccessor
+						{
+							Index = -1,
+							Field = field,
+							Getter = CreateFieldGetter(field),
+							Setter = CreateFieldSetter(field),
+							IsPublic = field.IsPublic,
+							HasSerializeFieldAttribute = false
+						});
+						entityOffsets.Add(size);
+					}
+					else
+					{
+						rawFields.Add(field);
+						rawOffsets.Add(size);
+					}
+
+					hash = HashName(HashName(hash, field.Name), field.FieldType.FullName ?? field.FieldType.Name);
+					size += fieldSize;
+				}
+			}
+
+			if (size == 0)
+			{
+				return null;
+			}
+
+			if (size > ScriptSnapshot.MaxRecordSize)
+			{
+				throw new InvalidOperationException($"Replicated fields of {type.FullName} take {size} bytes, more than the {ScriptSnapshot.MaxRecordSize} a snapshot record may hold");
+			}
+
+			var rawFieldArray = rawFields.ToArray();
+			var rawOffsetArray = rawOffsets.ToArray();
+			return new ReplicationLayout
+			{
+				Hash = hash,
+				Size = size,
+				Store = rawFieldArray.Length > 0 ? CreateFieldBlockCopy(type, rawFieldArray, rawOffsetArray, load: false) : null,
+				Load = rawFieldArray.Length > 0 ? CreateFieldBlockCopy(type, rawFieldArray, rawOffsetArray, load: true) : null,
+				EntityFields = entityFields.ToArray(),
+				EntityOffsets = entityOffsets.ToArray()
+			};
+		}
+
+		// FNV-1a over the UTF-16 code units of text.
+		private static uint HashName(uint hash, string text)
+		{
+			foreach (char c in text)
+			{
+				hash = (hash ^ c) * 16777619u;
+			}
+
+			return hash;
+		}
+
+		public int BindInstanceMethod(ulong instanceId, string methodName, int signatureId)
+		{
+			if (!_instances.TryGetValue(instanceId, out var instance))
+			{
+				throw new KeyNotFoundException($"Instance id not found: {instanceId}");
+			}
+
+			var resolved = ResolveMethod(instance.GetType(), methodName, signatureId, isStatic: false);
+			return AddInstanceBinding(instanceId, instance, resolved);
+		}
+
+		// Binds count instance methods of one instance in a single call. methodNames points to count
+		// UTF-8 string pointers and signatureIds to count ints; outMethodIds receives one method id per
+		// entry, or 0 where binding failed; the reason for each failure goes to log. Returns the number
+		// of methods bound.
+		public int BindMethods(ulong instanceId, IntPtr methodNames, IntPtr signatureIds, int count, IntPtr outMethodIds, Action<string>? log)
+		{
+			ArgumentOutOfRangeException.ThrowIfNegative(count);
+			if (count > 0 && (methodNames == IntPtr.Zero || signatureIds == IntPtr.Zero || outMethodIds == IntPtr.Zero))
+			{
+				throw new ArgumentException("Method name, signature and result buffers are required");
+			}
+
+			if (!_instances.TryGetValue(instanceId, out var instance))
+			{
+				throw new KeyNotFoundException($"Instance id not found: {instanceId}");
+			}
+
+			var type = instance.GetType();
+			int bound = 0;
+			for (int i = 0; i < count; i++)
+			{
+				int id = 0;
+				string methodName = Marshal.PtrToStringUTF8(Marshal.ReadIntPtr(methodNames, i * IntPtr.Size)) ?? string.Empty;
+				int signatureId = Marshal.ReadInt32(signatureIds, i * sizeof(int));
+				try
+				{
+					id = AddInstanceBinding(instanceId, instance, ResolveMethod(type, methodName, signatureId, isStatic: false));
+					bound++;
+				}
+				catch (Exception ex) when (ex is MissingMemberException or AmbiguousMatchException or ArgumentException or InvalidOperationException or TypeLoadException)
+				{
+					log?.Invoke($"{type.FullName}.{methodName} (signature {signatureId}) not bound: {ex.Message}");
+				}
+
+				Marshal.WriteInt32(outMethodIds, i * sizeof(int), id);
+			}
+
+			return bound;
+		}
+
+		public int BindStaticMethod(string typeName, string methodName, int signatureId)
+		{
+			Type type = ResolvePluginType(typeName);
+			var resolved = ResolveMethod(type, methodName, signatureId, isStatic: true);
+
+			int id = _nextMethodId++;
+			_methods.Add(id, new MethodBinding(null!, resolved));
+			return id;
+		}
+
+		// Consecutive faults after which a method is disabled; 0 never disables.
+		public int MaxConsecutiveFaults { get; set; }
+
+		// Runs the bound method. Failures come back as a status (with the exception, if any) instead
+		// of being thrown, and count against the method's circuit breaker; a disabled method returns
+		// InvokeStatus.Disabled without running. Bad arguments and marshalling failures count too: a
+		// call site that is wrong every frame trips the breaker like a script that throws every frame.
+		// Script exceptions are passed through unwrapped.
+		public InvokeStatus TryInvoke(int methodId, IntPtr argsPtr, int argCount, IntPtr returnPtr, out Exception? error)
+		{
+			error = null;
+			if (!_methods.TryGetValue(methodId, out var binding))
+			{
+				return InvokeStatus.UnknownMethod;
+			}
+
+			var faults = binding.Faults;
+			if (faults.Disabled)
+			{
+				return InvokeStatus.Disabled;
+			}
+
+			var sig = binding.Signature;
+			if (argCount != sig.ParameterTypes.Length)
+			{
+				error = new ArgumentException($"Argument count mismatch. Expected {sig.ParameterTypes.Length}, got {argCount}");
+				faults.Record(MaxConsecutiveFaults);
+				return InvokeStatus.BadArguments;
+			}
+
+			if (returnPtr == IntPtr.Zero && sig.ReturnType != typeof(void) && binding.Thunk != null)
+			{
+				error = new ArgumentException("Return pointer must be non-null for non-void return");
+				faults.Record(MaxConsecutiveFaults);
+				return InvokeStatus.BadArguments;
+			}
+
+			if (binding.Thunk != null)
+			{
+				try
+				{
+					binding.Thunk(binding.Target, argsPtr, returnPtr);
+				}
+				catch (Exception ex)
+				{
+					error = ex;
+					faults.Record(MaxConsecutiveFaults);
+					return InvokeStatus.ScriptException;
+				}
+
+				faults.ConsecutiveFaults = 0;
+				return InvokeStatus.Ok;
+			}
+
+			object[] args = argCount == 0 ? Array.Empty<object>() : new object[argCount];
+			try
+			{
+				for (int i = 0; i < argCount; i++)
+				{
+					IntPtr argValuePtr = Marshal.ReadIntPtr(argsPtr, i * IntPtr.Size);
+					args[i] = TryGetBlittableLayout(sig.ParameterTypes[i], out var argLayout)
+						? argLayout.Read(argValuePtr)
+						: ReadValueFromPointer(sig.ParameterTypes[i], argValuePtr);
+				}
+			}
+			catch (Exception ex)
+			{
+				error = ex;
+				faults.Record(MaxConsecutiveFaults);
+				return InvokeStatus.MarshalFailed;
+			}
+
+			object? result;
+			try
+			{
+				result = binding.Method.Invoke(binding.Target, args);
+			}
+			catch (TargetInvocationException ex) when (ex.InnerException != null)
+			{
+				error = ex.InnerException;
+				faults.Record(MaxConsecutiveFaults);
+				return InvokeStatus.ScriptException;
+			}
+			catch (Exception ex)
+			{
+				// The call itself was rejected (argument types, target, parameter count).
+				error = ex;
+				faults.Record(MaxConsecutiveFaults);
+				return InvokeStatus.BadArguments;
+			}
+
+			try
+			{
+				if (result != null && returnPtr != IntPtr.Zero && TryGetBlittableLayout(sig.ReturnType, out var returnLayout))
+				{
+					returnLayout.Write(returnPtr, result);
+				}
+				else
+				{
+					WriteReturnValueToPointer(sig.ReturnType, result!, returnPtr);
+				}
+			}
+			catch (Exception ex)
+			{
+				error = ex;
+				faults.Record(MaxConsecutiveFaults);
+				return InvokeStatus.MarshalFailed;
+			}
+
+			faults.ConsecutiveFaults = 0;
+			return InvokeStatus.Ok;
+		}
+
+		internal bool TryGetMethodFaults(int methodId, out MethodFaults faults)
+		{
+			if (_methods.TryGetValue(methodId, out var binding))
+			{
+				faults = binding.Faults;
+				return true;
+			}
+
+			faults = null!;
+			return false;
+		}
+
+		// Opens the circuit breaker by hand, e.g. when the native watchdog caught the method running over
+		// its time budget.
+		public bool DisableMethod(int methodId)
+		{
+			if (!TryGetMethodFaults(methodId, out var faults))
+			{
+				return false;
+			}
+
+			faults.Disabled = true;
+			return true;
+		}
+
+		// Closes the method's circuit breaker again and clears its consecutive faults, e.g. once the
+		// state the script depends on was repaired. Returns false for unknown ids.
+		public bool EnableMethod(int methodId)
+		{
+			if (!TryGetMethodFaults(methodId, out var faults))
+			{
+				return false;
+			}
+
+			faults.Reset();
+			return true;
+		}
+
+		private int AddInstanceBinding(ulong instanceId, object instance, ResolvedMethod resolved)
+		{
+			int id = _nextMethodId++;
+			_methods.Add(id, new MethodBinding(instance, resolved));
+			if (!_instanceMethodIds.TryGetValue(instanceId, out var methodIds))
+			{
+				methodIds = new List<int>(4);
+				_instanceMethodIds.Add(instanceId, methodIds);
+			}
+			methodIds.Add(id);
+			return id;
+		}
+
+		private ResolvedMethod ResolveMethod(Type type, string methodName, int signatureId, bool isStatic)
+		{
+			var key = new MethodKey(type, methodName, signatureId, isStatic);
+			if (_resolvedMethods.TryGetValue(key, out var resolved))
+			{
+				return resolved;
+			}
+
+			if (!_signatures.ContainsKey(signatureId))
+			{
+				RegisterManifestSignature(signatureId);
+			}
+
+			MethodInfo method;
 			Signature sig;
 			if (_signatures.TryGetValue(signatureId, out var registeredSig))
 			{
 				sig = registeredSig;
-				method = FindMethod(type, methodName, sig.ParameterTypes, isStatic: true);
+				method = FindManifestMethod(type, methodName, signatureId, isStatic, sig) ?? FindMethod(type, methodName, sig.ParameterTypes, isStatic);
 				EnsureReturnType(method, sig.ReturnType);
 			}
 			else
 			{
-				method = FindMethodByName(type, methodName, isStatic: true);
+				method = FindMethodByName(type, methodName, isStatic);
 				sig = new Signature(method.ReturnType, method.GetParameters().Select(p => p.ParameterType).ToArray());
 			}
 
-			int id = _nextMethodId++;
-			_methods.Add(id, new MethodBinding(null!, method, sig));
-			return id;
-		}
+			resolved = new ResolvedMethod
+			{
+				Method = method,
+				Signature = sig,
+				Thunk = CreateInvokeThunk(method, sig)
+			};
+			_resolvedMethods.Add(key, resolved);
+			return resolved;
+		}
+
+		// Signatures listed in the manifest can be bound before the host registers them.
+		private void RegisterManifestSignature(int signatureId)
+		{
+			if (!_manifestSignatures.TryGetValue(signatureId, out var entry))
+			{
+				return;
+			}
+
+			_signatures[signatureId] = new Signature(
+				ResolveType(entry.ReturnType),
+				entry.ParameterTypes.Length == 0 ? Array.Empty<Type>() : entry.ParameterTypes.Select(ResolveType).ToArray());
+		}
+
+		// Resolves by metadata token instead of searching the type's methods. Only methods declared
+		// on the type itself are in the manifest; inherited ones go through FindMethod.
+		private MethodInfo? FindManifestMethod(Type type, string methodName, int signatureId, bool isStatic, Signature sig)
+		{
+			if (type.Assembly != _pluginAssembly || type.FullName == null
+				|| !_manifestMethodTokens.TryGetValue(new ManifestMethodKey(type.FullName, methodName, signatureId, isStatic), out int token))
+			{
+				return null;
+			}
+
+			try
+			{
+				if (_pluginAssembly.ManifestModule.ResolveMethod(token) is MethodInfo method
+					&& method.Name == methodName
+					&& method.GetParameters().Select(p => p.ParameterType).SequenceEqual(sig.ParameterTypes))
+				{
+					return method;
+				}
+			}
+			catch (ArgumentException)
+			{
+			}
+
+			return null;
+		}
+
+		// Returns null when the signature uses types the thunk cannot marshal (reference types, by-ref
+		// parameters); Invoke then falls back to MethodInfo.Invoke with the same conversions as before.
+		private static InvokeThunk? CreateInvokeThunk(MethodInfo method, Signature sig)
+		{
+			if (method.DeclaringType == null || (!method.IsStatic && method.DeclaringType.IsValueType))
+			{
+				return null;
+			}
+
+			foreach (var parameterType in sig.ParameterTypes)
+			{
+				if (!parameterType.IsValueType || parameterType.IsByRef)
+				{
+					return null;
+				}
+			}
+
+			if (sig.ReturnType != typeof(void) && !sig.ReturnType.IsValueType)
+			{
+				return null;
+			}
+
+			var dynamicMethod = new DynamicMethod(
+				$"MochiSharp_Invoke_{method.DeclaringType.FullName}_{method.Name}",
+				typeof(void),
+				new[] { typeof(object), typeof(IntPtr), typeof(IntPtr) },
+				restrictedSkipVisibility: true);
+
+			var getTypeFromHandle = typeof(Type).GetMethod(nameof(Type.GetTypeFromHandle))!;
+			var readValue = typeof(ScriptContext).GetMethod(nameof(ReadValueFromPointer), BindingFlags.Static | BindingFlags.NonPublic)!;
+			var writeReturnValue = typeof(ScriptContext).GetMethod(nameof(WriteReturnValueToPointer), BindingFlags.Static | BindingFlags.NonPublic)!;
 
-		public void Invoke(int methodId, IntPtr argsPtr, int argCount, IntPtr returnPtr)
-		{
-			if (!_methods.TryGetValue(methodId, out var binding))
+			ILGenerator il = dynamicMethod.GetILGenerator();
+			if (!method.IsStatic)
 			{
-				throw new KeyNotFoundException($"Method id not found: {methodId}");
+				il.Emit(OpCodes.Ldarg_0);
+				il.Emit(OpCodes.Castclass, method.DeclaringType);
 			}
 
-			var sig = binding.Signature;
-			if (argCount != sig.ParameterTypes.Length)
+			for (int i = 0; i < sig.ParameterTypes.Length; i++)
 			{
-				throw new ArgumentException($"Argument count mismatch. Expected {sig.ParameterTypes.Length}, got {argCount}");
+				Type parameterType = sig.ParameterTypes[i];
+				bool isPrimitive = parameterType == typeof(int) || parameterType == typeof(float) || parameterType == typeof(bool);
+				bool isBlittable = !isPrimitive && IsBlittable(parameterType, 0);
+				if (!isPrimitive && !isBlittable)
+				{
+					il.Emit(OpCodes.Ldtoken, parameterType);
+					il.Emit(OpCodes.Call, getTypeFromHandle);
+				}
+
+				// args[i] is a pointer to the value.
+				il.Emit(OpCodes.Ldarg_1);
+				il.Emit(OpCodes.Ldc_I4, i * IntPtr.Size);
+				il.Emit(OpCodes.Add);
+				il.Emit(OpCodes.Ldind_I);
+
+				if (parameterType == typeof(int))
+				{
+					il.Emit(OpCodes.Ldind_I4);
+				}
+				else if (parameterType == typeof(float))
+				{
+					il.Emit(OpCodes.Ldind_R4);
+				}
+				else if (parameterType == typeof(bool))
+				{
+					il.Emit(OpCodes.Ldind_I4);
+					il.Emit(OpCodes.Ldc_I4_0);
+					il.Emit(OpCodes.Cgt_Un);
+				}
+				else if (isBlittable)
+				{
+					// Native buffers carry no alignment guarantee beyond the C++ type's own.
+					il.Emit(OpCodes.Unaligned, (byte)1);
+					il.Emit(OpCodes.Ldobj, parameterType);
+				}
+				else
+				{
+					il.Emit(OpCodes.Call, readValue);
+					il.Emit(OpCodes.Unbox_Any, parameterType);
+				}
 			}
 
-			object[] args = argCount == 0 ? Array.Empty<object>() : new object[argCount];
-			for (int i = 0; i < argCount; i++)
+			il.Emit(method.IsStatic || !method.IsVirtual ? OpCodes.Call : OpCodes.Callvirt, method);
+
+			Type returnType = sig.ReturnType;
+			if (returnType != typeof(void))
 			{
-				IntPtr argValuePtr = Marshal.ReadIntPtr(argsPtr, i * IntPtr.Size);
-				args[i] = ReadValueFromPointer(sig.ParameterTypes[i], argValuePtr);
+				LocalBuilder result = il.DeclareLocal(returnType);
+				il.Emit(OpCodes.Stloc, result);
+
+				if (returnType == typeof(int) || returnType == typeof(bool))
+				{
+					il.Emit(OpCodes.Ldarg_2);
+					il.Emit(OpCodes.Ldloc, result);
+					il.Emit(OpCodes.Stind_I4);
+				}
+				else if (returnType == typeof(float))
+				{
+					il.Emit(OpCodes.Ldarg_2);
+					il.Emit(OpCodes.Ldloc, result);
+					il.Emit(OpCodes.Stind_R4);
+				}
+				else if (IsBlittable(returnType, 0))
+				{
+					il.Emit(OpCodes.Ldarg_2);
+					il.Emit(OpCodes.Ldloc, result);
+					il.Emit(OpCodes.Unaligned, (byte)1);
+					il.Emit(OpCodes.Stobj, returnType);
+				}
+				else
+				{
+					il.Emit(OpCodes.Ldtoken, returnType);
+					il.Emit(OpCodes.Call, getTypeFromHandle);
+					il.Emit(OpCodes.Ldloc, result);
+					il.Emit(OpCodes.Box, returnType);
+					il.Emit(OpCodes.Ldarg_2);
+					il.Emit(OpCodes.Call, writeReturnValue);
+				}
 			}
 
-			object? result = binding.Method.Invoke(binding.Target, args);
-			WriteReturnValueToPointer(sig.ReturnType, result!, returnPtr);
+			il.Emit(OpCodes.Ret);
+
+			return (InvokeThunk)dynamicMethod.CreateDelegate(typeof(InvokeThunk));
 		}
 
 		private static void EnsureReturnType(MethodInfo method, Type expectedReturnType)
@@ -459,7 +2461,142 @@ namespace MochiSharp.Managed.Core
 			return matches[0];
 		}
 
+		private void OnAssemblyLoad(object? sender, AssemblyLoadEventArgs args)
+		{
+			// May be raised on any thread; the game thread drops cached misses when it sees the change.
+			Interlocked.Increment(ref _assemblyLoadGeneration);
+		}
+
+		// Assemblies of other script modules are never used to resolve names: referencing them would
+		// keep those modules from unloading. Shared, framework and host assemblies stay visible.
+		private bool IsVisibleAssembly(Assembly assembly)
+		{
+			var context = AssemblyLoadContext.GetLoadContext(assembly);
+			return context is not PluginLoadContext || context == _loadContext;
+		}
+
+		private bool IsKnownMissingType(HashSet<string> missingTypeNames, string typeName)
+		{
+			int generation = Volatile.Read(ref _assemblyLoadGeneration);
+			if (generation != _missingTypeNamesGeneration)
+			{
+				_missingPluginTypeNames.Clear();
+				_missingSignatureTypeNames.Clear();
+				_missingTypeNamesGeneration = generation;
+				return false;
+			}
+
+			return missingTypeNames.Contains(typeName);
+		}
+
+		private void EnsurePluginTypeIndex()
+		{
+			if (_pluginTypeIndexBuilt)
+			{
+				return;
+			}
+
+			_pluginTypeIndexBuilt = true;
+
+			Type?[] types;
+			try
+			{
+				types = _pluginAssembly.GetTypes();
+			}
+			catch (ReflectionTypeLoadException ex)
+			{
+				types = ex.Types;
+			}
+
+			string assemblyName = _pluginAssembly.GetName().Name ?? string.Empty;
+			foreach (var type in types)
+			{
+				if (type?.FullName == null)
+				{
+					continue;
+				}
+
+				_pluginTypeIndex.TryAdd(type.FullName, type);
+				_pluginTypeIndex.TryAdd($"{type.FullName}, {assemblyName}", type);
+				if (type.AssemblyQualifiedName != null)
+				{
+					_pluginTypeIndex.TryAdd(type.AssemblyQualifiedName, type);
+				}
+			}
+		}
+
 		private Type ResolvePluginType(string typeName)
+		{
+			if (_pluginTypeIndex.TryGetValue(typeName, out var indexed))
+			{
+				return indexed;
+			}
+
+			if (TryResolveManifestType(typeName, out indexed))
+			{
+				_pluginTypeIndex[typeName] = indexed;
+				return indexed;
+			}
+
+			EnsurePluginTypeIndex();
+			if (_pluginTypeIndex.TryGetValue(typeName, out indexed))
+			{
+				return indexed;
+			}
+
+			if (IsKnownMissingType(_missingPluginTypeNames, typeName))
+			{
+				throw new TypeLoadException($"Type not found: {typeName}");
+			}
+
+			var t = ResolvePluginTypeUncached(typeName);
+			if (t == null)
+			{
+				_missingPluginTypeNames.Add(typeName);
+				throw new TypeLoadException($"Type not found: {typeName}");
+			}
+
+			_pluginTypeIndex[typeName] = t;
+			return t;
+		}
+
+		// Accepts "Full.Name" or "Full.Name, Assembly" for types defined in the plugin assembly.
+		private bool TryResolveManifestType(string typeName, out Type type)
+		{
+			type = null!;
+			if (_manifest == null)
+			{
+				return false;
+			}
+
+			string name = typeName;
+			int comma = typeName.IndexOf(',');
+			if (comma >= 0)
+			{
+				if (!string.Equals(typeName[(comma + 1)..].Trim(), _manifest.AssemblyName, StringComparison.Ordinal))
+				{
+					return false;
+				}
+				name = typeName[..comma].Trim();
+			}
+
+			if (!_manifestTypeTokens.TryGetValue(name, out int token))
+			{
+				return false;
+			}
+
+			try
+			{
+				type = _pluginAssembly.ManifestModule.ResolveType(token);
+				return type.FullName == name;
+			}
+			catch (ArgumentException)
+			{
+				return false;
+			}
+		}
+
+		private Type? ResolvePluginTypeUncached(string typeName)
 		{
 			// Prefer plugin assembly resolution so scripts stay in the collectible context.
 			var t = _pluginAssembly.GetType(typeName, throwOnError: false, ignoreCase: false);
@@ -483,7 +2620,7 @@ namespace MochiSharp.Managed.Core
 			foreach (var reference in _pluginAssembly.GetReferencedAssemblies())
 			{
 				Assembly? referencedAssembly = AppDomain.CurrentDomain.GetAssemblies()
-					.FirstOrDefault(a => string.Equals(a.GetName().Name, reference.Name, StringComparison.OrdinalIgnoreCase));
+					.FirstOrDefault(a => IsVisibleAssembly(a) && string.Equals(a.GetName().Name, reference.Name, StringComparison.OrdinalIgnoreCase));
 
 				if (referencedAssembly == null)
 				{
@@ -520,7 +2657,7 @@ namespace MochiSharp.Managed.Core
 			}
 
 			// Try all currently loaded assemblies.
-			foreach (var asm in AppDomain.CurrentDomain.GetAssemblies())
+			foreach (var asm in AppDomain.CurrentDomain.GetAssemblies().Where(IsVisibleAssembly))
 			{
 				t = asm.GetType(typeName, throwOnError: false, ignoreCase: false);
 				if (t != null)
@@ -530,23 +2667,12 @@ namespace MochiSharp.Managed.Core
 			}
 
 			// Last resort.
-			t = Type.GetType(typeName, throwOnError: false);
-			if (t != null)
-			{
-				return t;
-			}
-
-			throw new TypeLoadException($"Type not found: {typeName}");
+			return Type.GetType(typeName, throwOnError: false);
 		}
 
 		private string BuildFieldMetadataPayload(Type type)
 		{
-			if (!_typeFieldAccessorCache.TryGetValue(type, out var accessorsByName))
-			{
-				accessorsByName = BuildFieldAccessors(type);
-				_typeFieldAccessorCache[type] = accessorsByName;
-			}
-
+			var accessorsByName = GetFieldAccessors(type);
 			if (accessorsByName.Count == 0)
 			{
 				return string.Empty;
@@ -573,6 +2699,11 @@ namespace MochiSharp.Managed.Core
 		}
 
 		private bool TryGetFieldAccessor(Type type, string fieldName, out FieldAccessor accessor)
+		{
+			return GetFieldAccessors(type).TryGetValue(fieldName, out accessor!);
+		}
+
+		private Dictionary<string, FieldAccessor> GetFieldAccessors(Type type)
 		{
 			if (!_typeFieldAccessorCache.TryGetValue(type, out var accessorsByName))
 			{
@@ -580,22 +2711,29 @@ namespace MochiSharp.Managed.Core
 				_typeFieldAccessorCache[type] = accessorsByName;
 			}
 
-			return accessorsByName.TryGetValue(fieldName, out accessor!);
+			return accessorsByName;
 		}
 
 		private Dictionary<string, FieldAccessor> BuildFieldAccessors(Type type)
 		{
 			const BindingFlags flags = BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic;
-			var fields = type.GetFields(flags)
+			var fields = GetManifestFields(type) ?? type.GetFields(flags)
 				.Where(f => IsSerializableField(f))
 				.ToArray();
 
 			var result = new Dictionary<string, FieldAccessor>(StringComparer.Ordinal);
 			foreach (var field in fields)
 			{
+				if (field.FieldType.IsValueType && !field.FieldType.IsPrimitive)
+				{
+					TryGetBlittableLayout(field.FieldType, out _);
+				}
+
 				bool hasSerializeField = HasSerializeFieldAttribute(field);
 				result[field.Name] = new FieldAccessor
 				{
+					// A name seen again replaces the earlier field in place, keeping its position.
+					Index = result.TryGetValue(field.Name, out var hidden) ? hidden.Index : result.Count,
 					Field = field,
 					Getter = CreateFieldGetter(field),
 					Setter = CreateFieldSetter(field),
@@ -607,6 +2745,48 @@ namespace MochiSharp.Managed.Core
 			return result;
 		}
 
+		// Same selection and order as the reflection path (declared fields first, then inherited
+		// public ones), resolved by token. Null when some type in the hierarchy is not described
+		// by the manifest or it was generated for a different serialize-field attribute.
+		private FieldInfo[]? GetManifestFields(Type type)
+		{
+			if (_manifest == null || !string.Equals(_manifest.SerializeFieldAttributeTypeName, _serializeFieldAttributeTypeName, StringComparison.Ordinal))
+			{
+				return null;
+			}
+
+			var result = new List<FieldInfo>();
+			try
+			{
+				for (Type? current = type; current != null && current != typeof(object); current = current.BaseType)
+				{
+					if (current.Assembly != _pluginAssembly || current.FullName == null || !_manifestTypeTokens.ContainsKey(current.FullName))
+					{
+						return null;
+					}
+
+					if (!_manifestFields.TryGetValue(current.FullName, out var entries))
+					{
+						continue;
+					}
+
+					foreach (var entry in entries)
+					{
+						if (current == type || entry.IsPublic)
+						{
+							result.Add(_pluginAssembly.ManifestModule.ResolveField(entry.Token)!);
+						}
+					}
+				}
+			}
+			catch (ArgumentException)
+			{
+				return null;
+			}
+
+			return result.ToArray();
+		}
+
         private bool IsSerializableField(FieldInfo field)
 		{
 			if (field.IsStatic || field.IsLiteral || field.IsInitOnly || field.IsSpecialName)
@@ -625,13 +2805,18 @@ namespace MochiSharp.Managed.Core
 
 		private bool HasSerializeFieldAttribute(MemberInfo member)
 		{
-			if (string.IsNullOrWhiteSpace(_serializeFieldAttributeTypeName))
+			return HasAttribute(member, _serializeFieldAttributeTypeName);
+		}
+
+		private static bool HasAttribute(MemberInfo member, string attributeTypeName)
+		{
+			if (string.IsNullOrWhiteSpace(attributeTypeName))
 			{
 				return false;
 			}
 
 			return member.GetCustomAttributesData()
-			  .Any(a => string.Equals(a.AttributeType.FullName, _serializeFieldAttributeTypeName, StringComparison.Ordinal));
+			  .Any(a => string.Equals(a.AttributeType.FullName, attributeTypeName, StringComparison.Ordinal));
 		}
 
 		private static Func<object, object?> CreateFieldGetter(FieldInfo field)
@@ -769,42 +2954,40 @@ namespace MochiSharp.Managed.Core
 			if (fieldType == typeof(float))
 			{
 				if (bufferSize < sizeof(float)) return false;
-				Marshal.StructureToPtr(value is float f ? f : 0.0f, buffer, fDeleteOld: false);
+				Marshal.WriteInt32(buffer, BitConverter.SingleToInt32Bits(value is float f ? f : 0.0f));
 				return true;
 			}
 
 			if (fieldType == typeof(double))
 			{
 				if (bufferSize < sizeof(double)) return false;
-				Marshal.StructureToPtr(value is double d ? d : 0.0, buffer, fDeleteOld: false);
+				Marshal.WriteInt64(buffer, BitConverter.DoubleToInt64Bits(value is double d ? d : 0.0));
 				return true;
 			}
 
 			if (IsEntityFieldType(fieldType))
 			{
 				if (bufferSize < sizeof(ulong)) return false;
-				ulong id = 0;
-				if (value != null)
-				{
-					var idProperty = value.GetType().GetProperty("ID", BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic);
-					if (idProperty?.PropertyType == typeof(ulong))
-					{
-						id = (ulong)(idProperty.GetValue(value) ?? 0UL);
-					}
-				}
-				Marshal.WriteInt64(buffer, unchecked((long)id));
+				Marshal.WriteInt64(buffer, unchecked((long)GetEntityId(fieldType, value)));
 				return true;
 			}
 
 			if (fieldType.IsValueType)
 			{
-				int typeSize = Marshal.SizeOf(fieldType);
+				bool isBlittable = TryGetBlittableLayout(fieldType, out var layout);
+				int typeSize = isBlittable ? layout.Size : Marshal.SizeOf(fieldType);
 				if (bufferSize < typeSize)
 				{
 					return false;
 				}
 
 				object boxed = value ?? Activator.CreateInstance(fieldType)!;
+				if (isBlittable)
+				{
+					layout.Write(buffer, boxed);
+					return true;
+				}
+
 				Marshal.StructureToPtr(boxed, buffer, fDeleteOld: false);
 				return true;
 			}
@@ -909,14 +3092,14 @@ namespace MochiSharp.Managed.Core
 			if (fieldType == typeof(float))
 			{
 				if (bufferSize < sizeof(float)) return false;
-				value = Marshal.PtrToStructure<float>(buffer);
+				value = BitConverter.Int32BitsToSingle(Marshal.ReadInt32(buffer));
 				return true;
 			}
 
 			if (fieldType == typeof(double))
 			{
 				if (bufferSize < sizeof(double)) return false;
-				value = Marshal.PtrToStructure<double>(buffer);
+				value = BitConverter.Int64BitsToDouble(Marshal.ReadInt64(buffer));
 				return true;
 			}
 
@@ -930,30 +3113,20 @@ namespace MochiSharp.Managed.Core
 					return true;
 				}
 
-				var ctor = fieldType.GetConstructor(
-					BindingFlags.Instance | BindingFlags.NonPublic,
-					binder: null,
-					types: new[] { typeof(ulong) },
-					modifiers: null);
-
-				if (ctor == null)
-				{
-					return false;
-				}
-
-				value = ctor.Invoke(new object[] { id });
-				return true;
+				value = GetEntityWrapper(GetEntityMarshaller(fieldType), id);
+				return value != null;
 			}
 
 			if (fieldType.IsValueType)
 			{
-				int typeSize = Marshal.SizeOf(fieldType);
+				bool isBlittable = TryGetBlittableLayout(fieldType, out var layout);
+				int typeSize = isBlittable ? layout.Size : Marshal.SizeOf(fieldType);
 				if (bufferSize < typeSize)
 				{
 					return false;
 				}
 
-				value = Marshal.PtrToStructure(buffer, fieldType);
+				value = isBlittable ? layout.Read(buffer) : Marshal.PtrToStructure(buffer, fieldType);
 				return value != null;
 			}
 
@@ -965,6 +3138,115 @@ namespace MochiSharp.Managed.Core
           return !string.IsNullOrWhiteSpace(_entityTypeName) && string.Equals(type.FullName, _entityTypeName, StringComparison.Ordinal);
 		}
 
+		private EntityMarshaller GetEntityMarshaller(Type entityType)
+		{
+			if (!_entityMarshallers.TryGetValue(entityType, out var marshaller))
+			{
+				marshaller = new EntityMarshaller
+				{
+					GetId = CreateEntityIdGetter(entityType),
+					Create = CreateEntityConstructor(entityType)
+				};
+				_entityMarshallers[entityType] = marshaller;
+			}
+
+			return marshaller;
+		}
+
+		// The wrapper already handed out for this id while it is still alive, otherwise a new one.
+		// Null when the entity type has no (ulong) constructor.
+		private static object? GetEntityWrapper(EntityMarshaller marshaller, ulong id)
+		{
+			if (marshaller.Create == null)
+			{
+				return null;
+			}
+
+			if (marshaller.Wrappers.TryGetValue(id, out var weak) && weak.TryGetTarget(out var wrapper))
+			{
+				return wrapper;
+			}
+
+			wrapper = marshaller.Create(id);
+			if (weak != null)
+			{
+				weak.SetTarget(wrapper);
+				return wrapper;
+			}
+
+			if (marshaller.Wrappers.Count >= marshaller.PruneThreshold)
+			{
+				foreach (var entry in marshaller.Wrappers)
+				{
+					if (!entry.Value.TryGetTarget(out _))
+					{
+						marshaller.Wrappers.Remove(entry.Key);
+					}
+				}
+				marshaller.PruneThreshold = Math.Max(256, marshaller.Wrappers.Count * 2);
+			}
+
+			marshaller.Wrappers.Add(id, new WeakReference<object>(wrapper));
+			return wrapper;
+		}
+
+		private static Func<object, ulong>? CreateEntityIdGetter(Type entityType)
+		{
+			var getter = entityType.GetProperty("ID", BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic)?.GetGetMethod(nonPublic: true);
+			if (getter == null || getter.ReturnType != typeof(ulong))
+			{
+				return null;
+			}
+
+			var dynamicMethod = new DynamicMethod(
+				$"MochiSharp_EntityId_{entityType.FullName}",
+				typeof(ulong),
+				new[] { typeof(object) },
+				restrictedSkipVisibility: true);
+
+			ILGenerator il = dynamicMethod.GetILGenerator();
+			il.Emit(OpCodes.Ldarg_0);
+			if (entityType.IsValueType)
+			{
+				il.Emit(OpCodes.Unbox, entityType);
+				il.Emit(OpCodes.Call, getter);
+			}
+			else
+			{
+				il.Emit(OpCodes.Castclass, entityType);
+				il.Emit(getter.IsVirtual ? OpCodes.Callvirt : OpCodes.Call, getter);
+			}
+			il.Emit(OpCodes.Ret);
+
+			return (Func<object, ulong>)dynamicMethod.CreateDelegate(typeof(Func<object, ulong>));
+		}
+
+		private static Func<ulong, object>? CreateEntityConstructor(Type entityType)
+		{
+			var ctor = entityType.GetConstructor(BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic, binder: null, new[] { typeof(ulong) }, modifiers: null);
+			if (ctor == null || entityType.IsAbstract)
+			{
+				return null;
+			}
+
+			var dynamicMethod = new DynamicMethod(
+				$"MochiSharp_NewEntity_{entityType.FullName}",
+				typeof(object),
+				new[] { typeof(ulong) },
+				restrictedSkipVisibility: true);
+
+			ILGenerator il = dynamicMethod.GetILGenerator();
+			il.Emit(OpCodes.Ldarg_0);
+			il.Emit(OpCodes.Newobj, ctor);
+			if (entityType.IsValueType)
+			{
+				il.Emit(OpCodes.Box, entityType);
+			}
+			il.Emit(OpCodes.Ret);
+
+			return (Func<ulong, object>)dynamicMethod.CreateDelegate(typeof(Func<ulong, object>));
+		}
+
 		private Type ResolveType(string typeName)
 		{
 			if (string.IsNullOrWhiteSpace(typeName))
@@ -972,6 +3254,34 @@ namespace MochiSharp.Managed.Core
 				throw new ArgumentException("Type name required", nameof(typeName));
 			}
 
+			if (_signatureTypeIndex.TryGetValue(typeName, out var indexed))
+			{
+				return indexed;
+			}
+
+			if (IsKnownMissingType(_missingSignatureTypeNames, typeName))
+			{
+				throw new TypeLoadException($"Unable to resolve type: {typeName}");
+			}
+
+			Type resolved;
+			try
+			{
+				resolved = ResolveTypeUncached(typeName);
+			}
+			catch (TypeLoadException)
+			{
+				_missingSignatureTypeNames.Add(typeName);
+				throw;
+			}
+
+			_signatureTypeIndex[typeName] = resolved;
+			return resolved;
+		}
+
+		private Type ResolveTypeUncached(string typeName)
+		{
+
 			string n = typeName.Trim();
 			bool isByRef = false;
 			if (n.EndsWith("&", StringComparison.Ordinal))
@@ -1011,7 +3321,17 @@ namespace MochiSharp.Managed.Core
 				return typeof(bool);
 			}
 
-			Type t = null;
+			// Script-defined types come from the plugin index so they always bind to the collectible copy.
+			if (assemblyPart == null || string.Equals(assemblyPart, _pluginAssembly.GetName().Name, StringComparison.OrdinalIgnoreCase))
+			{
+				EnsurePluginTypeIndex();
+				if (_pluginTypeIndex.TryGetValue(fullName, out var pluginType))
+				{
+					return isByRef ? pluginType.MakeByRefType() : pluginType;
+				}
+			}
+
+			Type? t = null;
 
 			// Try standard resolution first.
 			t = Type.GetType(typeName.Trim(), throwOnError: false);
@@ -1023,7 +3343,7 @@ namespace MochiSharp.Managed.Core
 			if (!string.IsNullOrWhiteSpace(assemblyPart))
 			{
 				var loadedAsm = AppDomain.CurrentDomain.GetAssemblies()
-					.FirstOrDefault(a => string.Equals(a.GetName().Name, assemblyPart, StringComparison.OrdinalIgnoreCase));
+					.FirstOrDefault(a => IsVisibleAssembly(a) && string.Equals(a.GetName().Name, assemblyPart, StringComparison.OrdinalIgnoreCase));
 
 				if (loadedAsm != null)
 				{
@@ -1077,7 +3397,7 @@ namespace MochiSharp.Managed.Core
 			}
 
 			// Try AppDomain assemblies too (covers BCL and already loaded deps).
-			foreach (var asm in AppDomain.CurrentDomain.GetAssemblies())
+			foreach (var asm in AppDomain.CurrentDomain.GetAssemblies().Where(IsVisibleAssembly))
 			{
 				t = asm.GetType(fullName, throwOnError: false, ignoreCase: false);
 				if (t != null)
@@ -1098,7 +3418,7 @@ namespace MochiSharp.Managed.Core
 
 			if (type == typeof(float))
 			{
-				return Marshal.PtrToStructure<float>(ptr);
+				return BitConverter.Int32BitsToSingle(Marshal.ReadInt32(ptr));
 			}
 
 			if (type == typeof(bool))
@@ -1135,7 +3455,7 @@ namespace MochiSharp.Managed.Core
 			if (returnType == typeof(float))
 			{
 				float f = result is float ff ? ff : 0.0f;
-				Marshal.StructureToPtr(f, returnPtr, fDeleteOld: false);
+				Marshal.WriteInt32(returnPtr, BitConverter.SingleToInt32Bits(f));
 				return;
 			}
 
@@ -0,0 +1,22 @@
+using System;
+
+namespace MochiSharp.Managed.Core
+{
+	// Marks an instance method as the handler for a native event id pushed through
+	// DotNetHost::PushEvent. Supported shapes:
+	//   void OnX()
+	//   void OnX(TPayload payload)
+	//   void OnX(in TPayload payload)   // reads the payload in place, no copy
+	// TPayload must be a blittable struct laid out like the native payload.
+	// A handler declared on a derived type replaces one for the same id on a base type.
+	[AttributeUsage(AttributeTargets.Method, AllowMultiple = true, Inherited = false)]
+	public sealed class ScriptEventAttribute : Attribute
+	{
+		public int EventTypeId { get; }
+
+		public ScriptEventAttribute(int eventTypeId)
+		{
+			EventTypeId = eventTypeId;
+		}
+	}
+}
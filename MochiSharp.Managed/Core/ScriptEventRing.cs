@@ -0,0 +1,72 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace MochiSharp.Managed.Core
+{
+	// Consumer side of the native event ring (MochiSharp.Native/Source/ScriptEvents.h).
+	//
+	// Header (32 bytes): uint32 slotCount, uint32 slotSize, uint64 writeIndex, uint64 readIndex,
+	// uint64 droppedCount. Each slot starts with int32 eventTypeId, uint32 payloadSize,
+	// uint64 targetInstanceId, followed by the payload. Native code is the only writer of
+	// writeIndex, this class the only writer of readIndex.
+	internal sealed class ScriptEventRing
+	{
+		private const int HeaderSize = 32;
+		private const int RecordHeaderSize = 16;
+		private const int WriteIndexOffset = 8;
+		private const int ReadIndexOffset = 16;
+
+		private readonly IntPtr _buffer;
+		private readonly IntPtr _slots;
+		private readonly uint _slotCount;
+		private readonly int _slotSize;
+
+		public ScriptEventRing(IntPtr buffer, int bufferSize)
+		{
+			if (buffer == IntPtr.Zero || bufferSize < HeaderSize)
+			{
+				throw new ArgumentException("Event ring buffer is too small", nameof(bufferSize));
+			}
+
+			uint slotCount = unchecked((uint)Marshal.ReadInt32(buffer, 0));
+			int slotSize = Marshal.ReadInt32(buffer, 4);
+			if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0 || slotSize < RecordHeaderSize
+				|| HeaderSize + (long)slotCount * slotSize > bufferSize)
+			{
+				throw new ArgumentException("Event ring header does not describe the buffer", nameof(buffer));
+			}
+
+			_buffer = buffer;
+			_slots = buffer + HeaderSize;
+			_slotCount = slotCount;
+			_slotSize = slotSize;
+		}
+
+		// Dispatches the records that were complete when the call started; events pushed by the
+		// handlers themselves wait for the next call. Returns the number of handler calls.
+		public int Drain(ScriptModuleRegistry modules, Action<Exception> onError)
+		{
+			ulong read = unchecked((ulong)Marshal.ReadInt64(_buffer, ReadIndexOffset));
+			ulong write = unchecked((ulong)Marshal.ReadInt64(_buffer, WriteIndexOffset));
+			// Acquire: record contents must not be read before the write index that publishes them.
+			Interlocked.MemoryBarrier();
+
+			int handled = 0;
+			for (; read != write; read++)
+			{
+				IntPtr record = _slots + (int)(read & (_slotCount - 1)) * _slotSize;
+				int eventTypeId = Marshal.ReadInt32(record, 0);
+				int payloadSize = Math.Min(Marshal.ReadInt32(record, 4), _slotSize - RecordHeaderSize);
+				ulong targetInstanceId = unchecked((ulong)Marshal.ReadInt64(record, 8));
+
+				handled += modules.DispatchEvent(eventTypeId, targetInstanceId, record + RecordHeaderSize, payloadSize, onError);
+			}
+
+			// Release: the slots may be reused by native code only after they were consumed.
+			Interlocked.MemoryBarrier();
+			Marshal.WriteInt64(_buffer, ReadIndexOffset, unchecked((long)read));
+			return handled;
+		}
+	}
+}
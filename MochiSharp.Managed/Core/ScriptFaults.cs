@@ -0,0 +1,72 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Core
+{
+	// Result of Bootstrap.Invoke, mirrored by MochiSharp::InvokeStatus in Host.h. Success keeps the
+	// old value 1 and "the script threw" the old 0; every other failure is negative.
+	public enum InvokeStatus
+	{
+		Ok = 1,
+		ScriptException = 0,
+		// The method's circuit breaker is open: the call was skipped, nothing was written.
+		Disabled = -1,
+		UnknownMethod = -2,
+		BadArguments = -3,
+		MarshalFailed = -4,
+		InternalError = -5
+	}
+
+	// Native view of a method's fault state (MochiSharp::InvokeFaultInfo), 24 bytes.
+	[StructLayout(LayoutKind.Sequential)]
+	internal struct InvokeFaultInfo
+	{
+		public int MethodId;
+		public int Status;
+		public int ConsecutiveFaults;
+		public int Disabled;
+		public long TotalFaults;
+	}
+
+	// Fault counters of one method binding. A method whose consecutive faults reach the module's
+	// limit is disabled: further calls return InvokeStatus.Disabled without running script code,
+	// until it is re-enabled. A successful call resets the consecutive count.
+	internal sealed class MethodFaults
+	{
+		public int ConsecutiveFaults;
+		public long TotalFaults;
+		public bool Disabled;
+
+		// Returns true when this fault tripped the breaker.
+		public bool Record(int maxConsecutiveFaults)
+		{
+			ConsecutiveFaults++;
+			TotalFaults++;
+			if (!Disabled && maxConsecutiveFaults > 0 && ConsecutiveFaults >= maxConsecutiveFaults)
+			{
+				Disabled = true;
+				return true;
+			}
+
+			return false;
+		}
+
+		public void Reset()
+		{
+			ConsecutiveFaults = 0;
+			Disabled = false;
+		}
+
+		public InvokeFaultInfo ToInfo(int methodId, InvokeStatus status)
+		{
+			return new InvokeFaultInfo
+			{
+				MethodId = methodId,
+				Status = (int)status,
+				ConsecutiveFaults = ConsecutiveFaults,
+				Disabled = Disabled ? 1 : 0,
+				TotalFaults = TotalFaults
+			};
+		}
+	}
+}
@@ -0,0 +1,161 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Text;
+
+namespace MochiSharp.Managed.Core
+{
+	// Build-time description of a script assembly, written by MochiSharp.HeaderGen next to the
+	// assembly (<name>.mochimanifest). When present and matching the assembly's MVID, ScriptContext
+	// uses it to resolve types, methods and fields by metadata token instead of reflection searches.
+	//
+	// Text format, one tab-separated record per line:
+	//   mochisharp-manifest  <version>
+	//   assembly   <name> <mvid> <serialize-field attribute or ->
+	//   type       <token> <full name> <concrete 0|1> <ancestors;...>
+	//   struct     <full name> <size> <alignment> <field:offset;...>
+	//   signature  <id> <return type> <parameter types;...>
+	//   method     <type> <name> <signature id> <token> <static 0|1>
+	//   field      <type> <name> <token> <handle> <public 0|1> <serialize-field 0|1> <field type>
+	public sealed class ScriptManifest
+	{
+		public const int FormatVersion = 1;
+		public const string FileExtension = ".mochimanifest";
+		private const string Header = "mochisharp-manifest";
+
+		public sealed record TypeEntry(int Token, string FullName, bool IsConcreteClass, string[] Ancestors);
+		public sealed record StructEntry(string FullName, int Size, int Alignment, (string Name, int Offset)[] Fields);
+		public sealed record SignatureEntry(int Id, string ReturnType, string[] ParameterTypes);
+		public sealed record MethodEntry(string TypeName, string Name, int SignatureId, int Token, bool IsStatic);
+		public sealed record FieldEntry(string TypeName, string Name, int Token, int Handle, bool IsPublic, bool HasSerializeFieldAttribute, string FieldTypeName);
+
+		public string AssemblyName = string.Empty;
+		public Guid Mvid;
+		public string SerializeFieldAttributeTypeName = string.Empty;
+		public readonly List<TypeEntry> Types = new();
+		public readonly List<StructEntry> Structs = new();
+		public readonly List<SignatureEntry> Signatures = new();
+		public readonly List<MethodEntry> Methods = new();
+		public readonly List<FieldEntry> Fields = new();
+
+		public static string GetDefaultPath(string assemblyPath)
+		{
+			return Path.ChangeExtension(assemblyPath, FileExtension);
+		}
+
+		public void Write(string path)
+		{
+			var builder = new StringBuilder();
+			AppendLine(builder, Header, FormatVersion.ToString(CultureInfo.InvariantCulture));
+			AppendLine(builder, "assembly", AssemblyName, Mvid.ToString("D"), OrDash(SerializeFieldAttributeTypeName));
+
+			foreach (var t in Types)
+			{
+				AppendLine(builder, "type", FormatToken(t.Token), t.FullName, FormatBool(t.IsConcreteClass), string.Join(';', t.Ancestors));
+			}
+
+			foreach (var s in Structs)
+			{
+				var fields = new string[s.Fields.Length];
+				for (int i = 0; i < fields.Length; i++)
+				{
+					fields[i] = $"{s.Fields[i].Name}:{s.Fields[i].Offset.ToString(CultureInfo.InvariantCulture)}";
+				}
+				AppendLine(builder, "struct", s.FullName, s.Size.ToString(CultureInfo.InvariantCulture), s.Alignment.ToString(CultureInfo.InvariantCulture), string.Join(';', fields));
+			}
+
+			foreach (var s in Signatures)
+			{
+				AppendLine(builder, "signature", s.Id.ToString(CultureInfo.InvariantCulture), s.ReturnType, string.Join(';', s.ParameterTypes));
+			}
+
+			foreach (var m in Methods)
+			{
+				AppendLine(builder, "method", m.TypeName, m.Name, m.SignatureId.ToString(CultureInfo.InvariantCulture), FormatToken(m.Token), FormatBool(m.IsStatic));
+			}
+
+			foreach (var f in Fields)
+			{
+				AppendLine(builder, "field", f.TypeName, f.Name, FormatToken(f.Token), f.Handle.ToString(CultureInfo.InvariantCulture), FormatBool(f.IsPublic), FormatBool(f.HasSerializeFieldAttribute), f.FieldTypeName);
+			}
+
+			File.WriteAllText(path, builder.ToString(), new UTF8Encoding(encoderShouldEmitUTF8Identifier: false));
+		}
+
+		public static ScriptManifest Read(string path)
+		{
+			var manifest = new ScriptManifest();
+			bool sawHeader = false;
+			foreach (var line in File.ReadLines(path, Encoding.UTF8))
+			{
+				if (line.Length == 0)
+				{
+					continue;
+				}
+
+				string[] p = line.Split('\t');
+				switch (p[0])
+				{
+					case Header:
+						int version = int.Parse(p[1], CultureInfo.InvariantCulture);
+						if (version != FormatVersion)
+						{
+							throw new InvalidDataException($"Unsupported manifest version {version} in {path}");
+						}
+						sawHeader = true;
+						break;
+					case "assembly":
+						manifest.AssemblyName = p[1];
+						manifest.Mvid = Guid.Parse(p[2]);
+						manifest.SerializeFieldAttributeTypeName = p[3] == "-" ? string.Empty : p[3];
+						break;
+					case "type":
+						manifest.Types.Add(new TypeEntry(ParseToken(p[1]), p[2], p[3] == "1", SplitList(p[4])));
+						break;
+					case "struct":
+						var names = SplitList(p[4]);
+						var fields = new (string, int)[names.Length];
+						for (int i = 0; i < names.Length; i++)
+						{
+							int colon = names[i].LastIndexOf(':');
+							fields[i] = (names[i][..colon], int.Parse(names[i][(colon + 1)..], CultureInfo.InvariantCulture));
+						}
+						manifest.Structs.Add(new StructEntry(p[1], int.Parse(p[2], CultureInfo.InvariantCulture), int.Parse(p[3], CultureInfo.InvariantCulture), fields));
+						break;
+					case "signature":
+						manifest.Signatures.Add(new SignatureEntry(int.Parse(p[1], CultureInfo.InvariantCulture), p[2], SplitList(p[3])));
+						break;
+					case "method":
+						manifest.Methods.Add(new MethodEntry(p[1], p[2], int.Parse(p[3], CultureInfo.InvariantCulture), ParseToken(p[4]), p[5] == "1"));
+						break;
+					case "field":
+						manifest.Fields.Add(new FieldEntry(p[1], p[2], ParseToken(p[3]), int.Parse(p[4], CultureInfo.InvariantCulture), p[5] == "1", p[6] == "1", p[7]));
+						break;
+					default:
+						// Unknown records are skipped so newer tools can add data without breaking older runtimes.
+						break;
+				}
+			}
+
+			if (!sawHeader)
+			{
+				throw new InvalidDataException($"Not a MochiSharp manifest: {path}");
+			}
+
+			return manifest;
+		}
+
+		private static void AppendLine(StringBuilder builder, params string[] parts)
+		{
+			builder.AppendJoin('\t', parts);
+			builder.Append('\n');
+		}
+
+		private static string OrDash(string value) => string.IsNullOrEmpty(value) ? "-" : value;
+		private static string FormatBool(bool value) => value ? "1" : "0";
+		private static string FormatToken(int token) => token.ToString("X8", CultureInfo.InvariantCulture);
+		private static int ParseToken(string token) => int.Parse(token, NumberStyles.HexNumber, CultureInfo.InvariantCulture);
+		private static string[] SplitList(string value) => value.Length == 0 ? Array.Empty<string>() : value.Split(';');
+	}
+}
@@ -0,0 +1,583 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Core
+{
+	// The set of script modules loaded side by side, each one a ScriptContext with its own collectible
+	// load context, instances, bindings and caches. A module is identified by a small handle that is
+	// stable across reloads of that module. Calls are routed by method id (the handle is encoded in its
+	// top bits), by instance id (owner map) or by type name (the module that declares the type).
+	internal sealed class ScriptModuleRegistry
+	{
+		public const int MaxModules = (1 << (31 - ScriptContext.MethodIdModuleShift)) - 1;
+
+		private sealed class SignatureRegistration
+		{
+			public required string ReturnTypeName;
+			public required string[] ParameterTypeNames;
+			public int[]? NativeSizes;
+			public int[]? NativeAlignments;
+		}
+
+		private readonly ScriptContext?[] _modules = new ScriptContext?[MaxModules + 1];
+		private readonly List<ScriptContext> _loaded = new();
+		private readonly Dictionary<ulong, ScriptContext> _instanceOwners = new();
+		private readonly List<ulong> _releasedInstanceIds = new();
+
+		// Every module sees every signature: they are replayed when a module is loaded or reloaded, so
+		// native callers register each signature once for the lifetime of the host.
+		private readonly Dictionary<int, SignatureRegistration> _signatures = new();
+
+		private string _serializeFieldAttributeTypeName = string.Empty;
+		private string _entityTypeName = string.Empty;
+		private int _maxConsecutiveFaults;
+
+		private string _replicatedAttributeTypeName = typeof(ReplicatedAttribute).FullName!;
+		private ulong[] _snapshotIds = Array.Empty<ulong>();
+
+		// Types with field change tracking, re-enabled in the module that declares them after a reload.
+		private readonly HashSet<string> _trackedTypeNames = new(StringComparer.Ordinal);
+
+		// Last failed Invoke. The exception is only turned into text when the host asks for it, or when
+		// its module is unloaded (the exception would otherwise keep the module's context alive).
+		private int _lastErrorMethodId;
+		private InvokeStatus _lastErrorStatus = InvokeStatus.Ok;
+		private Exception? _lastError;
+		private string? _lastErrorMessage;
+
+		private readonly ScriptUnloadTracker _unloadTracker = new();
+
+		public IReadOnlyList<ScriptContext> Modules => _loaded;
+
+		// Loads the assembly as a new module, or reloads the module that already has this path if its
+		// content changed. Returns the module handle.
+		public int Load(string assemblyPath, Action<string>? log)
+		{
+			int handle = LoadCore(assemblyPath, log, out var unloaded);
+			VerifyUnload(unloaded, log);
+			return handle;
+		}
+
+		// The public entry points below do their work in a non-inlined *Core method and verify the
+		// unload afterwards, once no frame holds the old ScriptContext any more.
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private int LoadCore(string assemblyPath, Action<string>? log, out PendingUnload? unloaded)
+		{
+			unloaded = null;
+			string fullPath = Path.GetFullPath(assemblyPath);
+			foreach (var module in _loaded)
+			{
+				if (string.Equals(module.PluginPath, fullPath, StringComparison.OrdinalIgnoreCase))
+				{
+					// Same bytes as loaded: keep the module, its instances and its method ids.
+					int existing = module.ModuleHandle;
+					if (module.IsContentUnchanged())
+					{
+						log?.Invoke($"Module {existing} is unchanged, not reloaded: {fullPath}");
+						return existing;
+					}
+
+					unloaded = ReloadCore(existing, log);
+					return existing;
+				}
+			}
+
+			int handle = AllocateHandle();
+			Install(Create(handle, fullPath, null, null, log));
+			return handle;
+		}
+
+		// Loads a module from an image the host already holds in memory. modulePath names the module
+		// (and locates private dependencies); loading the same name again replaces that module unless
+		// the image is identical.
+		public int LoadFromMemory(string modulePath, byte[] image, byte[]? symbols, Action<string>? log)
+		{
+			int handle = LoadFromMemoryCore(modulePath, image, symbols, log, out var unloaded);
+			VerifyUnload(unloaded, log);
+			return handle;
+		}
+
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private int LoadFromMemoryCore(string modulePath, byte[] image, byte[]? symbols, Action<string>? log, out PendingUnload? unloaded)
+		{
+			unloaded = null;
+			string fullPath = Path.GetFullPath(modulePath);
+			var existing = FindByPath(fullPath);
+			if (existing != null)
+			{
+				int existingHandle = existing.ModuleHandle;
+				if (existing.IsContentUnchanged(image))
+				{
+					log?.Invoke($"Module {existingHandle} is unchanged, not reloaded: {fullPath}");
+					return existingHandle;
+				}
+
+				var replacement = Create(existingHandle, fullPath, image, symbols, log);
+				unloaded = Detach(existing, log);
+				Install(replacement);
+				return existingHandle;
+			}
+
+			int handle = AllocateHandle();
+			Install(Create(handle, fullPath, image, symbols, log));
+			return handle;
+		}
+
+		// Replaces the module's context with a fresh one loaded from the same path. Instances and
+		// bindings of this module are dropped; other modules are not touched. The new copy is loaded
+		// before the old one is unloaded, so a failed load (e.g. a broken build) keeps the module running.
+		public void Reload(int handle, Action<string>? log)
+		{
+			VerifyUnload(ReloadCore(handle, log), log);
+		}
+
+		public void Unload(int handle, Action<string>? log)
+		{
+			VerifyUnload(UnloadCore(handle, log), log);
+		}
+
+		// Collections run after each unload before the module's report is logged (default 8; 0 skips
+		// them). With diagnostics, a context that survives is searched for what keeps it alive.
+		public void ConfigureUnloadTracking(int maxCollections, bool diagnostics)
+		{
+			_unloadTracker.Configure(maxCollections, diagnostics);
+		}
+
+		public bool TryGetUnloadReport(int handle, out ScriptUnloadReport report, out string roots)
+		{
+			return _unloadTracker.TryGetReport(handle, out report, out roots);
+		}
+
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private PendingUnload ReloadCore(int handle, Action<string>? log)
+		{
+			var module = GetModule(handle);
+			if (module.IsInMemory)
+			{
+				throw new InvalidOperationException($"Module {handle} was loaded from memory; load a new image with LoadAssemblyFromMemory instead");
+			}
+
+			var replacement = Create(handle, module.PluginPath, null, null, log);
+			var unloaded = Detach(module, log);
+			Install(replacement);
+			return unloaded;
+		}
+
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		private PendingUnload UnloadCore(int handle, Action<string>? log)
+		{
+			return Detach(GetModule(handle), log);
+		}
+
+		private void VerifyUnload(PendingUnload? unloaded, Action<string>? log)
+		{
+			if (unloaded.HasValue)
+			{
+				_unloadTracker.Verify(unloaded.Value, log);
+			}
+		}
+
+		public ScriptContext GetModule(int handle)
+		{
+			var module = handle > 0 && handle < _modules.Length ? _modules[handle] : null;
+			return module ?? throw new ArgumentException($"No script module with handle {handle}", nameof(handle));
+		}
+
+		public ScriptContext? FindByPath(string assemblyPath)
+		{
+			string fullPath = Path.GetFullPath(assemblyPath);
+			return _loaded.Find(module => string.Equals(module.PluginPath, fullPath, StringComparison.OrdinalIgnoreCase));
+		}
+
+		public ScriptContext GetByMethodId(int methodId)
+		{
+			int handle = methodId >> ScriptContext.MethodIdModuleShift;
+			var module = handle > 0 && handle < _modules.Length ? _modules[handle] : null;
+			return module ?? throw new InvalidOperationException($"Unknown method id {methodId}");
+		}
+
+		// Non-throwing lookup for the Invoke hot path.
+		public ScriptContext? FindByMethodId(int methodId)
+		{
+			int handle = methodId >> ScriptContext.MethodIdModuleShift;
+			return handle > 0 && handle < _modules.Length ? _modules[handle] : null;
+		}
+
+		public void RecordInvokeError(int methodId, InvokeStatus status, Exception? error)
+		{
+			_lastErrorMethodId = methodId;
+			_lastErrorStatus = status;
+			_lastError = error;
+			_lastErrorMessage = null;
+		}
+
+		// False until some Invoke has failed.
+		public bool TryGetLastInvokeError(out int methodId, out InvokeStatus status, out string message)
+		{
+			methodId = _lastErrorMethodId;
+			status = _lastErrorStatus;
+			message = _lastErrorMessage ?? _lastError?.ToString() ?? status.ToString();
+			return status != InvokeStatus.Ok;
+		}
+
+		public ScriptContext GetByInstance(ulong instanceId)
+		{
+			if (_instanceOwners.TryGetValue(instanceId, out var owner))
+			{
+				return owner;
+			}
+
+			throw new InvalidOperationException($"Unknown instance id {instanceId}");
+		}
+
+		// The module whose assembly declares the type. Names that no module declares (shared or
+		// framework types) go to the only module, or to the first one that can resolve them.
+		public ScriptContext GetByTypeName(string typeName)
+		{
+			if (_loaded.Count == 0)
+			{
+				throw new InvalidOperationException("No ScriptContext loaded. Call LoadAssembly first.");
+			}
+
+			foreach (var module in _loaded)
+			{
+				if (module.DefinesType(typeName))
+				{
+					return module;
+				}
+			}
+
+			return _loaded[0];
+		}
+
+		public void ConfigureSerializationTypeNames(string serializeFieldAttributeTypeName, string entityTypeName)
+		{
+			_serializeFieldAttributeTypeName = serializeFieldAttributeTypeName;
+			_entityTypeName = entityTypeName;
+			foreach (var module in _loaded)
+			{
+				module.ConfigureSerializationTypeNames(serializeFieldAttributeTypeName, entityTypeName);
+			}
+		}
+
+		// Applies to every module, including ones loaded later.
+		public void ConfigureReplication(string replicatedAttributeTypeName)
+		{
+			_replicatedAttributeTypeName = replicatedAttributeTypeName;
+			foreach (var module in _loaded)
+			{
+				module.ConfigureReplication(replicatedAttributeTypeName);
+			}
+		}
+
+		// Replicated fields of the instances of every module, see ScriptSnapshot.
+		public int CaptureSnapshot(IntPtr buffer, int bufferSize)
+		{
+			return ScriptSnapshot.Capture(_instanceOwners, ref _snapshotIds, buffer, bufferSize);
+		}
+
+		public int ApplySnapshot(IntPtr snapshot, int snapshotSize, IntPtr previous, int previousSize)
+		{
+			return ScriptSnapshot.Apply(_instanceOwners, snapshot, snapshotSize, previous, previousSize);
+		}
+
+		// Applies to every module, including ones loaded later. 0 disables the circuit breaker.
+		public void ConfigureFaultPolicy(int maxConsecutiveFaults)
+		{
+			ArgumentOutOfRangeException.ThrowIfNegative(maxConsecutiveFaults);
+			_maxConsecutiveFaults = maxConsecutiveFaults;
+			foreach (var module in _loaded)
+			{
+				module.MaxConsecutiveFaults = maxConsecutiveFaults;
+			}
+		}
+
+		// Registers the signature with every module that can resolve its types. Fails (with the first
+		// module's error) only when none can, e.g. a struct no loaded module or shared assembly defines.
+		public void RegisterSignature(int signatureId, string returnTypeName, string[] parameterTypeNames, int[]? nativeSizes, int[]? nativeAlignments)
+		{
+			if (_loaded.Count == 0)
+			{
+				throw new InvalidOperationException("No ScriptContext loaded. Call LoadAssembly first.");
+			}
+
+			Exception? firstError = null;
+			bool registered = false;
+			foreach (var module in _loaded)
+			{
+				try
+				{
+					module.RegisterSignature(signatureId, returnTypeName, parameterTypeNames, nativeSizes, nativeAlignments);
+					registered = true;
+				}
+				catch (Exception ex) when (ex is TypeLoadException or InvalidOperationException or ArgumentException)
+				{
+					// A layout mismatch says more than "type not found in this module".
+					if (firstError == null || (firstError is TypeLoadException && ex is not TypeLoadException))
+					{
+						firstError = ex;
+					}
+				}
+			}
+
+			if (!registered)
+			{
+				throw firstError!;
+			}
+
+			_signatures[signatureId] = new SignatureRegistration
+			{
+				ReturnTypeName = returnTypeName,
+				ParameterTypeNames = parameterTypeNames,
+				NativeSizes = nativeSizes,
+				NativeAlignments = nativeAlignments
+			};
+		}
+
+		// From the first module that resolved the signature.
+		public int[]? GetSignatureLayout(int signatureId)
+		{
+			foreach (var module in _loaded)
+			{
+				var sizes = module.GetSignatureLayout(signatureId);
+				if (sizes != null)
+				{
+					return sizes;
+				}
+			}
+
+			return null;
+		}
+
+		// Returns the number of tracked fields of the type (0 when disabled).
+		public int ConfigureFieldTracking(string typeName, bool enabled)
+		{
+			int fields = GetByTypeName(typeName).ConfigureFieldTracking(typeName, enabled);
+			if (enabled)
+			{
+				_trackedTypeNames.Add(typeName);
+			}
+			else
+			{
+				_trackedTypeNames.Remove(typeName);
+			}
+
+			return fields;
+		}
+
+		// Field changes of every module, in load order. Returns the number of records written.
+		public int CollectDirtyFields(IntPtr buffer, int bufferSize, out int bytesWritten)
+		{
+			var writer = new FieldChangeWriter(buffer, bufferSize);
+			for (int i = 0; i < _loaded.Count; i++)
+			{
+				_loaded[i].CollectDirtyFields(ref writer);
+			}
+
+			bytesWritten = writer.Offset;
+			return writer.Count;
+		}
+
+		public bool CreateInstance(ulong instanceId, string typeName)
+		{
+			var module = GetByTypeName(typeName);
+			EnsureInstanceIdAvailable(instanceId, module);
+
+			bool created = module.CreateInstance(instanceId, typeName);
+			_instanceOwners[instanceId] = module;
+			return created;
+		}
+
+		public int CreateInstances(string typeName, IntPtr instanceIds, int count, IntPtr resultBitmap, Action<Exception>? onError)
+		{
+			var module = GetByTypeName(typeName);
+			for (int i = 0; i < count; i++)
+			{
+				EnsureInstanceIdAvailable(ReadInstanceId(instanceIds, i), module);
+			}
+
+			int succeeded = module.CreateInstances(typeName, instanceIds, count, resultBitmap, onError);
+			for (int i = 0; i < count; i++)
+			{
+				if ((Marshal.ReadByte(resultBitmap, i >> 3) & (1 << (i & 7))) != 0)
+				{
+					_instanceOwners[ReadInstanceId(instanceIds, i)] = module;
+				}
+			}
+
+			return succeeded;
+		}
+
+		public void ConfigureInstancePool(string typeName, int capacity, Action<Exception>? onError)
+		{
+			GetByTypeName(typeName).ConfigureInstancePool(typeName, capacity, onError);
+		}
+
+		public void DestroyInstance(ulong instanceId)
+		{
+			if (_instanceOwners.Remove(instanceId, out var owner))
+			{
+				owner.DestroyInstance(instanceId);
+			}
+		}
+
+		// Each module detaches the ids it owns and ignores the others; the disposal budget is shared
+		// by all modules in load order. An id stays owned until its module has detached it, so a module
+		// that fails leaves its instances reachable. Returns the number of instances still pending disposal.
+		public int DestroyInstances(IntPtr instanceIds, int count, double budgetMilliseconds, Action<Exception>? onError)
+		{
+			ArgumentOutOfRangeException.ThrowIfNegative(count);
+			long start = Stopwatch.GetTimestamp();
+			int pending = 0;
+			foreach (var module in _loaded)
+			{
+				double remaining = budgetMilliseconds;
+				if (budgetMilliseconds > 0.0)
+				{
+					// Keep a positive budget so every module detaches its ids even when time is up.
+					remaining = Math.Max(budgetMilliseconds - Stopwatch.GetElapsedTime(start).TotalMilliseconds, double.Epsilon);
+				}
+
+				pending += module.DestroyInstances(instanceIds, count, remaining, onError);
+				for (int i = 0; i < count; i++)
+				{
+					ulong instanceId = ReadInstanceId(instanceIds, i);
+					if (_instanceOwners.TryGetValue(instanceId, out var owner) && owner == module)
+					{
+						_instanceOwners.Remove(instanceId);
+					}
+				}
+			}
+
+			return pending;
+		}
+
+		public int DispatchEvent(int eventTypeId, ulong targetInstanceId, IntPtr payload, int payloadSize, Action<Exception> onError)
+		{
+			if (targetInstanceId != 0)
+			{
+				return _instanceOwners.TryGetValue(targetInstanceId, out var owner)
+					? owner.DispatchEvent(eventTypeId, targetInstanceId, payload, payloadSize, onError)
+					: 0;
+			}
+
+			int handled = 0;
+			for (int i = 0; i < _loaded.Count; i++)
+			{
+				handled += _loaded[i].DispatchEvent(eventTypeId, 0, payload, payloadSize, onError);
+			}
+
+			return handled;
+		}
+
+		private void EnsureInstanceIdAvailable(ulong instanceId, ScriptContext module)
+		{
+			if (_instanceOwners.TryGetValue(instanceId, out var owner) && owner != module)
+			{
+				throw new InvalidOperationException($"Instance id {instanceId} is already used by module {owner.ModuleHandle} ({Path.GetFileName(owner.PluginPath)})");
+			}
+		}
+
+		private int AllocateHandle()
+		{
+			int handle = Array.IndexOf(_modules, null, 1);
+			if (handle < 0)
+			{
+				throw new InvalidOperationException($"Too many script modules loaded (max {MaxModules})");
+			}
+
+			return handle;
+		}
+
+		private ScriptContext Create(int handle, string path, byte[]? image, byte[]? symbols, Action<string>? log)
+		{
+			var module = new ScriptContext(path, image, symbols, handle);
+			module.ConfigureSerializationTypeNames(_serializeFieldAttributeTypeName, _entityTypeName);
+			module.ConfigureReplication(_replicatedAttributeTypeName);
+			module.MaxConsecutiveFaults = _maxConsecutiveFaults;
+
+			// Signatures whose types belong to another module do not resolve here; that is expected.
+			foreach (var (signatureId, signature) in _signatures)
+			{
+				try
+				{
+					module.RegisterSignature(signatureId, signature.ReturnTypeName, signature.ParameterTypeNames, signature.NativeSizes, signature.NativeAlignments);
+				}
+				catch (Exception ex) when (ex is TypeLoadException)
+				{
+				}
+				catch (Exception ex) when (ex is InvalidOperationException or ArgumentException)
+				{
+					log?.Invoke($"Module {handle}: signature {signatureId} not registered: {ex.Message}");
+				}
+			}
+
+			foreach (string typeName in _trackedTypeNames)
+			{
+				if (!module.DefinesType(typeName))
+				{
+					continue;
+				}
+
+				try
+				{
+					module.ConfigureFieldTracking(typeName, true);
+				}
+				catch (Exception ex) when (ex is TypeLoadException or InvalidOperationException or ArgumentException)
+				{
+					log?.Invoke($"Module {handle}: field tracking for {typeName} not enabled: {ex.Message}");
+				}
+			}
+
+			return module;
+		}
+
+		private void Install(ScriptContext module)
+		{
+			_modules[module.ModuleHandle] = module;
+			_loaded.Add(module);
+		}
+
+		private PendingUnload Detach(ScriptContext module, Action<string>? log)
+		{
+			long heapBytes = GC.GetTotalMemory(false);
+			long start = Stopwatch.GetTimestamp();
+
+			_modules[module.ModuleHandle] = null;
+			_loaded.Remove(module);
+
+			_releasedInstanceIds.Clear();
+			foreach (var (instanceId, owner) in _instanceOwners)
+			{
+				if (owner == module)
+				{
+					_releasedInstanceIds.Add(instanceId);
+				}
+			}
+
+			foreach (ulong instanceId in _releasedInstanceIds)
+			{
+				_instanceOwners.Remove(instanceId);
+			}
+			_releasedInstanceIds.Clear();
+
+			if (_lastError != null && _lastErrorMethodId >> ScriptContext.MethodIdModuleShift == module.ModuleHandle)
+			{
+				_lastErrorMessage = _lastError.ToString();
+				_lastError = null;
+			}
+
+			var context = module.Unload(ex => log?.Invoke($"Module {module.ModuleHandle}: disposing an instance failed: {ex.GetType().FullName}: {ex.Message}"));
+			return new PendingUnload(module.ModuleHandle, module.PluginPath, context, heapBytes, start);
+		}
+
+		private static ulong ReadInstanceId(IntPtr instanceIds, int index)
+		{
+			return unchecked((ulong)Marshal.ReadInt64(instanceIds, index * sizeof(ulong)));
+		}
+	}
+}
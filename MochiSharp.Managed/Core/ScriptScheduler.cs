@@ -0,0 +1,469 @@
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.CompilerServices;
+using System.Runtime.Loader;
+using System.Threading;
+
+namespace MochiSharp.Managed.Core
+{
+	// Yield instruction for coroutines: resumes after the given number of scheduler seconds.
+	// Instances are immutable and can be cached and yielded repeatedly.
+	public sealed class WaitForSeconds
+	{
+		public double Seconds { get; }
+
+		public WaitForSeconds(double seconds)
+		{
+			Seconds = seconds;
+		}
+	}
+
+	public readonly record struct CoroutineHandle(int Id)
+	{
+		public bool IsValid => Id != 0;
+	}
+
+	// Frame-driven scheduler for script code, pumped once per frame by DotNetHost::TickScheduler.
+	//
+	// Coroutines:  ScriptScheduler.StartCoroutine(Routine(), this);
+	//              IEnumerator Routine() { yield return null; yield return wait; yield return Other(); }
+	// Async:       await ScriptScheduler.NextFrame();  await ScriptScheduler.Seconds(0.5);
+	//
+	// Everything resumes on the game thread. While scripts run on that thread the current
+	// SynchronizationContext posts back into this scheduler, so continuations of other awaits
+	// (Task.Delay, I/O) also come back to the game thread instead of the thread pool.
+	// Continuations and coroutines live in reusable lists, queues and a timer heap, so a steady
+	// state of waiting scripts allocates nothing per frame.
+	public static class ScriptScheduler
+	{
+		public readonly struct NextFrameAwaitable
+		{
+			public Awaiter GetAwaiter() => default;
+
+			public readonly struct Awaiter : ICriticalNotifyCompletion
+			{
+				public bool IsCompleted => false;
+				public void GetResult() { }
+				public void OnCompleted(Action continuation) => EnqueueNextFrame(continuation);
+				public void UnsafeOnCompleted(Action continuation) => EnqueueNextFrame(continuation);
+			}
+		}
+
+		public readonly struct SecondsAwaitable
+		{
+			private readonly double _seconds;
+
+			internal SecondsAwaitable(double seconds)
+			{
+				_seconds = seconds;
+			}
+
+			public Awaiter GetAwaiter() => new(_seconds);
+
+			public readonly struct Awaiter : ICriticalNotifyCompletion
+			{
+				private readonly double _seconds;
+
+				internal Awaiter(double seconds)
+				{
+					_seconds = seconds;
+				}
+
+				public bool IsCompleted => _seconds <= 0.0;
+				public void GetResult() { }
+				public void OnCompleted(Action continuation) => EnqueueTimer(_seconds, continuation);
+				public void UnsafeOnCompleted(Action continuation) => EnqueueTimer(_seconds, continuation);
+			}
+		}
+
+		private sealed class GameThreadSynchronizationContext : SynchronizationContext
+		{
+			public override void Post(SendOrPostCallback d, object? state)
+			{
+				lock (_lock)
+				{
+					_posted.Enqueue((d, state));
+				}
+			}
+
+			public override void Send(SendOrPostCallback d, object? state)
+			{
+				if (Thread.CurrentThread.ManagedThreadId == _gameThreadId)
+				{
+					d(state);
+					return;
+				}
+
+				using var done = new ManualResetEventSlim();
+				Post(_ => { try { d(state); } finally { done.Set(); } }, null);
+				done.Wait();
+			}
+
+			public override SynchronizationContext CreateCopy() => this;
+		}
+
+		private sealed class Coroutine
+		{
+			public int Id;
+			public object? Owner;
+			public double WakeTime;
+			public readonly Stack<IEnumerator> Routines = new();
+		}
+
+		private static readonly object _lock = new();
+		private static readonly GameThreadSynchronizationContext _context = new();
+		private static int _gameThreadId = -1;
+
+		private static readonly Queue<(SendOrPostCallback Callback, object? State)> _posted = new();
+		private static List<Action> _nextFrame = new();
+		private static List<Action> _running = new();
+		private static readonly PriorityQueue<Action, (double Time, long Sequence)> _timers = new();
+		private static long _timerSequence;
+
+		private static readonly List<Coroutine> _coroutines = new();
+		private static readonly Stack<Coroutine> _coroutinePool = new();
+		private static int _nextCoroutineId = 1;
+
+		public static double Time { get; private set; }
+		public static double DeltaTime { get; private set; }
+		public static long FrameCount { get; private set; }
+
+		// Receives exceptions thrown by coroutines and posted callbacks; set by Bootstrap.
+		internal static Action<Exception>? ErrorHandler;
+
+		public static NextFrameAwaitable NextFrame() => default;
+
+		public static SecondsAwaitable Seconds(double seconds) => new(seconds);
+
+		// Runs the routine up to its first yield immediately, then once per frame or wait.
+		// Coroutines started with an owner can be stopped together with StopCoroutines(owner).
+		public static CoroutineHandle StartCoroutine(IEnumerator routine, object? owner = null)
+		{
+			ArgumentNullException.ThrowIfNull(routine);
+
+			var coroutine = _coroutinePool.Count > 0 ? _coroutinePool.Pop() : new Coroutine();
+			coroutine.Id = _nextCoroutineId++;
+			coroutine.Owner = owner;
+			coroutine.WakeTime = Time;
+			coroutine.Routines.Push(routine);
+
+			if (!Step(coroutine))
+			{
+				int id = coroutine.Id;
+				Recycle(coroutine);
+				return new CoroutineHandle(id);
+			}
+
+			_coroutines.Add(coroutine);
+			return new CoroutineHandle(coroutine.Id);
+		}
+
+		public static bool StopCoroutine(CoroutineHandle handle)
+		{
+			for (int i = 0; i < _coroutines.Count; i++)
+			{
+				if (_coroutines[i].Id == handle.Id)
+				{
+					// Stopped coroutines are removed on the next tick so an in-progress tick stays consistent.
+					_coroutines[i].Routines.Clear();
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		public static int StopCoroutines(object owner)
+		{
+			int stopped = 0;
+			foreach (var coroutine in _coroutines)
+			{
+				if (ReferenceEquals(coroutine.Owner, owner) && coroutine.Routines.Count > 0)
+				{
+					coroutine.Routines.Clear();
+					stopped++;
+				}
+			}
+
+			return stopped;
+		}
+
+		// Makes the calling thread the game thread: the one Tick must be called on.
+		internal static void InstallOnCurrentThread()
+		{
+			_gameThreadId = Thread.CurrentThread.ManagedThreadId;
+			if (SynchronizationContext.Current != _context)
+			{
+				SynchronizationContext.SetSynchronizationContext(_context);
+			}
+		}
+
+		// Returns the amount of work still pending (continuations, timers, coroutines).
+		internal static int Tick(double deltaSeconds)
+		{
+			InstallOnCurrentThread();
+
+			DeltaTime = deltaSeconds > 0.0 ? deltaSeconds : 0.0;
+			Time += DeltaTime;
+			FrameCount++;
+
+			RunPosted();
+			RunNextFrame();
+			RunTimers();
+			RunCoroutines();
+
+			lock (_lock)
+			{
+				return _posted.Count + _nextFrame.Count + _timers.Count + _coroutines.Count;
+			}
+		}
+
+		// Drops the pending continuations and coroutines whose code lives in the given (plugin) load
+		// context. Called before a script module is unloaded so that nothing here keeps it alive;
+		// work belonging to other modules is left untouched.
+		internal static void Release(AssemblyLoadContext context)
+		{
+			lock (_lock)
+			{
+				int postedCount = _posted.Count;
+				for (int i = 0; i < postedCount; i++)
+				{
+					var item = _posted.Dequeue();
+					if (!BelongsTo(item.Callback, context) && !BelongsTo(item.State, context))
+					{
+						_posted.Enqueue(item);
+					}
+				}
+
+				_nextFrame.RemoveAll(continuation => BelongsTo(continuation, context));
+				_running.RemoveAll(continuation => BelongsTo(continuation, context));
+
+				if (_timers.Count > 0)
+				{
+					var timers = _timers.UnorderedItems.Where(timer => !BelongsTo(timer.Element, context)).ToList();
+					_timers.Clear();
+					_timers.EnqueueRange(timers);
+				}
+			}
+
+			foreach (var coroutine in _coroutines)
+			{
+				if (BelongsTo(coroutine.Owner, context) || coroutine.Routines.Any(routine => BelongsTo(routine, context)))
+				{
+					// Removed on the next tick; drop the references now so the module can unload.
+					coroutine.Routines.Clear();
+					coroutine.Owner = null;
+				}
+			}
+		}
+
+		private static bool BelongsTo(object? target, AssemblyLoadContext context)
+		{
+			if (target is Delegate callback)
+			{
+				return BelongsTo(callback.Target, context)
+					|| (callback.Method.DeclaringType != null && IsFromContext(callback.Method.DeclaringType, context));
+			}
+
+			return target != null && IsFromContext(target.GetType(), context);
+		}
+
+		// Generic arguments count too: an async continuation's target is a runtime box whose type
+		// argument is the script's state machine.
+		private static bool IsFromContext(Type type, AssemblyLoadContext context)
+		{
+			if (AssemblyLoadContext.GetLoadContext(type.Assembly) == context)
+			{
+				return true;
+			}
+
+			if (type.IsGenericType)
+			{
+				foreach (var argument in type.GetGenericArguments())
+				{
+					if (IsFromContext(argument, context))
+					{
+						return true;
+					}
+				}
+			}
+
+			return type.HasElementType && IsFromContext(type.GetElementType()!, context);
+		}
+
+		private static void EnqueueNextFrame(Action continuation)
+		{
+			lock (_lock)
+			{
+				_nextFrame.Add(continuation);
+			}
+		}
+
+		private static void EnqueueTimer(double seconds, Action continuation)
+		{
+			lock (_lock)
+			{
+				_timers.Enqueue(continuation, (Time + seconds, _timerSequence++));
+			}
+		}
+
+		private static void RunPosted()
+		{
+			// Only what was posted before this tick; callbacks that post again run next frame.
+			int count;
+			lock (_lock)
+			{
+				count = _posted.Count;
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				(SendOrPostCallback Callback, object? State) item;
+				lock (_lock)
+				{
+					item = _posted.Dequeue();
+				}
+
+				try
+				{
+					item.Callback(item.State);
+				}
+				catch (Exception ex)
+				{
+					ErrorHandler?.Invoke(ex);
+				}
+			}
+		}
+
+		private static void RunNextFrame()
+		{
+			lock (_lock)
+			{
+				(_running, _nextFrame) = (_nextFrame, _running);
+			}
+
+			foreach (var continuation in _running)
+			{
+				try
+				{
+					continuation();
+				}
+				catch (Exception ex)
+				{
+					ErrorHandler?.Invoke(ex);
+				}
+			}
+
+			_running.Clear();
+		}
+
+		private static void RunTimers()
+		{
+			double now = Time;
+			while (true)
+			{
+				Action continuation;
+				lock (_lock)
+				{
+					if (!_timers.TryPeek(out continuation!, out var due) || due.Time > now)
+					{
+						return;
+					}
+					_timers.Dequeue();
+				}
+
+				try
+				{
+					continuation();
+				}
+				catch (Exception ex)
+				{
+					ErrorHandler?.Invoke(ex);
+				}
+			}
+		}
+
+		private static void RunCoroutines()
+		{
+			// Coroutines started during this pass already ran their first step.
+			int count = _coroutines.Count;
+			for (int i = 0; i < count; i++)
+			{
+				var coroutine = _coroutines[i];
+				if (coroutine.Routines.Count > 0 && coroutine.WakeTime <= Time)
+				{
+					Step(coroutine);
+				}
+			}
+
+			for (int i = _coroutines.Count - 1; i >= 0; i--)
+			{
+				var coroutine = _coroutines[i];
+				if (coroutine.Routines.Count == 0)
+				{
+					_coroutines[i] = _coroutines[^1];
+					_coroutines.RemoveAt(_coroutines.Count - 1);
+					Recycle(coroutine);
+				}
+			}
+		}
+
+		// Advances the coroutine to its next wait. Returns false once it has finished.
+		private static bool Step(Coroutine coroutine)
+		{
+			while (coroutine.Routines.Count > 0)
+			{
+				var routine = coroutine.Routines.Peek();
+				bool hasNext;
+				try
+				{
+					hasNext = routine.MoveNext();
+				}
+				catch (Exception ex)
+				{
+					coroutine.Routines.Clear();
+					ErrorHandler?.Invoke(ex);
+					return false;
+				}
+
+				// StopCoroutine or StopCoroutines from inside the routine has already cleared the stack.
+				if (coroutine.Routines.Count == 0 || coroutine.Routines.Peek() != routine)
+				{
+					return false;
+				}
+
+				if (!hasNext)
+				{
+					coroutine.Routines.Pop();
+					continue;
+				}
+
+				switch (routine.Current)
+				{
+					case IEnumerator nested:
+						coroutine.Routines.Push(nested);
+						continue;
+					case WaitForSeconds wait:
+						coroutine.WakeTime = Time + wait.Seconds;
+						return true;
+					default:
+						// null or anything else: next frame.
+						coroutine.WakeTime = Time;
+						return true;
+				}
+			}
+
+			return false;
+		}
+
+		private static void Recycle(Coroutine coroutine)
+		{
+			coroutine.Id = 0;
+			coroutine.Owner = null;
+			coroutine.Routines.Clear();
+			_coroutinePool.Push(coroutine);
+		}
+	}
+}
@@ -0,0 +1,180 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Core
+{
+	// Packed snapshot of the replicated fields of every script instance (MochiSharp::ScriptSnapshotHeader):
+	// a 16-byte header (magic "MSRS", version, entry count, total size), then one entry per instance with
+	// replicated fields in ascending id order: a 16-byte entry header (uint64 instance id, uint32 layout
+	// hash, int32 size) and the fields packed without padding, the next entry starting on an 8-byte
+	// boundary. Values are in host byte order. Deltas between two snapshots are computed natively
+	// (ScriptSnapshot.h), so a server can encode one per client without calling into managed code.
+	internal static class ScriptSnapshot
+	{
+		public const uint Magic = 0x5352534D;
+		public const uint Version = 1;
+		public const int HeaderSize = 16;
+		public const int EntryHeaderSize = 16;
+		// Largest record one instance may replicate (ScriptSnapshotMaxRecordSize); receivers reject
+		// deltas that add larger ones.
+		public const int MaxRecordSize = 4096;
+
+		[StructLayout(LayoutKind.Sequential)]
+		private struct Header
+		{
+			public uint Magic;
+			public uint Version;
+			public int EntryCount;
+			public int Size;
+		}
+
+		[StructLayout(LayoutKind.Sequential)]
+		private struct EntryHeader
+		{
+			public ulong InstanceId;
+			public uint LayoutHash;
+			public int Size;
+		}
+
+		// Writes the snapshot to buffer and returns its size. When that is more than bufferSize the
+		// buffer holds no valid snapshot and the caller retries with a larger one.
+		public static int Capture(Dictionary<ulong, ScriptContext> owners, ref ulong[] ids, IntPtr buffer, int bufferSize)
+		{
+			ArgumentOutOfRangeException.ThrowIfNegative(bufferSize);
+			int count = owners.Count;
+			if (ids.Length < count)
+			{
+				ids = new ulong[Math.Max(count, ids.Length * 2)];
+			}
+			owners.Keys.CopyTo(ids, 0);
+			Array.Sort(ids, 0, count);
+
+			Span<byte> output = NativeSpan.Create<byte>(buffer, bufferSize);
+			int offset = HeaderSize;
+			int entries = 0;
+			for (int i = 0; i < count; i++)
+			{
+				ulong instanceId = ids[i];
+				int recordOffset = offset + EntryHeaderSize;
+				Span<byte> record = recordOffset <= output.Length ? output.Slice(recordOffset) : Span<byte>.Empty;
+				int size = owners[instanceId].CaptureReplicatedFields(instanceId, record, out uint layoutHash);
+				if (size == 0)
+				{
+					continue;
+				}
+
+				if (recordOffset + size <= output.Length)
+				{
+					var entry = new EntryHeader { InstanceId = instanceId, LayoutHash = layoutHash, Size = size };
+					MemoryMarshal.Write(output.Slice(offset), in entry);
+					// Padding is zeroed so equal states give equal bytes.
+					output.Slice(recordOffset + size, Math.Min(Align(size) - size, output.Length - recordOffset - size)).Clear();
+				}
+
+				offset = checked(recordOffset + Align(size));
+				entries++;
+			}
+
+			if (offset <= output.Length)
+			{
+				var header = new Header { Magic = Magic, Version = Version, EntryCount = entries, Size = offset };
+				MemoryMarshal.Write(output, in header);
+			}
+
+			return offset;
+		}
+
+		// Writes each entry to the instance with its id. Entries that are byte for byte the same as in
+		// previous (the snapshot applied before, optional) are skipped, as are ids with no instance here
+		// and entries written for another layout. Returns the number of instances updated.
+		public static int Apply(Dictionary<ulong, ScriptContext> owners, IntPtr snapshot, int snapshotSize, IntPtr previous, int previousSize)
+		{
+			ReadOnlySpan<byte> current = Validate(snapshot, snapshotSize);
+			ReadOnlySpan<byte> prior = previous != IntPtr.Zero ? Validate(previous, previousSize) : ReadOnlySpan<byte>.Empty;
+
+			int applied = 0;
+			int priorOffset = HeaderSize;
+			for (int offset = HeaderSize; offset < current.Length;)
+			{
+				var entry = ReadEntry(current, offset);
+				var record = current.Slice(offset + EntryHeaderSize, entry.Size);
+				offset += EntryHeaderSize + Align(entry.Size);
+
+				bool unchanged = false;
+				while (priorOffset < prior.Length)
+				{
+					var priorEntry = ReadEntry(prior, priorOffset);
+					if (priorEntry.InstanceId > entry.InstanceId)
+					{
+						break;
+					}
+
+					if (priorEntry.InstanceId == entry.InstanceId)
+					{
+						unchanged = priorEntry.LayoutHash == entry.LayoutHash
+							&& prior.Slice(priorOffset + EntryHeaderSize, priorEntry.Size).SequenceEqual(record);
+					}
+					priorOffset += EntryHeaderSize + Align(priorEntry.Size);
+				}
+
+				if (!unchanged && owners.TryGetValue(entry.InstanceId, out var owner) && owner.ApplyReplicatedFields(entry.InstanceId, entry.LayoutHash, record))
+				{
+					applied++;
+				}
+			}
+
+			return applied;
+		}
+
+		private static ReadOnlySpan<byte> Validate(IntPtr buffer, int bufferSize)
+		{
+			if (buffer == IntPtr.Zero || bufferSize < HeaderSize)
+			{
+				throw new ArgumentException("Snapshot buffer is required", nameof(buffer));
+			}
+
+			ReadOnlySpan<byte> bytes = NativeSpan.Create<byte>(buffer, bufferSize);
+			var header = MemoryMarshal.Read<Header>(bytes);
+			if (header.Magic != Magic || header.Version != Version || header.Size < HeaderSize || header.Size > bufferSize)
+			{
+				throw new InvalidDataException($"Not a version {Version} script snapshot, or truncated");
+			}
+
+			bytes = bytes.Slice(0, header.Size);
+			int entries = 0;
+			for (int offset = HeaderSize; offset < bytes.Length; entries++)
+			{
+				if (bytes.Length - offset < EntryHeaderSize)
+				{
+					throw new InvalidDataException($"Script snapshot entry {entries} is truncated");
+				}
+
+				var entry = ReadEntry(bytes, offset);
+				if (entry.Size <= 0 || entry.Size > bytes.Length - offset - EntryHeaderSize)
+				{
+					throw new InvalidDataException($"Script snapshot entry {entries} is truncated");
+				}
+				offset += EntryHeaderSize + Align(entry.Size);
+			}
+
+			if (entries != header.EntryCount)
+			{
+				throw new InvalidDataException($"Script snapshot holds {entries} entries, its header says {header.EntryCount}");
+			}
+
+			return bytes;
+		}
+
+		private static EntryHeader ReadEntry(ReadOnlySpan<byte> snapshot, int offset)
+		{
+			return MemoryMarshal.Read<EntryHeader>(snapshot.Slice(offset));
+		}
+
+		private static int Align(int size)
+		{
+			return (size + 7) & ~7;
+		}
+	}
+}
@@ -0,0 +1,483 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Loader;
+using System.Threading;
+
+namespace MochiSharp.Managed.Core
+{
+	// Native view of how a module's last unload went (MochiSharp::ScriptUnloadReport), 48 bytes.
+	[StructLayout(LayoutKind.Sequential)]
+	internal struct ScriptUnloadReport
+	{
+		public int ModuleHandle;
+		public int Collected;
+		public int Collections;
+		public int RootCount;
+		public double MillisecondsToCollect;
+		public long FreedBytes;
+		public long HeapBytes;
+		public long HeapGrowthBytes;
+	}
+
+	// A module whose context has been unloaded but not verified yet. Only weakly references the context.
+	internal readonly record struct PendingUnload(int ModuleHandle, string PluginPath, WeakReference Context, long HeapBytesBefore, long StartTimestamp);
+
+	// Checks that an unloaded module's collectible context is actually collected. AssemblyLoadContext.Unload
+	// only starts the unload: the context, its assemblies and every static of the plugin stay in memory
+	// until nothing references a plugin type, instance or delegate any more, which is how a reload that
+	// "worked" still leaks a full copy of the module. Verify runs blocking collections until the context
+	// is gone (or MaxCollections is reached) and records the outcome per module; with diagnostics on, a
+	// context that survives is searched for the static roots that keep it alive.
+	//
+	// Verify must run from a frame that holds no reference to the module: the registry detaches the
+	// module in a separate, non-inlined method and only passes the PendingUnload on.
+	internal sealed class ScriptUnloadTracker
+	{
+		public const int DefaultMaxCollections = 8;
+
+		private int _maxCollections = DefaultMaxCollections;
+		private bool _diagnostics;
+		private long _lastHeapBytes = -1;
+		private readonly Dictionary<int, (ScriptUnloadReport Report, string Roots)> _reports = new();
+
+		// maxCollections = 0 skips the forced collections; the report then only tells whether the
+		// context happened to be collected already.
+		public void Configure(int maxCollections, bool diagnostics)
+		{
+			if (maxCollections < 0)
+			{
+				throw new ArgumentOutOfRangeException(nameof(maxCollections), "Collection count cannot be negative");
+			}
+
+			_maxCollections = maxCollections;
+			_diagnostics = diagnostics;
+		}
+
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		public ScriptUnloadReport Verify(PendingUnload pending, Action<string>? log)
+		{
+			int collections = 0;
+			while (pending.Context.IsAlive && collections < _maxCollections)
+			{
+				GC.Collect();
+				GC.WaitForPendingFinalizers();
+				collections++;
+			}
+
+			bool collected = !pending.Context.IsAlive;
+			double milliseconds = Stopwatch.GetElapsedTime(pending.StartTimestamp).TotalMilliseconds;
+			long heapBytes = GC.GetTotalMemory(false);
+
+			var report = new ScriptUnloadReport
+			{
+				ModuleHandle = pending.ModuleHandle,
+				Collected = collected ? 1 : 0,
+				Collections = collections,
+				MillisecondsToCollect = milliseconds,
+				FreedBytes = pending.HeapBytesBefore - heapBytes,
+				HeapBytes = heapBytes,
+				HeapGrowthBytes = _lastHeapBytes >= 0 ? heapBytes - _lastHeapBytes : 0
+			};
+			_lastHeapBytes = heapBytes;
+
+			string roots = string.Empty;
+			if (!collected && _diagnostics)
+			{
+				var paths = ScriptRootFinder.Find(pending.Context);
+				report.RootCount = paths.Count;
+				roots = string.Join("\n", paths);
+			}
+
+			_reports[pending.ModuleHandle] = (report, roots);
+
+			string name = Path.GetFileName(pending.PluginPath);
+			if (collected)
+			{
+				log?.Invoke($"Module {pending.ModuleHandle} ({name}) collected after {collections} GC(s) in {milliseconds:F1} ms: " +
+					$"freed {report.FreedBytes / 1024} KB, heap {heapBytes / 1024} KB ({report.HeapGrowthBytes / 1024:+0;-0;0} KB since the last unload)");
+			}
+			else if (!_diagnostics)
+			{
+				log?.Invoke($"Module {pending.ModuleHandle} ({name}) is still alive after {collections} GC(s): something references its types or instances " +
+					"(enable unload diagnostics to list the roots)");
+			}
+			else
+			{
+				log?.Invoke($"Module {pending.ModuleHandle} ({name}) is still alive after {collections} GC(s); " +
+					(report.RootCount > 0 ? $"kept alive by:\n{roots}" : "no static root found (a thread's stack or a GC handle holds it)"));
+			}
+
+			return report;
+		}
+
+		// False if the module was never unloaded.
+		public bool TryGetReport(int moduleHandle, out ScriptUnloadReport report, out string roots)
+		{
+			bool found = _reports.TryGetValue(moduleHandle, out var entry);
+			report = entry.Report;
+			roots = entry.Roots ?? string.Empty;
+			return found;
+		}
+	}
+
+	// Searches the object graph reachable from static fields for references into an unloaded context:
+	// its load context object, its assemblies, types, members, delegates to its code, or instances of its
+	// types. Roots are the statics of every non-framework assembly in the other load contexts (the host,
+	// shared assemblies, the other modules) plus the framework statics that commonly leak plugins:
+	// AppContext/AppDomain events, the default context's resolving events, queued thread pool work and
+	// timers. Each root is reported once, as the field path to the first reference found:
+	//
+	//   MochiSharp.Managed.Core.Bootstrap._modules -> _loaded -> _items -> [0] -> ... -> instance of Game.Player
+	//
+	// References held by a thread's stack, by GC handles (e.g. native code holding a delegate) or by
+	// framework caches outside the roots above are not visible from here. Reading a static field runs
+	// its type's static constructor if it has not run yet, so this is a diagnostic, not a per-reload check.
+	internal static class ScriptRootFinder
+	{
+		private const int MaxRoots = 16;
+		private const int MaxObjects = 2_000_000;
+		private const BindingFlags InstanceFields = BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.DeclaredOnly;
+		private const BindingFlags StaticFields = BindingFlags.Static | BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.DeclaredOnly;
+
+		[MethodImpl(MethodImplOptions.NoInlining)]
+		public static List<string> Find(WeakReference contextReference)
+		{
+			var paths = new List<string>();
+			if (contextReference.Target is not AssemblyLoadContext context)
+			{
+				return paths;
+			}
+
+			var search = new Search(context);
+			foreach (var (name, value) in EnumerateRoots(context))
+			{
+				if (search.Budget <= 0)
+				{
+					paths.Add($"(search stopped after {MaxObjects} objects)");
+					break;
+				}
+
+				if (search.FindPath(name, value) is string path)
+				{
+					paths.Add(path);
+					if (paths.Count == MaxRoots)
+					{
+						break;
+					}
+				}
+			}
+
+			return paths;
+		}
+
+		private static IEnumerable<(string Name, object? Value)> EnumerateRoots(AssemblyLoadContext context)
+		{
+			yield return ("AssemblyLoadContext.Default", AssemblyLoadContext.Default);
+
+			var coreLibrary = typeof(object).Assembly;
+			foreach (var type in new[] { typeof(AppContext), typeof(ThreadPool), coreLibrary.GetType("System.Threading.TimerQueue") })
+			{
+				if (type != null)
+				{
+					foreach (var root in ReadStatics(type))
+					{
+						yield return root;
+					}
+				}
+			}
+
+			string frameworkDirectory = Path.GetDirectoryName(coreLibrary.Location) ?? string.Empty;
+			foreach (var loadContext in AssemblyLoadContext.All)
+			{
+				if (loadContext == context)
+				{
+					continue;
+				}
+
+				foreach (var assembly in loadContext.Assemblies)
+				{
+					if (assembly.IsDynamic || (frameworkDirectory.Length > 0 &&
+						assembly.Location.StartsWith(frameworkDirectory, StringComparison.OrdinalIgnoreCase)))
+					{
+						continue;
+					}
+
+					foreach (var type in GetLoadableTypes(assembly))
+					{
+						foreach (var root in ReadStatics(type))
+						{
+							yield return root;
+						}
+					}
+				}
+			}
+		}
+
+		private static IEnumerable<(string Name, object? Value)> ReadStatics(Type type)
+		{
+			if (type.ContainsGenericParameters)
+			{
+				yield break;
+			}
+
+			foreach (var field in type.GetFields(StaticFields))
+			{
+				if (field.IsLiteral || !MayReference(field.FieldType))
+				{
+					continue;
+				}
+
+				object? value;
+				try
+				{
+					value = field.GetValue(null);
+				}
+				catch (Exception)
+				{
+					continue;
+				}
+
+				yield return ($"{type.FullName}.{field.Name}", value);
+			}
+		}
+
+		private static Type[] GetLoadableTypes(Assembly assembly)
+		{
+			try
+			{
+				return assembly.GetTypes();
+			}
+			catch (ReflectionTypeLoadException ex)
+			{
+				return Array.FindAll(ex.Types, type => type != null)!;
+			}
+		}
+
+		private static bool MayReference(Type type)
+		{
+			return !type.IsPrimitive && !type.IsEnum && !type.IsPointer && !type.IsByRef && !type.IsByRefLike
+				&& type != typeof(string) && type != typeof(IntPtr) && type != typeof(UIntPtr) && type != typeof(decimal);
+		}
+
+		private static string EdgeName(FieldInfo field)
+		{
+			// <Name>k__BackingField -> Name
+			string name = field.Name;
+			return name.StartsWith('<') && name.IndexOf('>') is int end and > 1 ? name[1..end] : name;
+		}
+
+		private sealed class Search
+		{
+			private readonly AssemblyLoadContext _context;
+			private readonly Dictionary<Assembly, bool> _ownedAssemblies = new();
+			private readonly Dictionary<Type, bool> _ownedTypes = new();
+			private readonly Dictionary<Type, FieldInfo[]> _fields = new();
+			private readonly Dictionary<Type, bool> _structsWithReferences = new();
+			private readonly HashSet<object> _visited = new(ReferenceEqualityComparer.Instance);
+			private readonly Dictionary<object, (object? Parent, string Edge)> _parents = new(ReferenceEqualityComparer.Instance);
+			private readonly Queue<object> _queue = new();
+
+			public int Budget { get; private set; } = MaxObjects;
+
+			public Search(AssemblyLoadContext context)
+			{
+				_context = context;
+			}
+
+			// Breadth first, so the path reported is the shortest from this root.
+			public string? FindPath(string rootName, object? root)
+			{
+				if (root == null || !_visited.Add(root))
+				{
+					return null;
+				}
+
+				_parents.Clear();
+				_parents[root] = (null, rootName);
+				_queue.Clear();
+				_queue.Enqueue(root);
+
+				while (_queue.Count > 0 && Budget-- > 0)
+				{
+					object current = _queue.Dequeue();
+					if (Describe(current) is string target)
+					{
+						// Objects queued but not expanded may lead elsewhere from a later root.
+						foreach (object pending in _queue)
+						{
+							_visited.Remove(pending);
+						}
+						_queue.Clear();
+						return BuildPath(current, target);
+					}
+
+					Expand(current);
+				}
+
+				return null;
+			}
+
+			private void Expand(object current)
+			{
+				// Reflection objects only reach the runtime's own caches.
+				if (current is MemberInfo or Assembly or Module)
+				{
+					return;
+				}
+
+				var type = current.GetType();
+				if (current is Array array)
+				{
+					if (!MayHoldReferences(type.GetElementType()!))
+					{
+						return;
+					}
+
+					int index = 0;
+					foreach (object? element in array)
+					{
+						Visit(element, current, $"[{index++}]");
+					}
+					return;
+				}
+
+				foreach (var field in GetFields(type))
+				{
+					object? value;
+					try
+					{
+						value = field.GetValue(current);
+					}
+					catch (Exception)
+					{
+						continue;
+					}
+
+					Visit(value, current, EdgeName(field));
+				}
+			}
+
+			private void Visit(object? value, object parent, string edge)
+			{
+				if (value == null || !_visited.Add(value))
+				{
+					return;
+				}
+
+				_parents[value] = (parent, edge);
+				_queue.Enqueue(value);
+			}
+
+			// What the object is, if it belongs to the unloaded context.
+			private string? Describe(object value)
+			{
+				switch (value)
+				{
+					case AssemblyLoadContext loadContext:
+						return loadContext == _context ? $"load context {loadContext.Name}" : null;
+					case Assembly assembly:
+						return Owns(assembly) ? $"assembly {assembly.GetName().Name}" : null;
+					case Type type:
+						return Owns(type) ? $"type {type.FullName}" : null;
+					case MemberInfo member:
+						return member.DeclaringType != null && Owns(member.DeclaringType) ? $"member {member.DeclaringType.FullName}.{member.Name}" : null;
+					case Delegate callback when callback.Method.DeclaringType is Type declaringType && Owns(declaringType):
+						return $"delegate to {declaringType.FullName}.{callback.Method.Name}";
+				}
+
+				var valueType = value.GetType();
+				return Owns(valueType) ? $"instance of {valueType.FullName}" : null;
+			}
+
+			private bool Owns(Assembly assembly)
+			{
+				if (!_ownedAssemblies.TryGetValue(assembly, out bool owned))
+				{
+					owned = AssemblyLoadContext.GetLoadContext(assembly) == _context;
+					_ownedAssemblies[assembly] = owned;
+				}
+
+				return owned;
+			}
+
+			private bool Owns(Type type)
+			{
+				if (_ownedTypes.TryGetValue(type, out bool owned))
+				{
+					return owned;
+				}
+
+				owned = Owns(type.Assembly)
+					|| (type.HasElementType && Owns(type.GetElementType()!))
+					|| (type.IsGenericType && !type.IsGenericTypeDefinition && Array.Exists(type.GetGenericArguments(), Owns));
+				_ownedTypes[type] = owned;
+				return owned;
+			}
+
+			private FieldInfo[] GetFields(Type type)
+			{
+				if (!_fields.TryGetValue(type, out var fields))
+				{
+					var list = new List<FieldInfo>();
+					for (var current = type; current != null; current = current.BaseType)
+					{
+						foreach (var field in current.GetFields(InstanceFields))
+						{
+							if (MayHoldReferences(field.FieldType))
+							{
+								list.Add(field);
+							}
+						}
+					}
+
+					fields = list.ToArray();
+					_fields[type] = fields;
+				}
+
+				return fields;
+			}
+
+			// Structs without reference fields (vectors, handles) cannot lead anywhere; skipping them
+			// avoids boxing every element of large blittable arrays.
+			private bool MayHoldReferences(Type type)
+			{
+				if (!MayReference(type))
+				{
+					return false;
+				}
+
+				if (!type.IsValueType)
+				{
+					return true;
+				}
+
+				if (!_structsWithReferences.TryGetValue(type, out bool holds))
+				{
+					_structsWithReferences[type] = false;
+					holds = Array.Exists(type.GetFields(BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic), field => MayHoldReferences(field.FieldType));
+					_structsWithReferences[type] = holds;
+				}
+
+				return holds;
+			}
+
+			private string BuildPath(object target, string description)
+			{
+				var edges = new List<string>();
+				for (object? current = target; current != null; current = _parents[current].Parent)
+				{
+					edges.Add(_parents[current].Edge);
+				}
+
+				edges.Reverse();
+				edges.Add(description);
+				return string.Join(" -> ", edges);
+			}
+		}
+	}
+}
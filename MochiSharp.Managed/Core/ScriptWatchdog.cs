@@ -0,0 +1,49 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Core
+{
+	// Script side of the native watchdog (MochiSharp.Native/Source/ScriptWatchdog.h). The runtime
+	// cannot interrupt a running method, so long loops and searches should poll this and bail out:
+	//
+	//   foreach (var node in graph) { ScriptWatchdog.ThrowIfAbortRequested(); ... }
+	//
+	// The exception counts as a fault of the invoked method (see ConfigureFaultPolicy).
+	public static class ScriptWatchdog
+	{
+		private const int SequenceOffset = 0;
+		private const int AbortSequenceOffset = 4;
+
+		// uint32 Sequence (odd while an Invoke runs), uint32 AbortSequence. Owned by the native host.
+		private static IntPtr _sharedState;
+
+		// True when the native watchdog asked the currently invoked method to stop.
+		public static bool IsAbortRequested
+		{
+			get
+			{
+				IntPtr state = _sharedState;
+				if (state == IntPtr.Zero)
+				{
+					return false;
+				}
+
+				int sequence = Marshal.ReadInt32(state, SequenceOffset);
+				return (sequence & 1) != 0 && sequence == Marshal.ReadInt32(state, AbortSequenceOffset);
+			}
+		}
+
+		public static void ThrowIfAbortRequested()
+		{
+			if (IsAbortRequested)
+			{
+				throw new OperationCanceledException("Script call aborted by the watchdog: it exceeded its time budget");
+			}
+		}
+
+		internal static void Attach(IntPtr sharedState)
+		{
+			_sharedState = sharedState;
+		}
+	}
+}
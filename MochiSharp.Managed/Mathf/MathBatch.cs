@@ -0,0 +1,124 @@
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+
+namespace MochiSharp.Managed.Mathf
+{
+	// Operations over whole spans of points, for component arrays shared with native code.
+	//
+	//   MathBatch.TransformPoints(transform.ToMatrix(), localPoints, worldPoints);
+	//   MathBatch.Integrate(positions, velocities, deltaTime);
+	//
+	// Element-wise work (Integrate) runs over the flattened floats with Vector256/Vector128, matrix
+	// work keeps the rows in registers and broadcasts each point's components. No step is fused, so
+	// results are bit-identical to the obvious scalar loop on every machine (MochiSharp.MathBench
+	// checks this and measures the difference). Destination may be the source span itself; other
+	// overlaps are not supported.
+	public static class MathBatch
+	{
+		// destination[i] = points[i] * matrix.
+		public static void TransformPoints(in Matrix4x4 matrix, ReadOnlySpan<Vector3> points, Span<Vector3> destination)
+		{
+			CheckLengths(points.Length, destination.Length, nameof(destination));
+
+			var row0 = matrix.GetRow(0);
+			var row1 = matrix.GetRow(1);
+			var row2 = matrix.GetRow(2);
+			var row3 = matrix.GetRow(3);
+
+			ref Vector3 source = ref MemoryMarshal.GetReference(points);
+			ref Vector3 target = ref MemoryMarshal.GetReference(destination);
+			for (int i = 0; i < points.Length; i++)
+			{
+				Vector3 p = Unsafe.Add(ref source, i);
+				var result = row0 * Vector128.Create(p.X) + row1 * Vector128.Create(p.Y) + row2 * Vector128.Create(p.Z) + row3;
+				Unsafe.Add(ref target, i) = result.AsVector3();
+			}
+		}
+
+		// destination[i] = directions[i] * matrix, without the translation.
+		public static void TransformDirections(in Matrix4x4 matrix, ReadOnlySpan<Vector3> directions, Span<Vector3> destination)
+		{
+			CheckLengths(directions.Length, destination.Length, nameof(destination));
+
+			var row0 = matrix.GetRow(0);
+			var row1 = matrix.GetRow(1);
+			var row2 = matrix.GetRow(2);
+
+			ref Vector3 source = ref MemoryMarshal.GetReference(directions);
+			ref Vector3 target = ref MemoryMarshal.GetReference(destination);
+			for (int i = 0; i < directions.Length; i++)
+			{
+				Vector3 d = Unsafe.Add(ref source, i);
+				var result = row0 * Vector128.Create(d.X) + row1 * Vector128.Create(d.Y) + row2 * Vector128.Create(d.Z);
+				Unsafe.Add(ref target, i) = result.AsVector3();
+			}
+		}
+
+		public static void TransformPoints(in Transform transform, ReadOnlySpan<Vector3> points, Span<Vector3> destination)
+		{
+			TransformPoints(transform.ToMatrix(), points, destination);
+		}
+
+		// positions[i] += velocities[i] * deltaTime.
+		public static void Integrate(Span<Vector3> positions, ReadOnlySpan<Vector3> velocities, float deltaTime)
+		{
+			CheckLengths(positions.Length, velocities.Length, nameof(velocities));
+			MultiplyAdd(MemoryMarshal.Cast<Vector3, float>(positions), MemoryMarshal.Cast<Vector3, float>(velocities), deltaTime);
+		}
+
+		// Semi-implicit Euler: velocities[i] += accelerations[i] * deltaTime, then positions[i] += velocities[i] * deltaTime.
+		public static void Integrate(Span<Vector3> positions, Span<Vector3> velocities, ReadOnlySpan<Vector3> accelerations, float deltaTime)
+		{
+			CheckLengths(positions.Length, velocities.Length, nameof(velocities));
+			CheckLengths(positions.Length, accelerations.Length, nameof(accelerations));
+
+			var velocityFloats = MemoryMarshal.Cast<Vector3, float>(velocities);
+			MultiplyAdd(velocityFloats, MemoryMarshal.Cast<Vector3, float>(accelerations), deltaTime);
+			MultiplyAdd(MemoryMarshal.Cast<Vector3, float>(positions), velocityFloats, deltaTime);
+		}
+
+		// destination[i] += source[i] * scale.
+		public static void MultiplyAdd(Span<float> destination, ReadOnlySpan<float> source, float scale)
+		{
+			CheckLengths(destination.Length, source.Length, nameof(source));
+
+			ref float target = ref MemoryMarshal.GetReference(destination);
+			ref float values = ref MemoryMarshal.GetReference(source);
+			nuint length = (nuint)destination.Length;
+			nuint i = 0;
+
+			if (Vector256.IsHardwareAccelerated && length >= (nuint)Vector256<float>.Count)
+			{
+				var factor = Vector256.Create(scale);
+				for (; i + (nuint)Vector256<float>.Count <= length; i += (nuint)Vector256<float>.Count)
+				{
+					(Vector256.LoadUnsafe(ref target, i) + Vector256.LoadUnsafe(ref values, i) * factor).StoreUnsafe(ref target, i);
+				}
+			}
+
+			if (Vector128.IsHardwareAccelerated)
+			{
+				var factor = Vector128.Create(scale);
+				for (; i + (nuint)Vector128<float>.Count <= length; i += (nuint)Vector128<float>.Count)
+				{
+					(Vector128.LoadUnsafe(ref target, i) + Vector128.LoadUnsafe(ref values, i) * factor).StoreUnsafe(ref target, i);
+				}
+			}
+
+			for (; i < length; i++)
+			{
+				Unsafe.Add(ref target, i) += Unsafe.Add(ref values, i) * scale;
+			}
+		}
+
+		private static void CheckLengths(int expected, int actual, string paramName)
+		{
+			if (expected != actual)
+			{
+				throw new ArgumentException($"Span length {actual} does not match {expected}", paramName);
+			}
+		}
+	}
+}
@@ -0,0 +1,110 @@
+using System;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using NMatrix4x4 = System.Numerics.Matrix4x4;
+using NVector3 = System.Numerics.Vector3;
+
+namespace MochiSharp.Managed.Mathf
+{
+	// 4x4 float matrix, 64 bytes, row-major; MochiSharp::Matrix4x4 in MathTypes.h. Same conventions as
+	// System.Numerics.Matrix4x4: vectors are rows (p' = p * M), translation lives in M41..M43, and
+	// a * b applies a first, then b.
+	[StructLayout(LayoutKind.Sequential)]
+	public struct Matrix4x4 : IEquatable<Matrix4x4>
+	{
+		public float M11, M12, M13, M14;
+		public float M21, M22, M23, M24;
+		public float M31, M32, M33, M34;
+		public float M41, M42, M43, M44;
+
+		public Matrix4x4(
+			float m11, float m12, float m13, float m14,
+			float m21, float m22, float m23, float m24,
+			float m31, float m32, float m33, float m34,
+			float m41, float m42, float m43, float m44)
+		{
+			M11 = m11; M12 = m12; M13 = m13; M14 = m14;
+			M21 = m21; M22 = m22; M23 = m23; M24 = m24;
+			M31 = m31; M32 = m32; M33 = m33; M34 = m34;
+			M41 = m41; M42 = m42; M43 = m43; M44 = m44;
+		}
+
+		public static Matrix4x4 Identity => NMatrix4x4.Identity;
+
+		public readonly bool IsIdentity => ((NMatrix4x4)this).IsIdentity;
+		public readonly Vector3 Translation => new(M41, M42, M43);
+
+		public static Matrix4x4 CreateTranslation(Vector3 position) => NMatrix4x4.CreateTranslation(position);
+		public static Matrix4x4 CreateScale(Vector3 scale) => NMatrix4x4.CreateScale(scale);
+		public static Matrix4x4 CreateFromQuaternion(Quaternion rotation) => NMatrix4x4.CreateFromQuaternion(rotation);
+
+		// Scale, then rotate, then translate.
+		public static Matrix4x4 CreateTRS(Vector3 position, Quaternion rotation, Vector3 scale)
+		{
+			NMatrix4x4 m = NMatrix4x4.CreateFromQuaternion(rotation);
+			m.M11 *= scale.X; m.M12 *= scale.X; m.M13 *= scale.X;
+			m.M21 *= scale.Y; m.M22 *= scale.Y; m.M23 *= scale.Y;
+			m.M31 *= scale.Z; m.M32 *= scale.Z; m.M33 *= scale.Z;
+			m.M41 = position.X; m.M42 = position.Y; m.M43 = position.Z;
+			return m;
+		}
+
+		public static Matrix4x4 CreateLookAt(Vector3 eye, Vector3 target, Vector3 up) => NMatrix4x4.CreateLookAt(eye, target, up);
+
+		// Field of view in radians.
+		public static Matrix4x4 CreatePerspectiveFieldOfView(float fieldOfView, float aspectRatio, float nearPlane, float farPlane)
+			=> NMatrix4x4.CreatePerspectiveFieldOfView(fieldOfView, aspectRatio, nearPlane, farPlane);
+
+		public static Matrix4x4 Transpose(in Matrix4x4 matrix) => NMatrix4x4.Transpose(matrix);
+
+		public static bool Invert(in Matrix4x4 matrix, out Matrix4x4 result)
+		{
+			bool invertible = NMatrix4x4.Invert(matrix, out NMatrix4x4 inverse);
+			result = inverse;
+			return invertible;
+		}
+
+		public static bool Decompose(in Matrix4x4 matrix, out Vector3 scale, out Quaternion rotation, out Vector3 position)
+		{
+			bool decomposed = NMatrix4x4.Decompose(matrix, out var s, out var r, out var p);
+			scale = s;
+			rotation = r;
+			position = p;
+			return decomposed;
+		}
+
+		public readonly Vector3 TransformPoint(Vector3 point) => NVector3.Transform(point, this);
+		// Ignores the translation.
+		public readonly Vector3 TransformDirection(Vector3 direction) => NVector3.TransformNormal(direction, this);
+
+		public static Matrix4x4 operator *(in Matrix4x4 a, in Matrix4x4 b) => (NMatrix4x4)a * (NMatrix4x4)b;
+		public static bool operator ==(in Matrix4x4 a, in Matrix4x4 b) => (NMatrix4x4)a == (NMatrix4x4)b;
+		public static bool operator !=(in Matrix4x4 a, in Matrix4x4 b) => (NMatrix4x4)a != (NMatrix4x4)b;
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator NMatrix4x4(in Matrix4x4 value) => Unsafe.BitCast<Matrix4x4, NMatrix4x4>(value);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator Matrix4x4(in NMatrix4x4 value) => Unsafe.BitCast<NMatrix4x4, Matrix4x4>(value);
+
+		// Row 0..3 as a Vector128.
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public readonly Vector128<float> GetRow(int index)
+		{
+			if ((uint)index > 3)
+			{
+				throw new ArgumentOutOfRangeException(nameof(index));
+			}
+
+			return Vector128.LoadUnsafe(ref Unsafe.AsRef(in M11), (nuint)(index * 4));
+		}
+
+		public readonly bool Equals(Matrix4x4 other) => this == other;
+		public override readonly bool Equals(object? obj) => obj is Matrix4x4 other && Equals(other);
+		public override readonly int GetHashCode() => ((NMatrix4x4)this).GetHashCode();
+		public override readonly string ToString() => string.Create(CultureInfo.InvariantCulture,
+			$"{{ {{{M11}, {M12}, {M13}, {M14}}} {{{M21}, {M22}, {M23}, {M24}}} {{{M31}, {M32}, {M33}, {M34}}} {{{M41}, {M42}, {M43}, {M44}}} }}");
+	}
+}
@@ -0,0 +1,72 @@
+using System;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using NQuaternion = System.Numerics.Quaternion;
+using NVector3 = System.Numerics.Vector3;
+
+namespace MochiSharp.Managed.Mathf
+{
+	// Rotation as X, Y, Z (vector part) and W (scalar part), 16 bytes; MochiSharp::Quaternion in
+	// MathTypes.h. Same conventions as System.Numerics.Quaternion: a * b applies b first, then a.
+	[StructLayout(LayoutKind.Sequential)]
+	public struct Quaternion : IEquatable<Quaternion>
+	{
+		public float X;
+		public float Y;
+		public float Z;
+		public float W;
+
+		public Quaternion(float x, float y, float z, float w)
+		{
+			X = x;
+			Y = y;
+			Z = z;
+			W = w;
+		}
+
+		public static Quaternion Identity => new(0.0f, 0.0f, 0.0f, 1.0f);
+
+		public readonly bool IsIdentity => this == Identity;
+		public readonly float Length => ((NQuaternion)this).Length();
+		public readonly Quaternion Normalized => NQuaternion.Normalize(this);
+		// Inverse of a unit quaternion.
+		public readonly Quaternion Conjugate => NQuaternion.Conjugate(this);
+
+		// Angle in radians.
+		public static Quaternion CreateFromAxisAngle(Vector3 axis, float angle) => NQuaternion.CreateFromAxisAngle(axis, angle);
+
+		// Angles in radians: yaw about Y, pitch about X, roll about Z, applied roll, pitch, yaw.
+		public static Quaternion CreateFromYawPitchRoll(float yaw, float pitch, float roll) => NQuaternion.CreateFromYawPitchRoll(yaw, pitch, roll);
+
+		public static Quaternion CreateFromRotationMatrix(in Matrix4x4 matrix) => NQuaternion.CreateFromRotationMatrix(matrix);
+
+		public static float Dot(Quaternion a, Quaternion b) => NQuaternion.Dot(a, b);
+		public static Quaternion Normalize(Quaternion value) => NQuaternion.Normalize(value);
+		public static Quaternion Inverse(Quaternion value) => NQuaternion.Inverse(value);
+		public static Quaternion Slerp(Quaternion a, Quaternion b, float t) => NQuaternion.Slerp(a, b, t);
+		public static Quaternion Lerp(Quaternion a, Quaternion b, float t) => NQuaternion.Lerp(a, b, t);
+
+		public static Vector3 Rotate(Vector3 value, Quaternion rotation) => NVector3.Transform(value, rotation);
+
+		public static Quaternion operator *(Quaternion a, Quaternion b) => (NQuaternion)a * (NQuaternion)b;
+		public static Vector3 operator *(Quaternion rotation, Vector3 value) => NVector3.Transform(value, rotation);
+		public static bool operator ==(Quaternion a, Quaternion b) => (NQuaternion)a == (NQuaternion)b;
+		public static bool operator !=(Quaternion a, Quaternion b) => (NQuaternion)a != (NQuaternion)b;
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator NQuaternion(Quaternion value) => Unsafe.BitCast<Quaternion, NQuaternion>(value);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator Quaternion(NQuaternion value) => Unsafe.BitCast<NQuaternion, Quaternion>(value);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public readonly Vector128<float> AsVector128() => Unsafe.BitCast<Quaternion, Vector128<float>>(this);
+
+		public readonly bool Equals(Quaternion other) => this == other;
+		public override readonly bool Equals(object? obj) => obj is Quaternion other && Equals(other);
+		public override readonly int GetHashCode() => HashCode.Combine(X, Y, Z, W);
+		public override readonly string ToString() => string.Create(CultureInfo.InvariantCulture, $"({X}, {Y}, {Z}, {W})");
+	}
+}
@@ -0,0 +1,67 @@
+using System;
+using System.Globalization;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Mathf
+{
+	// Position, rotation and non-uniform scale, 40 bytes; MochiSharp::Transform in MathTypes.h.
+	// A point is scaled, then rotated, then translated.
+	[StructLayout(LayoutKind.Sequential)]
+	public struct Transform : IEquatable<Transform>
+	{
+		public Vector3 Position;
+		public Quaternion Rotation;
+		public Vector3 Scale;
+
+		public Transform(Vector3 position, Quaternion rotation, Vector3 scale)
+		{
+			Position = position;
+			Rotation = rotation;
+			Scale = scale;
+		}
+
+		public Transform(Vector3 position) : this(position, Quaternion.Identity, Vector3.One)
+		{
+		}
+
+		public static Transform Identity => new(Vector3.Zero, Quaternion.Identity, Vector3.One);
+
+		public readonly Vector3 Right => Rotation * Vector3.UnitX;
+		public readonly Vector3 Up => Rotation * Vector3.UnitY;
+		public readonly Vector3 Forward => Rotation * Vector3.UnitZ;
+
+		public readonly Matrix4x4 ToMatrix() => Matrix4x4.CreateTRS(Position, Rotation, Scale);
+
+		public readonly Vector3 TransformPoint(Vector3 point) => Rotation * (point * Scale) + Position;
+		// Ignores the position.
+		public readonly Vector3 TransformDirection(Vector3 direction) => Rotation * (direction * Scale);
+		public readonly Vector3 InverseTransformPoint(Vector3 point) => (Rotation.Conjugate * (point - Position)) / Scale;
+
+		// Applies local in the space of parent: the result maps a point through local, then parent.
+		// Exact for uniform scale; non-uniform parent scale under rotation cannot be represented by a
+		// Transform and is approximated per axis.
+		public static Transform Combine(in Transform parent, in Transform local)
+		{
+			return new Transform(
+				parent.TransformPoint(local.Position),
+				Quaternion.Normalize(parent.Rotation * local.Rotation),
+				parent.Scale * local.Scale);
+		}
+
+		public static Transform Lerp(in Transform a, in Transform b, float t)
+		{
+			return new Transform(
+				Vector3.Lerp(a.Position, b.Position, t),
+				Quaternion.Slerp(a.Rotation, b.Rotation, t),
+				Vector3.Lerp(a.Scale, b.Scale, t));
+		}
+
+		public static bool operator ==(in Transform a, in Transform b) => a.Position == b.Position && a.Rotation == b.Rotation && a.Scale == b.Scale;
+		public static bool operator !=(in Transform a, in Transform b) => !(a == b);
+
+		public readonly bool Equals(Transform other) => this == other;
+		public override readonly bool Equals(object? obj) => obj is Transform other && Equals(other);
+		public override readonly int GetHashCode() => HashCode.Combine(Position, Rotation, Scale);
+		public override readonly string ToString() => string.Create(CultureInfo.InvariantCulture, $"{{ Position {Position} Rotation {Rotation} Scale {Scale} }}");
+	}
+}
@@ -0,0 +1,70 @@
+using System;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using NVector2 = System.Numerics.Vector2;
+
+namespace MochiSharp.Managed.Mathf
+{
+	// Two floats, 8 bytes; MochiSharp::Vector2 in MathTypes.h. Arithmetic goes through
+	// System.Numerics.Vector2, which the JIT lowers to SIMD instructions.
+	[StructLayout(LayoutKind.Sequential)]
+	public struct Vector2 : IEquatable<Vector2>
+	{
+		public float X;
+		public float Y;
+
+		public Vector2(float x, float y)
+		{
+			X = x;
+			Y = y;
+		}
+
+		public Vector2(float value) : this(value, value)
+		{
+		}
+
+		public static Vector2 Zero => default;
+		public static Vector2 One => new(1.0f);
+		public static Vector2 UnitX => new(1.0f, 0.0f);
+		public static Vector2 UnitY => new(0.0f, 1.0f);
+
+		public readonly float Length => ((NVector2)this).Length();
+		public readonly float LengthSquared => ((NVector2)this).LengthSquared();
+		public readonly Vector2 Normalized => Normalize(this);
+
+		public static float Dot(Vector2 a, Vector2 b) => NVector2.Dot(a, b);
+		public static float Distance(Vector2 a, Vector2 b) => NVector2.Distance(a, b);
+		public static Vector2 Normalize(Vector2 value) => NVector2.Normalize(value);
+		public static Vector2 Lerp(Vector2 a, Vector2 b, float t) => NVector2.Lerp(a, b, t);
+		public static Vector2 Min(Vector2 a, Vector2 b) => NVector2.Min(a, b);
+		public static Vector2 Max(Vector2 a, Vector2 b) => NVector2.Max(a, b);
+		public static Vector2 Abs(Vector2 value) => NVector2.Abs(value);
+
+		public static Vector2 operator +(Vector2 a, Vector2 b) => (NVector2)a + (NVector2)b;
+		public static Vector2 operator -(Vector2 a, Vector2 b) => (NVector2)a - (NVector2)b;
+		public static Vector2 operator -(Vector2 value) => -(NVector2)value;
+		public static Vector2 operator *(Vector2 a, Vector2 b) => (NVector2)a * (NVector2)b;
+		public static Vector2 operator *(Vector2 value, float scale) => (NVector2)value * scale;
+		public static Vector2 operator *(float scale, Vector2 value) => (NVector2)value * scale;
+		public static Vector2 operator /(Vector2 a, Vector2 b) => (NVector2)a / (NVector2)b;
+		public static Vector2 operator /(Vector2 value, float divisor) => (NVector2)value / divisor;
+		public static bool operator ==(Vector2 a, Vector2 b) => (NVector2)a == (NVector2)b;
+		public static bool operator !=(Vector2 a, Vector2 b) => (NVector2)a != (NVector2)b;
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator NVector2(Vector2 value) => Unsafe.BitCast<Vector2, NVector2>(value);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator Vector2(NVector2 value) => Unsafe.BitCast<NVector2, Vector2>(value);
+
+		// X, Y in the lower lanes, zero above.
+		public readonly Vector128<float> AsVector128() => ((NVector2)this).AsVector128();
+
+		public readonly bool Equals(Vector2 other) => this == other;
+		public override readonly bool Equals(object? obj) => obj is Vector2 other && Equals(other);
+		public override readonly int GetHashCode() => HashCode.Combine(X, Y);
+		public override readonly string ToString() => string.Create(CultureInfo.InvariantCulture, $"({X}, {Y})");
+	}
+}
@@ -0,0 +1,81 @@
+using System;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using NVector3 = System.Numerics.Vector3;
+
+namespace MochiSharp.Managed.Mathf
+{
+	// Three floats, 12 bytes; MochiSharp::Vector3 in MathTypes.h. Arithmetic goes through
+	// System.Numerics.Vector3, which the JIT lowers to SIMD instructions. Use MathBatch for whole
+	// arrays of points.
+	[StructLayout(LayoutKind.Sequential)]
+	public struct Vector3 : IEquatable<Vector3>
+	{
+		public float X;
+		public float Y;
+		public float Z;
+
+		public Vector3(float x, float y, float z)
+		{
+			X = x;
+			Y = y;
+			Z = z;
+		}
+
+		public Vector3(float value) : this(value, value, value)
+		{
+		}
+
+		public Vector3(Vector2 xy, float z) : this(xy.X, xy.Y, z)
+		{
+		}
+
+		public static Vector3 Zero => default;
+		public static Vector3 One => new(1.0f);
+		public static Vector3 UnitX => new(1.0f, 0.0f, 0.0f);
+		public static Vector3 UnitY => new(0.0f, 1.0f, 0.0f);
+		public static Vector3 UnitZ => new(0.0f, 0.0f, 1.0f);
+
+		public readonly float Length => ((NVector3)this).Length();
+		public readonly float LengthSquared => ((NVector3)this).LengthSquared();
+		public readonly Vector3 Normalized => Normalize(this);
+
+		public static float Dot(Vector3 a, Vector3 b) => NVector3.Dot(a, b);
+		public static Vector3 Cross(Vector3 a, Vector3 b) => NVector3.Cross(a, b);
+		public static float Distance(Vector3 a, Vector3 b) => NVector3.Distance(a, b);
+		public static float DistanceSquared(Vector3 a, Vector3 b) => NVector3.DistanceSquared(a, b);
+		public static Vector3 Normalize(Vector3 value) => NVector3.Normalize(value);
+		public static Vector3 Lerp(Vector3 a, Vector3 b, float t) => NVector3.Lerp(a, b, t);
+		public static Vector3 Min(Vector3 a, Vector3 b) => NVector3.Min(a, b);
+		public static Vector3 Max(Vector3 a, Vector3 b) => NVector3.Max(a, b);
+		public static Vector3 Abs(Vector3 value) => NVector3.Abs(value);
+		public static Vector3 Reflect(Vector3 direction, Vector3 normal) => NVector3.Reflect(direction, normal);
+
+		public static Vector3 operator +(Vector3 a, Vector3 b) => (NVector3)a + (NVector3)b;
+		public static Vector3 operator -(Vector3 a, Vector3 b) => (NVector3)a - (NVector3)b;
+		public static Vector3 operator -(Vector3 value) => -(NVector3)value;
+		public static Vector3 operator *(Vector3 a, Vector3 b) => (NVector3)a * (NVector3)b;
+		public static Vector3 operator *(Vector3 value, float scale) => (NVector3)value * scale;
+		public static Vector3 operator *(float scale, Vector3 value) => (NVector3)value * scale;
+		public static Vector3 operator /(Vector3 a, Vector3 b) => (NVector3)a / (NVector3)b;
+		public static Vector3 operator /(Vector3 value, float divisor) => (NVector3)value / divisor;
+		public static bool operator ==(Vector3 a, Vector3 b) => (NVector3)a == (NVector3)b;
+		public static bool operator !=(Vector3 a, Vector3 b) => (NVector3)a != (NVector3)b;
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator NVector3(Vector3 value) => Unsafe.BitCast<Vector3, NVector3>(value);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator Vector3(NVector3 value) => Unsafe.BitCast<NVector3, Vector3>(value);
+
+		// X, Y, Z in the lower lanes, zero in W.
+		public readonly Vector128<float> AsVector128() => ((NVector3)this).AsVector128();
+
+		public readonly bool Equals(Vector3 other) => this == other;
+		public override readonly bool Equals(object? obj) => obj is Vector3 other && Equals(other);
+		public override readonly int GetHashCode() => HashCode.Combine(X, Y, Z);
+		public override readonly string ToString() => string.Create(CultureInfo.InvariantCulture, $"({X}, {Y}, {Z})");
+	}
+}
@@ -0,0 +1,78 @@
+using System;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using NVector4 = System.Numerics.Vector4;
+
+namespace MochiSharp.Managed.Mathf
+{
+	// Four floats, 16 bytes; MochiSharp::Vector4 in MathTypes.h. Maps one to one onto a Vector128.
+	[StructLayout(LayoutKind.Sequential)]
+	public struct Vector4 : IEquatable<Vector4>
+	{
+		public float X;
+		public float Y;
+		public float Z;
+		public float W;
+
+		public Vector4(float x, float y, float z, float w)
+		{
+			X = x;
+			Y = y;
+			Z = z;
+			W = w;
+		}
+
+		public Vector4(float value) : this(value, value, value, value)
+		{
+		}
+
+		public Vector4(Vector3 xyz, float w) : this(xyz.X, xyz.Y, xyz.Z, w)
+		{
+		}
+
+		public static Vector4 Zero => default;
+		public static Vector4 One => new(1.0f);
+
+		public readonly float Length => ((NVector4)this).Length();
+		public readonly float LengthSquared => ((NVector4)this).LengthSquared();
+		public readonly Vector4 Normalized => Normalize(this);
+		public readonly Vector3 XYZ => new(X, Y, Z);
+
+		public static float Dot(Vector4 a, Vector4 b) => NVector4.Dot(a, b);
+		public static Vector4 Normalize(Vector4 value) => NVector4.Normalize(value);
+		public static Vector4 Lerp(Vector4 a, Vector4 b, float t) => NVector4.Lerp(a, b, t);
+		public static Vector4 Min(Vector4 a, Vector4 b) => NVector4.Min(a, b);
+		public static Vector4 Max(Vector4 a, Vector4 b) => NVector4.Max(a, b);
+		public static Vector4 Abs(Vector4 value) => NVector4.Abs(value);
+
+		public static Vector4 operator +(Vector4 a, Vector4 b) => (NVector4)a + (NVector4)b;
+		public static Vector4 operator -(Vector4 a, Vector4 b) => (NVector4)a - (NVector4)b;
+		public static Vector4 operator -(Vector4 value) => -(NVector4)value;
+		public static Vector4 operator *(Vector4 a, Vector4 b) => (NVector4)a * (NVector4)b;
+		public static Vector4 operator *(Vector4 value, float scale) => (NVector4)value * scale;
+		public static Vector4 operator *(float scale, Vector4 value) => (NVector4)value * scale;
+		public static Vector4 operator /(Vector4 a, Vector4 b) => (NVector4)a / (NVector4)b;
+		public static Vector4 operator /(Vector4 value, float divisor) => (NVector4)value / divisor;
+		public static bool operator ==(Vector4 a, Vector4 b) => (NVector4)a == (NVector4)b;
+		public static bool operator !=(Vector4 a, Vector4 b) => (NVector4)a != (NVector4)b;
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator NVector4(Vector4 value) => Unsafe.BitCast<Vector4, NVector4>(value);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static implicit operator Vector4(NVector4 value) => Unsafe.BitCast<NVector4, Vector4>(value);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public readonly Vector128<float> AsVector128() => Unsafe.BitCast<Vector4, Vector128<float>>(this);
+
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public static Vector4 FromVector128(Vector128<float> value) => Unsafe.BitCast<Vector128<float>, Vector4>(value);
+
+		public readonly bool Equals(Vector4 other) => this == other;
+		public override readonly bool Equals(object? obj) => obj is Vector4 other && Equals(other);
+		public override readonly int GetHashCode() => HashCode.Combine(X, Y, Z, W);
+		public override readonly string ToString() => string.Create(CultureInfo.InvariantCulture, $"({X}, {Y}, {Z}, {W})");
+	}
+}
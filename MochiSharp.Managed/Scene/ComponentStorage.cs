@@ -0,0 +1,88 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace MochiSharp.Managed.Scene
+{
+	// Native chunk descriptor (MochiSharp::ScriptChunk), 16 bytes.
+	[StructLayout(LayoutKind.Sequential)]
+	internal struct ChunkInfo
+	{
+		public IntPtr Entities;
+		public int Count;
+		public int Reserved;
+	}
+
+	// Script side of the host's component storage (MochiSharp.Native/Source/ScriptComponents.h): the
+	// component id the host registered for each struct, and the callback that lists chunks.
+	public static class ComponentStorage
+	{
+		private delegate int QueryChunksDelegate(IntPtr context, int[] componentIds, int componentCount, [Out] ChunkInfo[] chunks, [Out] IntPtr[] columns, int capacity);
+
+		private readonly record struct Registration(int ComponentId, int Size);
+
+		// Keyed by full name so a reloaded module's copy of a struct maps to the same component.
+		private static readonly Dictionary<string, Registration> _components = new(StringComparer.Ordinal);
+		private static QueryChunksDelegate? _queryChunks;
+		private static IntPtr _context;
+
+		// True while the host has a storage attached; queries throw otherwise.
+		public static bool IsAvailable => _queryChunks != null;
+
+		public static bool IsRegistered<T>() where T : unmanaged
+		{
+			return typeof(T).FullName is string name && _components.ContainsKey(name);
+		}
+
+		internal static void Register(int componentId, string typeName, int size)
+		{
+			if (string.IsNullOrWhiteSpace(typeName))
+			{
+				throw new ArgumentException("Component type name required", nameof(typeName));
+			}
+
+			if (size <= 0)
+			{
+				throw new ArgumentOutOfRangeException(nameof(size), "Component size must be positive");
+			}
+
+			int commaIndex = typeName.IndexOf(',');
+			string fullName = (commaIndex >= 0 ? typeName[..commaIndex] : typeName).Trim();
+			_components[fullName] = new Registration(componentId, size);
+		}
+
+		internal static void Attach(IntPtr queryFunction, IntPtr context)
+		{
+			_queryChunks = queryFunction == IntPtr.Zero ? null : Marshal.GetDelegateForFunctionPointer<QueryChunksDelegate>(queryFunction);
+			_context = queryFunction == IntPtr.Zero ? IntPtr.Zero : context;
+		}
+
+		internal static int GetComponentId(Type type, int managedSize)
+		{
+			if (type.FullName is not string name || !_components.TryGetValue(name, out var registration))
+			{
+				throw new InvalidOperationException($"{type.FullName} is not a registered component (DotNetHost::RegisterComponent)");
+			}
+
+			if (registration.Size != managedSize)
+			{
+				throw new InvalidOperationException($"Component {type.FullName} is {managedSize} bytes in managed code but {registration.Size} bytes natively");
+			}
+
+			return registration.ComponentId;
+		}
+
+		// Fills chunks/columns with up to capacity chunks and returns how many the storage has.
+		internal static int QueryChunks(int[] componentIds, ChunkInfo[] chunks, IntPtr[] columns, int capacity)
+		{
+			var queryChunks = _queryChunks ?? throw new InvalidOperationException("No component storage: the host has not called DotNetHost::SetComponentStorage");
+			int total = queryChunks(_context, componentIds, componentIds.Length, chunks, columns, capacity);
+			if (total < 0)
+			{
+				throw new InvalidOperationException("Component storage query failed");
+			}
+
+			return total;
+		}
+	}
+}
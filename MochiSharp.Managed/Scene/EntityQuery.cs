@@ -0,0 +1,186 @@
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using MochiSharp.Managed.Core;
+
+namespace MochiSharp.Managed.Scene
+{
+	public delegate void ChunkAction<T1>(Span<T1> column1, ReadOnlySpan<ulong> entities);
+	public delegate void ChunkAction<T1, T2>(Span<T1> column1, Span<T2> column2, ReadOnlySpan<ulong> entities);
+	public delegate void ChunkAction<T1, T2, T3>(Span<T1> column1, Span<T2> column2, Span<T3> column3, ReadOnlySpan<ulong> entities);
+
+	// Systems-style iteration over components stored natively (see ComponentStorage). A query names
+	// the component structs it reads or writes; enumerating it asks the host once for every chunk of
+	// entities that has all of them, and each chunk exposes its component arrays as spans over the
+	// native memory:
+	//
+	//   private static readonly EntityQuery Movers = EntityQuery.Create<Position, Velocity>();
+	//
+	//   foreach (var chunk in Movers)
+	//   {
+	//       Span<Position> positions = chunk.GetColumn<Position>(0);
+	//       Span<Velocity> velocities = chunk.GetColumn<Velocity>(1);
+	//       for (int i = 0; i < chunk.Count; i++) { ... }
+	//   }
+	//
+	// Spans are valid only until the script call that ran the query returns. A query keeps its chunk
+	// buffers between runs, so running the same query again inside its own loop is not supported;
+	// create a second query instead. Game thread only.
+	public sealed class EntityQuery
+	{
+		private readonly Type[] _componentTypes;
+		private readonly int[] _componentIds;
+		private ChunkInfo[] _chunks = new ChunkInfo[16];
+		private IntPtr[] _columns;
+
+		private EntityQuery(Type[] componentTypes, int[] componentSizes)
+		{
+			_componentTypes = componentTypes;
+			_componentIds = new int[componentTypes.Length];
+			for (int i = 0; i < componentTypes.Length; i++)
+			{
+				_componentIds[i] = ComponentStorage.GetComponentId(componentTypes[i], componentSizes[i]);
+			}
+
+			_columns = new IntPtr[_chunks.Length * componentTypes.Length];
+		}
+
+		public static EntityQuery Create<T1>() where T1 : unmanaged
+		{
+			return new EntityQuery(new[] { typeof(T1) }, new[] { Unsafe.SizeOf<T1>() });
+		}
+
+		public static EntityQuery Create<T1, T2>() where T1 : unmanaged where T2 : unmanaged
+		{
+			return new EntityQuery(new[] { typeof(T1), typeof(T2) }, new[] { Unsafe.SizeOf<T1>(), Unsafe.SizeOf<T2>() });
+		}
+
+		public static EntityQuery Create<T1, T2, T3>() where T1 : unmanaged where T2 : unmanaged where T3 : unmanaged
+		{
+			return new EntityQuery(new[] { typeof(T1), typeof(T2), typeof(T3) }, new[] { Unsafe.SizeOf<T1>(), Unsafe.SizeOf<T2>(), Unsafe.SizeOf<T3>() });
+		}
+
+		public static EntityQuery Create<T1, T2, T3, T4>() where T1 : unmanaged where T2 : unmanaged where T3 : unmanaged where T4 : unmanaged
+		{
+			return new EntityQuery(
+				new[] { typeof(T1), typeof(T2), typeof(T3), typeof(T4) },
+				new[] { Unsafe.SizeOf<T1>(), Unsafe.SizeOf<T2>(), Unsafe.SizeOf<T3>(), Unsafe.SizeOf<T4>() });
+		}
+
+		public int ComponentCount => _componentTypes.Length;
+
+		public Enumerator GetEnumerator()
+		{
+			int count = Run();
+			return new Enumerator(this, count);
+		}
+
+		// Number of entities matching the query right now.
+		public int CountEntities()
+		{
+			int count = Run();
+			int entities = 0;
+			for (int i = 0; i < count; i++)
+			{
+				entities += _chunks[i].Count;
+			}
+			return entities;
+		}
+
+		public void ForEach<T1>(ChunkAction<T1> action) where T1 : unmanaged
+		{
+			foreach (var chunk in this)
+			{
+				action(chunk.GetColumn<T1>(0), chunk.Entities);
+			}
+		}
+
+		public void ForEach<T1, T2>(ChunkAction<T1, T2> action) where T1 : unmanaged where T2 : unmanaged
+		{
+			foreach (var chunk in this)
+			{
+				action(chunk.GetColumn<T1>(0), chunk.GetColumn<T2>(1), chunk.Entities);
+			}
+		}
+
+		public void ForEach<T1, T2, T3>(ChunkAction<T1, T2, T3> action) where T1 : unmanaged where T2 : unmanaged where T3 : unmanaged
+		{
+			foreach (var chunk in this)
+			{
+				action(chunk.GetColumn<T1>(0), chunk.GetColumn<T2>(1), chunk.GetColumn<T3>(2), chunk.Entities);
+			}
+		}
+
+		private int Run()
+		{
+			int total = ComponentStorage.QueryChunks(_componentIds, _chunks, _columns, _chunks.Length);
+			if (total > _chunks.Length)
+			{
+				// Grown buffers are kept, so this only happens when the storage gains chunks.
+				_chunks = new ChunkInfo[Math.Max(total, _chunks.Length * 2)];
+				_columns = new IntPtr[_chunks.Length * _componentTypes.Length];
+				total = Math.Min(ComponentStorage.QueryChunks(_componentIds, _chunks, _columns, _chunks.Length), _chunks.Length);
+			}
+
+			return total;
+		}
+
+		private QueryChunk GetChunk(int index)
+		{
+			ref readonly ChunkInfo info = ref _chunks[index];
+			int columnCount = _componentTypes.Length;
+			return new QueryChunk(_componentTypes, new ReadOnlySpan<IntPtr>(_columns, index * columnCount, columnCount), info.Entities, info.Count);
+		}
+
+		public ref struct Enumerator
+		{
+			private readonly EntityQuery _query;
+			private readonly int _count;
+			private int _index;
+
+			internal Enumerator(EntityQuery query, int count)
+			{
+				_query = query;
+				_count = count;
+				_index = -1;
+			}
+
+			public bool MoveNext() => ++_index < _count;
+
+			public QueryChunk Current => _query.GetChunk(_index);
+		}
+	}
+
+	// One chunk of a query result: Count entities and one native array per queried component.
+	public readonly ref struct QueryChunk
+	{
+		private readonly Type[] _componentTypes;
+		private readonly ReadOnlySpan<IntPtr> _columns;
+		private readonly IntPtr _entities;
+
+		internal QueryChunk(Type[] componentTypes, ReadOnlySpan<IntPtr> columns, IntPtr entities, int count)
+		{
+			_componentTypes = componentTypes;
+			_columns = columns;
+			_entities = entities;
+			Count = count;
+		}
+
+		public int Count { get; }
+
+		// Entity ids of the chunk, or empty when the storage does not provide them.
+		public ReadOnlySpan<ulong> Entities => NativeSpan.Create<ulong>(_entities, Count);
+
+		// Column of the component at this position in the query's type list.
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public Span<T> GetColumn<T>(int index) where T : unmanaged
+		{
+			if ((uint)index >= (uint)_columns.Length || _componentTypes[index] != typeof(T))
+			{
+				throw new ArgumentException($"Component {index} of this query is not {typeof(T).FullName}", nameof(index));
+			}
+
+			return NativeSpan.Create<T>(_columns[index], Count);
+		}
+	}
+}
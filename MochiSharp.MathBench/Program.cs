@@ -0,0 +1,154 @@
+using System;
+using System.Diagnostics;
+using System.Globalization;
+using System.Runtime.InteropServices;
+using MochiSharp.Managed.Mathf;
+
+namespace MochiSharp.MathBench
+{
+	// Times MathBatch against the plain scalar loops it replaces and checks that both produce the
+	// same bits.
+	//
+	//   MochiSharp.MathBench [count] [iterations]
+	internal static class Program
+	{
+		private const float DeltaTime = 1.0f / 60.0f;
+
+		private static int Main(string[] args)
+		{
+			int count = args.Length > 0 ? int.Parse(args[0], CultureInfo.InvariantCulture) : 10_000;
+			int iterations = args.Length > 1 ? int.Parse(args[1], CultureInfo.InvariantCulture) : 2_000;
+			if (count <= 0 || iterations <= 0)
+			{
+				Console.Error.WriteLine("Usage: MochiSharp.MathBench [count] [iterations]");
+				return 2;
+			}
+
+			var random = new Random(1234);
+			var points = new Vector3[count];
+			var velocities = new Vector3[count];
+			var accelerations = new Vector3[count];
+			for (int i = 0; i < count; i++)
+			{
+				points[i] = RandomVector(random, 100.0f);
+				velocities[i] = RandomVector(random, 10.0f);
+				accelerations[i] = RandomVector(random, 1.0f);
+			}
+
+			var transform = new Transform(new Vector3(1.0f, 2.0f, 3.0f), Quaternion.CreateFromYawPitchRoll(0.3f, 0.2f, 0.1f), new Vector3(1.5f, 0.5f, 2.0f));
+			Matrix4x4 matrix = transform.ToMatrix();
+
+			Console.WriteLine($"MathBench: {count} elements, {iterations} iterations");
+			bool identical = true;
+
+			identical &= Compare("TransformPoints", count, iterations,
+				(Span<Vector3> destination) => ScalarTransformPoints(matrix, points, destination),
+				(Span<Vector3> destination) => MathBatch.TransformPoints(matrix, points, destination));
+
+			identical &= Compare("TransformDirections", count, iterations,
+				(Span<Vector3> destination) => ScalarTransformDirections(matrix, velocities, destination),
+				(Span<Vector3> destination) => MathBatch.TransformDirections(matrix, velocities, destination));
+
+			identical &= Compare("Integrate", count, iterations,
+				(Span<Vector3> destination) => { points.CopyTo(destination); ScalarIntegrate(destination, velocities, DeltaTime); },
+				(Span<Vector3> destination) => { points.CopyTo(destination); MathBatch.Integrate(destination, velocities, DeltaTime); });
+
+			var scalarVelocities = new Vector3[count];
+			var batchVelocities = new Vector3[count];
+			identical &= Compare("Integrate (accel)", count, iterations,
+				(Span<Vector3> destination) => { points.CopyTo(destination); velocities.CopyTo(scalarVelocities, 0); ScalarIntegrate(destination, scalarVelocities, accelerations, DeltaTime); },
+				(Span<Vector3> destination) => { points.CopyTo(destination); velocities.CopyTo(batchVelocities, 0); MathBatch.Integrate(destination, batchVelocities, accelerations, DeltaTime); });
+
+			return identical ? 0 : 1;
+		}
+
+		private delegate void BatchAction(Span<Vector3> destination);
+
+		private static bool Compare(string name, int count, int iterations, BatchAction scalar, BatchAction batch)
+		{
+			var scalarResult = new Vector3[count];
+			var batchResult = new Vector3[count];
+
+			// Warm up both paths so tiered compilation has produced optimized code before timing.
+			for (int i = 0; i < 50; i++)
+			{
+				scalar(scalarResult);
+				batch(batchResult);
+			}
+
+			double scalarNs = Time(scalar, scalarResult, iterations) / count;
+			double batchNs = Time(batch, batchResult, iterations) / count;
+
+			bool identical = MemoryMarshal.AsBytes(scalarResult.AsSpan()).SequenceEqual(MemoryMarshal.AsBytes(batchResult.AsSpan()));
+			Console.WriteLine(string.Create(CultureInfo.InvariantCulture,
+				$"{name,-20} scalar {scalarNs,7:F3} ns/elem   batch {batchNs,7:F3} ns/elem   {scalarNs / batchNs,5:F2}x   {(identical ? "bit-identical" : "MISMATCH")}"));
+			return identical;
+		}
+
+		private static double Time(BatchAction action, Vector3[] destination, int iterations)
+		{
+			var stopwatch = Stopwatch.StartNew();
+			for (int i = 0; i < iterations; i++)
+			{
+				action(destination);
+			}
+			return stopwatch.Elapsed.TotalNanoseconds / iterations;
+		}
+
+		private static Vector3 RandomVector(Random random, float range)
+		{
+			return new Vector3(
+				(random.NextSingle() * 2.0f - 1.0f) * range,
+				(random.NextSingle() * 2.0f - 1.0f) * range,
+				(random.NextSingle() * 2.0f - 1.0f) * range);
+		}
+
+		// The scalar loops a script would write by hand; MathBatch must match them exactly.
+		private static void ScalarTransformPoints(in Matrix4x4 m, Vector3[] points, Span<Vector3> destination)
+		{
+			for (int i = 0; i < points.Length; i++)
+			{
+				Vector3 p = points[i];
+				destination[i] = new Vector3(
+					p.X * m.M11 + p.Y * m.M21 + p.Z * m.M31 + m.M41,
+					p.X * m.M12 + p.Y * m.M22 + p.Z * m.M32 + m.M42,
+					p.X * m.M13 + p.Y * m.M23 + p.Z * m.M33 + m.M43);
+			}
+		}
+
+		private static void ScalarTransformDirections(in Matrix4x4 m, Vector3[] directions, Span<Vector3> destination)
+		{
+			for (int i = 0; i < directions.Length; i++)
+			{
+				Vector3 d = directions[i];
+				destination[i] = new Vector3(
+					d.X * m.M11 + d.Y * m.M21 + d.Z * m.M31,
+					d.X * m.M12 + d.Y * m.M22 + d.Z * m.M32,
+					d.X * m.M13 + d.Y * m.M23 + d.Z * m.M33);
+			}
+		}
+
+		private static void ScalarIntegrate(Span<Vector3> positions, Vector3[] velocities, float deltaTime)
+		{
+			for (int i = 0; i < positions.Length; i++)
+			{
+				positions[i].X += velocities[i].X * deltaTime;
+				positions[i].Y += velocities[i].Y * deltaTime;
+				positions[i].Z += velocities[i].Z * deltaTime;
+			}
+		}
+
+		private static void ScalarIntegrate(Span<Vector3> positions, Vector3[] velocities, Vector3[] accelerations, float deltaTime)
+		{
+			for (int i = 0; i < positions.Length; i++)
+			{
+				velocities[i].X += accelerations[i].X * deltaTime;
+				velocities[i].Y += accelerations[i].Y * deltaTime;
+				velocities[i].Z += accelerations[i].Z * deltaTime;
+				positions[i].X += velocities[i].X * deltaTime;
+				positions[i].Y += velocities[i].Y * deltaTime;
+				positions[i].Z += velocities[i].Z * deltaTime;
+			}
+		}
+	}
+}
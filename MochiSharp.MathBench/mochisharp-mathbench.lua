@@ -0,0 +1,31 @@
+project "MochiSharp.MathBench"
+    location "%{wks.location}/MochiSharp.MathBench"
+    kind "ConsoleApp"
+    language "C#"
+    dotnetframework "net9.0"
+
+    targetdir (OUTPUT_DIR)
+    objdir (INTOUTPUT_DIR)
+
+    files {
+        "**.cs"
+    }
+
+    links {
+        "MochiSharp.Managed"
+    }
+
+    filter { "action:vs* or system:windows" }
+        vsprops {
+            AppendTargetFrameworkToOutputPath = "false",
+            Nullable = "enable",
+            CopyLocalLockFileAssemblies = "true",
+            ImplicitUsing = "enable"
+        }
+        
+    filter "configurations:Debug"
+        symbols "on"
+
+    filter "configurations:Release"
+        optimize "on"
+        symbols "off"
\ No newline at end of file
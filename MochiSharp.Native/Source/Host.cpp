@@ -5,22 +5,55 @@
 #include <iomanip>
 #include <assert.h>
 #include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <csignal>
+#include <type_traits>
 #ifdef _WIN32
 #include <combaseapi.h>
-#endif
 
 #define STR(s) L ## s
 #define CH(c) L ## c
 #define DIR_SEPARATOR L'\\'
+#else
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define STR(s) s
+#define CH(c) c
+#define DIR_SEPARATOR '/'
+#define MAX_PATH PATH_MAX
+#endif
 
 hostfxr_initialize_for_runtime_config_fn init_fptr = nullptr;
 hostfxr_get_runtime_delegate_fn get_delegate_fptr = nullptr;
 hostfxr_close_fn close_fptr = nullptr;
+hostfxr_set_runtime_property_value_fn set_property_fptr = nullptr;
 
 #include <filesystem>
 
+// Quiet mode (DotNetHost::SetQuietLogging): script and per-call messages are counted instead of printed.
+static std::atomic<bool> s_QuietLogging{ false };
+static std::atomic<uint64_t> s_SuppressedLogMessages{ 0 };
+
+static void LogHotPath(const char *message)
+{
+    if (s_QuietLogging.load(std::memory_order_relaxed))
+    {
+        s_SuppressedLogMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::cout << "[MochiSharp.Native] " << message << "\n";
+}
+
 static std::filesystem::path GetExecutablePath()
 {
+#ifdef _WIN32
     wchar_t buffer[MAX_PATH];
     DWORD len = GetModuleFileNameW(nullptr, buffer, MAX_PATH);
     if (len == 0)
@@ -28,10 +61,87 @@ static std::filesystem::path GetExecutablePath()
         return std::filesystem::current_path();
     }
     return std::filesystem::path(buffer);
+#else
+    std::error_code error;
+    auto path = std::filesystem::read_symlink("/proc/self/exe", error);
+    return error ? std::filesystem::current_path() : path;
+#endif
+}
+
+static unsigned long GetHostProcessId()
+{
+#ifdef _WIN32
+    return GetCurrentProcessId();
+#else
+    return (unsigned long)getpid();
+#endif
+}
+
+// Strings and name lists returned by managed code are allocated with Marshal.AllocCoTaskMem, which is
+// malloc outside Windows.
+static void FreeManagedMemory(const void *block)
+{
+#ifdef _WIN32
+    CoTaskMemFree((LPVOID)block);
+#else
+    free((void *)block);
+#endif
+}
+
+// hostfxr takes wide strings on Windows; property names and values are ASCII.
+static std::basic_string<char_t> ToHostString(const std::string &text)
+{
+    return std::basic_string<char_t>(text.begin(), text.end());
+}
+
+static void SetProcessEnvironment(const char_t *name, const char_t *value)
+{
+#ifdef _WIN32
+    SetEnvironmentVariableW(name, value);
+#else
+    setenv(name, value, 1);
+#endif
+}
+
+// Decodes (and frees) a CoTaskMem name list from managed code: int32 totalBytes, int32 count,
+// then count x (int32 byteLength, UTF-8 bytes).
+static std::vector<std::string> DecodeNameList(const void *block)
+{
+    std::vector<std::string> names;
+    const uint8_t *result = (const uint8_t *)block;
+    if (!result)
+        return names;
+
+    int32_t totalSize = 0;
+    int32_t count = 0;
+    std::memcpy(&totalSize, result, sizeof(int32_t));
+    std::memcpy(&count, result + sizeof(int32_t), sizeof(int32_t));
+
+    size_t offset = sizeof(int32_t) * 2;
+    names.reserve(count);
+    for (int32_t i = 0; i < count && offset + sizeof(int32_t) <= (size_t)totalSize; i++)
+    {
+        int32_t length = 0;
+        std::memcpy(&length, result + offset, sizeof(int32_t));
+        offset += sizeof(int32_t);
+        if (length < 0 || offset + length > (size_t)totalSize)
+            break;
+
+        names.emplace_back((const char *)result + offset, (size_t)length);
+        offset += length;
+    }
+
+    FreeManagedMemory(result);
+    return names;
 }
 
+// Debugger integration: one line per event to the ignite-debug-events pipe, dropped when nobody
+// listens. Outside Windows it is a FIFO in $XDG_RUNTIME_DIR (or /tmp without one), written only when
+// it is a FIFO owned by this user: anyone can create files in /tmp, so a plain file or a symlink
+// planted there must neither receive the events nor be clobbered by them.
 static void EmitDebugEvent(const std::string &eventPayload)
 {
+#ifdef _WIN32
     HANDLE pipe = CreateFileW(
         L"\\\\.\\pipe\\ignite-debug-events",
         GENERIC_WRITE,
@@ -51,19 +161,39 @@ static void EmitDebugEvent(const std::string &eventPayload)
     WriteFile(pipe, line.c_str(), (DWORD)line.size(), &bytesWritten, nullptr);
     FlushFileBuffers(pipe);
     CloseHandle(pipe);
+#else
+    const char *runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    auto pipePath = std::filesystem::path(runtimeDir && *runtimeDir ? runtimeDir : "/tmp") / "ignite-debug-events";
+    int pipe = open(pipePath.c_str(), O_WRONLY | O_NONBLOCK | O_NOFOLLOW | O_CLOEXEC);
+    if (pipe < 0)
+    {
+        return;
+    }
+
+    struct stat info = {};
+    if (fstat(pipe, &info) != 0 || !S_ISFIFO(info.st_mode) || info.st_uid != geteuid())
+    {
+        close(pipe);
+        return;
+    }
+
+    std::string line = eventPayload + "\n";
+    (void)write(pipe, line.c_str(), line.size());
+    close(pipe);
+#endif
 }
 
 static void EmitRuntimeStartedEvent()
 {
     std::ostringstream payload;
-    payload << "event=runtime-started;pid=" << GetCurrentProcessId();
+    payload << "event=runtime-started;pid=" << GetHostProcessId();
     EmitDebugEvent(payload.str());
 }
 
 static void EmitAssemblyLoadedEvent(const std::filesystem::path &assemblyPath)
 {
     std::ostringstream payload;
-    payload << "event=assembly-loaded;pid=" << GetCurrentProcessId() << ";path=" << assemblyPath.string();
+    payload << "event=assembly-loaded;pid=" << GetHostProcessId() << ";path=" << assemblyPath.string();
     EmitDebugEvent(payload.str());
 }
 
@@ -90,35 +220,141 @@ static std::filesystem::path ResolvePathRelativeToExecutable(const std::filesyst
     return std::filesystem::current_path() / path;
 }
 
+#ifndef _WIN32
+// There is no structured exception handling to trap a fault around Invoke, and a process that took a
+// SIGSEGV in native code cannot safely continue. The handler is installed before the runtime starts,
+// so CoreCLR, which turns faults in managed code into exceptions, installs its own on top and only
+// chains to this one for faults it does not handle. It names the script method that was running
+// (async-signal-safe: write(2) only), then lets the default action terminate the process and dump core.
+static volatile std::sig_atomic_t s_RunningMethodId = 0;
+
+static void WriteSignalSafe(const char *text)
+{
+    size_t length = 0;
+    while (text[length] != '\0')
+    {
+        length++;
+    }
+    (void)write(STDERR_FILENO, text, length);
+}
+
+static void WriteSignalSafe(long value)
+{
+    char digits[24];
+    char *end = digits + sizeof(digits);
+    char *cursor = end;
+    unsigned long magnitude = value < 0 ? 0ul - (unsigned long)value : (unsigned long)value;
+    do
+    {
+        *--cursor = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0 && cursor > digits + 1);
+
+    if (value < 0)
+    {
+        *--cursor = '-';
+    }
+    (void)write(STDERR_FILENO, cursor, (size_t)(end - cursor));
+}
+
+static void OnFatalSignal(int signal)
+{
+    WriteSignalSafe("[MochiSharp.Native] Fatal signal ");
+    WriteSignalSafe((long)signal);
+    if (s_RunningMethodId != 0)
+    {
+        WriteSignalSafe(" while running script method ");
+        WriteSignalSafe((long)s_RunningMethodId);
+    }
+    WriteSignalSafe("\n");
+
+    // SA_RESETHAND restored the default action: returning re-executes the faulting instruction and
+    // raising covers signals that were sent rather than caused by a fault.
+    std::signal(signal, SIG_DFL);
+    raise(signal);
+}
+
+static void InstallFatalSignalHandlers()
+{
+    static bool installed = false;
+    if (installed)
+    {
+        return;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler = &OnFatalSignal;
+    action.sa_flags = SA_RESETHAND | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (int signal : { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT })
+    {
+        sigaction(signal, &action, nullptr);
+    }
+    installed = true;
+}
+#endif
+
 namespace MochiSharp
 {
     void DotNetHost::EngineLog(const char *msg)
     {
-        std::cout << "[MochiSharp.Native] " << msg << "\n";
+        LogHotPath(msg);
+    }
+
+    void DotNetHost::SetQuietLogging(bool quiet)
+    {
+        s_QuietLogging.store(quiet, std::memory_order_relaxed);
+    }
+
+    bool DotNetHost::IsQuietLogging()
+    {
+        return s_QuietLogging.load(std::memory_order_relaxed);
     }
 
-    bool DotNetHost::Init(const std::wstring &configPath)
+    uint64_t DotNetHost::GetSuppressedLogCount()
+    {
+        return s_SuppressedLogMessages.load(std::memory_order_relaxed);
+    }
+
+    bool DotNetHost::Init(const std::filesystem::path &configPath, const HostSettings &settings)
     {
         if (!LoadHostFxr())
         {
             return false;
         }
 
-        auto configFullPath = ResolvePathRelativeToExecutable(std::filesystem::path(configPath));
+        auto configFullPath = ResolvePathRelativeToExecutable(configPath);
         if (!std::filesystem::exists(configFullPath))
         {
-            std::wcout << L"[MochiSharp.Native] runtimeconfig not found: " << configFullPath.wstring() << L"\n";
+            std::cout << "[MochiSharp.Native] runtimeconfig not found: " << configFullPath.string() << "\n";
             return false;
         }
 
+#ifndef _WIN32
+        InstallFatalSignalHandlers();
+#endif
+
         m_BaseDir = configFullPath.parent_path();
 
+        // Read from the environment when the runtime starts (get_delegate_fptr below).
+        if (settings.ReadyToRun)
+        {
+            SetProcessEnvironment(STR("DOTNET_ReadyToRun"), *settings.ReadyToRun ? STR("1") : STR("0"));
+        }
+
         int rc = init_fptr(configFullPath.c_str(), nullptr, &m_Ctx);
         if (rc != 0 || m_Ctx == nullptr)
         {
             return false;
         }
 
+        if (!ApplySettings(settings))
+        {
+            close_fptr(m_Ctx);
+            m_Ctx = nullptr;
+            return false;
+        }
+
         load_assembly_and_get_function_pointer_fn load_assembly_and_get_function_pointer = nullptr;
         rc = get_delegate_fptr(
             m_Ctx,
@@ -131,14 +367,14 @@ namespace MochiSharp
         }
 
         // Load ManagedCore and get the function pointers
-        auto managedCorePath = (m_BaseDir / L"MochiSharp.Managed.dll");
+        auto managedCorePath = (m_BaseDir / "MochiSharp.Managed.dll");
         if (!std::filesystem::exists(managedCorePath))
         {
-            std::wcout << L"[MochiSharp.Native] MochiSharp.Managed.dll not found: " << managedCorePath.wstring() << L"\n";
+            std::cout << "[MochiSharp.Native] MochiSharp.Managed.dll not found: " << managedCorePath.string() << "\n";
             return false;
         }
 
-        std::wcout << L"[MochiSharp.Native] Trying to load " << managedCorePath.wstring() << L" functions\n";
+        std::cout << "[MochiSharp.Native] Trying to load " << managedCorePath.string() << " functions\n";
 
         // Get Initialize
         rc = load_assembly_and_get_function_pointer(
@@ -185,6 +421,21 @@ namespace MochiSharp
             return false;
         }
 
+        // Get RegisterSignatureChecked
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("RegisterSignatureChecked"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedRegisterSignatureChecked);
+
+        if (rc != 0 || ManagedRegisterSignatureChecked == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load RegisterSignatureChecked function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
         // Get CreateInstance
         rc = load_assembly_and_get_function_pointer(
             managedCorePath.c_str(),
@@ -200,6 +451,36 @@ namespace MochiSharp
             return false;
         }
 
+        // Get CreateInstances
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("CreateInstances"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedCreateInstances);
+
+        if (rc != 0 || ManagedCreateInstances == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load CreateInstances function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
+        // Get ConfigureInstancePool
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureInstancePool"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureInstancePool);
+
+        if (rc != 0 || ManagedConfigureInstancePool == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureInstancePool function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
         // Get DestroyInstance
         rc = load_assembly_and_get_function_pointer(
             managedCorePath.c_str(),
@@ -215,6 +496,21 @@ namespace MochiSharp
             return false;
         }
 
+        // Get DestroyInstances
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("DestroyInstances"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedDestroyInstances);
+
+        if (rc != 0 || ManagedDestroyInstances == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load DestroyInstances function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
 		// Get GetInstanceFields
 		rc = load_assembly_and_get_function_pointer(
 			managedCorePath.c_str(),
@@ -305,6 +601,21 @@ namespace MochiSharp
             return false;
         }
 
+        // Get BindMethods
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("BindMethods"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedBindMethods);
+
+        if (rc != 0 || ManagedBindMethods == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load BindMethods function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
         // Get BindStaticMethod
         rc = load_assembly_and_get_function_pointer(
             managedCorePath.c_str(),
@@ -348,91 +659,776 @@ namespace MochiSharp
             std::cout << "[MochiSharp.Native] Failed to load GetDerivedTypes function (rc: 0x" << std::hex << rc << std::dec << ")\n";
         }
 
-        // Call Initialize
-        EngineInterface api;
-        api.LogMessage = &EngineLog;
-        ManagedInit(&api);
-        EmitRuntimeStartedEvent();
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("GetDerivedTypeList"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedGetDerivedTypeList);
 
-        return true;
-    }
+        if (rc != 0 || ManagedGetDerivedTypeList == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load GetDerivedTypeList function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
 
-    bool DotNetHost::LoadAssembly(const char *path)
-    {
-        if (!ManagedLoadAssembly)
+        // Get ConfigureEventRing
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureEventRing"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureEventRing);
+
+        if (rc != 0 || ManagedConfigureEventRing == nullptr)
         {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureEventRing function (rc: 0x" << std::hex << rc << std::dec << ")\n";
             return false;
         }
 
-        std::filesystem::path scriptPath(path);
-        if (!scriptPath.is_absolute())
+        // Get DispatchEvents
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("DispatchEvents"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedDispatchEvents);
+
+        if (rc != 0 || ManagedDispatchEvents == nullptr)
         {
-            scriptPath = m_BaseDir / scriptPath;
+            std::cout << "[MochiSharp.Native] Failed to load DispatchEvents function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
         }
 
-        auto resolved = scriptPath.string();
-        bool loaded = ManagedLoadAssembly(resolved.c_str()) != 0;
-        if (loaded)
+        // Get TickScheduler
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("TickScheduler"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedTickScheduler);
+
+        if (rc != 0 || ManagedTickScheduler == nullptr)
         {
-            EmitAssemblyLoadedEvent(scriptPath);
+            std::cout << "[MochiSharp.Native] Failed to load TickScheduler function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
         }
 
-        return loaded;
-    }
+        // Get ReloadModule
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ReloadModule"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedReloadModule);
 
-    bool DotNetHost::RegisterSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount)
-    {
-        if (!ManagedRegisterSignature)
+        if (rc != 0 || ManagedReloadModule == nullptr)
         {
+            std::cout << "[MochiSharp.Native] Failed to load ReloadModule function (rc: 0x" << std::hex << rc << std::dec << ")\n";
             return false;
         }
 
-        return ManagedRegisterSignature(signatureId, returnTypeName, parameterTypeNames, parameterCount) != 0;
-    }
+        // Get UnloadModule
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("UnloadModule"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedUnloadModule);
 
-    bool DotNetHost::CreateInstance(const char *typeName, uint64_t instanceId)
-    {
-        if (!ManagedCreateInstance)
+        if (rc != 0 || ManagedUnloadModule == nullptr)
         {
+            std::cout << "[MochiSharp.Native] Failed to load UnloadModule function (rc: 0x" << std::hex << rc << std::dec << ")\n";
             return false;
         }
 
-        return ManagedCreateInstance(typeName, instanceId) != 0;
-    }
+        // Get LoadSharedAssembly
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("LoadSharedAssembly"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedLoadSharedAssembly);
 
-    void DotNetHost::DestroyInstance(uint64_t instanceId)
-    {
-        if (ManagedDestroyInstance)
+        if (rc != 0 || ManagedLoadSharedAssembly == nullptr)
         {
-            ManagedDestroyInstance(instanceId);
+            std::cout << "[MochiSharp.Native] Failed to load LoadSharedAssembly function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
         }
-    }
 
-	std::string DotNetHost::GetInstanceFields(uint64_t instanceId)
-	{
-		if (!ManagedGetInstanceFields)
-		{
-			return {};
-		}
+        // Get GetModuleFiles
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("GetModuleFiles"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedGetModuleFiles);
 
-		const char *result = ManagedGetInstanceFields(instanceId);
-		if (!result)
-		{
-			return {};
-		}
+        if (rc != 0 || ManagedGetModuleFiles == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load GetModuleFiles function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
 
-		std::string managedResult(result);
-#ifdef _WIN32
-		CoTaskMemFree((LPVOID)result);
-#endif
-		return managedResult;
-	}
+        // Get LoadAssemblyFromMemory
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("LoadAssemblyFromMemory"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedLoadAssemblyFromMemory);
 
-    std::string DotNetHost::GetTypeFields(const char *typeName)
-    {
-        if (!ManagedGetTypeFields)
+        if (rc != 0 || ManagedLoadAssemblyFromMemory == nullptr)
         {
-            return {};
+            std::cout << "[MochiSharp.Native] Failed to load LoadAssemblyFromMemory function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
+        // Get ConfigureFaultPolicy
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureFaultPolicy"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureFaultPolicy);
+
+        if (rc != 0 || ManagedConfigureFaultPolicy == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureFaultPolicy function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
+        // Get EnableMethod
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("EnableMethod"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedEnableMethod);
+
+        if (rc != 0 || ManagedEnableMethod == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load EnableMethod function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
+        // Get GetMethodFaults
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("GetMethodFaults"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedGetMethodFaults);
+
+        if (rc != 0 || ManagedGetMethodFaults == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load GetMethodFaults function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
+        // Get GetLastInvokeError
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("GetLastInvokeError"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedGetLastInvokeError);
+
+        if (rc != 0 || ManagedGetLastInvokeError == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load GetLastInvokeError function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
+        // Get DisableMethod
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("DisableMethod"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedDisableMethod);
+
+        if (rc != 0 || ManagedDisableMethod == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load DisableMethod function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+            return false;
+        }
+
+        // Get ConfigureWatchdog
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureWatchdog"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureWatchdog);
+
+        if (rc != 0 || ManagedConfigureWatchdog == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureWatchdog function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get GetSignatureLayout
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("GetSignatureLayout"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedGetSignatureLayout);
+
+        if (rc != 0 || ManagedGetSignatureLayout == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load GetSignatureLayout function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get RegisterComponent
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("RegisterComponent"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedRegisterComponent);
+
+        if (rc != 0 || ManagedRegisterComponent == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load RegisterComponent function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get ConfigureComponentStorage
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureComponentStorage"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureComponentStorage);
+
+        if (rc != 0 || ManagedConfigureComponentStorage == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureComponentStorage function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get ConfigureFrameArena
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureFrameArena"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureFrameArena);
+
+        if (rc != 0 || ManagedConfigureFrameArena == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureFrameArena function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get ConfigureUnloadTracking
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureUnloadTracking"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureUnloadTracking);
+
+        if (rc != 0 || ManagedConfigureUnloadTracking == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureUnloadTracking function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get GetUnloadReport
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("GetUnloadReport"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedGetUnloadReport);
+
+        if (rc != 0 || ManagedGetUnloadReport == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load GetUnloadReport function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get ConfigureFieldTracking
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureFieldTracking"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureFieldTracking);
+
+        if (rc != 0 || ManagedConfigureFieldTracking == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureFieldTracking function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get CollectDirtyFields
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("CollectDirtyFields"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedCollectDirtyFields);
+
+        if (rc != 0 || ManagedCollectDirtyFields == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load CollectDirtyFields function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get ConfigureReplication
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ConfigureReplication"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedConfigureReplication);
+
+        if (rc != 0 || ManagedConfigureReplication == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ConfigureReplication function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get CaptureSnapshot
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("CaptureSnapshot"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedCaptureSnapshot);
+
+        if (rc != 0 || ManagedCaptureSnapshot == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load CaptureSnapshot function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Get ApplySnapshot
+        rc = load_assembly_and_get_function_pointer(
+            managedCorePath.c_str(),
+            STR("MochiSharp.Managed.Core.Bootstrap, MochiSharp.Managed"),
+            STR("ApplySnapshot"),
+            UNMANAGEDCALLERSONLY_METHOD,
+            nullptr,
+            (void **)&ManagedApplySnapshot);
+
+        if (rc != 0 || ManagedApplySnapshot == nullptr)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load ApplySnapshot function (rc: 0x" << std::hex << rc << std::dec << ")\n";
+        }
+
+        // Call Initialize
+        EngineInterface api;
+        api.LogMessage = &EngineLog;
+        ManagedInit(&api);
+        EmitRuntimeStartedEvent();
+
+        return true;
+    }
+
+    std::filesystem::path DotNetHost::ResolveScriptPath(const char *path) const
+    {
+        std::filesystem::path scriptPath(path);
+        if (!scriptPath.is_absolute())
+        {
+            scriptPath = m_BaseDir / scriptPath;
+        }
+
+        return scriptPath;
+    }
+
+    bool DotNetHost::LoadAssembly(const char *path)
+    {
+        return LoadModule(path) != 0;
+    }
+
+    int DotNetHost::LoadModule(const char *path)
+    {
+        if (!ManagedLoadAssembly)
+        {
+            return 0;
+        }
+
+        auto scriptPath = ResolveScriptPath(path);
+        auto resolved = scriptPath.string();
+        int moduleHandle = ManagedLoadAssembly(resolved.c_str());
+        if (moduleHandle != 0)
+        {
+            EmitAssemblyLoadedEvent(scriptPath);
+            if (m_Recorder.IsRecording())
+            {
+                m_Recorder.RecordLoadModule(moduleHandle, resolved);
+            }
+        }
+
+        return moduleHandle;
+    }
+
+    int DotNetHost::LoadModuleFromMemory(const char *name, const void *image, size_t imageSize, const void *symbols, size_t symbolsSize)
+    {
+        if (!ManagedLoadAssemblyFromMemory || image == nullptr || imageSize == 0 || imageSize > INT32_MAX || symbolsSize > INT32_MAX)
+        {
+            return 0;
+        }
+
+        auto scriptPath = ResolveScriptPath(name);
+        auto resolved = scriptPath.string();
+        int moduleHandle = ManagedLoadAssemblyFromMemory(resolved.c_str(), image, (int)imageSize, symbols, symbols ? (int)symbolsSize : 0);
+        if (moduleHandle != 0)
+        {
+            EmitAssemblyLoadedEvent(scriptPath);
+            if (m_Recorder.IsRecording())
+            {
+                m_Recorder.RecordLoadModuleFromMemory(moduleHandle, resolved, image, imageSize, symbols, symbolsSize);
+            }
+        }
+
+        return moduleHandle;
+    }
+
+    bool DotNetHost::ReloadModule(int moduleHandle)
+    {
+        if (!ManagedReloadModule)
+        {
+            return false;
+        }
+
+        return ManagedReloadModule(moduleHandle) != 0;
+    }
+
+    bool DotNetHost::ConfigureUnloadTracking(int maxCollections, bool diagnostics)
+    {
+        if (!ManagedConfigureUnloadTracking)
+        {
+            return false;
+        }
+
+        return ManagedConfigureUnloadTracking(maxCollections, diagnostics ? 1 : 0) != 0;
+    }
+
+    bool DotNetHost::GetUnloadReport(int moduleHandle, ScriptUnloadReport &report, std::string *roots)
+    {
+        if (!ManagedGetUnloadReport)
+        {
+            return false;
+        }
+
+        const char *result = ManagedGetUnloadReport(moduleHandle, &report);
+        if (!result)
+        {
+            return false;
+        }
+
+        if (roots)
+        {
+            *roots = result;
+        }
+        FreeManagedMemory(result);
+        return true;
+    }
+
+    bool DotNetHost::UnloadModule(int moduleHandle)
+    {
+        if (!ManagedUnloadModule)
+        {
+            return false;
+        }
+
+        if (ManagedUnloadModule(moduleHandle) == 0)
+        {
+            return false;
+        }
+
+        m_Watcher.Unwatch(moduleHandle);
+        return true;
+    }
+
+    std::vector<std::string> DotNetHost::GetModuleFiles(int moduleHandle)
+    {
+        if (!ManagedGetModuleFiles)
+        {
+            return {};
+        }
+
+        return DecodeNameList(ManagedGetModuleFiles(moduleHandle));
+    }
+
+    bool DotNetHost::WatchModule(int moduleHandle, std::chrono::milliseconds debounce)
+    {
+        std::vector<std::filesystem::path> files;
+        for (const auto &file : GetModuleFiles(moduleHandle))
+        {
+            files.emplace_back(std::u8string(file.begin(), file.end()));
+        }
+
+        if (!m_Watcher.Watch(moduleHandle, std::move(files)))
+        {
+            return false;
+        }
+
+        return m_Watcher.IsRunning() || m_Watcher.Start(debounce);
+    }
+
+    std::vector<int> DotNetHost::ApplyPendingReloads()
+    {
+        std::vector<int> reloaded;
+        for (int moduleHandle : m_Watcher.TakePendingReloads())
+        {
+            // A failed reload (e.g. a broken build) keeps the old module; either way the watcher
+            // records the current files so only the next change is reported.
+            if (ReloadModule(moduleHandle))
+            {
+                reloaded.push_back(moduleHandle);
+            }
+
+            if (!WatchModule(moduleHandle))
+            {
+                m_Watcher.Unwatch(moduleHandle);
+            }
+        }
+
+        return reloaded;
+    }
+
+    bool DotNetHost::LoadSharedAssembly(const char *path)
+    {
+        if (!ManagedLoadSharedAssembly)
+        {
+            return false;
+        }
+
+        auto resolved = ResolveScriptPath(path).string();
+        if (ManagedLoadSharedAssembly(resolved.c_str()) == 0)
+        {
+            return false;
+        }
+
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordLoadSharedAssembly(resolved);
+        }
+
+        return true;
+    }
+
+    bool DotNetHost::RegisterSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount)
+    {
+        if (!ManagedRegisterSignature)
+        {
+            return false;
+        }
+
+        if (ManagedRegisterSignature(signatureId, returnTypeName, parameterTypeNames, parameterCount) == 0)
+        {
+            return false;
+        }
+
+        m_RegisteredSignatures.insert(signatureId);
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordRegisterSignature(signatureId, returnTypeName, parameterTypeNames, parameterCount, nullptr, nullptr, GetSignatureLayout(signatureId));
+        }
+        return true;
+    }
+
+    bool DotNetHost::RegisterSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount, const int *nativeSizes, const int *nativeAlignments)
+    {
+        if (!ManagedRegisterSignatureChecked)
+        {
+            return false;
+        }
+
+        if (ManagedRegisterSignatureChecked(signatureId, returnTypeName, parameterTypeNames, parameterCount, nativeSizes, nativeAlignments) == 0)
+        {
+            return false;
+        }
+
+        m_RegisteredSignatures.insert(signatureId);
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordRegisterSignature(signatureId, returnTypeName, parameterTypeNames, parameterCount, nativeSizes, nativeAlignments, GetSignatureLayout(signatureId));
+        }
+        return true;
+    }
+
+    bool DotNetHost::EnsureSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount, const int *nativeSizes, const int *nativeAlignments)
+    {
+        if (m_RegisteredSignatures.contains(signatureId))
+        {
+            return true;
+        }
+
+        if (nativeSizes != nullptr)
+        {
+            return RegisterSignature(signatureId, returnTypeName, parameterTypeNames, parameterCount, nativeSizes, nativeAlignments);
+        }
+
+        return RegisterSignature(signatureId, returnTypeName, parameterTypeNames, parameterCount);
+    }
+
+    bool DotNetHost::CreateInstance(const char *typeName, uint64_t instanceId)
+    {
+        if (!ManagedCreateInstance)
+        {
+            return false;
+        }
+
+        if (ManagedCreateInstance(typeName, instanceId) == 0)
+        {
+            return false;
+        }
+
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordCreateInstance(instanceId, typeName);
+        }
+
+        return true;
+    }
+
+    std::vector<uint8_t> DotNetHost::CreateInstances(const char *typeName, const uint64_t *instanceIds, int count)
+    {
+        std::vector<uint8_t> resultBitmap(count > 0 ? (count + 7) / 8 : 0, 0);
+        if (!ManagedCreateInstances || count <= 0 || instanceIds == nullptr)
+        {
+            return resultBitmap;
+        }
+
+        if (ManagedCreateInstances(typeName, instanceIds, count, resultBitmap.data()) < 0)
+        {
+            std::fill(resultBitmap.begin(), resultBitmap.end(), 0);
+        }
+        else if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordCreateInstances(typeName, instanceIds, count);
+        }
+
+        return resultBitmap;
+    }
+
+    bool DotNetHost::ConfigureInstancePool(const char *typeName, int capacity)
+    {
+        if (!ManagedConfigureInstancePool)
+        {
+            return false;
+        }
+
+        if (ManagedConfigureInstancePool(typeName, capacity) == 0)
+        {
+            return false;
+        }
+
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordConfigureInstancePool(typeName, capacity);
+        }
+
+        return true;
+    }
+
+    void DotNetHost::DestroyInstance(uint64_t instanceId)
+    {
+        if (ManagedDestroyInstance)
+        {
+            ManagedDestroyInstance(instanceId);
+            if (m_Recorder.IsRecording())
+            {
+                m_Recorder.RecordDestroyInstance(instanceId);
+            }
+        }
+    }
+
+    void DotNetHost::QueueDestroyInstance(uint64_t instanceId)
+    {
+        m_DestroyQueue.push_back(instanceId);
+    }
+
+    int DotNetHost::FlushDestroyQueue(double budgetMilliseconds)
+    {
+        if (!ManagedDestroyInstances || (m_DestroyQueue.empty() && m_PendingDestroyCount == 0))
+        {
+            return m_PendingDestroyCount;
+        }
+
+        int pending = ManagedDestroyInstances(m_DestroyQueue.data(), (int)m_DestroyQueue.size(), budgetMilliseconds);
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordDestroyInstances(m_DestroyQueue.data(), (int)m_DestroyQueue.size(), budgetMilliseconds);
+        }
+        m_DestroyQueue.clear();
+        // On failure (-1) the managed queue may still hold instances; keep flushing until it reports none.
+        m_PendingDestroyCount = pending >= 0 ? pending : std::max(m_PendingDestroyCount, 1);
+        return m_PendingDestroyCount;
+    }
+
+    void DotNetHost::SetDestroyBudget(double budgetMilliseconds)
+    {
+        m_DestroyBudgetMilliseconds = budgetMilliseconds > 0.0 ? budgetMilliseconds : 0.0;
+    }
+
+    void DotNetHost::EndFrame()
+    {
+        FlushDestroyQueue(m_DestroyBudgetMilliseconds);
+        m_Watchdog.EndFrame();
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordEndFrame();
+        }
+
+        m_FrameArena.Reset();
+    }
+
+    bool DotNetHost::InitFrameArena(size_t capacity)
+    {
+        if (!ManagedConfigureFrameArena || !m_FrameArena.Init(capacity))
+        {
+            return false;
+        }
+
+        return ManagedConfigureFrameArena(m_FrameArena.GetBuffer(), (int)m_FrameArena.GetBufferSize()) != 0;
+    }
+
+	std::string DotNetHost::GetInstanceFields(uint64_t instanceId)
+	{
+		if (!ManagedGetInstanceFields)
+		{
+			return {};
+		}
+
+		const char *result = ManagedGetInstanceFields(instanceId);
+		if (!result)
+		{
+			return {};
+		}
+
+		std::string managedResult(result);
+		FreeManagedMemory(result);
+		return managedResult;
+	}
+
+    std::string DotNetHost::GetTypeFields(const char *typeName)
+    {
+        if (!ManagedGetTypeFields)
+        {
+            return {};
         }
 
         const char *result = ManagedGetTypeFields(typeName);
@@ -442,9 +1438,7 @@ namespace MochiSharp
         }
 
         std::string managedResult(result);
-#ifdef _WIN32
-        CoTaskMemFree((LPVOID)result);
-#endif
+        FreeManagedMemory(result);
         return managedResult;
     }
 
@@ -465,7 +1459,99 @@ namespace MochiSharp
             return false;
         }
 
-        return ManagedSetInstanceFieldValue(instanceId, fieldName, buffer, bufferSize) != 0;
+        if (ManagedSetInstanceFieldValue(instanceId, fieldName, buffer, bufferSize) == 0)
+        {
+            return false;
+        }
+
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordSetFieldValue(instanceId, fieldName, buffer, bufferSize);
+        }
+
+        return true;
+    }
+
+    int DotNetHost::ConfigureFieldTracking(const char *typeName, bool enabled)
+    {
+        if (!ManagedConfigureFieldTracking)
+        {
+            return -1;
+        }
+
+        return ManagedConfigureFieldTracking(typeName, enabled ? 1 : 0);
+    }
+
+    int DotNetHost::CollectDirtyFields(void *buffer, size_t bufferSize, size_t *bytesWritten)
+    {
+        if (bytesWritten)
+        {
+            *bytesWritten = 0;
+        }
+
+        if (!ManagedCollectDirtyFields)
+        {
+            return -1;
+        }
+
+        int written = 0;
+        int count = ManagedCollectDirtyFields(buffer, (int)std::min<size_t>(bufferSize, INT32_MAX), &written);
+        if (bytesWritten && count >= 0)
+        {
+            *bytesWritten = (size_t)written;
+        }
+
+        return count;
+    }
+
+    bool DotNetHost::ConfigureReplication(const char *replicatedAttributeTypeName)
+    {
+        if (!ManagedConfigureReplication)
+        {
+            return false;
+        }
+
+        return ManagedConfigureReplication(replicatedAttributeTypeName) != 0;
+    }
+
+    bool DotNetHost::CaptureSnapshot(std::vector<uint8_t> &snapshot)
+    {
+        if (!ManagedCaptureSnapshot)
+        {
+            return false;
+        }
+
+        // A second attempt is needed only when instances were added since the last capture.
+        snapshot.resize(std::max<size_t>(snapshot.capacity(), sizeof(ScriptSnapshotHeader)));
+        for (int attempt = 0; attempt < 2; attempt++)
+        {
+            int size = ManagedCaptureSnapshot(snapshot.data(), (int)std::min<size_t>(snapshot.size(), INT32_MAX));
+            if (size < 0)
+            {
+                snapshot.clear();
+                return false;
+            }
+
+            bool complete = (size_t)size <= snapshot.size();
+            snapshot.resize((size_t)size);
+            if (complete)
+            {
+                return true;
+            }
+        }
+
+        snapshot.clear();
+        return false;
+    }
+
+    int DotNetHost::ApplySnapshot(const void *snapshot, size_t snapshotSize, const void *previous, size_t previousSize)
+    {
+        if (!ManagedApplySnapshot || snapshotSize > INT32_MAX || previousSize > INT32_MAX)
+        {
+            return -1;
+        }
+
+        return ManagedApplySnapshot(snapshot, (int)snapshotSize, previous, (int)previousSize);
     }
 
     bool DotNetHost::ConfigureSerialization(const char *serializeFieldAttributeTypeName, const char *entityTypeName)
@@ -475,7 +1561,17 @@ namespace MochiSharp
             return false;
         }
 
-        return ManagedConfigureSerialization(serializeFieldAttributeTypeName, entityTypeName) != 0;
+        if (ManagedConfigureSerialization(serializeFieldAttributeTypeName, entityTypeName) == 0)
+        {
+            return false;
+        }
+
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordConfigureSerialization(serializeFieldAttributeTypeName, entityTypeName);
+        }
+
+        return true;
     }
 
 	int DotNetHost::BindInstanceMethod(uint64_t instanceId, const char *methodName, int signature)
@@ -485,7 +1581,41 @@ namespace MochiSharp
             return 0;
         }
 
-        return ManagedBindInstanceMethod(instanceId, methodName, signature);
+        int methodId = ManagedBindInstanceMethod(instanceId, methodName, signature);
+        if (methodId != 0 && m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordBindInstanceMethod(methodId, instanceId, methodName, signature);
+        }
+
+        return methodId;
+    }
+
+    int DotNetHost::BindMethods(uint64_t instanceId, const char **methodNames, const int *signatures, int count, int *outMethodIds)
+    {
+        if (count <= 0 || outMethodIds == nullptr)
+        {
+            return 0;
+        }
+
+        std::fill(outMethodIds, outMethodIds + count, 0);
+        if (!ManagedBindMethods)
+        {
+            return 0;
+        }
+
+        int bound = ManagedBindMethods(instanceId, methodNames, signatures, count, outMethodIds);
+        if (m_Recorder.IsRecording())
+        {
+            // Replayed as single binds: only the resulting method ids matter.
+            for (int i = 0; i < count; i++)
+            {
+                if (outMethodIds[i] != 0)
+                {
+                    m_Recorder.RecordBindInstanceMethod(outMethodIds[i], instanceId, methodNames[i], signatures[i]);
+                }
+            }
+        }
+        return bound > 0 ? bound : 0;
     }
 
     int DotNetHost::BindStaticMethod(const char *typeName, const char *methodName, int signature)
@@ -495,41 +1625,155 @@ namespace MochiSharp
             return 0;
         }
 
-        return ManagedBindStaticMethod(typeName, methodName, signature);
+        int methodId = ManagedBindStaticMethod(typeName, methodName, signature);
+        if (methodId != 0 && m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordBindStaticMethod(methodId, typeName, methodName, signature);
+        }
+
+        return methodId;
     }
 
     bool DotNetHost::Invoke(int methodId, const void *argsPtr, int argCount, void *returnPtr)
+    {
+        return TryInvoke(methodId, argsPtr, argCount, returnPtr) == InvokeStatus::Ok;
+    }
+
+    InvokeStatus DotNetHost::TryInvoke(int methodId, const void *argsPtr, int argCount, void *returnPtr)
     {
         if (!ManagedInvoke)
-            return false;
+            return InvokeStatus::InternalError;
 
         if (argCount < 0)
         {
-            std::cout << "[MochiSharp.Native] Invoke failed: negative argCount\n";
-            return false;
+            LogHotPath("Invoke failed: negative argCount");
+            return InvokeStatus::BadArguments;
         }
 
         if (argCount > 0 && argsPtr == nullptr)
         {
-            std::cout << "[MochiSharp.Native] Invoke failed: argsPtr is null with argCount > 0\n";
-            return false;
+            LogHotPath("Invoke failed: argsPtr is null with argCount > 0");
+            return InvokeStatus::BadArguments;
         }
 
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordInvoke(methodId, argsPtr, argCount);
+        }
+
+        InvokeStatus status;
+        m_Watchdog.BeginCall(methodId);
 #ifdef _WIN32
         __try
         {
-            int result = ManagedInvoke(methodId, argsPtr, argCount, returnPtr);
-            return result != 0;
+            status = (InvokeStatus)ManagedInvoke(methodId, argsPtr, argCount, returnPtr);
         }
         __except (EXCEPTION_EXECUTE_HANDLER)
         {
-            std::cout << "[MochiSharp.Native] Invoke trapped structured exception (possible script runtime fault)\n";
-            return false;
+            LogHotPath("Invoke trapped structured exception (possible script runtime fault)");
+            status = InvokeStatus::NativeFault;
         }
 #else
-        int result = ManagedInvoke(methodId, argsPtr, argCount, returnPtr);
-        return result != 0;
+        std::sig_atomic_t outerMethodId = s_RunningMethodId;
+        s_RunningMethodId = methodId;
+        status = (InvokeStatus)ManagedInvoke(methodId, argsPtr, argCount, returnPtr);
+        s_RunningMethodId = outerMethodId;
 #endif
+        if (m_Watchdog.EndCall() && m_Watchdog.GetSettings().DisableOverBudgetMethods)
+        {
+            DisableMethod(methodId);
+        }
+
+        return status;
+    }
+
+    bool DotNetHost::ConfigureFaultPolicy(int maxConsecutiveFaults)
+    {
+        if (!ManagedConfigureFaultPolicy)
+        {
+            return false;
+        }
+
+        return ManagedConfigureFaultPolicy(maxConsecutiveFaults) != 0;
+    }
+
+    bool DotNetHost::EnableMethod(int methodId)
+    {
+        if (!ManagedEnableMethod)
+        {
+            return false;
+        }
+
+        return ManagedEnableMethod(methodId) != 0;
+    }
+
+    bool DotNetHost::DisableMethod(int methodId)
+    {
+        if (!ManagedDisableMethod)
+        {
+            return false;
+        }
+
+        return ManagedDisableMethod(methodId) != 0;
+    }
+
+    bool DotNetHost::StartWatchdog(ScriptWatchdogSettings settings)
+    {
+        if (!m_Watchdog.Start(std::move(settings)))
+        {
+            return false;
+        }
+
+        // Optional: without it scripts just never see an abort request.
+        if (ManagedConfigureWatchdog)
+        {
+            ManagedConfigureWatchdog(m_Watchdog.GetSharedState());
+        }
+
+        return true;
+    }
+
+    void DotNetHost::StopWatchdog()
+    {
+        m_Watchdog.Stop();
+    }
+
+    bool DotNetHost::GetMethodFaults(int methodId, InvokeFaultInfo &info)
+    {
+        if (!ManagedGetMethodFaults)
+        {
+            return false;
+        }
+
+        return ManagedGetMethodFaults(methodId, &info) != 0;
+    }
+
+    InvokeStatus DotNetHost::GetLastInvokeError(InvokeFaultInfo *info, std::string *message)
+    {
+        if (!ManagedGetLastInvokeError)
+        {
+            return InvokeStatus::Ok;
+        }
+
+        InvokeFaultInfo record;
+        const char *result = ManagedGetLastInvokeError(&record);
+        if (!result)
+        {
+            return InvokeStatus::Ok;
+        }
+
+        if (message)
+        {
+            *message = result;
+        }
+        FreeManagedMemory(result);
+
+        if (info)
+        {
+            *info = record;
+        }
+
+        return (InvokeStatus)record.Status;
     }
 
     std::string DotNetHost::GetDerivedTypes(const char *asmPath, const char *baseType)
@@ -542,12 +1786,108 @@ namespace MochiSharp
             return {};
 
         std::string managedResult(result);
-#ifdef _WIN32
-        CoTaskMemFree((LPVOID)result);
-#endif
+        FreeManagedMemory(result);
         return managedResult;
 	}
 
+    std::vector<std::string> DotNetHost::GetDerivedTypeList(const char *asmPath, const char *baseType)
+    {
+        if (!ManagedGetDerivedTypeList)
+            return {};
+
+        return DecodeNameList(ManagedGetDerivedTypeList(asmPath, baseType));
+    }
+
+    bool DotNetHost::InitEvents(uint32_t slotCount, uint32_t maxPayloadSize)
+    {
+        if (!ManagedConfigureEventRing || !m_Events.Init(slotCount, maxPayloadSize))
+        {
+            return false;
+        }
+
+        return ManagedConfigureEventRing(m_Events.GetBuffer(), (int)m_Events.GetBufferSize()) != 0;
+    }
+
+    int DotNetHost::DispatchEvents()
+    {
+        if (!ManagedDispatchEvents || !m_Events.IsInitialized())
+        {
+            return -1;
+        }
+
+        if (m_Events.GetPendingCount() == 0)
+        {
+            return 0;
+        }
+
+        return ManagedDispatchEvents();
+    }
+
+    int DotNetHost::TickScheduler(double deltaSeconds)
+    {
+        if (!ManagedTickScheduler)
+        {
+            return -1;
+        }
+
+        if (m_Recorder.IsRecording())
+        {
+            m_Recorder.RecordTickScheduler(deltaSeconds);
+        }
+
+        return ManagedTickScheduler(deltaSeconds);
+    }
+
+    bool DotNetHost::RegisterComponent(int componentId, const char *typeName, int size)
+    {
+        if (!ManagedRegisterComponent || !typeName || size <= 0)
+        {
+            return false;
+        }
+
+        return ManagedRegisterComponent(componentId, typeName, size) != 0;
+    }
+
+    bool DotNetHost::SetComponentStorage(ScriptComponentStorage *storage)
+    {
+        if (!ManagedConfigureComponentStorage)
+        {
+            return false;
+        }
+
+        m_Components.SetStorage(storage);
+        void *queryFunction = storage ? reinterpret_cast<void *>(&ScriptComponentBridge::QueryChunks) : nullptr;
+        return ManagedConfigureComponentStorage(queryFunction, storage ? &m_Components : nullptr) != 0;
+    }
+
+    std::vector<int> DotNetHost::GetSignatureLayout(int signatureId)
+    {
+        if (!ManagedGetSignatureLayout)
+        {
+            return {};
+        }
+
+        int count = ManagedGetSignatureLayout(signatureId, nullptr, 0);
+        if (count <= 0)
+        {
+            return {};
+        }
+
+        std::vector<int> sizes((size_t)count);
+        ManagedGetSignatureLayout(signatureId, sizes.data(), count);
+        return sizes;
+    }
+
+    bool DotNetHost::StartRecording(const std::filesystem::path &path)
+    {
+        return m_Recorder.Start(path);
+    }
+
+    void DotNetHost::StopRecording()
+    {
+        m_Recorder.Stop();
+    }
+
 	bool DotNetHost::LoadHostFxr()
     {
         char_t buffer[MAX_PATH];
@@ -558,12 +1898,124 @@ namespace MochiSharp
             return false;
         }
 
+#ifdef _WIN32
         HMODULE lib = LoadLibraryW(buffer);
+        if (!lib)
+        {
+            return false;
+        }
+
         init_fptr = (hostfxr_initialize_for_runtime_config_fn)GetProcAddress(lib, "hostfxr_initialize_for_runtime_config");
         get_delegate_fptr = (hostfxr_get_runtime_delegate_fn)GetProcAddress(lib, "hostfxr_get_runtime_delegate");
         close_fptr = (hostfxr_close_fn)GetProcAddress(lib, "hostfxr_close");
+        set_property_fptr = (hostfxr_set_runtime_property_value_fn)GetProcAddress(lib, "hostfxr_set_runtime_property_value");
+#else
+        void *lib = dlopen(buffer, RTLD_NOW | RTLD_LOCAL);
+        if (!lib)
+        {
+            std::cout << "[MochiSharp.Native] Failed to load " << buffer << ": " << dlerror() << "\n";
+            return false;
+        }
+
+        init_fptr = (hostfxr_initialize_for_runtime_config_fn)dlsym(lib, "hostfxr_initialize_for_runtime_config");
+        get_delegate_fptr = (hostfxr_get_runtime_delegate_fn)dlsym(lib, "hostfxr_get_runtime_delegate");
+        close_fptr = (hostfxr_close_fn)dlsym(lib, "hostfxr_close");
+        set_property_fptr = (hostfxr_set_runtime_property_value_fn)dlsym(lib, "hostfxr_set_runtime_property_value");
+#endif
+
+        return (init_fptr && get_delegate_fptr && close_fptr && set_property_fptr);
+    }
+
+    bool DotNetHost::ApplySettings(const HostSettings &settings)
+    {
+        std::vector<std::pair<std::string, std::string>> properties;
+        auto add = [&properties](const char *name, const auto &value)
+        {
+            if (!value)
+            {
+                return;
+            }
+
+            if constexpr (std::is_same_v<std::decay_t<decltype(*value)>, bool>)
+            {
+                properties.emplace_back(name, *value ? "true" : "false");
+            }
+            else
+            {
+                properties.emplace_back(name, std::to_string(*value));
+            }
+        };
+
+        add("System.GC.Server", settings.ServerGC);
+        add("System.GC.Concurrent", settings.ConcurrentGC);
+        add("System.GC.RetainVM", settings.RetainVM);
+        add("System.GC.HeapHardLimit", settings.HeapHardLimit);
+        add("System.GC.HeapCount", settings.HeapCount);
+        add("System.Runtime.TieredCompilation", settings.TieredCompilation);
+        add("System.Runtime.TieredCompilation.QuickJit", settings.QuickJit);
+        add("System.Runtime.TieredCompilation.QuickJitForLoops", settings.QuickJitForLoops);
+        add("System.Runtime.TieredPGO", settings.TieredPGO);
+        properties.insert(properties.end(), settings.Properties.begin(), settings.Properties.end());
+
+        for (const auto &[name, value] : properties)
+        {
+            int rc = set_property_fptr(m_Ctx, ToHostString(name).c_str(), ToHostString(value).c_str());
+            if (rc != 0)
+            {
+                std::cout << "[MochiSharp.Native] Failed to set runtime property " << name << "=" << value << " (rc: 0x" << std::hex << rc << std::dec << ")\n";
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    HostSettings HostSettings::LowLatencyClient()
+    {
+        HostSettings settings;
+        settings.ServerGC = false;
+        settings.ConcurrentGC = true;
+        settings.RetainVM = true;
+        settings.TieredCompilation = true;
+        settings.QuickJitForLoops = false;
+        settings.TieredPGO = false;
+        settings.ReadyToRun = true;
+        return settings;
+    }
+
+    HostSettings HostSettings::ThroughputServer()
+    {
+        HostSettings settings;
+        settings.ServerGC = true;
+        settings.ConcurrentGC = false;
+        settings.RetainVM = true;
+        settings.TieredCompilation = true;
+        settings.QuickJitForLoops = true;
+        settings.TieredPGO = true;
+        settings.ReadyToRun = true;
+        return settings;
+    }
+
+    bool HostSettings::FromPreset(std::string_view name, HostSettings &settings)
+    {
+        if (name == "default")
+        {
+            settings = {};
+        }
+        else if (name == "low-latency-client")
+        {
+            settings = LowLatencyClient();
+        }
+        else if (name == "throughput-server")
+        {
+            settings = ThroughputServer();
+        }
+        else
+        {
+            return false;
+        }
 
-        return (init_fptr && get_delegate_fptr && close_fptr);
+        return true;
     }
 
 }
\ No newline at end of file
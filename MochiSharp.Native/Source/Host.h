@@ -11,43 +11,168 @@
 
 #include <vector>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <filesystem>
+#include <unordered_set>
+#include <utility>
 
 #include <nethost.h>
 
+#include "ScriptArena.h"
+#include "ScriptComponents.h"
+#include "ScriptEvents.h"
+#include "ScriptFieldChanges.h"
+#include "ScriptWatcher.h"
+#include "ScriptWatchdog.h"
+#include "ScriptRecorder.h"
+#include "ScriptSnapshot.h"
+
 #include <coreclr_delegates.h>
 #include <hostfxr.h>
 
 extern hostfxr_initialize_for_runtime_config_fn init_fptr;
 extern hostfxr_get_runtime_delegate_fn get_delegate_fptr;
 extern hostfxr_close_fn close_fptr;
+extern hostfxr_set_runtime_property_value_fn set_property_fptr;
 
 namespace MochiSharp
 {
+    // Managed type name of a native struct; specialized by MOCHI_SCRIPT_STRUCT (ScriptMethod.h).
+    template<typename T>
+    struct ScriptTypeTraits;
+
     struct EngineInterface
     {
         typedef void (*LogFunc)(const char *message);
         LogFunc LogMessage;
     };
 
+    // Result of DotNetHost::TryInvoke (MochiSharp.Managed.Core.InvokeStatus). Ok and ScriptException
+    // keep the values the managed Invoke always returned (1 and 0); other failures are negative.
+    enum class InvokeStatus : int
+    {
+        Ok = 1,
+        ScriptException = 0,
+        Disabled = -1,       // circuit breaker open: the script was not run
+        UnknownMethod = -2,
+        BadArguments = -3,
+        MarshalFailed = -4,
+        InternalError = -5,
+        NativeFault = -6     // structured exception trapped around the call (Windows)
+    };
+
+    struct InvokeFaultInfo
+    {
+        int32_t MethodId = 0;
+        int32_t Status = 0;
+        int32_t ConsecutiveFaults = 0;
+        int32_t Disabled = 0;
+        int64_t TotalFaults = 0;
+    };
+    static_assert(sizeof(InvokeFaultInfo) == 24, "InvokeFaultInfo must match the managed layout");
+
+    // How a module's last unload or reload went: whether its old load context was collected, how many
+    // blocking GCs and how long that took, and the managed heap afterwards. A context that is still
+    // alive means something (a static, an event handler, a queued callback) references the old plugin.
+    struct ScriptUnloadReport
+    {
+        int32_t ModuleHandle = 0;
+        int32_t Collected = 0;
+        int32_t Collections = 0;
+        int32_t RootCount = 0;          // roots listed by diagnostics (ConfigureUnloadTracking)
+        double MillisecondsToCollect = 0.0;
+        int64_t FreedBytes = 0;         // managed heap before the unload minus after its collections
+        int64_t HeapBytes = 0;          // managed heap after the collections
+        int64_t HeapGrowthBytes = 0;    // HeapBytes minus that of the previous unload; creeps up when reloads leak
+    };
+    static_assert(sizeof(ScriptUnloadReport) == 48, "ScriptUnloadReport must match the managed layout");
+
     typedef int (CORECLR_DELEGATE_CALLTYPE *InitializeFn)(EngineInterface *engineApi);
     typedef int (CORECLR_DELEGATE_CALLTYPE *LoadAssemblyFn)(const char *path);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *LoadAssemblyFromMemoryFn)(const char *modulePath, const void *image, int imageSize, const void *symbols, int symbolsSize);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ReloadModuleFn)(int moduleHandle);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *UnloadModuleFn)(int moduleHandle);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *LoadSharedAssemblyFn)(const char *path);
+    typedef const void *(CORECLR_DELEGATE_CALLTYPE *GetModuleFilesFn)(int moduleHandle);
     typedef int (CORECLR_DELEGATE_CALLTYPE *RegisterSignatureFn)(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *RegisterSignatureCheckedFn)(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount, const int *nativeSizes, const int *nativeAlignments);
     typedef int (CORECLR_DELEGATE_CALLTYPE *CreateInstanceFn)(const char *typeName, uint64_t instanceId);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *CreateInstancesFn)(const char *typeName, const uint64_t *instanceIds, int count, uint8_t *resultBitmap);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureInstancePoolFn)(const char *typeName, int capacity);
     typedef void (CORECLR_DELEGATE_CALLTYPE *DestroyInstanceFn)(uint64_t instanceId);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *DestroyInstancesFn)(const uint64_t *instanceIds, int count, double budgetMilliseconds);
     typedef const char *(CORECLR_DELEGATE_CALLTYPE *GetInstanceFieldsFn)(uint64_t instanceId);
     typedef const char *(CORECLR_DELEGATE_CALLTYPE *GetTypeFieldsFn)(const char *typeName);
     typedef int (CORECLR_DELEGATE_CALLTYPE *GetInstanceFieldValueFn)(uint64_t instanceId, const char *fieldName, void *buffer, int bufferSize);
     typedef int (CORECLR_DELEGATE_CALLTYPE *SetInstanceFieldValueFn)(uint64_t instanceId, const char *fieldName, const void *buffer, int bufferSize);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureFieldTrackingFn)(const char *typeName, int enabled);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *CollectDirtyFieldsFn)(void *buffer, int bufferSize, int *bytesWritten);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureReplicationFn)(const char *replicatedAttributeTypeName);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *CaptureSnapshotFn)(void *buffer, int bufferSize);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ApplySnapshotFn)(const void *snapshot, int snapshotSize, const void *previous, int previousSize);
     typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureSerializationFn)(const char *serializeFieldAttributeTypeName, const char *entityTypeName);
     typedef int (CORECLR_DELEGATE_CALLTYPE *BindInstanceMethodFn)(uint64_t instanceId, const char *methodName, int signature);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *BindMethodsFn)(uint64_t instanceId, const char **methodNames, const int *signatures, int count, int *outMethodIds);
     typedef int (CORECLR_DELEGATE_CALLTYPE *BindStaticMethodFn)(const char *typeName, const char *methodName, int signature);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *GetSignatureLayoutFn)(int signatureId, int *sizes, int capacity);
     typedef int (CORECLR_DELEGATE_CALLTYPE *InvokeFn)(int methodId, const void *argsPtr, int argCount, void *returnPtr);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureFaultPolicyFn)(int maxConsecutiveFaults);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *EnableMethodFn)(int methodId);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *DisableMethodFn)(int methodId);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureWatchdogFn)(void *sharedState);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *GetMethodFaultsFn)(int methodId, InvokeFaultInfo *info);
+    typedef const char *(CORECLR_DELEGATE_CALLTYPE *GetLastInvokeErrorFn)(InvokeFaultInfo *info);
     typedef const char *(CORECLR_DELEGATE_CALLTYPE *GetDerivedTypesFn)(const char *asmPath, const char *baseType);
+    typedef const void *(CORECLR_DELEGATE_CALLTYPE *GetDerivedTypeListFn)(const char *asmPath, const char *baseType);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureEventRingFn)(void *buffer, int bufferSize);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *DispatchEventsFn)();
+    typedef int (CORECLR_DELEGATE_CALLTYPE *TickSchedulerFn)(double deltaSeconds);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *RegisterComponentFn)(int componentId, const char *typeName, int size);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureComponentStorageFn)(void *queryFunction, void *context);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureFrameArenaFn)(void *buffer, int bufferSize);
+    typedef int (CORECLR_DELEGATE_CALLTYPE *ConfigureUnloadTrackingFn)(int maxCollections, int diagnostics);
+    typedef const char *(CORECLR_DELEGATE_CALLTYPE *GetUnloadReportFn)(int moduleHandle, ScriptUnloadReport *report);
 
+    // Runtime tuning applied by Init before the runtime starts, on top of the runtimeconfig.json: each
+    // set value overrides the matching configProperties entry, unset ones keep what the file says.
+    //
+    //   auto settings = MochiSharp::HostSettings::LowLatencyClient();
+    //   settings.HeapHardLimit = 512ull << 20;
+    //   host.Init("MochiSharp.Managed.runtimeconfig.json", settings);
+    //
+    // Presets:
+    //   LowLatencyClient - a game client, where frame-time spikes matter more than throughput:
+    //     workstation GC with background (concurrent) gen2 collections, RetainVM so freed segments are
+    //     kept instead of being returned and faulted in again, loops jitted fully optimized right away
+    //     (QuickJitForLoops off) and no PGO instrumentation tier, so fewer methods are rejitted mid-game.
+    //   ThroughputServer - a headless server that owns its cores: server GC (one heap per core unless
+    //     HeapCount says otherwise), no background GC, and the full tiered pipeline with dynamic PGO for
+    //     the best steady-state code.
+    // Both keep ReadyToRun code, which is what makes startup and first calls cheap. Compare them on a
+    // real workload with MochiSharp.Replay --profile (or MochiSharp.Server --profile).
     struct HostSettings
     {
+        std::optional<bool> ServerGC;           // System.GC.Server
+        std::optional<bool> ConcurrentGC;       // System.GC.Concurrent (background gen2 collections)
+        std::optional<bool> RetainVM;           // System.GC.RetainVM
+        std::optional<uint64_t> HeapHardLimit;  // System.GC.HeapHardLimit, bytes
+        std::optional<uint32_t> HeapCount;      // System.GC.HeapCount, server GC only
+        std::optional<bool> TieredCompilation;  // System.Runtime.TieredCompilation
+        std::optional<bool> QuickJit;           // System.Runtime.TieredCompilation.QuickJit
+        std::optional<bool> QuickJitForLoops;   // System.Runtime.TieredCompilation.QuickJitForLoops
+        std::optional<bool> TieredPGO;          // System.Runtime.TieredPGO
+        // Use precompiled (ReadyToRun) framework and script code. The runtime has no property for this;
+        // Init sets the DOTNET_ReadyToRun environment variable of the process instead.
+        std::optional<bool> ReadyToRun;
+        // Any other runtime property, e.g. { "System.GC.ConserveMemory", "5" }.
+        std::vector<std::pair<std::string, std::string>> Properties;
+
+        static HostSettings LowLatencyClient();
+        static HostSettings ThroughputServer();
+        // "default" (runtimeconfig only), "low-latency-client" or "throughput-server"; false otherwise.
+        static bool FromPreset(std::string_view name, HostSettings &settings);
     };
 
     class DotNetHost
@@ -57,38 +182,208 @@ namespace MochiSharp
         std::filesystem::path m_BaseDir;
         InitializeFn ManagedInit = nullptr;
         LoadAssemblyFn ManagedLoadAssembly = nullptr;
+        LoadAssemblyFromMemoryFn ManagedLoadAssemblyFromMemory = nullptr;
+        ReloadModuleFn ManagedReloadModule = nullptr;
+        UnloadModuleFn ManagedUnloadModule = nullptr;
+        LoadSharedAssemblyFn ManagedLoadSharedAssembly = nullptr;
+        GetModuleFilesFn ManagedGetModuleFiles = nullptr;
         RegisterSignatureFn ManagedRegisterSignature = nullptr;
+        RegisterSignatureCheckedFn ManagedRegisterSignatureChecked = nullptr;
         CreateInstanceFn ManagedCreateInstance = nullptr;
+        CreateInstancesFn ManagedCreateInstances = nullptr;
+        ConfigureInstancePoolFn ManagedConfigureInstancePool = nullptr;
         DestroyInstanceFn ManagedDestroyInstance = nullptr;
+        DestroyInstancesFn ManagedDestroyInstances = nullptr;
         GetInstanceFieldsFn ManagedGetInstanceFields = nullptr;
         GetTypeFieldsFn ManagedGetTypeFields = nullptr;
         GetInstanceFieldValueFn ManagedGetInstanceFieldValue = nullptr;
         SetInstanceFieldValueFn ManagedSetInstanceFieldValue = nullptr;
+        ConfigureFieldTrackingFn ManagedConfigureFieldTracking = nullptr;
+        CollectDirtyFieldsFn ManagedCollectDirtyFields = nullptr;
+        ConfigureReplicationFn ManagedConfigureReplication = nullptr;
+        CaptureSnapshotFn ManagedCaptureSnapshot = nullptr;
+        ApplySnapshotFn ManagedApplySnapshot = nullptr;
         ConfigureSerializationFn ManagedConfigureSerialization = nullptr;
         BindInstanceMethodFn ManagedBindInstanceMethod = nullptr;
+        BindMethodsFn ManagedBindMethods = nullptr;
         BindStaticMethodFn ManagedBindStaticMethod = nullptr;
         InvokeFn ManagedInvoke = nullptr;
+        GetSignatureLayoutFn ManagedGetSignatureLayout = nullptr;
+        ConfigureFaultPolicyFn ManagedConfigureFaultPolicy = nullptr;
+        EnableMethodFn ManagedEnableMethod = nullptr;
+        DisableMethodFn ManagedDisableMethod = nullptr;
+        ConfigureWatchdogFn ManagedConfigureWatchdog = nullptr;
+        GetMethodFaultsFn ManagedGetMethodFaults = nullptr;
+        GetLastInvokeErrorFn ManagedGetLastInvokeError = nullptr;
         GetDerivedTypesFn ManagedGetDerivedTypes = nullptr;
+        GetDerivedTypeListFn ManagedGetDerivedTypeList = nullptr;
+        ConfigureEventRingFn ManagedConfigureEventRing = nullptr;
+        DispatchEventsFn ManagedDispatchEvents = nullptr;
+        TickSchedulerFn ManagedTickScheduler = nullptr;
+        RegisterComponentFn ManagedRegisterComponent = nullptr;
+        ConfigureComponentStorageFn ManagedConfigureComponentStorage = nullptr;
+        ConfigureFrameArenaFn ManagedConfigureFrameArena = nullptr;
+        ConfigureUnloadTrackingFn ManagedConfigureUnloadTracking = nullptr;
+        GetUnloadReportFn ManagedGetUnloadReport = nullptr;
+
+        std::unordered_set<int> m_RegisteredSignatures;
+
+        std::vector<uint64_t> m_DestroyQueue;
+        int m_PendingDestroyCount = 0;
+        double m_DestroyBudgetMilliseconds = 0.0;
+
+        ScriptEventQueue m_Events;
+        ScriptWatcher m_Watcher;
+        ScriptWatchdog m_Watchdog;
+        ScriptRecorder m_Recorder;
+        ScriptComponentBridge m_Components;
+        ScriptFrameArena m_FrameArena;
 
     public:
         static void EngineLog(const char *msg);
-        bool Init(const std::wstring &configPath);
+        // Quiet mode drops the messages scripts log through the host and per-call diagnostics from
+        // Invoke (they are only counted), so a server loop does no console I/O. Setup errors are
+        // still printed, and failed calls remain available through GetLastInvokeError.
+        static void SetQuietLogging(bool quiet);
+        static bool IsQuietLogging();
+        static uint64_t GetSuppressedLogCount();
+        // Resolves hostfxr through nethost (LoadLibrary on Windows, dlopen elsewhere) and starts the runtime.
+        bool Init(const std::filesystem::path &configPath, const HostSettings &settings = {});
         bool LoadAssembly(const char *path);
+        // Script modules: each loaded assembly gets its own collectible context, instances and method
+        // handles, and can be reloaded or unloaded without touching the others. LoadModule returns the
+        // module handle (0 on error); loading an already loaded path reloads that module.
+        int LoadModule(const char *path);
+        // Loads a module from an image already in memory (e.g. read from a package); the symbols (PDB)
+        // are optional. The name identifies the module and is where its private dependencies are looked
+        // for; loading the same name again replaces it. Such modules are not watched or reloaded from disk.
+        int LoadModuleFromMemory(const char *name, const void *image, size_t imageSize, const void *symbols = nullptr, size_t symbolsSize = 0);
+        bool ReloadModule(int moduleHandle);
+        bool UnloadModule(int moduleHandle);
+        // Every unload and reload is followed by up to maxCollections blocking GCs that check the old
+        // context is really collected (default 8, 0 skips them); the outcome is logged and kept per module.
+        // diagnostics lists the static roots of a context that survives, at the cost of a heap walk.
+        bool ConfigureUnloadTracking(int maxCollections, bool diagnostics = false);
+        // False if the module was never unloaded or reloaded. roots gets one reference path per line.
+        bool GetUnloadReport(int moduleHandle, ScriptUnloadReport &report, std::string *roots = nullptr);
+        // Loads an assembly that several modules reference into a shared parent context so its types are
+        // the same in every module. Call before loading the modules that use it.
+        bool LoadSharedAssembly(const char *path);
+        // The module's assembly followed by the dependencies it loads privately.
+        std::vector<std::string> GetModuleFiles(int moduleHandle);
+
+        // Hot reload (see ScriptWatcher.h). WatchModule starts the watcher on first use (debounce only
+        // applies then). ApplyPendingReloads reloads every module whose files changed, on the calling
+        // thread, and returns their handles: their instances and method handles must be recreated.
+        bool WatchModule(int moduleHandle, std::chrono::milliseconds debounce = std::chrono::milliseconds(250));
+        bool IsReloadPending() const { return m_Watcher.IsReloadPending(); }
+        std::vector<int> ApplyPendingReloads();
         bool RegisterSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount);
+        // nativeSizes/nativeAlignments hold sizeof/alignof of the return type (index 0) and of each parameter
+        // (parameterCount + 1 entries, 0 = unchecked). Fails if they do not match the managed layout.
+        bool RegisterSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount, const int *nativeSizes, const int *nativeAlignments);
+        // Registers the signature only if this id has not been registered yet. Managed code keeps registered
+        // signatures and replays them to modules that are loaded or reloaded later.
+        bool EnsureSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount, const int *nativeSizes = nullptr, const int *nativeAlignments = nullptr);
 		bool CreateInstance(const char *typeName, uint64_t instanceId);
+        // Returns a bitmap of (count + 7) / 8 bytes; bit i is set when instanceIds[i] was created or already existed.
+        std::vector<uint8_t> CreateInstances(const char *typeName, const uint64_t *instanceIds, int count);
+        bool ConfigureInstancePool(const char *typeName, int capacity);
         void DestroyInstance(uint64_t instanceId);
+
+        // Deferred destruction: ids are only recorded here; FlushDestroyQueue hands the whole batch
+        // to managed code in one call. With a budget, disposal is spread over several flushes.
+        // Returns the number of instances still waiting for disposal.
+        void QueueDestroyInstance(uint64_t instanceId);
+        int FlushDestroyQueue(double budgetMilliseconds = 0.0);
+        void SetDestroyBudget(double budgetMilliseconds);
+        // End-of-frame housekeeping: flushes the destroy queue with the configured budget, checks
+        // the frame's script time against the watchdog's frame budget and resets the frame arena.
+        void EndFrame();
+
+        // Scratch memory scripts allocate from during a frame (see ScriptArena.h); released by EndFrame.
+        bool InitFrameArena(size_t capacity = 1 << 20);
+        ScriptFrameArena &GetFrameArena() { return m_FrameArena; }
+        ScriptArenaStats GetFrameArenaStats() const { return m_FrameArena.GetStats(); }
+
+        // Script time budgets and runaway detection for Invoke (see ScriptWatchdog.h).
+        bool StartWatchdog(ScriptWatchdogSettings settings);
+        void StopWatchdog();
         std::string GetInstanceFields(uint64_t instanceId);
         std::string GetTypeFields(const char *typeName);
         bool GetInstanceFieldValue(uint64_t instanceId, const char *fieldName, void *buffer, int bufferSize);
         bool SetInstanceFieldValue(uint64_t instanceId, const char *fieldName, const void *buffer, int bufferSize);
+        // Field change tracking (see ScriptFieldChanges.h). ConfigureFieldTracking returns the number of
+        // tracked fields of the type, CollectDirtyFields the number of records written; both -1 on error.
+        int ConfigureFieldTracking(const char *typeName, bool enabled = true);
+        int CollectDirtyFields(void *buffer, size_t bufferSize, size_t *bytesWritten = nullptr);
+        // Replication snapshots (see ScriptSnapshot.h). Fields are selected by
+        // MochiSharp.Managed.Core.ReplicatedAttribute unless another attribute is configured here.
+        bool ConfigureReplication(const char *replicatedAttributeTypeName);
+        // Captures the snapshot into snapshot, growing it as needed; its capacity is reused across calls.
+        bool CaptureSnapshot(std::vector<uint8_t> &snapshot);
+        // previous (optional) is the snapshot applied before; instances whose entry did not change are
+        // skipped. Returns the number of instances updated, -1 on error.
+        int ApplySnapshot(const void *snapshot, size_t snapshotSize, const void *previous = nullptr, size_t previousSize = 0);
         bool ConfigureSerialization(const char *serializeFieldAttributeTypeName, const char *entityTypeName);
 
         int BindInstanceMethod(uint64_t instanceId, const char *methodName, int signature);
+        // Binds count methods of one instance in a single call; outMethodIds[i] is 0 where binding failed.
+        // Returns the number of methods bound.
+        int BindMethods(uint64_t instanceId, const char **methodNames, const int *signatures, int count, int *outMethodIds);
         int BindStaticMethod(const char *typeName, const char *methodName, int signature);
         bool Invoke(int methodId, const void *argsPtr, int argCount, void *returnPtr);
+        // Same call, with the reason for a failure. Faults are counted per method; once a method has
+        // faulted maxConsecutiveFaults times in a row (ConfigureFaultPolicy, 0 = never) it is disabled
+        // and returns InvokeStatus::Disabled without running until EnableMethod is called.
+        InvokeStatus TryInvoke(int methodId, const void *argsPtr, int argCount, void *returnPtr);
+        bool ConfigureFaultPolicy(int maxConsecutiveFaults);
+        bool EnableMethod(int methodId);
+        bool DisableMethod(int methodId);
+        bool GetMethodFaults(int methodId, InvokeFaultInfo &info);
+        // The most recent failed call (InvokeStatus::Ok if none); the message includes the script's
+        // exception and stack trace.
+        InvokeStatus GetLastInvokeError(InvokeFaultInfo *info = nullptr, std::string *message = nullptr);
         std::string GetDerivedTypes(const char *asmPath, const char *baseType);
+        // Scans the assembly's metadata without loading it; results are cached until the file changes.
+        std::vector<std::string> GetDerivedTypeList(const char *asmPath, const char *baseType);
+
+        // Native size of the return value (index 0) and of each parameter of a registered signature;
+        // empty if no module knows it.
+        std::vector<int> GetSignatureLayout(int signatureId);
+
+        // Writes every call into scripts to a binary log for MochiSharp.Replay (see ScriptRecorder.h).
+        // Start before loading modules so the log contains the setup as well.
+        bool StartRecording(const std::filesystem::path &path);
+        void StopRecording();
+        bool IsRecording() const { return m_Recorder.IsRecording(); }
+
+        // Event bus (see ScriptEvents.h). InitEvents allocates the ring and shares it with managed code;
+        // PushEvent only writes to that memory. DispatchEvents routes everything queued so far to the
+        // [ScriptEvent] handlers and returns the number of handler calls, or -1 on error.
+        bool InitEvents(uint32_t slotCount = 4096, uint32_t maxPayloadSize = 64);
+        template<typename T>
+        bool PushEvent(int eventTypeId, uint64_t targetInstanceId, const T &payload) { return m_Events.Push(eventTypeId, targetInstanceId, payload); }
+        bool PushEvent(int eventTypeId, uint64_t targetInstanceId) { return m_Events.Push(eventTypeId, targetInstanceId, nullptr, 0); }
+        int DispatchEvents();
+        const ScriptEventQueue &GetEventQueue() const { return m_Events; }
+
+        // Pumps the managed script scheduler once per frame on the game thread: coroutines and
+        // awaits (ScriptScheduler.NextFrame/Seconds) resume here. Returns the amount of pending
+        // work (continuations, timers, coroutines), or -1 on error.
+        int TickScheduler(double deltaSeconds);
+
+        // Chunked component queries (see ScriptComponents.h). RegisterComponent maps a managed struct
+        // (assembly-qualified or full name) to the id the storage uses; size is checked against the
+        // managed layout when a query names the struct. SetComponentStorage(nullptr) detaches it.
+        bool RegisterComponent(int componentId, const char *typeName, int size);
+        template<typename T>
+        bool RegisterComponent(int componentId) { return RegisterComponent(componentId, ScriptTypeTraits<T>::Name, (int)sizeof(T)); }
+        bool SetComponentStorage(ScriptComponentStorage *storage);
     private:
         bool LoadHostFxr();
+        bool ApplySettings(const HostSettings &settings);
+        std::filesystem::path ResolveScriptPath(const char *path) const;
     };
 }
 
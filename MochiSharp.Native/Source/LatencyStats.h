@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <print>
+#include <vector>
+
+// Percentile reports for the headless tools (MochiSharp.Replay, MochiSharp.Server), so both print
+// their call, frame and tick timings in the same format:
+//
+//   call     n=1200 p50=1.20us p90=2.41us p99=8.03us p99.9=40.11us max=95.72us
+
+namespace MochiSharp
+{
+    // Nearest-rank percentile of an ascending list; 0 when it is empty.
+    inline int64_t Percentile(const std::vector<int64_t> &sorted, double fraction)
+    {
+        if (sorted.empty())
+        {
+            return 0;
+        }
+
+        size_t index = (size_t)(fraction * (double)(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    // Prints one line of percentiles for durations in nanoseconds, in microseconds.
+    inline void PrintLatencyDistribution(const char *label, std::vector<int64_t> nanoseconds)
+    {
+        std::sort(nanoseconds.begin(), nanoseconds.end());
+        std::println("{:<8} n={} p50={:.2f}us p90={:.2f}us p99={:.2f}us p99.9={:.2f}us max={:.2f}us", label, nanoseconds.size(),
+            Percentile(nanoseconds, 0.50) / 1000.0, Percentile(nanoseconds, 0.90) / 1000.0, Percentile(nanoseconds, 0.99) / 1000.0,
+            Percentile(nanoseconds, 0.999) / 1000.0, nanoseconds.empty() ? 0.0 : nanoseconds.back() / 1000.0);
+    }
+}
+
+#endif // !LATENCY_STATS_H
@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef MATH_TYPES_H
+#define MATH_TYPES_H
+
+#include "ScriptMethod.h"
+
+#include <cstddef>
+
+// Native side of MochiSharp.Managed.Mathf: plain float structs with the exact managed layout, so
+// they cross the boundary by copy (ScriptMethod arguments, fields, event payloads, shared arrays).
+//
+//   MochiSharp::ScriptMethod<MochiSharp::Vector3(MochiSharp::Transform, MochiSharp::Vector3)> toWorld;
+//
+// Matrix4x4 is row-major with row vectors (p' = p * M) and the translation in M41..M43, as in
+// System.Numerics. Transform applies scale, then rotation, then position.
+
+namespace MochiSharp
+{
+    struct Vector2
+    {
+        float X;
+        float Y;
+    };
+
+    struct Vector3
+    {
+        float X;
+        float Y;
+        float Z;
+    };
+
+    struct Vector4
+    {
+        float X;
+        float Y;
+        float Z;
+        float W;
+    };
+
+    struct Quaternion
+    {
+        float X;
+        float Y;
+        float Z;
+        float W;
+    };
+
+    struct Matrix4x4
+    {
+        float M11, M12, M13, M14;
+        float M21, M22, M23, M24;
+        float M31, M32, M33, M34;
+        float M41, M42, M43, M44;
+    };
+
+    struct Transform
+    {
+        Vector3 Position;
+        Quaternion Rotation;
+        Vector3 Scale;
+    };
+
+    static_assert(alignof(Matrix4x4) == 4 && offsetof(Matrix4x4, M41) == 48, "Matrix4x4 must match MochiSharp.Managed.Mathf.Matrix4x4");
+    static_assert(offsetof(Transform, Rotation) == 12 && offsetof(Transform, Scale) == 28, "Transform must match MochiSharp.Managed.Mathf.Transform");
+}
+
+MOCHI_SCRIPT_STRUCT(MochiSharp::Vector2, "MochiSharp.Managed.Mathf.Vector2, MochiSharp.Managed", 8);
+MOCHI_SCRIPT_STRUCT(MochiSharp::Vector3, "MochiSharp.Managed.Mathf.Vector3, MochiSharp.Managed", 12);
+MOCHI_SCRIPT_STRUCT(MochiSharp::Vector4, "MochiSharp.Managed.Mathf.Vector4, MochiSharp.Managed", 16);
+MOCHI_SCRIPT_STRUCT(MochiSharp::Quaternion, "MochiSharp.Managed.Mathf.Quaternion, MochiSharp.Managed", 16);
+MOCHI_SCRIPT_STRUCT(MochiSharp::Matrix4x4, "MochiSharp.Managed.Mathf.Matrix4x4, MochiSharp.Managed", 64);
+MOCHI_SCRIPT_STRUCT(MochiSharp::Transform, "MochiSharp.Managed.Mathf.Transform, MochiSharp.Managed", 40);
+
+#endif // !MATH_TYPES_H
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptArena.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MochiSharp
+{
+    bool ScriptFrameArena::Init(size_t capacity)
+    {
+        capacity = (capacity + 63) & ~(size_t)63;
+        if (capacity == 0 || capacity > (size_t)INT32_MAX - sizeof(ScriptArenaHeader))
+        {
+            return false;
+        }
+
+        size_t bufferSize = sizeof(ScriptArenaHeader) + capacity;
+        m_Storage = std::make_unique<uint64_t[]>(bufferSize / sizeof(uint64_t));
+        m_Header = reinterpret_cast<ScriptArenaHeader *>(m_Storage.get());
+        m_Data = reinterpret_cast<uint8_t *>(m_Header + 1);
+        m_BufferSize = bufferSize;
+        m_Header->Capacity = capacity;
+
+        m_LastFrameBytes = 0;
+        m_HighWaterBytes = 0;
+        m_LastFrameOverflowBytes = 0;
+        m_OverflowFrames = 0;
+        return true;
+    }
+
+    void *ScriptFrameArena::Allocate(size_t size, size_t alignment)
+    {
+        if (!m_Header || alignment == 0 || (alignment & (alignment - 1)) != 0)
+        {
+            return nullptr;
+        }
+
+        uintptr_t base = reinterpret_cast<uintptr_t>(m_Data);
+        uintptr_t start = (base + m_Header->Offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        uint64_t end = (uint64_t)(start - base) + size;
+        if (end > m_Header->Capacity)
+        {
+            m_Header->OverflowBytes += size;
+            return nullptr;
+        }
+
+        m_Header->Offset = end;
+        return reinterpret_cast<void *>(start);
+    }
+
+    void ScriptFrameArena::Reset()
+    {
+        if (!m_Header)
+        {
+            return;
+        }
+
+        uint64_t used = std::min(m_Header->Offset, m_Header->Capacity);
+#ifdef MOCHI_DEBUG
+        std::memset(m_Data, 0xCD, (size_t)used);
+#endif
+
+        m_LastFrameBytes = used;
+        m_HighWaterBytes = std::max(m_HighWaterBytes, used);
+        m_LastFrameOverflowBytes = m_Header->OverflowBytes;
+        m_OverflowFrames += m_Header->OverflowBytes > 0 ? 1 : 0;
+
+        m_Header->Offset = 0;
+        m_Header->OverflowBytes = 0;
+        m_Header->Frame++;
+    }
+
+    ScriptArenaStats ScriptFrameArena::GetStats() const
+    {
+        ScriptArenaStats stats;
+        if (!m_Header)
+        {
+            return stats;
+        }
+
+        stats.Capacity = m_Header->Capacity;
+        stats.Frames = m_Header->Frame;
+        stats.LastFrameBytes = m_LastFrameBytes;
+        stats.HighWaterBytes = m_HighWaterBytes;
+        stats.LastFrameOverflowBytes = m_LastFrameOverflowBytes;
+        stats.OverflowFrames = m_OverflowFrames;
+        stats.PoolBytesInUse = m_Header->PoolBytesInUse;
+        stats.PoolBytesPeak = m_Header->PoolBytesPeak;
+        return stats;
+    }
+}
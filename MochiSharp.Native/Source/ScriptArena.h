@@ -0,0 +1,83 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_ARENA_H
+#define SCRIPT_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Per-frame scratch memory for scripts (MochiSharp.Managed.Core.FrameAllocator).
+//
+//   host.InitFrameArena(4 << 20);
+//   ...                                  // scripts: FrameAllocator.Allocate<int>(n), FrameAllocator.CreateList<T>(n)
+//   host.EndFrame();                     // releases everything allocated during the frame at once
+//   ScriptArenaStats stats = host.GetFrameArenaStats();
+//
+// The arena is a linear (bump) allocator in memory shared with MochiSharp.Managed. Scripts advance
+// the offset themselves, so an allocation is a few instructions with no transition and no GC; the
+// host only resets it. Requests that do not fit are served from the GC heap instead and counted as
+// overflow, which the stats report so the capacity can be tuned. Game thread only.
+//
+// With MOCHI_DEBUG, memory released by Reset is filled with 0xCD so that data kept past its frame
+// shows up as garbage, and managed builds with DEBUG check NativeList lifetimes against Frame.
+
+namespace MochiSharp
+{
+    // Shared with MochiSharp.Managed.Core.FrameAllocator and NativePool; keep both layouts in sync.
+    struct ScriptArenaHeader
+    {
+        uint64_t Capacity;          // bytes of arena memory after the header
+        uint64_t Offset;            // next free byte, advanced by managed code, reset by the host
+        uint64_t Frame;             // incremented by every Reset
+        uint64_t OverflowBytes;     // bytes requested this frame that did not fit
+        uint64_t PoolBytesInUse;    // NativePool: persistent buffers currently rented
+        uint64_t PoolBytesPeak;
+        uint64_t Reserved[2];
+    };
+
+    static_assert(sizeof(ScriptArenaHeader) == 64, "ScriptArenaHeader layout is shared with managed code");
+
+    struct ScriptArenaStats
+    {
+        uint64_t Capacity = 0;
+        uint64_t Frames = 0;                // frames ended since InitFrameArena
+        uint64_t LastFrameBytes = 0;        // arena bytes used by the last frame that ended
+        uint64_t HighWaterBytes = 0;        // largest LastFrameBytes so far
+        uint64_t LastFrameOverflowBytes = 0;
+        uint64_t OverflowFrames = 0;        // frames that needed more than Capacity
+        uint64_t PoolBytesInUse = 0;
+        uint64_t PoolBytesPeak = 0;
+    };
+
+    class ScriptFrameArena
+    {
+    public:
+        // capacity is rounded up to a multiple of 64 bytes.
+        bool Init(size_t capacity);
+        bool IsInitialized() const { return m_Header != nullptr; }
+        void *GetBuffer() const { return m_Header; }
+        size_t GetBufferSize() const { return m_BufferSize; }
+
+        // Native callers may allocate from the same arena; returns nullptr when it is full.
+        void *Allocate(size_t size, size_t alignment = 16);
+
+        // Ends the frame: records its usage and makes the whole arena available again.
+        void Reset();
+
+        ScriptArenaStats GetStats() const;
+
+    private:
+        std::unique_ptr<uint64_t[]> m_Storage; // uint64_t keeps the header and data 8-byte aligned
+        ScriptArenaHeader *m_Header = nullptr;
+        uint8_t *m_Data = nullptr;
+        size_t m_BufferSize = 0;
+
+        uint64_t m_LastFrameBytes = 0;
+        uint64_t m_HighWaterBytes = 0;
+        uint64_t m_LastFrameOverflowBytes = 0;
+        uint64_t m_OverflowFrames = 0;
+    };
+}
+
+#endif // !SCRIPT_ARENA_H
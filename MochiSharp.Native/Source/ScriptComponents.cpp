@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptComponents.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MochiSharp
+{
+    int32_t ScriptComponentBridge::QueryChunks(void *context, const int32_t *componentIds, int32_t componentCount, ScriptChunk *chunks, void **columns, int32_t capacity)
+    {
+        auto *bridge = static_cast<ScriptComponentBridge *>(context);
+        if (!bridge || !bridge->m_Storage || !componentIds || componentCount <= 0 || capacity < 0)
+        {
+            return -1;
+        }
+
+        // Called from managed code: nothing may unwind through it.
+        try
+        {
+            bridge->m_Chunks.clear();
+            bridge->m_Columns.clear();
+            bridge->m_Storage->QueryChunks(std::span<const int32_t>(componentIds, (size_t)componentCount), bridge->m_Chunks, bridge->m_Columns);
+        }
+        catch (...)
+        {
+            return -1;
+        }
+
+        size_t total = bridge->m_Chunks.size();
+        if (bridge->m_Columns.size() != total * (size_t)componentCount || total > INT32_MAX)
+        {
+            return -1;
+        }
+
+        size_t copied = std::min(total, (size_t)capacity);
+        if (copied > 0)
+        {
+            std::memcpy(chunks, bridge->m_Chunks.data(), copied * sizeof(ScriptChunk));
+            std::memcpy(columns, bridge->m_Columns.data(), copied * (size_t)componentCount * sizeof(void *));
+        }
+
+        return (int32_t)total;
+    }
+}
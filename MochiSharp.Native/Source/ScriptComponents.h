@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_COMPONENTS_H
+#define SCRIPT_COMPONENTS_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Engine component storage exposed to scripts as chunks (MochiSharp.Managed.Scene.EntityQuery).
+//
+//   class World : public MochiSharp::ScriptComponentStorage { ... };   // over the engine's SoA arrays
+//   host.RegisterComponent<Position>(PositionId);                     // managed struct <-> component id
+//   host.SetComponentStorage(&world);
+//
+// and in a script, within one call:
+//
+//   foreach (var chunk in EntityQuery.Create<Position, Velocity>()) { Span<Position> p = chunk.GetColumn<Position>(0); ... }
+//
+// Iterating a query makes one call back into the storage, which lists every chunk (a run of
+// entities whose components are stored contiguously, such as an archetype chunk) that has all the
+// requested components: entity count, optional entity ids and the base address of each component
+// array. Scripts loop over those arrays directly; nothing crosses the boundary per entity. The
+// addresses are used only during the script call that ran the query, so the storage must not move
+// or resize its arrays while scripts run.
+
+namespace MochiSharp
+{
+    // Shared with MochiSharp.Managed.Scene.ChunkInfo; keep both layouts in sync.
+    struct ScriptChunk
+    {
+        const uint64_t *Entities = nullptr; // Count entity ids, or null if the storage has none
+        int32_t Count = 0;
+        int32_t Reserved = 0;
+    };
+
+    static_assert(sizeof(ScriptChunk) == 16, "ScriptChunk layout is shared with managed code");
+
+    class ScriptComponentStorage
+    {
+    public:
+        virtual ~ScriptComponentStorage() = default;
+
+        // Appends one ScriptChunk per non-empty chunk holding every component in componentIds and, for
+        // each chunk, componentIds.size() column base addresses to columns, in query order. Game thread.
+        virtual void QueryChunks(std::span<const int32_t> componentIds, std::vector<ScriptChunk> &chunks, std::vector<void *> &columns) = 0;
+    };
+
+    // What DotNetHost hands to managed code: a C entry point plus this object as its context.
+    class ScriptComponentBridge
+    {
+    public:
+        void SetStorage(ScriptComponentStorage *storage) { m_Storage = storage; }
+        ScriptComponentStorage *GetStorage() const { return m_Storage; }
+
+        // Copies at most capacity chunks (and capacity * componentCount columns) and returns the total
+        // number of chunks, so the caller can grow its buffers and ask again; -1 on error.
+        static int32_t QueryChunks(void *context, const int32_t *componentIds, int32_t componentCount, ScriptChunk *chunks, void **columns, int32_t capacity);
+
+    private:
+        ScriptComponentStorage *m_Storage = nullptr;
+        std::vector<ScriptChunk> m_Chunks;
+        std::vector<void *> m_Columns;
+    };
+}
+
+#endif // !SCRIPT_COMPONENTS_H
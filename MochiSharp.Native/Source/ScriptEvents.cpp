@@ -0,0 +1,80 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptEvents.h"
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+namespace MochiSharp
+{
+    bool ScriptEventQueue::Init(uint32_t slotCount, uint32_t maxPayloadSize)
+    {
+        if (slotCount == 0 || slotCount > (1u << 24) || maxPayloadSize > (1u << 16))
+        {
+            return false;
+        }
+
+        slotCount = std::bit_ceil(slotCount);
+        uint32_t slotSize = ((uint32_t)sizeof(ScriptEventRecord) + maxPayloadSize + 7u) & ~7u;
+        uint64_t bufferSize = sizeof(ScriptEventRingHeader) + (uint64_t)slotCount * slotSize;
+        if (bufferSize > INT32_MAX)
+        {
+            return false;
+        }
+
+        m_Storage = std::make_unique<uint64_t[]>((size_t)(bufferSize / sizeof(uint64_t)));
+        m_Header = reinterpret_cast<ScriptEventRingHeader *>(m_Storage.get());
+        m_Slots = reinterpret_cast<uint8_t *>(m_Header + 1);
+        m_BufferSize = (uint32_t)bufferSize;
+        m_MaxPayloadSize = slotSize - (uint32_t)sizeof(ScriptEventRecord);
+
+        m_Header->SlotCount = slotCount;
+        m_Header->SlotSize = slotSize;
+        return true;
+    }
+
+    bool ScriptEventQueue::Push(int eventTypeId, uint64_t targetInstanceId, const void *payload, uint32_t payloadSize)
+    {
+        if (!m_Header)
+        {
+            return false;
+        }
+
+        std::atomic_ref<uint64_t> dropped(m_Header->DroppedCount);
+        uint64_t write = std::atomic_ref<uint64_t>(m_Header->WriteIndex).load(std::memory_order_relaxed);
+        uint64_t read = std::atomic_ref<uint64_t>(m_Header->ReadIndex).load(std::memory_order_acquire);
+        if (payloadSize > m_MaxPayloadSize || write - read >= m_Header->SlotCount)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        uint8_t *slot = m_Slots + (size_t)(write & (m_Header->SlotCount - 1)) * m_Header->SlotSize;
+        ScriptEventRecord record{ eventTypeId, payloadSize, targetInstanceId };
+        std::memcpy(slot, &record, sizeof(record));
+        if (payloadSize > 0)
+        {
+            std::memcpy(slot + sizeof(record), payload, payloadSize);
+        }
+
+        std::atomic_ref<uint64_t>(m_Header->WriteIndex).store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t ScriptEventQueue::GetPendingCount() const
+    {
+        if (!m_Header)
+        {
+            return 0;
+        }
+
+        return std::atomic_ref<uint64_t>(m_Header->WriteIndex).load(std::memory_order_relaxed)
+            - std::atomic_ref<uint64_t>(m_Header->ReadIndex).load(std::memory_order_acquire);
+    }
+
+    uint64_t ScriptEventQueue::GetDroppedCount() const
+    {
+        return m_Header ? std::atomic_ref<uint64_t>(m_Header->DroppedCount).load(std::memory_order_relaxed) : 0;
+    }
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_EVENTS_H
+#define SCRIPT_EVENTS_H
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Native -> script event bus.
+//
+//   host.InitEvents();
+//   host.PushEvent(CollisionEventId, instanceId, collision);   // plain memory write, no transition
+//   ...
+//   host.DispatchEvents();                                     // once per frame, one transition
+//
+// Records go into a single-producer/single-consumer ring buffer shared with MochiSharp.Managed,
+// which routes them to [ScriptEvent(id)] methods on the target instance (or every instance when
+// the target is 0).
+
+namespace MochiSharp
+{
+    // Shared with MochiSharp.Managed.Core.ScriptEventRing; keep both layouts in sync.
+    struct ScriptEventRingHeader
+    {
+        uint32_t SlotCount;     // power of two
+        uint32_t SlotSize;      // bytes per slot, ScriptEventRecord included; multiple of 8
+        uint64_t WriteIndex;    // advanced by native code once a record is complete
+        uint64_t ReadIndex;     // advanced by managed code once a record was dispatched
+        uint64_t DroppedCount;  // records rejected because the ring was full
+    };
+
+    struct ScriptEventRecord
+    {
+        int32_t EventTypeId;
+        uint32_t PayloadSize;
+        uint64_t TargetInstanceId; // 0 broadcasts to every instance with a handler
+        // Payload bytes follow.
+    };
+
+    static_assert(sizeof(ScriptEventRingHeader) == 32, "ScriptEventRingHeader layout is shared with managed code");
+    static_assert(sizeof(ScriptEventRecord) == 16, "ScriptEventRecord layout is shared with managed code");
+
+    class ScriptEventQueue
+    {
+    public:
+        // slotCount is rounded up to a power of two.
+        bool Init(uint32_t slotCount, uint32_t maxPayloadSize);
+
+        // Returns false (and counts the event as dropped) when the ring is full or the payload
+        // is larger than maxPayloadSize.
+        bool Push(int eventTypeId, uint64_t targetInstanceId, const void *payload, uint32_t payloadSize);
+
+        template<typename T>
+        bool Push(int eventTypeId, uint64_t targetInstanceId, const T &payload)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Event payloads are copied as raw bytes");
+            return Push(eventTypeId, targetInstanceId, &payload, (uint32_t)sizeof(T));
+        }
+
+        bool IsInitialized() const { return m_Header != nullptr; }
+        void *GetBuffer() const { return m_Header; }
+        uint32_t GetBufferSize() const { return m_BufferSize; }
+        uint32_t GetMaxPayloadSize() const { return m_MaxPayloadSize; }
+        uint64_t GetPendingCount() const;
+        uint64_t GetDroppedCount() const;
+
+    private:
+        std::unique_ptr<uint64_t[]> m_Storage; // uint64_t keeps the header and slots 8-byte aligned
+        ScriptEventRingHeader *m_Header = nullptr;
+        uint8_t *m_Slots = nullptr;
+        uint32_t m_BufferSize = 0;
+        uint32_t m_MaxPayloadSize = 0;
+    };
+}
+
+#endif // !SCRIPT_EVENTS_H
@@ -0,0 +1,54 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_FIELD_CHANGES_H
+#define SCRIPT_FIELD_CHANGES_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Field change tracking: what changed in script instances since the last collection, for replication
+// or editor views, without reading every field of every instance each frame.
+//
+//   host.ConfigureFieldTracking("Game.Player");                // fields of new and existing players
+//   ...
+//   int count = host.CollectDirtyFields(buffer, sizeof(buffer), &bytes);
+//   MochiSharp::ForEachFieldChange(buffer, bytes, [](const MochiSharp::ScriptFieldChange &change, const uint8_t *value)
+//   {
+//       // change.FieldHandle is the field's position in GetTypeFields
+//   });
+//
+// Managed code keeps a shadow copy of each tracked instance's fields and compares it on collection;
+// SetInstanceFieldValue marks the field it writes. Strings, entity references, primitives, enums and
+// blittable structs are tracked. A new instance reports all its tracked fields once. Changes that do
+// not fit in the buffer stay pending for the next call.
+
+namespace MochiSharp
+{
+    // Shared with MochiSharp.Managed.Core.FieldChangeWriter. The value follows the header in the format
+    // of GetInstanceFieldValue (strings are UTF-8 without a terminator, entities their id), and each
+    // record starts on an 8-byte boundary.
+    struct ScriptFieldChange
+    {
+        uint64_t InstanceId;
+        int32_t FieldHandle;
+        int32_t Size;
+        // Value bytes follow.
+    };
+    static_assert(sizeof(ScriptFieldChange) == 16, "ScriptFieldChange must match the managed layout");
+
+    // Calls fn(const ScriptFieldChange &, const uint8_t *value) for each record CollectDirtyFields wrote.
+    template<typename Fn>
+    void ForEachFieldChange(const void *buffer, size_t bytesWritten, Fn &&fn)
+    {
+        const auto *bytes = static_cast<const uint8_t *>(buffer);
+        size_t offset = 0;
+        while (offset + sizeof(ScriptFieldChange) <= bytesWritten)
+        {
+            const auto *change = reinterpret_cast<const ScriptFieldChange *>(bytes + offset);
+            fn(*change, bytes + offset + sizeof(ScriptFieldChange));
+            offset += (sizeof(ScriptFieldChange) + (size_t)change->Size + 7) & ~(size_t)7;
+        }
+    }
+}
+
+#endif // !SCRIPT_FIELD_CHANGES_H
@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_METHOD_H
+#define SCRIPT_METHOD_H
+
+#include "Host.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Typed bindings on top of DotNetHost.
+//
+//   MochiSharp::ScriptMethod<Vector3(Vector3, Vector3)> addVector;
+//   addVector.BindInstance(host, instanceId, "AddVector");
+//   Vector3 sum = addVector(a, b);
+//
+// The signature id and the managed type names are derived from the C++ function type at compile
+// time; the signature is registered with the host the first time a method of that type is bound.
+// App-defined structs must be declared with MOCHI_SCRIPT_STRUCT before they can be used.
+
+namespace MochiSharp
+{
+    // Managed type name for a native type, as passed to DotNetHost::RegisterSignature.
+    // Left undefined on purpose: using an unregistered type is a compile error.
+    template<typename T>
+    struct ScriptTypeTraits;
+
+    template<> struct ScriptTypeTraits<void> { static constexpr const char *Name = "System.Void"; };
+    template<> struct ScriptTypeTraits<bool> { static constexpr const char *Name = "System.Boolean"; };
+    template<> struct ScriptTypeTraits<int32_t> { static constexpr const char *Name = "System.Int32"; };
+    template<> struct ScriptTypeTraits<uint32_t> { static constexpr const char *Name = "System.UInt32"; };
+    template<> struct ScriptTypeTraits<int64_t> { static constexpr const char *Name = "System.Int64"; };
+    template<> struct ScriptTypeTraits<uint64_t> { static constexpr const char *Name = "System.UInt64"; };
+    template<> struct ScriptTypeTraits<float> { static constexpr const char *Name = "System.Single"; };
+    template<> struct ScriptTypeTraits<double> { static constexpr const char *Name = "System.Double"; };
+
+    namespace Detail
+    {
+        template<typename T>
+        concept HasScriptTypeTraits = requires { { ScriptTypeTraits<T>::Name } -> std::convertible_to<const char *>; };
+
+        constexpr uint32_t Fnv1a(std::string_view text, uint32_t hash = 2166136261u)
+        {
+            for (char c : text)
+            {
+                hash ^= (uint8_t)c;
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        // Generated ids live in [0x40000000, 0x7FFFFFFF] so they do not collide with small
+        // hand-assigned signature ids.
+        template<typename R, typename... Args>
+        constexpr int ComputeSignatureId()
+        {
+            uint32_t hash = Fnv1a(ScriptTypeTraits<R>::Name);
+            ((hash = Fnv1a(ScriptTypeTraits<Args>::Name, Fnv1a("|", hash))), ...);
+            return (int)((hash & 0x3FFFFFFFu) | 0x40000000u);
+        }
+
+        // bool crosses the boundary as a 32-bit integer; everything else is passed by address.
+        template<typename T> struct ArgStorage { using Type = const T &; };
+        template<> struct ArgStorage<bool> { using Type = int32_t; };
+
+        template<typename T> struct ReturnStorage { using Type = T; };
+        template<> struct ReturnStorage<bool> { using Type = int32_t; };
+
+        // Size and alignment of T as it crosses the boundary, checked against the managed layout
+        // when the signature is registered. 0 means "nothing to check" (void).
+        template<typename T>
+        constexpr int WireSize()
+        {
+            if constexpr (std::is_void_v<T>) return 0;
+            else return (int)sizeof(typename ReturnStorage<T>::Type);
+        }
+
+        template<typename T>
+        constexpr int WireAlignment()
+        {
+            if constexpr (std::is_void_v<T>) return 0;
+            else return (int)alignof(typename ReturnStorage<T>::Type);
+        }
+    }
+
+    template<typename Signature>
+    class ScriptMethod;
+
+    template<typename R, typename... Args>
+    class ScriptMethod<R(Args...)>
+    {
+    public:
+        static_assert(Detail::HasScriptTypeTraits<std::remove_cv_t<R>>, "Return type has no ScriptTypeTraits; declare it with MOCHI_SCRIPT_STRUCT");
+        static_assert((Detail::HasScriptTypeTraits<std::remove_cvref_t<Args>> && ...), "Parameter type has no ScriptTypeTraits; declare it with MOCHI_SCRIPT_STRUCT");
+
+        static constexpr int SignatureId = Detail::ComputeSignatureId<std::remove_cv_t<R>, std::remove_cvref_t<Args>...>();
+        static constexpr int ArgCount = (int)sizeof...(Args);
+
+        ScriptMethod() = default;
+
+        bool BindInstance(DotNetHost &host, uint64_t instanceId, const char *methodName)
+        {
+            m_Host = &host;
+            m_MethodId = Register(host) ? host.BindInstanceMethod(instanceId, methodName, SignatureId) : 0;
+            return m_MethodId != 0;
+        }
+
+        bool BindStatic(DotNetHost &host, const char *typeName, const char *methodName)
+        {
+            m_Host = &host;
+            m_MethodId = Register(host) ? host.BindStaticMethod(typeName, methodName, SignatureId) : 0;
+            return m_MethodId != 0;
+        }
+
+        // Registers the signature with the host if it is not registered yet.
+        static bool Register(DotNetHost &host)
+        {
+            static constexpr std::array<const char *, sizeof...(Args)> parameterTypeNames = { ScriptTypeTraits<std::remove_cvref_t<Args>>::Name... };
+            static constexpr std::array<int, sizeof...(Args) + 1> wireSizes = { Detail::WireSize<std::remove_cv_t<R>>(), Detail::WireSize<std::remove_cvref_t<Args>>()... };
+            static constexpr std::array<int, sizeof...(Args) + 1> wireAlignments = { Detail::WireAlignment<std::remove_cv_t<R>>(), Detail::WireAlignment<std::remove_cvref_t<Args>>()... };
+            return host.EnsureSignature(SignatureId, ScriptTypeTraits<std::remove_cv_t<R>>::Name,
+                ArgCount > 0 ? const_cast<const char **>(parameterTypeNames.data()) : nullptr, ArgCount,
+                wireSizes.data(), wireAlignments.data());
+        }
+
+        int GetMethodId() const { return m_MethodId; }
+        bool IsBound() const { return m_Host != nullptr && m_MethodId != 0; }
+        explicit operator bool() const { return IsBound(); }
+
+        // Calls the bound method. If the call fails, a value-initialized R is returned.
+        R operator()(Args... args) const
+        {
+            std::tuple<typename Detail::ArgStorage<std::remove_cvref_t<Args>>::Type...> values(args...);
+            return Call(values, std::index_sequence_for<Args...>{});
+        }
+
+    private:
+        template<typename Tuple, size_t... I>
+        R Call(Tuple &values, std::index_sequence<I...>) const
+        {
+            const void *argv[sizeof...(I) > 0 ? sizeof...(I) : 1] = { static_cast<const void *>(&std::get<I>(values))... };
+
+            if constexpr (std::is_void_v<R>)
+            {
+                if (IsBound())
+                {
+                    m_Host->Invoke(m_MethodId, argv, ArgCount, nullptr);
+                }
+            }
+            else
+            {
+                typename Detail::ReturnStorage<std::remove_cv_t<R>>::Type result{};
+                if (IsBound())
+                {
+                    m_Host->Invoke(m_MethodId, argv, ArgCount, &result);
+                }
+
+                if constexpr (std::is_same_v<std::remove_cv_t<R>, bool>)
+                {
+                    return result != 0;
+                }
+                else
+                {
+                    return result;
+                }
+            }
+        }
+
+        DotNetHost *m_Host = nullptr;
+        int m_MethodId = 0;
+    };
+}
+
+// Declares the managed counterpart of a native struct. Must be used at global scope.
+// The struct has to be trivially copyable and exactly ExpectedSize bytes, matching the managed
+// [StructLayout(LayoutKind.Sequential)] definition. Its sizeof/alignof are checked again against the
+// managed type when a ScriptMethod using it is first bound.
+#define MOCHI_SCRIPT_STRUCT(NativeType, ManagedTypeName, ExpectedSize)                                      \
+    static_assert(std::is_trivially_copyable_v<NativeType>, #NativeType " must be trivially copyable");    \
+    static_assert(sizeof(NativeType) == (ExpectedSize), "sizeof(" #NativeType ") does not match its managed layout"); \
+    template<> struct MochiSharp::ScriptTypeTraits<NativeType> { static constexpr const char *Name = ManagedTypeName; }
+
+#endif // !SCRIPT_METHOD_H
@@ -0,0 +1,436 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptRecorder.h"
+
+#include <cstring>
+
+namespace MochiSharp
+{
+    namespace
+    {
+        constexpr size_t FlushThreshold = 1 << 20;
+
+        class RecordReader
+        {
+        public:
+            explicit RecordReader(std::ifstream &stream) : m_Stream(stream) {}
+
+            bool ReadBytes(void *data, size_t size)
+            {
+                return size == 0 || (bool)m_Stream.read(static_cast<char *>(data), (std::streamsize)size);
+            }
+
+            template<typename T>
+            bool Read(T &value) { return ReadBytes(&value, sizeof(T)); }
+
+            bool ReadString(std::string &text)
+            {
+                uint32_t length = 0;
+                if (!Read(length))
+                {
+                    return false;
+                }
+
+                text.resize(length);
+                return ReadBytes(text.data(), length);
+            }
+
+            bool ReadBlob(std::vector<uint8_t> &bytes)
+            {
+                uint32_t length = 0;
+                if (!Read(length))
+                {
+                    return false;
+                }
+
+                bytes.resize(length);
+                return ReadBytes(bytes.data(), length);
+            }
+
+            template<typename T>
+            bool ReadArray(std::vector<T> &values, uint32_t count)
+            {
+                values.resize(count);
+                return ReadBytes(values.data(), count * sizeof(T));
+            }
+
+        private:
+            std::ifstream &m_Stream;
+        };
+    }
+
+    ScriptRecorder::~ScriptRecorder()
+    {
+        Stop();
+    }
+
+    bool ScriptRecorder::Start(const std::filesystem::path &path)
+    {
+        Stop();
+
+        m_File.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_File)
+        {
+            return false;
+        }
+
+        m_Buffer.clear();
+        m_Buffer.reserve(FlushThreshold + 4096);
+        WriteBytes(Magic, sizeof(Magic));
+        Write(Version);
+
+        m_SignatureLayouts.clear();
+        m_MethodSignatures.clear();
+        m_SkippedCalls = 0;
+        m_Recording = true;
+        return true;
+    }
+
+    void ScriptRecorder::Stop()
+    {
+        if (!m_Recording)
+        {
+            return;
+        }
+
+        Flush();
+        m_File.close();
+        m_Recording = false;
+    }
+
+    void ScriptRecorder::RecordLoadModule(int moduleHandle, const std::string &path)
+    {
+        WriteType(RecordType::LoadModule);
+        Write<int32_t>(moduleHandle);
+        WriteString(path.c_str());
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordLoadModuleFromMemory(int moduleHandle, const std::string &name, const void *image, size_t imageSize,
+        const void *symbols, size_t symbolsSize)
+    {
+        symbolsSize = symbols ? symbolsSize : 0;
+        WriteType(RecordType::LoadModuleFromMemory);
+        Write<int32_t>(moduleHandle);
+        WriteString(name.c_str());
+        Write((uint32_t)imageSize);
+        WriteBytes(image, imageSize);
+        Write((uint32_t)symbolsSize);
+        WriteBytes(symbols, symbolsSize);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordLoadSharedAssembly(const std::string &path)
+    {
+        WriteType(RecordType::LoadSharedAssembly);
+        WriteString(path.c_str());
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordConfigureSerialization(const char *attributeTypeName, const char *entityTypeName)
+    {
+        WriteType(RecordType::ConfigureSerialization);
+        WriteString(attributeTypeName);
+        WriteString(entityTypeName);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordRegisterSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount,
+        const int *nativeSizes, const int *nativeAlignments, std::vector<int> layout)
+    {
+        uint32_t count = parameterCount > 0 ? (uint32_t)parameterCount : 0;
+        WriteType(RecordType::RegisterSignature);
+        Write<int32_t>(signatureId);
+        WriteString(returnTypeName);
+        Write(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            WriteString(parameterTypeNames[i]);
+        }
+
+        bool checked = nativeSizes != nullptr;
+        Write<uint8_t>(checked ? 1 : 0);
+        if (checked)
+        {
+            for (uint32_t i = 0; i <= count; i++)
+            {
+                Write<int32_t>(nativeSizes[i]);
+            }
+            for (uint32_t i = 0; i <= count; i++)
+            {
+                Write<int32_t>(nativeAlignments ? nativeAlignments[i] : 0);
+            }
+        }
+
+        m_SignatureLayouts[signatureId] = std::move(layout);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordCreateInstance(uint64_t instanceId, const char *typeName)
+    {
+        WriteType(RecordType::CreateInstance);
+        Write(instanceId);
+        WriteString(typeName);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordCreateInstances(const char *typeName, const uint64_t *instanceIds, int count)
+    {
+        WriteType(RecordType::CreateInstances);
+        WriteString(typeName);
+        Write<uint32_t>((uint32_t)count);
+        WriteBytes(instanceIds, (size_t)count * sizeof(uint64_t));
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordDestroyInstance(uint64_t instanceId)
+    {
+        WriteType(RecordType::DestroyInstance);
+        Write(instanceId);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordDestroyInstances(const uint64_t *instanceIds, int count, double budgetMilliseconds)
+    {
+        WriteType(RecordType::DestroyInstances);
+        Write(budgetMilliseconds);
+        Write<uint32_t>((uint32_t)count);
+        WriteBytes(instanceIds, (size_t)count * sizeof(uint64_t));
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordConfigureInstancePool(const char *typeName, int capacity)
+    {
+        WriteType(RecordType::ConfigureInstancePool);
+        WriteString(typeName);
+        Write<int32_t>(capacity);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordBindInstanceMethod(int methodId, uint64_t instanceId, const char *methodName, int signature)
+    {
+        WriteType(RecordType::BindInstanceMethod);
+        Write<int32_t>(methodId);
+        Write(instanceId);
+        WriteString(methodName);
+        Write<int32_t>(signature);
+        m_MethodSignatures[methodId] = signature;
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordBindStaticMethod(int methodId, const char *typeName, const char *methodName, int signature)
+    {
+        WriteType(RecordType::BindStaticMethod);
+        Write<int32_t>(methodId);
+        WriteString(typeName);
+        WriteString(methodName);
+        Write<int32_t>(signature);
+        m_MethodSignatures[methodId] = signature;
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordInvoke(int methodId, const void *argsPtr, int argCount)
+    {
+        auto method = m_MethodSignatures.find(methodId);
+        if (method == m_MethodSignatures.end())
+        {
+            m_SkippedCalls++;
+            return;
+        }
+
+        auto layout = m_SignatureLayouts.find(method->second);
+        if (layout == m_SignatureLayouts.end() || layout->second.size() != (size_t)argCount + 1)
+        {
+            m_SkippedCalls++;
+            return;
+        }
+
+        const auto &sizes = layout->second;
+        uint32_t total = 0;
+        for (int i = 1; i <= argCount; i++)
+        {
+            total += (uint32_t)sizes[i];
+        }
+
+        WriteType(RecordType::Invoke);
+        Write<int32_t>(methodId);
+        Write<uint32_t>((uint32_t)argCount);
+        Write(total);
+
+        const void *const *args = static_cast<const void *const *>(argsPtr);
+        for (int i = 0; i < argCount; i++)
+        {
+            size_t size = (size_t)sizes[i + 1];
+            if (args[i] != nullptr)
+            {
+                WriteBytes(args[i], size);
+            }
+            else
+            {
+                m_Buffer.resize(m_Buffer.size() + size, 0);
+            }
+        }
+
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordSetFieldValue(uint64_t instanceId, const char *fieldName, const void *buffer, int bufferSize)
+    {
+        uint32_t size = bufferSize > 0 && buffer ? (uint32_t)bufferSize : 0;
+        WriteType(RecordType::SetFieldValue);
+        Write(instanceId);
+        WriteString(fieldName);
+        Write(size);
+        WriteBytes(buffer, size);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordTickScheduler(double deltaSeconds)
+    {
+        WriteType(RecordType::TickScheduler);
+        Write(deltaSeconds);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::RecordEndFrame()
+    {
+        WriteType(RecordType::EndFrame);
+        FlushIfFull();
+    }
+
+    void ScriptRecorder::WriteBytes(const void *data, size_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+    }
+
+    void ScriptRecorder::WriteString(const char *text)
+    {
+        uint32_t length = text ? (uint32_t)std::strlen(text) : 0;
+        Write(length);
+        WriteBytes(text, length);
+    }
+
+    void ScriptRecorder::FlushIfFull()
+    {
+        if (m_Buffer.size() >= FlushThreshold)
+        {
+            Flush();
+        }
+    }
+
+    void ScriptRecorder::Flush()
+    {
+        if (!m_Buffer.empty())
+        {
+            m_File.write(reinterpret_cast<const char *>(m_Buffer.data()), (std::streamsize)m_Buffer.size());
+            m_Buffer.clear();
+        }
+        m_File.flush();
+    }
+
+    bool ScriptRecorder::Load(const std::filesystem::path &path, std::vector<ScriptRecord> &records)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        RecordReader reader(stream);
+
+        char magic[4] = {};
+        uint32_t version = 0;
+        if (!reader.ReadBytes(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(magic)) != 0 || !reader.Read(version) || version == 0 || version > Version)
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            uint8_t type = 0;
+            if (!reader.Read(type))
+            {
+                // Clean end of file.
+                return stream.eof();
+            }
+
+            ScriptRecord record;
+            record.Type = (RecordType)type;
+            uint32_t count = 0;
+            bool ok = true;
+            switch (record.Type)
+            {
+            case RecordType::LoadModule:
+                ok = reader.Read(record.Id) && reader.ReadString(record.Name);
+                break;
+            case RecordType::LoadModuleFromMemory:
+                ok = reader.Read(record.Id) && reader.ReadString(record.Name) && reader.ReadBlob(record.Bytes) && reader.ReadBlob(record.Symbols);
+                break;
+            case RecordType::LoadSharedAssembly:
+                ok = reader.ReadString(record.Name);
+                break;
+            case RecordType::ConfigureSerialization:
+                ok = reader.ReadString(record.Name) && reader.ReadString(record.TypeName);
+                break;
+            case RecordType::RegisterSignature:
+            {
+                uint8_t checked = 0;
+                ok = reader.Read(record.Id) && reader.ReadString(record.TypeName) && reader.Read(count);
+                record.Names.resize(ok ? count : 0);
+                for (uint32_t i = 0; ok && i < count; i++)
+                {
+                    ok = reader.ReadString(record.Names[i]);
+                }
+                ok = ok && reader.Read(checked);
+                if (ok && checked)
+                {
+                    ok = reader.ReadArray(record.Sizes, count + 1) && reader.ReadArray(record.Alignments, count + 1);
+                }
+                break;
+            }
+            case RecordType::CreateInstance:
+                ok = reader.Read(record.InstanceId) && reader.ReadString(record.TypeName);
+                break;
+            case RecordType::CreateInstances:
+                ok = reader.ReadString(record.TypeName) && reader.Read(count) && reader.ReadArray(record.InstanceIds, count);
+                break;
+            case RecordType::DestroyInstance:
+                ok = reader.Read(record.InstanceId);
+                break;
+            case RecordType::DestroyInstances:
+                ok = reader.Read(record.Value) && reader.Read(count) && reader.ReadArray(record.InstanceIds, count);
+                break;
+            case RecordType::ConfigureInstancePool:
+                ok = reader.ReadString(record.TypeName) && reader.Read(record.Id);
+                break;
+            case RecordType::BindInstanceMethod:
+                ok = reader.Read(record.Id) && reader.Read(record.InstanceId) && reader.ReadString(record.Name) && reader.Read(record.Signature);
+                break;
+            case RecordType::BindStaticMethod:
+                ok = reader.Read(record.Id) && reader.ReadString(record.TypeName) && reader.ReadString(record.Name) && reader.Read(record.Signature);
+                break;
+            case RecordType::Invoke:
+                ok = reader.Read(record.Id) && reader.Read(record.ArgCount) && reader.ReadBlob(record.Bytes);
+                break;
+            case RecordType::SetFieldValue:
+                ok = reader.Read(record.InstanceId) && reader.ReadString(record.Name) && reader.ReadBlob(record.Bytes);
+                break;
+            case RecordType::TickScheduler:
+                ok = reader.Read(record.Value);
+                break;
+            case RecordType::EndFrame:
+                break;
+            default:
+                return false;
+            }
+
+            if (!ok)
+            {
+                return false;
+            }
+
+            records.push_back(std::move(record));
+        }
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_RECORDER_H
+#define SCRIPT_RECORDER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Binary log of the calls a host makes into scripts, for replaying a real workload headless
+// (MochiSharp.Replay).
+//
+//   host.StartRecording("session.msrec");    // before LoadModule: the log must contain the setup
+//   ... play ...
+//   host.StopRecording();
+//
+// The log holds module loads, signature registrations, instance creation and destruction, bindings,
+// field writes, Invoke (method id plus the raw bytes of each argument), scheduler ticks and frame
+// ends, in call order. Modules loaded from memory are stored with their image (and symbols), so the
+// replay does not depend on where the host got them. Events pushed through PushEvent are not
+// recorded. Argument sizes come from the managed signature layout, so only the bytes the script
+// reads are stored.
+//
+// Layout: "MSRL", uint32 version, then records of one uint8 RecordType followed by its fields.
+// Integers are little-endian, strings and blobs are uint32 length + bytes.
+
+namespace MochiSharp
+{
+    enum class RecordType : uint8_t
+    {
+        LoadModule = 1,             // int32 handle, str path
+        LoadSharedAssembly,         // str path
+        ConfigureSerialization,     // str attributeType, str entityType
+        RegisterSignature,          // int32 id, str returnType, uint32 n, str[n], uint8 checked, [int32 sizes[n+1], int32 alignments[n+1]]
+        CreateInstance,             // uint64 id, str type
+        CreateInstances,            // str type, uint32 n, uint64[n]
+        DestroyInstance,            // uint64 id
+        DestroyInstances,           // double budget, uint32 n, uint64[n]
+        ConfigureInstancePool,      // str type, int32 capacity
+        BindInstanceMethod,         // int32 methodId, uint64 instance, str name, int32 signature
+        BindStaticMethod,           // int32 methodId, str type, str name, int32 signature
+        Invoke,                     // int32 methodId, uint32 argCount, blob args (arguments back to back)
+        SetFieldValue,              // uint64 instance, str field, blob value
+        TickScheduler,              // double deltaSeconds
+        EndFrame,                   //
+        LoadModuleFromMemory        // int32 handle, str name, blob image, blob symbols (version 2)
+    };
+
+    struct ScriptRecord
+    {
+        RecordType Type = RecordType::EndFrame;
+        int32_t Id = 0;             // module handle, signature id, method id or pool capacity
+        int32_t Signature = 0;
+        uint64_t InstanceId = 0;
+        double Value = 0.0;
+        uint32_t ArgCount = 0;
+        std::string Name;
+        std::string TypeName;
+        std::vector<std::string> Names;
+        std::vector<int32_t> Sizes;
+        std::vector<int32_t> Alignments;
+        std::vector<uint64_t> InstanceIds;
+        std::vector<uint8_t> Bytes;
+        std::vector<uint8_t> Symbols;
+    };
+
+    class ScriptRecorder
+    {
+    public:
+        static constexpr char Magic[4] = { 'M', 'S', 'R', 'L' };
+        static constexpr uint32_t Version = 2;
+
+        ScriptRecorder() = default;
+        ~ScriptRecorder();
+
+        ScriptRecorder(const ScriptRecorder &) = delete;
+        ScriptRecorder &operator=(const ScriptRecorder &) = delete;
+
+        bool Start(const std::filesystem::path &path);
+        void Stop();
+        bool IsRecording() const { return m_Recording; }
+        // Invokes that could not be recorded because their method was bound before recording started.
+        uint64_t GetSkippedCalls() const { return m_SkippedCalls; }
+
+        void RecordLoadModule(int moduleHandle, const std::string &path);
+        void RecordLoadModuleFromMemory(int moduleHandle, const std::string &name, const void *image, size_t imageSize,
+            const void *symbols, size_t symbolsSize);
+        void RecordLoadSharedAssembly(const std::string &path);
+        void RecordConfigureSerialization(const char *attributeTypeName, const char *entityTypeName);
+        // layout: native size of the return value and of each parameter (GetSignatureLayout).
+        void RecordRegisterSignature(int signatureId, const char *returnTypeName, const char **parameterTypeNames, int parameterCount,
+            const int *nativeSizes, const int *nativeAlignments, std::vector<int> layout);
+        void RecordCreateInstance(uint64_t instanceId, const char *typeName);
+        void RecordCreateInstances(const char *typeName, const uint64_t *instanceIds, int count);
+        void RecordDestroyInstance(uint64_t instanceId);
+        void RecordDestroyInstances(const uint64_t *instanceIds, int count, double budgetMilliseconds);
+        void RecordConfigureInstancePool(const char *typeName, int capacity);
+        void RecordBindInstanceMethod(int methodId, uint64_t instanceId, const char *methodName, int signature);
+        void RecordBindStaticMethod(int methodId, const char *typeName, const char *methodName, int signature);
+        void RecordInvoke(int methodId, const void *argsPtr, int argCount);
+        void RecordSetFieldValue(uint64_t instanceId, const char *fieldName, const void *buffer, int bufferSize);
+        void RecordTickScheduler(double deltaSeconds);
+        void RecordEndFrame();
+
+        // Reads a whole log of this or an earlier version into memory. Returns false (with what was read
+        // so far) on a bad header or a truncated record.
+        static bool Load(const std::filesystem::path &path, std::vector<ScriptRecord> &records);
+
+    private:
+        void WriteType(RecordType type) { m_Buffer.push_back((uint8_t)type); }
+        void WriteBytes(const void *data, size_t size);
+        template<typename T>
+        void Write(T value) { WriteBytes(&value, sizeof(T)); }
+        void WriteString(const char *text);
+        void FlushIfFull();
+        void Flush();
+
+        std::ofstream m_File;
+        std::vector<uint8_t> m_Buffer;
+        bool m_Recording = false;
+        uint64_t m_SkippedCalls = 0;
+
+        // What RecordInvoke needs to know how many bytes each argument has.
+        std::unordered_map<int, std::vector<int>> m_SignatureLayouts;
+        std::unordered_map<int, int> m_MethodSignatures;
+    };
+}
+
+#endif // !SCRIPT_RECORDER_H
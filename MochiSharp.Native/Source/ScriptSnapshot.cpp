@@ -0,0 +1,433 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptSnapshot.h"
+
+#include <algorithm>
+
+namespace MochiSharp
+{
+    namespace
+    {
+        enum class DeltaOp : uint8_t
+        {
+            Removed = 0,
+            Changed = 1,    // runs of the record XOR the baseline record
+            Added = 2       // varint layout hash, varint size, runs of the record
+        };
+
+        // Zero runs shorter than this stay inside the literal run: ending a run and starting the next
+        // costs two varints.
+        constexpr size_t MinZeroRun = 3;
+
+        size_t Align(size_t size)
+        {
+            return (size + 7) & ~(size_t)7;
+        }
+
+        uint32_t HashBytes(const uint8_t *data, size_t size)
+        {
+            uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < size; i++)
+            {
+                hash = (hash ^ data[i]) * 16777619u;
+            }
+            return hash;
+        }
+
+        struct SnapshotRecord
+        {
+            ScriptSnapshotEntry Entry;
+            const uint8_t *Data;
+        };
+
+        // Validates the whole snapshot up front; an empty one (size 0) has no entries.
+        bool ReadSnapshot(const void *snapshot, size_t size, std::vector<SnapshotRecord> &records)
+        {
+            records.clear();
+            if (size == 0)
+            {
+                return true;
+            }
+
+            const auto *bytes = static_cast<const uint8_t *>(snapshot);
+            ScriptSnapshotHeader header;
+            if (!bytes || size < sizeof(header))
+            {
+                return false;
+            }
+
+            std::memcpy(&header, bytes, sizeof(header));
+            if (header.Magic != ScriptSnapshotMagic || header.Version != ScriptSnapshotVersion
+                || header.Size < (int32_t)sizeof(header) || (size_t)header.Size > size)
+            {
+                return false;
+            }
+
+            size_t end = (size_t)header.Size;
+            records.reserve(std::min<size_t>((size_t)std::max(header.EntryCount, 0), end / (sizeof(ScriptSnapshotEntry) + 8)));
+            for (size_t offset = sizeof(header); offset < end;)
+            {
+                SnapshotRecord record;
+                if (end - offset < sizeof(ScriptSnapshotEntry))
+                {
+                    return false;
+                }
+
+                std::memcpy(&record.Entry, bytes + offset, sizeof(record.Entry));
+                if (record.Entry.Size <= 0 || (size_t)record.Entry.Size > end - offset - sizeof(ScriptSnapshotEntry)
+                    || (!records.empty() && records.back().Entry.InstanceId >= record.Entry.InstanceId))
+                {
+                    return false;
+                }
+
+                record.Data = bytes + offset + sizeof(ScriptSnapshotEntry);
+                records.push_back(record);
+                offset += Align(sizeof(ScriptSnapshotEntry) + (size_t)record.Entry.Size);
+            }
+
+            return records.size() == (size_t)header.EntryCount;
+        }
+
+        void WriteVarint(std::vector<uint8_t> &out, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back((uint8_t)(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back((uint8_t)value);
+        }
+
+        class DeltaReader
+        {
+        public:
+            DeltaReader(const uint8_t *data, size_t size) : m_Data(data), m_Size(size) {}
+
+            bool ReadVarint(uint64_t &value)
+            {
+                value = 0;
+                for (int shift = 0; shift < 64 && m_Offset < m_Size; shift += 7)
+                {
+                    uint8_t byte = m_Data[m_Offset++];
+                    value |= (uint64_t)(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool ReadByte(uint8_t &value)
+            {
+                if (m_Offset >= m_Size)
+                {
+                    return false;
+                }
+                value = m_Data[m_Offset++];
+                return true;
+            }
+
+            const uint8_t *ReadBytes(size_t count)
+            {
+                if (count > m_Size - m_Offset)
+                {
+                    return nullptr;
+                }
+                const uint8_t *bytes = m_Data + m_Offset;
+                m_Offset += count;
+                return bytes;
+            }
+
+            bool AtEnd() const { return m_Offset == m_Size; }
+
+        private:
+            const uint8_t *m_Data;
+            size_t m_Size;
+            size_t m_Offset = 0;
+        };
+
+        // Runs of (record XOR base); base is null for records sent whole.
+        void WriteRuns(std::vector<uint8_t> &out, const uint8_t *record, const uint8_t *base, size_t size)
+        {
+            auto byteAt = [&](size_t i) { return (uint8_t)(base ? record[i] ^ base[i] : record[i]); };
+
+            // One byte is reserved for the run count; records rarely have 128 runs or more.
+            size_t runCountOffset = out.size();
+            out.push_back(0);
+            uint64_t runs = 0;
+            size_t i = 0;
+            while (i < size)
+            {
+                size_t zeros = 0;
+                for (; i < size && byteAt(i) == 0; i++)
+                {
+                    zeros++;
+                }
+                if (i == size)
+                {
+                    break;
+                }
+
+                // The literal run ends before MinZeroRun zeros in a row, or before the trailing zeros.
+                size_t start = i;
+                size_t end = i;
+                for (size_t zeroStreak = 0; i < size; i++)
+                {
+                    if (byteAt(i) != 0)
+                    {
+                        zeroStreak = 0;
+                        end = i + 1;
+                    }
+                    else if (++zeroStreak == MinZeroRun)
+                    {
+                        break;
+                    }
+                }
+                i = end;
+
+                WriteVarint(out, zeros);
+                WriteVarint(out, end - start);
+                for (size_t j = start; j < end; j++)
+                {
+                    out.push_back(byteAt(j));
+                }
+                runs++;
+            }
+
+            uint8_t count[10];
+            size_t countSize = 0;
+            for (uint64_t value = runs; ; value >>= 7)
+            {
+                count[countSize++] = (uint8_t)(value >= 0x80 ? (value & 0x7F) | 0x80 : value);
+                if (value < 0x80)
+                {
+                    break;
+                }
+            }
+            out[runCountOffset] = count[0];
+            out.insert(out.begin() + (ptrdiff_t)runCountOffset + 1, count + 1, count + countSize);
+        }
+
+        bool ReadRuns(DeltaReader &reader, uint8_t *record, const uint8_t *base, size_t size)
+        {
+            if (base)
+            {
+                std::memcpy(record, base, size);
+            }
+            else
+            {
+                std::memset(record, 0, size);
+            }
+
+            uint64_t runs = 0;
+            if (!reader.ReadVarint(runs))
+            {
+                return false;
+            }
+
+            size_t offset = 0;
+            for (uint64_t run = 0; run < runs; run++)
+            {
+                uint64_t zeros = 0, literals = 0;
+                if (!reader.ReadVarint(zeros) || !reader.ReadVarint(literals) || zeros > size - offset || literals > size - offset - zeros)
+                {
+                    return false;
+                }
+
+                offset += (size_t)zeros;
+                const uint8_t *bytes = reader.ReadBytes((size_t)literals);
+                if (!bytes)
+                {
+                    return false;
+                }
+
+                for (size_t j = 0; j < literals; j++)
+                {
+                    record[offset + j] ^= bytes[j];
+                }
+                offset += (size_t)literals;
+            }
+
+            return true;
+        }
+
+        void AppendEntry(std::vector<uint8_t> &snapshot, uint64_t instanceId, uint32_t layoutHash, size_t size, const uint8_t *data)
+        {
+            ScriptSnapshotEntry entry{ instanceId, layoutHash, (int32_t)size };
+            size_t offset = snapshot.size();
+            snapshot.resize(offset + Align(sizeof(entry) + size), 0);
+            std::memcpy(snapshot.data() + offset, &entry, sizeof(entry));
+            if (data)
+            {
+                std::memcpy(snapshot.data() + offset + sizeof(entry), data, size);
+            }
+        }
+    }
+
+    bool EncodeSnapshotDelta(const void *baseline, size_t baselineSize, const void *current, size_t currentSize, std::vector<uint8_t> &delta)
+    {
+        std::vector<SnapshotRecord> before, after;
+        if (!ReadSnapshot(baseline, baselineSize, before) || !ReadSnapshot(current, currentSize, after) || currentSize == 0)
+        {
+            return false;
+        }
+
+        ScriptSnapshotDeltaHeader header{ ScriptSnapshotDeltaMagic, ScriptSnapshotVersion,
+            baselineSize ? HashBytes(static_cast<const uint8_t *>(baseline), baselineSize) : 0u, 0 };
+        delta.assign(sizeof(header), 0);
+
+        uint64_t lastId = 0;
+        auto beginOp = [&](uint64_t instanceId, DeltaOp op)
+        {
+            WriteVarint(delta, instanceId - lastId);
+            delta.push_back((uint8_t)op);
+            lastId = instanceId;
+            header.OpCount++;
+        };
+
+        size_t b = 0;
+        for (const auto &record : after)
+        {
+            uint64_t id = record.Entry.InstanceId;
+            for (; b < before.size() && before[b].Entry.InstanceId < id; b++)
+            {
+                beginOp(before[b].Entry.InstanceId, DeltaOp::Removed);
+            }
+
+            const SnapshotRecord *base = b < before.size() && before[b].Entry.InstanceId == id ? &before[b++] : nullptr;
+            size_t size = (size_t)record.Entry.Size;
+            if (base && base->Entry.LayoutHash == record.Entry.LayoutHash && base->Entry.Size == record.Entry.Size)
+            {
+                if (std::memcmp(base->Data, record.Data, size) != 0)
+                {
+                    beginOp(id, DeltaOp::Changed);
+                    WriteRuns(delta, record.Data, base->Data, size);
+                }
+                continue;
+            }
+
+            if (size > ScriptSnapshotMaxRecordSize)
+            {
+                return false;
+            }
+
+            beginOp(id, DeltaOp::Added);
+            WriteVarint(delta, record.Entry.LayoutHash);
+            WriteVarint(delta, size);
+            WriteRuns(delta, record.Data, nullptr, size);
+        }
+
+        for (; b < before.size(); b++)
+        {
+            beginOp(before[b].Entry.InstanceId, DeltaOp::Removed);
+        }
+
+        std::memcpy(delta.data(), &header, sizeof(header));
+        return true;
+    }
+
+    bool ApplySnapshotDelta(const void *baseline, size_t baselineSize, const void *delta, size_t deltaSize, std::vector<uint8_t> &snapshot)
+    {
+        std::vector<SnapshotRecord> before;
+        ScriptSnapshotDeltaHeader header;
+        if (!ReadSnapshot(baseline, baselineSize, before) || !delta || deltaSize < sizeof(header))
+        {
+            return false;
+        }
+
+        std::memcpy(&header, delta, sizeof(header));
+        uint32_t baselineHash = baselineSize ? HashBytes(static_cast<const uint8_t *>(baseline), baselineSize) : 0u;
+        if (header.Magic != ScriptSnapshotDeltaMagic || header.Version != ScriptSnapshotVersion || header.BaselineHash != baselineHash)
+        {
+            return false;
+        }
+
+        snapshot.assign(sizeof(ScriptSnapshotHeader), 0);
+        int32_t entryCount = 0;
+        size_t b = 0;
+        auto copyBaselineUntil = [&](uint64_t instanceId)
+        {
+            for (; b < before.size() && before[b].Entry.InstanceId < instanceId; b++, entryCount++)
+            {
+                AppendEntry(snapshot, before[b].Entry.InstanceId, before[b].Entry.LayoutHash, (size_t)before[b].Entry.Size, before[b].Data);
+            }
+        };
+
+        DeltaReader reader(static_cast<const uint8_t *>(delta) + sizeof(header), deltaSize - sizeof(header));
+        uint64_t id = 0;
+        for (uint32_t op = 0; op < header.OpCount; op++)
+        {
+            uint64_t idDelta = 0;
+            uint8_t kind = 0;
+            if (!reader.ReadVarint(idDelta) || !reader.ReadByte(kind) || (op > 0 && idDelta == 0))
+            {
+                return false;
+            }
+
+            id += idDelta;
+            copyBaselineUntil(id);
+            const SnapshotRecord *base = b < before.size() && before[b].Entry.InstanceId == id ? &before[b++] : nullptr;
+            switch ((DeltaOp)kind)
+            {
+            case DeltaOp::Removed:
+                if (!base)
+                {
+                    return false;
+                }
+                break;
+            case DeltaOp::Changed:
+            {
+                if (!base)
+                {
+                    return false;
+                }
+
+                size_t size = (size_t)base->Entry.Size;
+                AppendEntry(snapshot, id, base->Entry.LayoutHash, size, nullptr);
+                if (!ReadRuns(reader, snapshot.data() + snapshot.size() - Align(sizeof(ScriptSnapshotEntry) + size) + sizeof(ScriptSnapshotEntry), base->Data, size))
+                {
+                    return false;
+                }
+                entryCount++;
+                break;
+            }
+            case DeltaOp::Added:
+            {
+                uint64_t layoutHash = 0, size = 0;
+                if (!reader.ReadVarint(layoutHash) || !reader.ReadVarint(size) || layoutHash > UINT32_MAX || size == 0 || size > ScriptSnapshotMaxRecordSize)
+                {
+                    return false;
+                }
+
+                AppendEntry(snapshot, id, (uint32_t)layoutHash, (size_t)size, nullptr);
+                if (!ReadRuns(reader, snapshot.data() + snapshot.size() - Align(sizeof(ScriptSnapshotEntry) + (size_t)size) + sizeof(ScriptSnapshotEntry), nullptr, (size_t)size))
+                {
+                    return false;
+                }
+                entryCount++;
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+
+        copyBaselineUntil(UINT64_MAX);
+        if (b < before.size())
+        {
+            // An id of UINT64_MAX is not covered by the loop above.
+            AppendEntry(snapshot, before[b].Entry.InstanceId, before[b].Entry.LayoutHash, (size_t)before[b].Entry.Size, before[b].Data);
+            entryCount++;
+        }
+
+        if (!reader.AtEnd() || snapshot.size() > INT32_MAX)
+        {
+            return false;
+        }
+
+        ScriptSnapshotHeader result{ ScriptSnapshotMagic, ScriptSnapshotVersion, entryCount, (int32_t)snapshot.size() };
+        std::memcpy(snapshot.data(), &result, sizeof(result));
+        return true;
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_SNAPSHOT_H
+#define SCRIPT_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Network replication of script state. A snapshot packs the [Replicated] fields of every script
+// instance; a delta encodes one snapshot against an older one the receiver already has.
+//
+//   // server, every tick: one call into scripts, then one delta per client against what it acked
+//   host.CaptureSnapshot(current);
+//   MochiSharp::EncodeSnapshotDelta(client.Acked.data(), client.Acked.size(), current.data(), current.size(), packet);
+//
+//   // client: rebuild the snapshot from the same baseline, then write it into its instances
+//   MochiSharp::ApplySnapshotDelta(acked.data(), acked.size(), packet.data(), packet.size(), next);
+//   host.ApplySnapshot(next.data(), next.size(), acked.data(), acked.size());
+//
+// Snapshot layout (written by MochiSharp.Managed.Core.ScriptSnapshot): ScriptSnapshotHeader, then one
+// ScriptSnapshotEntry per instance with replicated fields in ascending id order, each followed by its
+// fields packed without padding; entries start on 8-byte boundaries. The layout hash identifies the
+// script type and its replicated fields, so records of a different build are not applied.
+//
+// Delta layout: ScriptSnapshotDeltaHeader, then per added, changed or removed instance a varint id
+// (difference to the previous one) and a kind byte. Changed records are XORed with the baseline's,
+// added ones are sent whole (with varint layout hash and size), and both are then written as a
+// varint run count followed by (varint zero bytes, varint literal bytes, literals) runs. Trailing
+// zeros are implied. Unchanged fields and bytes cost nothing, so fields that move in small steps (or
+// are quantized to integers by the script) send little more than their low bytes.
+
+namespace MochiSharp
+{
+    // Shared with MochiSharp.Managed.Core.ScriptSnapshot; keep both layouts in sync.
+    struct ScriptSnapshotHeader
+    {
+        uint32_t Magic;         // "MSRS"
+        uint32_t Version;
+        int32_t EntryCount;
+        int32_t Size;           // bytes, this header included
+    };
+
+    struct ScriptSnapshotEntry
+    {
+        uint64_t InstanceId;
+        uint32_t LayoutHash;
+        int32_t Size;           // record bytes that follow
+    };
+
+    struct ScriptSnapshotDeltaHeader
+    {
+        uint32_t Magic;         // "MSRD"
+        uint32_t Version;
+        uint32_t BaselineHash;  // FNV-1a of the baseline snapshot, 0 when encoded against none
+        uint32_t OpCount;
+    };
+
+    static_assert(sizeof(ScriptSnapshotHeader) == 16 && sizeof(ScriptSnapshotEntry) == 16, "Snapshot headers must match the managed layout");
+
+    constexpr uint32_t ScriptSnapshotMagic = 0x5352534D;
+    constexpr uint32_t ScriptSnapshotDeltaMagic = 0x4452534D;
+    constexpr uint32_t ScriptSnapshotVersion = 1;
+    // Largest record a script type may replicate (ScriptSnapshot.MaxRecordSize in managed code). A
+    // delta that adds a larger record is malformed.
+    constexpr size_t ScriptSnapshotMaxRecordSize = 4096;
+
+    // Encodes current against baseline, which may be empty (every entry is then sent whole). False if
+    // either is not a valid snapshot, or current holds a record receivers would reject as too large.
+    bool EncodeSnapshotDelta(const void *baseline, size_t baselineSize, const void *current, size_t currentSize, std::vector<uint8_t> &delta);
+
+    // Rebuilds the snapshot a delta was encoded from, given the same baseline. False if the delta is
+    // malformed or was encoded against a different baseline. Added records larger than
+    // ScriptSnapshotMaxRecordSize are rejected, so a packet cannot make the receiver allocate more than
+    // any script's replicated state can take.
+    bool ApplySnapshotDelta(const void *baseline, size_t baselineSize, const void *delta, size_t deltaSize, std::vector<uint8_t> &snapshot);
+
+    // Calls fn(const ScriptSnapshotEntry &, const uint8_t *record) for each entry of a valid snapshot,
+    // e.g. to filter what a client gets before encoding its delta.
+    template<typename Fn>
+    void ForEachSnapshotEntry(const void *snapshot, size_t size, Fn &&fn)
+    {
+        const auto *bytes = static_cast<const uint8_t *>(snapshot);
+        ScriptSnapshotHeader header;
+        if (size < sizeof(header))
+        {
+            return;
+        }
+
+        std::memcpy(&header, bytes, sizeof(header));
+        size_t end = header.Size >= (int32_t)sizeof(header) && (size_t)header.Size <= size ? (size_t)header.Size : sizeof(header);
+        for (size_t offset = sizeof(header); offset + sizeof(ScriptSnapshotEntry) <= end;)
+        {
+            ScriptSnapshotEntry entry;
+            std::memcpy(&entry, bytes + offset, sizeof(entry));
+            if (entry.Size <= 0 || (size_t)entry.Size > end - offset - sizeof(entry))
+            {
+                return;
+            }
+
+            fn(entry, bytes + offset + sizeof(entry));
+            offset += (sizeof(entry) + (size_t)entry.Size + 7) & ~(size_t)7;
+        }
+    }
+}
+
+#endif // !SCRIPT_SNAPSHOT_H
@@ -0,0 +1,172 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptWatchdog.h"
+
+namespace MochiSharp
+{
+    static_assert(sizeof(ScriptWatchdog::SharedState) == 8, "SharedState must match the managed layout");
+
+    ScriptWatchdog::~ScriptWatchdog()
+    {
+        Stop();
+    }
+
+    bool ScriptWatchdog::Start(ScriptWatchdogSettings settings)
+    {
+        Stop();
+
+        if (settings.PollInterval.count() <= 0)
+        {
+            settings.PollInterval = std::chrono::milliseconds(1);
+        }
+
+        m_Settings = std::move(settings);
+        m_FrameTime = Clock::duration::zero();
+        m_FrameCalls = 0;
+        m_SlowestMethodId = 0;
+        m_SlowestCall = Clock::duration::zero();
+        m_StopRequested = false;
+        m_Enabled = true;
+
+        // Only the per-call budget and the abort need to see calls that have not returned yet.
+        if (m_Settings.CallBudget.count() > 0 || m_Settings.AbortAfter.count() > 0)
+        {
+            m_Thread = std::thread(&ScriptWatchdog::Run, this);
+        }
+
+        return true;
+    }
+
+    void ScriptWatchdog::Stop()
+    {
+        if (m_Thread.joinable())
+        {
+            {
+                std::lock_guard lock(m_Mutex);
+                m_StopRequested = true;
+            }
+            m_StopSignal.notify_all();
+            m_Thread.join();
+        }
+
+        // Stopped in the middle of a call: close it so a restarted watchdog does not see it as running.
+        if (m_Shared.Sequence.load(std::memory_order_relaxed) & 1)
+        {
+            m_Shared.Sequence.fetch_add(1, std::memory_order_release);
+        }
+
+        m_Enabled = false;
+        m_Depth = 0;
+    }
+
+    bool ScriptWatchdog::EndCall()
+    {
+        if (!m_Enabled || m_Depth == 0 || --m_Depth > 0)
+        {
+            return false;
+        }
+
+        auto elapsed = Clock::now() - Clock::time_point(Clock::duration(m_StartTicks.load(std::memory_order_relaxed)));
+        int methodId = m_MethodId.load(std::memory_order_relaxed);
+        uint32_t sequence = m_Shared.Sequence.fetch_add(1, std::memory_order_release);
+
+        m_FrameTime += elapsed;
+        m_FrameCalls++;
+        if (elapsed > m_SlowestCall)
+        {
+            m_SlowestCall = elapsed;
+            m_SlowestMethodId = methodId;
+        }
+
+        if (m_Settings.CallBudget.count() <= 0 || elapsed <= m_Settings.CallBudget)
+        {
+            return false;
+        }
+
+        Report(sequence, methodId, elapsed, false);
+        return true;
+    }
+
+    void ScriptWatchdog::EndFrame()
+    {
+        if (!m_Enabled)
+        {
+            return;
+        }
+
+        if (m_Settings.FrameBudget.count() > 0 && m_FrameTime > m_Settings.FrameBudget && m_Settings.OnFrameOverBudget)
+        {
+            ScriptFrameReport report;
+            report.ScriptTime = std::chrono::duration_cast<std::chrono::microseconds>(m_FrameTime);
+            report.Budget = m_Settings.FrameBudget;
+            report.Calls = m_FrameCalls;
+            report.SlowestMethodId = m_SlowestMethodId;
+            report.SlowestCall = std::chrono::duration_cast<std::chrono::microseconds>(m_SlowestCall);
+            m_Settings.OnFrameOverBudget(report);
+        }
+
+        m_FrameTime = Clock::duration::zero();
+        m_FrameCalls = 0;
+        m_SlowestMethodId = 0;
+        m_SlowestCall = Clock::duration::zero();
+    }
+
+    void ScriptWatchdog::Run()
+    {
+        while (true)
+        {
+            {
+                std::unique_lock lock(m_Mutex);
+                if (m_StopSignal.wait_for(lock, m_Settings.PollInterval, [this] { return m_StopRequested; }))
+                {
+                    return;
+                }
+            }
+
+            uint32_t sequence = m_Shared.Sequence.load(std::memory_order_acquire);
+            if ((sequence & 1) == 0)
+            {
+                continue;
+            }
+
+            int methodId = m_MethodId.load(std::memory_order_relaxed);
+            auto start = Clock::time_point(Clock::duration(m_StartTicks.load(std::memory_order_relaxed)));
+            if (m_Shared.Sequence.load(std::memory_order_acquire) != sequence)
+            {
+                // The call ended (and maybe another began) while reading; look again next poll.
+                continue;
+            }
+
+            auto elapsed = Clock::now() - start;
+            if (m_Settings.CallBudget.count() > 0 && elapsed > m_Settings.CallBudget)
+            {
+                Report(sequence, methodId, elapsed, true);
+            }
+
+            if (m_Settings.AbortAfter.count() > 0 && elapsed > m_Settings.AbortAfter)
+            {
+                m_Shared.AbortSequence.store(sequence, std::memory_order_release);
+            }
+        }
+    }
+
+    void ScriptWatchdog::Report(uint32_t sequence, int methodId, Clock::duration elapsed, bool stillRunning)
+    {
+        // Whichever thread claims the call first reports it.
+        uint32_t reported = m_ReportedSequence.load(std::memory_order_relaxed);
+        if (reported == sequence || !m_ReportedSequence.compare_exchange_strong(reported, sequence))
+        {
+            return;
+        }
+
+        if (m_Settings.OnCallOverBudget)
+        {
+            ScriptCallReport report;
+            report.MethodId = methodId;
+            report.Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+            report.Budget = m_Settings.CallBudget;
+            report.StillRunning = stillRunning;
+            m_Settings.OnCallOverBudget(report);
+        }
+    }
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_WATCHDOG_H
+#define SCRIPT_WATCHDOG_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Time budgets for script calls.
+//
+//   ScriptWatchdogSettings settings;
+//   settings.CallBudget = std::chrono::milliseconds(2);
+//   settings.FrameBudget = std::chrono::milliseconds(4);
+//   settings.OnCallOverBudget = [](const ScriptCallReport &r) { ... };   // watchdog or game thread
+//   settings.OnFrameOverBudget = [](const ScriptFrameReport &r) { ... }; // game thread, in EndFrame
+//   host.StartWatchdog(settings);
+//
+// The game thread publishes the running method in a shared slot (a sequence number, the method id and
+// the start time) around every outermost Invoke. A monitoring thread polls that slot, so a call stuck
+// in an infinite loop is still reported, by method id, while the game thread is hung. Calls that
+// finish over budget between two polls are reported by the game thread when they return. Each call is
+// reported at most once. Callbacks must not start or stop the watchdog.
+//
+// Script code cannot be interrupted from outside. With AbortAfter set, the watchdog raises a flag that
+// long-running scripts observe through ScriptWatchdog.ThrowIfAbortRequested() (managed); with
+// DisableOverBudgetMethods, the host disables a binding once a call of it has exceeded CallBudget.
+
+namespace MochiSharp
+{
+    struct ScriptCallReport
+    {
+        int MethodId = 0;
+        std::chrono::microseconds Elapsed{ 0 };
+        std::chrono::microseconds Budget{ 0 };
+        bool StillRunning = false; // reported by the watchdog thread while the call has not returned
+    };
+
+    struct ScriptFrameReport
+    {
+        std::chrono::microseconds ScriptTime{ 0 };
+        std::chrono::microseconds Budget{ 0 };
+        uint32_t Calls = 0;
+        int SlowestMethodId = 0;
+        std::chrono::microseconds SlowestCall{ 0 };
+    };
+
+    struct ScriptWatchdogSettings
+    {
+        std::chrono::microseconds CallBudget{ 0 };   // 0 = no per-call budget
+        std::chrono::microseconds FrameBudget{ 0 };  // 0 = no per-frame budget
+        std::chrono::milliseconds AbortAfter{ 0 };   // request a cooperative abort after this long; 0 = never
+        std::chrono::milliseconds PollInterval{ 2 };
+        bool DisableOverBudgetMethods = false;
+        std::function<void(const ScriptCallReport &)> OnCallOverBudget;
+        std::function<void(const ScriptFrameReport &)> OnFrameOverBudget;
+    };
+
+    class ScriptWatchdog
+    {
+    public:
+        // Memory shared with managed code (ScriptWatchdog.cs): a call is asked to abort while
+        // AbortSequence equals the Sequence of the running call.
+        struct SharedState
+        {
+            std::atomic<uint32_t> Sequence{ 0 }; // odd while a call is running
+            std::atomic<uint32_t> AbortSequence{ 0 };
+        };
+
+        ScriptWatchdog() = default;
+        ~ScriptWatchdog();
+
+        ScriptWatchdog(const ScriptWatchdog &) = delete;
+        ScriptWatchdog &operator=(const ScriptWatchdog &) = delete;
+
+        // Restarts the watchdog with new settings; a running watchdog is stopped first.
+        bool Start(ScriptWatchdogSettings settings);
+        void Stop();
+        bool IsEnabled() const { return m_Enabled; }
+        const ScriptWatchdogSettings &GetSettings() const { return m_Settings; }
+        SharedState *GetSharedState() { return &m_Shared; }
+
+        // Game thread, around each call. Nested calls (scripts calling back into scripts) are
+        // accounted to the outermost one.
+        void BeginCall(int methodId)
+        {
+            if (!m_Enabled || m_Depth++ > 0)
+            {
+                return;
+            }
+
+            m_MethodId.store(methodId, std::memory_order_relaxed);
+            m_StartTicks.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+            m_Shared.Sequence.fetch_add(1, std::memory_order_release);
+        }
+
+        // Returns true when the call that just ended exceeded CallBudget.
+        bool EndCall();
+
+        // Game thread, once per frame: checks the frame's script time and starts the next frame.
+        void EndFrame();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void Run();
+        void Report(uint32_t sequence, int methodId, Clock::duration elapsed, bool stillRunning);
+
+        ScriptWatchdogSettings m_Settings;
+        bool m_Enabled = false;
+
+        SharedState m_Shared;
+        std::atomic<int> m_MethodId{ 0 };
+        std::atomic<Clock::rep> m_StartTicks{ 0 };
+        std::atomic<uint32_t> m_ReportedSequence{ 0 };
+
+        // Game thread only.
+        int m_Depth = 0;
+        Clock::duration m_FrameTime{ 0 };
+        uint32_t m_FrameCalls = 0;
+        int m_SlowestMethodId = 0;
+        Clock::duration m_SlowestCall{ 0 };
+
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::condition_variable m_StopSignal;
+        bool m_StopRequested = false;
+    };
+}
+
+#endif // !SCRIPT_WATCHDOG_H
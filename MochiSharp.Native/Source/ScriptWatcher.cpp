@@ -0,0 +1,420 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptWatcher.h"
+
+#include <algorithm>
+#include <fstream>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace MochiSharp
+{
+    namespace
+    {
+        constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+        constexpr uint64_t FnvPrime = 1099511628211ull;
+
+#ifndef _WIN32
+        constexpr uint32_t WatchMask = IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+#endif
+
+        uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+        {
+            const uint8_t *bytes = static_cast<const uint8_t *>(data);
+            for (size_t i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= FnvPrime;
+            }
+            return hash;
+        }
+    }
+
+    ScriptWatcher::~ScriptWatcher()
+    {
+        Stop();
+    }
+
+    bool ScriptWatcher::Start(std::chrono::milliseconds debounce)
+    {
+        if (IsRunning())
+        {
+            return true;
+        }
+
+        m_Debounce = debounce;
+        m_StopRequested.store(false);
+
+#ifdef _WIN32
+        m_WakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        if (!m_WakeEvent)
+        {
+            return false;
+        }
+
+        std::lock_guard lock(m_Mutex);
+        m_DirectoriesChanged = true;
+#else
+        m_NotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        m_WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_NotifyFd < 0 || m_WakeFd < 0)
+        {
+            if (m_NotifyFd >= 0)
+                close(m_NotifyFd);
+            if (m_WakeFd >= 0)
+                close(m_WakeFd);
+            m_NotifyFd = m_WakeFd = -1;
+            return false;
+        }
+
+        std::lock_guard lock(m_Mutex);
+        for (const auto &directory : m_Directories)
+        {
+            inotify_add_watch(m_NotifyFd, directory.c_str(), WatchMask);
+        }
+#endif
+
+        m_Thread = std::thread(&ScriptWatcher::Run, this);
+        return true;
+    }
+
+    void ScriptWatcher::Stop()
+    {
+        if (!IsRunning())
+        {
+            return;
+        }
+
+        m_StopRequested.store(true);
+        Wake();
+        m_Thread.join();
+
+#ifdef _WIN32
+        CloseHandle(m_WakeEvent);
+        m_WakeEvent = nullptr;
+#else
+        close(m_NotifyFd);
+        close(m_WakeFd);
+        m_NotifyFd = m_WakeFd = -1;
+#endif
+    }
+
+    bool ScriptWatcher::Watch(int moduleHandle, std::vector<std::filesystem::path> files)
+    {
+        if (files.empty())
+        {
+            return false;
+        }
+
+        uint64_t hash = HashFiles(files);
+
+        std::lock_guard lock(m_Mutex);
+        auto it = std::find_if(m_Modules.begin(), m_Modules.end(), [&](const WatchedModule &m) { return m.Handle == moduleHandle; });
+        if (it == m_Modules.end())
+        {
+            it = m_Modules.emplace(m_Modules.end());
+            it->Handle = moduleHandle;
+        }
+
+        it->Files = std::move(files);
+        it->Hash = hash;
+        it->Pending = false;
+
+        for (const auto &file : it->Files)
+        {
+            AddDirectory(file.parent_path());
+        }
+
+        return true;
+    }
+
+    void ScriptWatcher::Unwatch(int moduleHandle)
+    {
+        std::lock_guard lock(m_Mutex);
+        std::erase_if(m_Modules, [&](const WatchedModule &m) { return m.Handle == moduleHandle; });
+    }
+
+    std::vector<int> ScriptWatcher::TakePendingReloads()
+    {
+        std::vector<int> modules;
+
+        std::lock_guard lock(m_Mutex);
+        m_ReloadPending.store(false, std::memory_order_release);
+        for (auto &module : m_Modules)
+        {
+            if (module.Pending)
+            {
+                modules.push_back(module.Handle);
+                module.Pending = false;
+            }
+        }
+
+        return modules;
+    }
+
+    uint64_t ScriptWatcher::HashFiles(const std::vector<std::filesystem::path> &files)
+    {
+        static constexpr uint8_t MissingMarker = 0xFF;
+
+        uint64_t hash = FnvOffsetBasis;
+        std::vector<char> buffer(64 * 1024);
+        for (const auto &file : files)
+        {
+            auto name = file.filename().u8string();
+            hash = HashBytes(hash, name.data(), name.size());
+
+            std::error_code error;
+            if (!std::filesystem::exists(file, error))
+            {
+                // A deleted dependency is a change too, not a reason to retry.
+                hash = HashBytes(hash, &MissingMarker, 1);
+                continue;
+            }
+
+            std::ifstream stream(file, std::ios::binary);
+            if (!stream)
+            {
+                return 0;
+            }
+
+            while (stream)
+            {
+                stream.read(buffer.data(), (std::streamsize)buffer.size());
+                hash = HashBytes(hash, buffer.data(), (size_t)stream.gcount());
+            }
+
+            if (stream.bad())
+            {
+                return 0;
+            }
+        }
+
+        return hash != 0 ? hash : 1;
+    }
+
+    void ScriptWatcher::Run()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        bool dirty = false;
+        Clock::time_point lastChange{};
+        while (!m_StopRequested.load(std::memory_order_acquire))
+        {
+            int timeout = -1;
+            if (dirty)
+            {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(lastChange + m_Debounce - Clock::now());
+                timeout = (int)std::max<int64_t>(remaining.count(), 0);
+            }
+
+            switch (WaitForChange(timeout))
+            {
+            case WaitResult::Changed:
+                // Every write restarts the quiet period, so a build is hashed once it is finished.
+                dirty = true;
+                lastChange = Clock::now();
+                break;
+            case WaitResult::Woken:
+                break;
+            case WaitResult::Timeout:
+                if (dirty && Clock::now() - lastChange >= m_Debounce)
+                {
+                    if (CheckForChanges())
+                    {
+                        dirty = false;
+                    }
+                    else
+                    {
+                        lastChange = Clock::now();
+                    }
+                }
+                break;
+            }
+        }
+
+#ifdef _WIN32
+        for (size_t i = 1; i < m_WaitHandles.size(); i++)
+        {
+            FindCloseChangeNotification(m_WaitHandles[i]);
+        }
+        m_WaitHandles.clear();
+#endif
+    }
+
+    ScriptWatcher::WaitResult ScriptWatcher::WaitForChange(int timeoutMilliseconds)
+    {
+#ifdef _WIN32
+        {
+            std::lock_guard lock(m_Mutex);
+            if (m_DirectoriesChanged)
+            {
+                for (size_t i = 1; i < m_WaitHandles.size(); i++)
+                {
+                    FindCloseChangeNotification(m_WaitHandles[i]);
+                }
+
+                m_WaitHandles.assign(1, m_WakeEvent);
+                for (const auto &directory : m_Directories)
+                {
+                    if (m_WaitHandles.size() == MAXIMUM_WAIT_OBJECTS)
+                    {
+                        break;
+                    }
+
+                    HANDLE change = FindFirstChangeNotificationW(directory.c_str(), FALSE,
+                        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+                    if (change != INVALID_HANDLE_VALUE)
+                    {
+                        m_WaitHandles.push_back(change);
+                    }
+                }
+
+                m_DirectoriesChanged = false;
+            }
+        }
+
+        DWORD rc = WaitForMultipleObjects((DWORD)m_WaitHandles.size(), m_WaitHandles.data(), FALSE,
+            timeoutMilliseconds < 0 ? INFINITE : (DWORD)timeoutMilliseconds);
+        if (rc == WAIT_FAILED)
+        {
+            Sleep(100);
+            return WaitResult::Timeout;
+        }
+
+        if (rc < WAIT_OBJECT_0 || rc >= WAIT_OBJECT_0 + m_WaitHandles.size())
+        {
+            return WaitResult::Timeout;
+        }
+
+        DWORD index = rc - WAIT_OBJECT_0;
+        if (index == 0)
+        {
+            return WaitResult::Woken;
+        }
+
+        FindNextChangeNotification(m_WaitHandles[index]);
+        return WaitResult::Changed;
+#else
+        pollfd fds[2] = { { m_NotifyFd, POLLIN, 0 }, { m_WakeFd, POLLIN, 0 } };
+        int rc = poll(fds, 2, timeoutMilliseconds);
+        if (rc <= 0)
+        {
+            return WaitResult::Timeout;
+        }
+
+        if (fds[1].revents & POLLIN)
+        {
+            uint64_t value = 0;
+            (void)read(m_WakeFd, &value, sizeof(value));
+            return WaitResult::Woken;
+        }
+
+        // Only "something changed" matters; the hashes decide what.
+        alignas(inotify_event) char events[4096];
+        bool changed = false;
+        while (read(m_NotifyFd, events, sizeof(events)) > 0)
+        {
+            changed = true;
+        }
+
+        return changed ? WaitResult::Changed : WaitResult::Timeout;
+#endif
+    }
+
+    bool ScriptWatcher::CheckForChanges()
+    {
+        struct Snapshot
+        {
+            int Handle;
+            std::vector<std::filesystem::path> Files;
+        };
+
+        // Hash without holding the lock so Watch/TakePendingReloads on the game thread never wait on I/O.
+        std::vector<Snapshot> snapshot;
+        {
+            std::lock_guard lock(m_Mutex);
+            for (const auto &module : m_Modules)
+            {
+                if (!module.Pending)
+                {
+                    snapshot.push_back({ module.Handle, module.Files });
+                }
+            }
+        }
+
+        bool complete = true;
+        bool changed = false;
+        for (const auto &entry : snapshot)
+        {
+            uint64_t hash = HashFiles(entry.Files);
+            if (hash == 0)
+            {
+                complete = false;
+                continue;
+            }
+
+            std::lock_guard lock(m_Mutex);
+            auto it = std::find_if(m_Modules.begin(), m_Modules.end(), [&](const WatchedModule &m) { return m.Handle == entry.Handle; });
+            if (it != m_Modules.end() && it->Files == entry.Files && it->Hash != hash)
+            {
+                it->Hash = hash;
+                it->Pending = true;
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            m_ReloadPending.store(true, std::memory_order_release);
+        }
+
+        return complete;
+    }
+
+    void ScriptWatcher::AddDirectory(const std::filesystem::path &directory)
+    {
+        auto normalized = directory.lexically_normal();
+        if (std::find(m_Directories.begin(), m_Directories.end(), normalized) != m_Directories.end())
+        {
+            return;
+        }
+
+        m_Directories.push_back(normalized);
+
+#ifdef _WIN32
+        m_DirectoriesChanged = true;
+        if (IsRunning())
+        {
+            Wake();
+        }
+#else
+        if (m_NotifyFd >= 0)
+        {
+            inotify_add_watch(m_NotifyFd, normalized.c_str(), WatchMask);
+        }
+#endif
+    }
+
+    void ScriptWatcher::Wake()
+    {
+#ifdef _WIN32
+        if (m_WakeEvent)
+        {
+            SetEvent(m_WakeEvent);
+        }
+#else
+        if (m_WakeFd >= 0)
+        {
+            uint64_t value = 1;
+            (void)write(m_WakeFd, &value, sizeof(value));
+        }
+#endif
+    }
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef SCRIPT_WATCHER_H
+#define SCRIPT_WATCHER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Hot reload trigger for script modules.
+//
+//   host.WatchModule(module);                            // once after LoadModule
+//   ...
+//   if (host.IsReloadPending())                          // one atomic load per frame
+//       for (int reloaded : host.ApplyPendingReloads())
+//           RecreateScripts(reloaded);
+//
+// A background thread waits on the directories of the watched files (inotify on Linux, change
+// notifications on Windows), lets a burst of compiler writes settle for the debounce interval and
+// then hashes the files. A module is only reported when the content of its assembly or one of its
+// dependencies actually changed; a rebuild that produces identical bytes is ignored.
+
+namespace MochiSharp
+{
+    class ScriptWatcher
+    {
+    public:
+        ScriptWatcher() = default;
+        ~ScriptWatcher();
+
+        ScriptWatcher(const ScriptWatcher &) = delete;
+        ScriptWatcher &operator=(const ScriptWatcher &) = delete;
+
+        bool Start(std::chrono::milliseconds debounce = std::chrono::milliseconds(250));
+        void Stop();
+        bool IsRunning() const { return m_Thread.joinable(); }
+
+        // Replaces the files watched for moduleHandle and records their current content hash.
+        bool Watch(int moduleHandle, std::vector<std::filesystem::path> files);
+        void Unwatch(int moduleHandle);
+
+        bool IsReloadPending() const { return m_ReloadPending.load(std::memory_order_acquire); }
+        // Returns the modules whose content changed since they were (re)watched and clears the flag.
+        std::vector<int> TakePendingReloads();
+
+        // FNV-1a over file names and contents. Returns 0 if a file cannot be read, e.g. while the
+        // compiler is still writing it.
+        static uint64_t HashFiles(const std::vector<std::filesystem::path> &files);
+
+    private:
+        struct WatchedModule
+        {
+            int Handle = 0;
+            std::vector<std::filesystem::path> Files;
+            uint64_t Hash = 0;
+            bool Pending = false;
+        };
+
+        enum class WaitResult
+        {
+            Timeout,
+            Changed,
+            Woken
+        };
+
+        void Run();
+        WaitResult WaitForChange(int timeoutMilliseconds);
+        // Returns false when some file could not be hashed yet and the check should be retried.
+        bool CheckForChanges();
+        // Called with m_Mutex held.
+        void AddDirectory(const std::filesystem::path &directory);
+        void Wake();
+
+        std::thread m_Thread;
+        std::atomic<bool> m_StopRequested = false;
+        std::atomic<bool> m_ReloadPending = false;
+        std::chrono::milliseconds m_Debounce{ 250 };
+
+        std::mutex m_Mutex;
+        std::vector<WatchedModule> m_Modules;
+        std::vector<std::filesystem::path> m_Directories;
+
+#ifdef _WIN32
+        void *m_WakeEvent = nullptr;
+        bool m_DirectoriesChanged = false;
+        std::vector<void *> m_WaitHandles; // wake event, then one change notification per directory; owned by the thread
+#else
+        int m_NotifyFd = -1;
+        int m_WakeFd = -1;
+#endif
+    };
+}
+
+#endif // !SCRIPT_WATCHER_H
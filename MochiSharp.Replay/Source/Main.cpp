@@ -0,0 +1,334 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+// Replays a recording made with DotNetHost::StartRecording against the same script assemblies, as fast
+// as possible, and reports Invoke throughput and latency percentiles. Setup (loads, signatures,
+// instances, bindings) is re-issued too but only Invoke, scheduler ticks and frames are timed.
+//
+//   MochiSharp.Replay <recording> [--module-dir <dir>] [--runtime-config <file>] [--warmup-frames <n>] [--profile <name>]
+//
+// --profile starts the runtime with a HostSettings preset (default, low-latency-client,
+// throughput-server); replaying one recording under each compares their GC and JIT trade-offs.
+
+#include "Host.h"
+#include "LatencyStats.h"
+#include "ScriptRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <print>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::filesystem::path Recording;
+        std::filesystem::path ModuleDirectory;
+        std::filesystem::path RuntimeConfig = "MochiSharp.Managed.runtimeconfig.json";
+        uint32_t WarmupFrames = 0;
+        std::string Profile = "default";
+    };
+
+    struct BoundMethod
+    {
+        int MethodId = 0;
+        int Signature = 0;
+    };
+
+    struct ReplayStats
+    {
+        std::vector<int64_t> CallNanoseconds;
+        std::vector<int64_t> FrameNanoseconds;
+        uint64_t FailedCalls = 0;
+        uint64_t UnboundCalls = 0;
+        uint64_t MalformedCalls = 0;
+        uint64_t FailedSetup = 0;
+        Clock::duration InvokeTime{ 0 };
+        Clock::duration SchedulerTime{ 0 };
+    };
+
+    template<typename CharT>
+    bool ParseOptions(int argc, CharT *argv[], Options &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::filesystem::path arg(argv[i]);
+            bool hasValue = i + 1 < argc;
+            if (arg == "--module-dir" && hasValue)
+            {
+                options.ModuleDirectory = argv[++i];
+            }
+            else if (arg == "--runtime-config" && hasValue)
+            {
+                options.RuntimeConfig = argv[++i];
+            }
+            else if (arg == "--warmup-frames" && hasValue)
+            {
+                try
+                {
+                    options.WarmupFrames = (uint32_t)std::stoul(std::filesystem::path(argv[++i]).string());
+                }
+                catch (const std::exception &)
+                {
+                    // std::invalid_argument or std::out_of_range: show the usage instead.
+                    return false;
+                }
+            }
+            else if (arg == "--profile" && hasValue)
+            {
+                options.Profile = std::filesystem::path(argv[++i]).string();
+            }
+            else if (options.Recording.empty())
+            {
+                options.Recording = arg;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return !options.Recording.empty();
+    }
+
+    std::string ResolveModulePath(const Options &options, const std::string &recordedPath)
+    {
+        if (options.ModuleDirectory.empty())
+        {
+            return recordedPath;
+        }
+
+        return (options.ModuleDirectory / std::filesystem::path(recordedPath).filename()).string();
+    }
+
+    std::vector<const char *> ToCStrings(const std::vector<std::string> &names)
+    {
+        std::vector<const char *> result;
+        result.reserve(names.size());
+        for (const auto &name : names)
+        {
+            result.push_back(name.c_str());
+        }
+        return result;
+    }
+
+    bool Replay(MochiSharp::DotNetHost &host, const Options &options, const std::vector<MochiSharp::ScriptRecord> &records, ReplayStats &stats)
+    {
+        using MochiSharp::RecordType;
+
+        // Recorded ids can differ from the ones this process gets back.
+        std::unordered_map<int, BoundMethod> methods;
+        std::unordered_map<int, std::vector<int>> layouts;
+        std::vector<const void *> args;
+        std::vector<uint64_t> returnBuffer;
+
+        uint32_t frame = 0;
+        Clock::duration frameTime{ 0 };
+        for (const auto &record : records)
+        {
+            bool measured = frame >= options.WarmupFrames;
+            switch (record.Type)
+            {
+            case RecordType::LoadModule:
+            {
+                auto path = ResolveModulePath(options, record.Name);
+                if (host.LoadModule(path.c_str()) == 0)
+                {
+                    std::println("[Replay] Failed to load module {}", path);
+                    return false;
+                }
+                break;
+            }
+            case RecordType::LoadModuleFromMemory:
+            {
+                auto name = ResolveModulePath(options, record.Name);
+                const void *symbols = record.Symbols.empty() ? nullptr : record.Symbols.data();
+                if (host.LoadModuleFromMemory(name.c_str(), record.Bytes.data(), record.Bytes.size(), symbols, record.Symbols.size()) == 0)
+                {
+                    std::println("[Replay] Failed to load module {} from the recorded image", name);
+                    return false;
+                }
+                break;
+            }
+            case RecordType::LoadSharedAssembly:
+            {
+                auto path = ResolveModulePath(options, record.Name);
+                stats.FailedSetup += host.LoadSharedAssembly(path.c_str()) ? 0 : 1;
+                break;
+            }
+            case RecordType::ConfigureSerialization:
+                stats.FailedSetup += host.ConfigureSerialization(record.Name.c_str(), record.TypeName.c_str()) ? 0 : 1;
+                break;
+            case RecordType::RegisterSignature:
+            {
+                auto names = ToCStrings(record.Names);
+                bool registered = record.Sizes.empty()
+                    ? host.RegisterSignature(record.Id, record.TypeName.c_str(), names.data(), (int)names.size())
+                    : host.RegisterSignature(record.Id, record.TypeName.c_str(), names.data(), (int)names.size(), record.Sizes.data(), record.Alignments.data());
+                stats.FailedSetup += registered ? 0 : 1;
+                layouts[record.Id] = host.GetSignatureLayout(record.Id);
+                break;
+            }
+            case RecordType::CreateInstance:
+                stats.FailedSetup += host.CreateInstance(record.TypeName.c_str(), record.InstanceId) ? 0 : 1;
+                break;
+            case RecordType::CreateInstances:
+                host.CreateInstances(record.TypeName.c_str(), record.InstanceIds.data(), (int)record.InstanceIds.size());
+                break;
+            case RecordType::DestroyInstance:
+                host.DestroyInstance(record.InstanceId);
+                break;
+            case RecordType::DestroyInstances:
+                for (uint64_t instanceId : record.InstanceIds)
+                {
+                    host.QueueDestroyInstance(instanceId);
+                }
+                host.FlushDestroyQueue(record.Value);
+                break;
+            case RecordType::ConfigureInstancePool:
+                stats.FailedSetup += host.ConfigureInstancePool(record.TypeName.c_str(), record.Id) ? 0 : 1;
+                break;
+            case RecordType::BindInstanceMethod:
+            case RecordType::BindStaticMethod:
+            {
+                int methodId = record.Type == RecordType::BindInstanceMethod
+                    ? host.BindInstanceMethod(record.InstanceId, record.Name.c_str(), record.Signature)
+                    : host.BindStaticMethod(record.TypeName.c_str(), record.Name.c_str(), record.Signature);
+                stats.FailedSetup += methodId != 0 ? 0 : 1;
+                methods[record.Id] = { methodId, record.Signature };
+                break;
+            }
+            case RecordType::Invoke:
+            {
+                auto method = methods.find(record.Id);
+                auto layout = method != methods.end() ? layouts.find(method->second.Signature) : layouts.end();
+                if (method == methods.end() || method->second.MethodId == 0 || layout == layouts.end() || layout->second.size() != record.ArgCount + 1)
+                {
+                    stats.UnboundCalls++;
+                    break;
+                }
+
+                // The signature may have changed since recording; never point past the recorded bytes.
+                const auto &sizes = layout->second;
+                size_t argumentBytes = 0;
+                for (uint32_t i = 0; i < record.ArgCount; i++)
+                {
+                    argumentBytes += (size_t)sizes[i + 1];
+                }
+                if (argumentBytes > record.Bytes.size())
+                {
+                    if (stats.MalformedCalls++ == 0)
+                    {
+                        std::println("[Replay] call to method {} needs {} argument bytes, the recording holds {}; signature {} changed since recording?",
+                            record.Id, argumentBytes, record.Bytes.size(), method->second.Signature);
+                    }
+                    break;
+                }
+
+                args.resize(record.ArgCount);
+                size_t offset = 0;
+                for (uint32_t i = 0; i < record.ArgCount; i++)
+                {
+                    args[i] = record.Bytes.data() + offset;
+                    offset += (size_t)sizes[i + 1];
+                }
+                returnBuffer.resize(std::max<size_t>(1, ((size_t)sizes[0] + sizeof(uint64_t) - 1) / sizeof(uint64_t)));
+
+                auto start = Clock::now();
+                auto status = host.TryInvoke(method->second.MethodId, args.data(), (int)record.ArgCount, sizes[0] > 0 ? returnBuffer.data() : nullptr);
+                auto elapsed = Clock::now() - start;
+
+                stats.FailedCalls += status == MochiSharp::InvokeStatus::Ok ? 0 : 1;
+                frameTime += elapsed;
+                if (measured)
+                {
+                    stats.InvokeTime += elapsed;
+                    stats.CallNanoseconds.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                }
+                break;
+            }
+            case RecordType::SetFieldValue:
+                host.SetInstanceFieldValue(record.InstanceId, record.Name.c_str(), record.Bytes.data(), (int)record.Bytes.size());
+                break;
+            case RecordType::TickScheduler:
+            {
+                auto start = Clock::now();
+                host.TickScheduler(record.Value);
+                auto elapsed = Clock::now() - start;
+                frameTime += elapsed;
+                if (measured)
+                {
+                    stats.SchedulerTime += elapsed;
+                }
+                break;
+            }
+            case RecordType::EndFrame:
+                host.EndFrame();
+                if (measured)
+                {
+                    stats.FrameNanoseconds.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(frameTime).count());
+                }
+                frameTime = Clock::duration::zero();
+                frame++;
+                break;
+            }
+        }
+
+        return true;
+    }
+}
+
+#ifdef _WIN32
+int __cdecl wmain(int argc, wchar_t *argv[])
+#else
+int main(int argc, char *argv[])
+#endif
+{
+    Options options;
+    MochiSharp::HostSettings settings;
+    if (!ParseOptions(argc, argv, options) || !MochiSharp::HostSettings::FromPreset(options.Profile, settings))
+    {
+        std::println("usage: MochiSharp.Replay <recording> [--module-dir <dir>] [--runtime-config <file>] [--warmup-frames <n>]");
+        std::println("                         [--profile default|low-latency-client|throughput-server]");
+        return 2;
+    }
+
+    std::vector<MochiSharp::ScriptRecord> records;
+    if (!MochiSharp::ScriptRecorder::Load(options.Recording, records))
+    {
+        std::println("[Replay] {} is not a complete recording ({} records read)", options.Recording.string(), records.size());
+        if (records.empty())
+        {
+            return 1;
+        }
+    }
+
+    MochiSharp::DotNetHost host;
+    if (!host.Init(options.RuntimeConfig, settings))
+    {
+        return 1;
+    }
+
+    ReplayStats stats;
+    auto start = Clock::now();
+    bool completed = Replay(host, options, records, stats);
+    auto wallTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double invokeSeconds = std::chrono::duration<double>(stats.InvokeTime).count();
+    std::println("[Replay] profile {}: {} records, {} frames measured, wall {:.3f}s", options.Profile, records.size(), stats.FrameNanoseconds.size(), wallTime);
+    std::println("[Replay] {} calls in {:.3f}s: {:.0f} calls/s; scheduler {:.3f}s", stats.CallNanoseconds.size(), invokeSeconds,
+        invokeSeconds > 0.0 ? stats.CallNanoseconds.size() / invokeSeconds : 0.0, std::chrono::duration<double>(stats.SchedulerTime).count());
+    MochiSharp::PrintLatencyDistribution("call", stats.CallNanoseconds);
+    MochiSharp::PrintLatencyDistribution("frame", stats.FrameNanoseconds);
+    if (stats.FailedCalls || stats.UnboundCalls || stats.MalformedCalls || stats.FailedSetup)
+    {
+        std::println("[Replay] {} failed calls, {} calls to methods that did not bind, {} calls skipped for a changed signature, {} failed setup calls",
+            stats.FailedCalls, stats.UnboundCalls, stats.MalformedCalls, stats.FailedSetup);
+    }
+
+    return completed ? 0 : 1;
+}
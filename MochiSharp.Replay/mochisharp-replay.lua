@@ -0,0 +1,61 @@
+project "MochiSharp.Replay"
+    location "%{wks.location}/MochiSharp.Replay"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "c++23"
+    architecture "x64"
+
+    targetdir (OUTPUT_DIR)
+    objdir (INTOUTPUT_DIR)
+
+    files {
+        "Source/**.cpp",
+        "Source/**.h"
+    }
+
+    includedirs {
+        "%{wks.location}/MochiSharp.Native/Source",
+        "%{IncludeDirs.Hostfxr}"
+    }
+
+    libdirs {
+        "%{IncludeDirs.Hostfxr}"
+    }
+
+    links {
+        "MochiSharp.Native"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+        buildoptions { "/utf-8" }
+        links {
+            "%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/nethost.lib"
+        }
+        postbuildcommands {
+            "{COPY} \"%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/nethost.dll\" \"%{cfg.targetdir}\"",
+            "{COPY} \"%{THIRDPARTY_DIR}/dotnet/host/fxr/9.0.11/x64/hostfxr.dll\" \"%{cfg.targetdir}\""
+        }
+        defines {
+            "_WINDOWS",
+            "WIN32",
+            "WIN32_LEAN_AND_MEAN",
+            "_CRT_SECURE_NO_WARNINGS",
+            "_CONSOLE"
+        }
+
+    filter "system:linux"
+        libdirs { NETHOST_LINUX_DIR }
+        links { "nethost", "dl", "pthread" }
+
+    filter "configurations:Debug"
+        runtime "Debug"
+        optimize "off"
+        symbols "on"
+        defines { "_DEBUG" }
+
+    filter "configurations:Release"
+        runtime "Release"
+        optimize "speed"
+        symbols "off"
+        defines { "NDEBUG" }
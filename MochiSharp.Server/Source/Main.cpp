@@ -0,0 +1,402 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+// Headless dedicated-server runner: loads script modules and drives them at a fixed tick rate with no
+// window and no console output while ticking, then reports the tick-time distribution so a server
+// instance can be sized. Each tick dispatches events, pumps the scheduler, calls the update method
+// (void(float), "Update" unless --update-method says otherwise) of every instance and every static
+// system method with the fixed tick length, and ends the frame.
+//
+//   MochiSharp.Server <module>... [--instances <type> <count>] [--update-method <name>] [--system <type> <method>]
+//                     [--tick-rate <hz>] [--ticks <n> | --duration <seconds>] [--spin <microseconds>]
+//                     [--runtime-config <file>] [--profile <name>] [--replicate] [--verbose]
+//
+// --profile selects a HostSettings preset (default, low-latency-client, throughput-server) on top of the
+// runtimeconfig, so GC and JIT settings can be compared on the same workload.
+//
+// --replicate captures a snapshot of the [Replicated] script fields after every tick and encodes it
+// against the previous tick's (a client that acks every tick), and reports the cost and the bandwidth.
+//
+// Ticks are paced by sleeping until shortly before the deadline and spinning the rest of the way, which
+// keeps wake-up lateness in the microseconds without burning a core between ticks. A tick that overruns
+// is followed immediately by the next one; more than MaxBacklogTicks behind, the backlog is dropped.
+// Ctrl+C / SIGTERM stops the run and still prints the report.
+
+#include "Host.h"
+#include "LatencyStats.h"
+#include "ScriptMethod.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <memory>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #include <timeapi.h>
+#endif
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int64_t MaxBacklogTicks = 5;
+
+    struct InstanceGroup
+    {
+        std::string TypeName;
+        uint32_t Count = 0;
+    };
+
+    struct SystemMethod
+    {
+        std::string TypeName;
+        std::string MethodName;
+    };
+
+    struct Options
+    {
+        std::vector<std::string> Modules;
+        std::vector<InstanceGroup> Instances;
+        std::vector<SystemMethod> Systems;
+        std::string UpdateMethod = "Update";
+        std::filesystem::path RuntimeConfig = "MochiSharp.Managed.runtimeconfig.json";
+        std::string Profile = "default";
+        double TickRate = 30.0;
+        uint64_t MaxTicks = 0;           // 0 = until stopped
+        double DurationSeconds = 0.0;
+        std::chrono::microseconds SpinWindow{ 1000 };
+        bool Replicate = false;
+        bool Verbose = false;
+    };
+
+    struct TickStats
+    {
+        std::vector<int64_t> WorkNanoseconds;
+        std::vector<int64_t> LatenessNanoseconds;
+        uint64_t Overruns = 0;
+        uint64_t SkippedTicks = 0;
+        uint64_t FailedCalls = 0;
+        std::vector<int64_t> ReplicationNanoseconds;
+        uint64_t DeltaBytes = 0;
+        size_t SnapshotBytes = 0;
+        uint64_t FailedSnapshots = 0;
+    };
+
+    volatile std::sig_atomic_t g_StopRequested = 0;
+
+    void OnStopSignal(int)
+    {
+        g_StopRequested = 1;
+    }
+
+    template<typename CharT>
+    std::string ToString(const CharT *arg)
+    {
+        return std::filesystem::path(arg).string();
+    }
+
+    template<typename CharT>
+    bool ParseOptions(int argc, CharT *argv[], Options &options)
+    {
+        // std::stoul and friends throw on a value that is not a number or out of range; show the usage instead.
+        try
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                std::string arg = ToString(argv[i]);
+                int remaining = argc - i - 1;
+                if (arg == "--instances" && remaining >= 2)
+                {
+                    options.Instances.push_back({ ToString(argv[i + 1]), (uint32_t)std::stoul(ToString(argv[i + 2])) });
+                    i += 2;
+                }
+                else if (arg == "--system" && remaining >= 2)
+                {
+                    options.Systems.push_back({ ToString(argv[i + 1]), ToString(argv[i + 2]) });
+                    i += 2;
+                }
+                else if (arg == "--update-method" && remaining >= 1)
+                {
+                    options.UpdateMethod = ToString(argv[++i]);
+                }
+                else if (arg == "--tick-rate" && remaining >= 1)
+                {
+                    options.TickRate = std::stod(ToString(argv[++i]));
+                }
+                else if (arg == "--ticks" && remaining >= 1)
+                {
+                    options.MaxTicks = std::stoull(ToString(argv[++i]));
+                }
+                else if (arg == "--duration" && remaining >= 1)
+                {
+                    options.DurationSeconds = std::stod(ToString(argv[++i]));
+                }
+                else if (arg == "--spin" && remaining >= 1)
+                {
+                    options.SpinWindow = std::chrono::microseconds(std::stoll(ToString(argv[++i])));
+                }
+                else if (arg == "--runtime-config" && remaining >= 1)
+                {
+                    options.RuntimeConfig = argv[++i];
+                }
+                else if (arg == "--profile" && remaining >= 1)
+                {
+                    options.Profile = ToString(argv[++i]);
+                }
+                else if (arg == "--replicate")
+                {
+                    options.Replicate = true;
+                }
+                else if (arg == "--verbose")
+                {
+                    options.Verbose = true;
+                }
+                else if (!arg.starts_with("--"))
+                {
+                    options.Modules.push_back(arg);
+                }
+                else
+                {
+                    return false;
+                }
+            }
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+
+        if (options.MaxTicks == 0 && options.DurationSeconds > 0.0)
+        {
+            options.MaxTicks = (uint64_t)(options.DurationSeconds * options.TickRate + 0.5);
+        }
+
+        return !options.Modules.empty() && options.TickRate > 0.0 && (!options.Instances.empty() || !options.Systems.empty());
+    }
+
+    void WaitUntil(Clock::time_point deadline, Clock::duration spinWindow)
+    {
+        auto sleepUntil = deadline - spinWindow;
+        if (Clock::now() < sleepUntil)
+        {
+            std::this_thread::sleep_until(sleepUntil);
+        }
+
+        while (Clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool Setup(MochiSharp::DotNetHost &host, const Options &options, std::vector<std::unique_ptr<MochiSharp::ScriptMethod<void(float)>>> &updates)
+    {
+        for (const auto &module : options.Modules)
+        {
+            if (host.LoadModule(module.c_str()) == 0)
+            {
+                std::println("[Server] Failed to load module {}", module);
+                return false;
+            }
+        }
+
+        uint64_t nextInstanceId = 1;
+        for (const auto &group : options.Instances)
+        {
+            for (uint32_t i = 0; i < group.Count; i++)
+            {
+                uint64_t instanceId = nextInstanceId++;
+                auto update = std::make_unique<MochiSharp::ScriptMethod<void(float)>>();
+                if (!host.CreateInstance(group.TypeName.c_str(), instanceId) || !update->BindInstance(host, instanceId, options.UpdateMethod.c_str()))
+                {
+                    std::println("[Server] Failed to create {} or bind its {}(float)", group.TypeName, options.UpdateMethod);
+                    return false;
+                }
+                updates.push_back(std::move(update));
+            }
+        }
+
+        for (const auto &system : options.Systems)
+        {
+            auto update = std::make_unique<MochiSharp::ScriptMethod<void(float)>>();
+            if (!update->BindStatic(host, system.TypeName.c_str(), system.MethodName.c_str()))
+            {
+                std::println("[Server] Failed to bind {}.{}(float)", system.TypeName, system.MethodName);
+                return false;
+            }
+            updates.push_back(std::move(update));
+        }
+
+        return true;
+    }
+
+    void Run(MochiSharp::DotNetHost &host, const Options &options, const std::vector<std::unique_ptr<MochiSharp::ScriptMethod<void(float)>>> &updates, TickStats &stats)
+    {
+        const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / options.TickRate));
+        const float deltaSeconds = (float)(1.0 / options.TickRate);
+        const size_t expectedTicks = options.MaxTicks > 0 ? (size_t)options.MaxTicks : (size_t)(options.TickRate * 3600.0);
+        stats.WorkNanoseconds.reserve(expectedTicks);
+        stats.LatenessNanoseconds.reserve(expectedTicks);
+        if (options.Replicate)
+        {
+            stats.ReplicationNanoseconds.reserve(expectedTicks);
+        }
+
+        std::vector<uint8_t> snapshot, previousSnapshot, packet;
+        std::vector<int> methodIds;
+        methodIds.reserve(updates.size());
+        for (const auto &update : updates)
+        {
+            methodIds.push_back(update->GetMethodId());
+        }
+
+        auto nextTick = Clock::now();
+        for (uint64_t tick = 0; !g_StopRequested && (options.MaxTicks == 0 || tick < options.MaxTicks); tick++)
+        {
+            WaitUntil(nextTick, options.SpinWindow);
+            auto start = Clock::now();
+
+            host.DispatchEvents();
+            host.TickScheduler(deltaSeconds);
+            float delta = deltaSeconds;
+            void *args[] = { &delta };
+            for (int methodId : methodIds)
+            {
+                stats.FailedCalls += host.TryInvoke(methodId, args, 1, nullptr) == MochiSharp::InvokeStatus::Ok ? 0 : 1;
+            }
+
+            if (options.Replicate)
+            {
+                auto replicationStart = Clock::now();
+                if (host.CaptureSnapshot(snapshot)
+                    && MochiSharp::EncodeSnapshotDelta(previousSnapshot.data(), previousSnapshot.size(), snapshot.data(), snapshot.size(), packet))
+                {
+                    stats.DeltaBytes += packet.size();
+                    stats.SnapshotBytes = snapshot.size();
+                    std::swap(snapshot, previousSnapshot);
+                }
+                else
+                {
+                    stats.FailedSnapshots++;
+                }
+                stats.ReplicationNanoseconds.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - replicationStart).count());
+            }
+            host.EndFrame();
+
+            auto end = Clock::now();
+            stats.WorkNanoseconds.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            stats.LatenessNanoseconds.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(start - nextTick).count());
+
+            nextTick += period;
+            if (end > nextTick)
+            {
+                stats.Overruns++;
+                if (end - nextTick > period * MaxBacklogTicks)
+                {
+                    stats.SkippedTicks += (uint64_t)((end - nextTick) / period);
+                    nextTick = end;
+                }
+            }
+        }
+    }
+}
+
+#ifdef _WIN32
+int __cdecl wmain(int argc, wchar_t *argv[])
+#else
+int main(int argc, char *argv[])
+#endif
+{
+    Options options;
+    MochiSharp::HostSettings settings;
+    if (!ParseOptions(argc, argv, options) || !MochiSharp::HostSettings::FromPreset(options.Profile, settings))
+    {
+        std::println("usage: MochiSharp.Server <module>... [--instances <type> <count>] [--update-method <name>] [--system <type> <method>]");
+        std::println("                         [--tick-rate <hz>] [--ticks <n> | --duration <seconds>] [--spin <microseconds>]");
+        std::println("                         [--runtime-config <file>] [--profile default|low-latency-client|throughput-server] [--replicate] [--verbose]");
+        return 2;
+    }
+
+    std::signal(SIGINT, OnStopSignal);
+    std::signal(SIGTERM, OnStopSignal);
+
+    MochiSharp::DotNetHost host;
+    if (!host.Init(options.RuntimeConfig, settings))
+    {
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<MochiSharp::ScriptMethod<void(float)>>> updates;
+    if (!Setup(host, options, updates))
+    {
+        return 1;
+    }
+
+    if (options.MaxTicks > 0)
+    {
+        std::println("[Server] {} update methods at {} Hz for {} ticks", updates.size(), options.TickRate, options.MaxTicks);
+    }
+    else
+    {
+        std::println("[Server] {} update methods at {} Hz, Ctrl+C to stop", updates.size(), options.TickRate);
+    }
+
+    MochiSharp::DotNetHost::SetQuietLogging(!options.Verbose);
+#ifdef _WIN32
+    // Sleep granularity is otherwise ~15.6 ms, longer than the spin window.
+    timeBeginPeriod(1);
+#endif
+
+    TickStats stats;
+    auto start = Clock::now();
+    Run(host, options, updates, stats);
+    auto wallTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+    MochiSharp::DotNetHost::SetQuietLogging(false);
+
+    double budgetMicroseconds = 1e6 / options.TickRate;
+    std::vector<int64_t> sorted = stats.WorkNanoseconds;
+    std::sort(sorted.begin(), sorted.end());
+    double p99Microseconds = MochiSharp::Percentile(sorted, 0.99) / 1000.0;
+    double meanMicroseconds = 0.0;
+    for (int64_t value : sorted)
+    {
+        meanMicroseconds += value / 1000.0;
+    }
+    meanMicroseconds = sorted.empty() ? 0.0 : meanMicroseconds / (double)sorted.size();
+
+    std::println("[Server] {} ticks in {:.3f}s ({:.1f} Hz measured), budget {:.0f}us per tick", stats.WorkNanoseconds.size(), wallTime,
+        wallTime > 0.0 ? stats.WorkNanoseconds.size() / wallTime : 0.0, budgetMicroseconds);
+    MochiSharp::PrintLatencyDistribution("tick", stats.WorkNanoseconds);
+    MochiSharp::PrintLatencyDistribution("late", stats.LatenessNanoseconds);
+    if (options.Replicate && !stats.ReplicationNanoseconds.empty())
+    {
+        // The mean includes the first delta, which carries the full state.
+        MochiSharp::PrintLatencyDistribution("repl", stats.ReplicationNanoseconds);
+        double meanDelta = (double)stats.DeltaBytes / (double)stats.ReplicationNanoseconds.size();
+        std::println("[Server] snapshot {} bytes, mean delta {:.0f} bytes per tick ({:.1f} KB/s per client at {} Hz)",
+            stats.SnapshotBytes, meanDelta, meanDelta * options.TickRate / 1024.0, options.TickRate);
+    }
+    std::println("[Server] mean tick {:.2f}us ({:.1f}% of budget), p99 {:.1f}% of budget: about {:.1f} such simulations per core at p99",
+        meanMicroseconds, 100.0 * meanMicroseconds / budgetMicroseconds, 100.0 * p99Microseconds / budgetMicroseconds,
+        p99Microseconds > 0.0 ? budgetMicroseconds / p99Microseconds : 0.0);
+    if (stats.Overruns || stats.SkippedTicks || stats.FailedCalls)
+    {
+        std::println("[Server] {} ticks overran, {} ticks skipped, {} failed calls", stats.Overruns, stats.SkippedTicks, stats.FailedCalls);
+    }
+    if (stats.FailedSnapshots)
+    {
+        std::println("[Server] {} snapshots could not be captured or encoded", stats.FailedSnapshots);
+    }
+    if (uint64_t suppressed = MochiSharp::DotNetHost::GetSuppressedLogCount())
+    {
+        std::println("[Server] {} log messages suppressed while ticking", suppressed);
+    }
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+// Runs the native unit tests: MochiSharp.Tests [name filter]
+
+#include "Test.h"
+
+#include <print>
+#include <string_view>
+
+namespace MochiSharp::Tests
+{
+    namespace
+    {
+        int g_Failures = 0;
+    }
+
+    std::vector<TestCase> &GetTests()
+    {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    void ReportFailure(const char *file, int line, const char *expression)
+    {
+        std::println("  {}({}): check failed: {}", file, line, expression);
+        g_Failures++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace MochiSharp::Tests;
+
+    std::string_view filter = argc > 1 ? argv[1] : "";
+    int run = 0, failed = 0;
+    for (const auto &test : GetTests())
+    {
+        if (!filter.empty() && std::string_view(test.Name).find(filter) == std::string_view::npos)
+        {
+            continue;
+        }
+
+        int failuresBefore = g_Failures;
+        test.Run();
+        bool passed = g_Failures == failuresBefore;
+        std::println("[{}] {}", passed ? "PASS" : "FAIL", test.Name);
+        run++;
+        failed += passed ? 0 : 1;
+    }
+
+    std::println("{} tests, {} failed", run, failed);
+    return failed == 0 && run > 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptEvents.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace MochiSharp;
+
+namespace
+{
+    // Consumes one record the way MochiSharp.Managed.Core.ScriptEventRing.Drain does.
+    bool Pop(ScriptEventQueue &queue, ScriptEventRecord &record, void *payload, size_t payloadCapacity)
+    {
+        auto *header = static_cast<ScriptEventRingHeader *>(queue.GetBuffer());
+        uint64_t read = std::atomic_ref<uint64_t>(header->ReadIndex).load(std::memory_order_relaxed);
+        if (read == std::atomic_ref<uint64_t>(header->WriteIndex).load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        const uint8_t *slot = reinterpret_cast<const uint8_t *>(header + 1) + (size_t)(read & (header->SlotCount - 1)) * header->SlotSize;
+        std::memcpy(&record, slot, sizeof(record));
+        std::memcpy(payload, slot + sizeof(record), std::min<size_t>(record.PayloadSize, payloadCapacity));
+        std::atomic_ref<uint64_t>(header->ReadIndex).store(read + 1, std::memory_order_release);
+        return true;
+    }
+}
+
+MOCHI_TEST(EventRingLayoutRoundsSlots)
+{
+    ScriptEventQueue queue;
+    MOCHI_CHECK(!queue.Init(0, 16));
+    MOCHI_CHECK(queue.Init(5, 13));
+
+    auto *header = static_cast<const ScriptEventRingHeader *>(queue.GetBuffer());
+    MOCHI_CHECK(header->SlotCount == 8);
+    MOCHI_CHECK(header->SlotSize % 8 == 0 && header->SlotSize >= sizeof(ScriptEventRecord) + 13);
+    MOCHI_CHECK(queue.GetMaxPayloadSize() == header->SlotSize - sizeof(ScriptEventRecord));
+    MOCHI_CHECK(queue.GetBufferSize() == sizeof(ScriptEventRingHeader) + 8 * header->SlotSize);
+}
+
+MOCHI_TEST(EventRingRoundTripsRecordsAcrossWraparound)
+{
+    ScriptEventQueue queue;
+    MOCHI_CHECK(queue.Init(4, 16));
+    for (uint64_t i = 0; i < 11; i++)
+    {
+        struct Payload { uint64_t Value; float Scale; } sent{ i * 1000, 0.5f * (float)i };
+        MOCHI_CHECK(queue.Push(7 + (int)i, 100 + i, sent));
+        MOCHI_CHECK(queue.GetPendingCount() == 1);
+
+        ScriptEventRecord record{};
+        Payload received{};
+        MOCHI_CHECK(Pop(queue, record, &received, sizeof(received)));
+        MOCHI_CHECK(record.EventTypeId == 7 + (int)i && record.TargetInstanceId == 100 + i && record.PayloadSize == sizeof(Payload));
+        MOCHI_CHECK(received.Value == sent.Value && received.Scale == sent.Scale);
+    }
+    MOCHI_CHECK(queue.GetPendingCount() == 0);
+    MOCHI_CHECK(queue.GetDroppedCount() == 0);
+}
+
+MOCHI_TEST(EventRingDropsWhenFullOrPayloadTooLarge)
+{
+    ScriptEventQueue queue;
+    MOCHI_CHECK(queue.Init(4, 8));
+    for (int i = 0; i < 4; i++)
+    {
+        MOCHI_CHECK(queue.Push(1, 0, nullptr, 0));
+    }
+    MOCHI_CHECK(!queue.Push(1, 0, nullptr, 0));
+
+    uint8_t large[64] = {};
+    ScriptEventRecord record{};
+    MOCHI_CHECK(Pop(queue, record, large, sizeof(large)));
+    MOCHI_CHECK(!queue.Push(1, 0, large, queue.GetMaxPayloadSize() + 1));
+    MOCHI_CHECK(queue.Push(1, 0, large, queue.GetMaxPayloadSize()));
+    MOCHI_CHECK(queue.GetDroppedCount() == 2);
+    MOCHI_CHECK(queue.GetPendingCount() == 4);
+
+    ScriptEventQueue uninitialized;
+    MOCHI_CHECK(!uninitialized.Push(1, 0, nullptr, 0));
+}
+
+MOCHI_TEST(EventRingKeepsOrderBetweenThreads)
+{
+    constexpr uint64_t Count = 200000;
+    ScriptEventQueue queue;
+    MOCHI_CHECK(queue.Init(64, 8));
+
+    std::thread producer([&]
+    {
+        for (uint64_t i = 0; i < Count;)
+        {
+            // A full ring counts as dropped; retry like a producer that must not lose the event.
+            i += queue.Push(1, i, i) ? 1 : 0;
+        }
+    });
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < Count)
+    {
+        ScriptEventRecord record{};
+        uint64_t value = 0;
+        if (Pop(queue, record, &value, sizeof(value)))
+        {
+            ordered &= record.TargetInstanceId == expected && value == expected;
+            expected++;
+        }
+    }
+    producer.join();
+
+    MOCHI_CHECK(ordered);
+    MOCHI_CHECK(queue.GetPendingCount() == 0);
+}
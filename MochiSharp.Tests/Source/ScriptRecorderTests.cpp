@@ -0,0 +1,158 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptRecorder.h"
+#include "Test.h"
+
+#include <cstring>
+#include <iterator>
+
+using namespace MochiSharp;
+
+namespace
+{
+    std::filesystem::path TempLogPath(const char *name)
+    {
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    // Signature 3: float Update(int, double) -> native sizes { 4, 4, 8 }.
+    void RecordSession(ScriptRecorder &recorder)
+    {
+        const char *parameters[] = { "System.Int32", "System.Double" };
+        uint64_t ids[] = { 11, 12, 13 };
+
+        recorder.RecordLoadModule(1, "Scripts.dll");
+        recorder.RecordLoadSharedAssembly("Shared.dll");
+        recorder.RecordConfigureSerialization("Game.SerializeField", "Game.Entity");
+        recorder.RecordRegisterSignature(3, "System.Single", parameters, 2, nullptr, nullptr, { 4, 4, 8 });
+        recorder.RecordCreateInstance(10, "Game.Player");
+        recorder.RecordCreateInstances("Game.Enemy", ids, 3);
+        recorder.RecordConfigureInstancePool("Game.Enemy", 32);
+        recorder.RecordBindInstanceMethod(100, 10, "Update", 3);
+        recorder.RecordBindStaticMethod(101, "Game.Rules", "Score", 3);
+
+        int32_t count = 5;
+        double scale = 0.25;
+        const void *args[] = { &count, &scale };
+        recorder.RecordInvoke(100, args, 2);
+        recorder.RecordInvoke(999, args, 2); // bound before recording started: skipped
+
+        float speed = 3.5f;
+        recorder.RecordSetFieldValue(10, "Speed", &speed, sizeof(speed));
+        recorder.RecordTickScheduler(1.0 / 60.0);
+        recorder.RecordDestroyInstance(10);
+        recorder.RecordDestroyInstances(ids, 3, 0.5);
+        recorder.RecordEndFrame();
+
+        const uint8_t image[] = { 'M', 'Z', 0, 1 };
+        const uint8_t symbols[] = { 'B', 'S', 'J', 'B', 2 };
+        recorder.RecordLoadModuleFromMemory(2, "Packed.dll", image, sizeof(image), symbols, sizeof(symbols));
+    }
+}
+
+MOCHI_TEST(RecorderRoundTripsEveryRecordType)
+{
+    auto path = TempLogPath("mochisharp-tests-roundtrip.msrec");
+    {
+        ScriptRecorder recorder;
+        MOCHI_CHECK(recorder.Start(path));
+        RecordSession(recorder);
+        MOCHI_CHECK(recorder.GetSkippedCalls() == 1);
+        recorder.Stop();
+        MOCHI_CHECK(!recorder.IsRecording());
+    }
+
+    std::vector<ScriptRecord> records;
+    MOCHI_CHECK(ScriptRecorder::Load(path, records));
+    std::filesystem::remove(path);
+    MOCHI_CHECK(records.size() == 16);
+    if (records.size() != 16)
+    {
+        return;
+    }
+
+    MOCHI_CHECK(records[0].Type == RecordType::LoadModule && records[0].Id == 1 && records[0].Name == "Scripts.dll");
+    MOCHI_CHECK(records[1].Type == RecordType::LoadSharedAssembly && records[1].Name == "Shared.dll");
+    MOCHI_CHECK(records[2].Type == RecordType::ConfigureSerialization && records[2].Name == "Game.SerializeField" && records[2].TypeName == "Game.Entity");
+    MOCHI_CHECK(records[3].Type == RecordType::RegisterSignature && records[3].Id == 3 && records[3].TypeName == "System.Single");
+    MOCHI_CHECK((records[3].Names == std::vector<std::string>{ "System.Int32", "System.Double" }) && records[3].Sizes.empty());
+    MOCHI_CHECK(records[4].Type == RecordType::CreateInstance && records[4].InstanceId == 10 && records[4].TypeName == "Game.Player");
+    MOCHI_CHECK(records[5].Type == RecordType::CreateInstances && records[5].TypeName == "Game.Enemy");
+    MOCHI_CHECK((records[5].InstanceIds == std::vector<uint64_t>{ 11, 12, 13 }));
+    MOCHI_CHECK(records[6].Type == RecordType::ConfigureInstancePool && records[6].TypeName == "Game.Enemy" && records[6].Id == 32);
+    MOCHI_CHECK(records[7].Type == RecordType::BindInstanceMethod && records[7].Id == 100 && records[7].InstanceId == 10
+        && records[7].Name == "Update" && records[7].Signature == 3);
+    MOCHI_CHECK(records[8].Type == RecordType::BindStaticMethod && records[8].Id == 101 && records[8].TypeName == "Game.Rules"
+        && records[8].Name == "Score" && records[8].Signature == 3);
+
+    // Arguments are stored back to back with the sizes of the signature layout.
+    const auto &invoke = records[9];
+    MOCHI_CHECK(invoke.Type == RecordType::Invoke && invoke.Id == 100 && invoke.ArgCount == 2 && invoke.Bytes.size() == 12);
+    if (invoke.Bytes.size() == 12)
+    {
+        int32_t count = 0;
+        double scale = 0.0;
+        std::memcpy(&count, invoke.Bytes.data(), sizeof(count));
+        std::memcpy(&scale, invoke.Bytes.data() + 4, sizeof(scale));
+        MOCHI_CHECK(count == 5 && scale == 0.25);
+    }
+
+    float speed = 0.0f;
+    MOCHI_CHECK(records[10].Type == RecordType::SetFieldValue && records[10].InstanceId == 10 && records[10].Name == "Speed"
+        && records[10].Bytes.size() == sizeof(speed));
+    if (records[10].Bytes.size() == sizeof(speed))
+    {
+        std::memcpy(&speed, records[10].Bytes.data(), sizeof(speed));
+    }
+    MOCHI_CHECK(speed == 3.5f);
+    MOCHI_CHECK(records[11].Type == RecordType::TickScheduler && records[11].Value == 1.0 / 60.0);
+    MOCHI_CHECK(records[12].Type == RecordType::DestroyInstance && records[12].InstanceId == 10);
+    MOCHI_CHECK(records[13].Type == RecordType::DestroyInstances && records[13].Value == 0.5 && records[13].InstanceIds.size() == 3);
+    MOCHI_CHECK(records[14].Type == RecordType::EndFrame);
+    MOCHI_CHECK(records[15].Type == RecordType::LoadModuleFromMemory && records[15].Id == 2 && records[15].Name == "Packed.dll");
+    MOCHI_CHECK((records[15].Bytes == std::vector<uint8_t>{ 'M', 'Z', 0, 1 }) && records[15].Symbols.size() == 5);
+}
+
+MOCHI_TEST(RecorderLoadRejectsTruncatedAndForeignLogs)
+{
+    auto path = TempLogPath("mochisharp-tests-truncated.msrec");
+    {
+        ScriptRecorder recorder;
+        MOCHI_CHECK(recorder.Start(path));
+        RecordSession(recorder);
+    }
+
+    std::vector<char> bytes;
+    {
+        std::ifstream stream(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+    MOCHI_CHECK(bytes.size() > 8);
+
+    // Every cut inside a record fails; cuts between records load the records before them.
+    size_t complete = 0;
+    for (size_t size = 0; size < bytes.size(); size++)
+    {
+        {
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream.write(bytes.data(), (std::streamsize)size);
+        }
+
+        std::vector<ScriptRecord> records;
+        if (ScriptRecorder::Load(path, records))
+        {
+            complete++;
+            MOCHI_CHECK(size >= 8 && records.size() < 16);
+        }
+    }
+    MOCHI_CHECK(complete == 16);
+
+    bytes[0] = 'X';
+    {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        stream.write(bytes.data(), (std::streamsize)bytes.size());
+    }
+    std::vector<ScriptRecord> records;
+    MOCHI_CHECK(!ScriptRecorder::Load(path, records) && records.empty());
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,217 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#include "ScriptSnapshot.h"
+#include "Test.h"
+
+#include <map>
+#include <random>
+
+using namespace MochiSharp;
+
+namespace
+{
+    struct Record
+    {
+        uint32_t LayoutHash;
+        std::vector<uint8_t> Data;
+    };
+
+    // Lays out a snapshot the way MochiSharp.Managed.Core.ScriptSnapshot.Capture does.
+    std::vector<uint8_t> BuildSnapshot(const std::map<uint64_t, Record> &records)
+    {
+        std::vector<uint8_t> snapshot(sizeof(ScriptSnapshotHeader), 0);
+        for (const auto &[instanceId, record] : records)
+        {
+            ScriptSnapshotEntry entry{ instanceId, record.LayoutHash, (int32_t)record.Data.size() };
+            size_t offset = snapshot.size();
+            snapshot.resize(offset + ((sizeof(entry) + record.Data.size() + 7) & ~(size_t)7), 0);
+            std::memcpy(snapshot.data() + offset, &entry, sizeof(entry));
+            std::memcpy(snapshot.data() + offset + sizeof(entry), record.Data.data(), record.Data.size());
+        }
+
+        ScriptSnapshotHeader header{ ScriptSnapshotMagic, ScriptSnapshotVersion, (int32_t)records.size(), (int32_t)snapshot.size() };
+        std::memcpy(snapshot.data(), &header, sizeof(header));
+        return snapshot;
+    }
+
+    std::vector<uint8_t> Bytes(std::initializer_list<int> values)
+    {
+        return std::vector<uint8_t>(values.begin(), values.end());
+    }
+
+    bool RoundTrips(const std::vector<uint8_t> &baseline, const std::vector<uint8_t> &current, size_t *deltaSize = nullptr)
+    {
+        std::vector<uint8_t> delta, rebuilt;
+        if (!EncodeSnapshotDelta(baseline.data(), baseline.size(), current.data(), current.size(), delta)
+            || !ApplySnapshotDelta(baseline.data(), baseline.size(), delta.data(), delta.size(), rebuilt))
+        {
+            return false;
+        }
+
+        if (deltaSize)
+        {
+            *deltaSize = delta.size();
+        }
+        return rebuilt == current;
+    }
+
+    void WriteVarint(std::vector<uint8_t> &out, uint64_t value)
+    {
+        for (; value >= 0x80; value >>= 7)
+        {
+            out.push_back((uint8_t)(value | 0x80));
+        }
+        out.push_back((uint8_t)value);
+    }
+}
+
+MOCHI_TEST(SnapshotDeltaRoundTripsChangedAddedAndRemovedRecords)
+{
+    std::map<uint64_t, Record> before = {
+        { 10, { 1, Bytes({ 1, 2, 3, 4, 5, 6, 7, 8, 9 }) } },
+        { 20, { 1, Bytes({ 0, 0, 0, 0, 0, 0, 0, 0, 0 }) } },
+        { 30, { 2, Bytes({ 42 }) } }
+    };
+    auto after = before;
+    after[10].Data[8] = 10;       // changed
+    after.erase(20);              // removed
+    after[25] = { 2, Bytes({ 7 }) }; // added
+    after[30].LayoutHash = 3;     // same id, other layout: sent whole
+
+    auto baseline = BuildSnapshot(before);
+    auto current = BuildSnapshot(after);
+    size_t deltaSize = 0;
+    MOCHI_CHECK(RoundTrips(baseline, current, &deltaSize));
+    MOCHI_CHECK(deltaSize < current.size());
+}
+
+MOCHI_TEST(SnapshotDeltaFromEmptyBaselineCarriesFullState)
+{
+    std::map<uint64_t, Record> records = {
+        { 1, { 5, Bytes({ 0, 0, 0, 1 }) } },
+        { UINT64_MAX, { 5, Bytes({ 9, 0, 0, 0 }) } }
+    };
+    MOCHI_CHECK(RoundTrips({}, BuildSnapshot(records)));
+}
+
+MOCHI_TEST(UnchangedSnapshotEncodesToHeaderOnly)
+{
+    auto snapshot = BuildSnapshot({ { 4, { 1, Bytes({ 1, 2, 3 }) } } });
+    std::vector<uint8_t> delta;
+    MOCHI_CHECK(EncodeSnapshotDelta(snapshot.data(), snapshot.size(), snapshot.data(), snapshot.size(), delta));
+    MOCHI_CHECK(delta.size() == sizeof(ScriptSnapshotDeltaHeader));
+}
+
+MOCHI_TEST(SnapshotDeltaRejectsOtherBaseline)
+{
+    auto baseline = BuildSnapshot({ { 4, { 1, Bytes({ 1, 2, 3 }) } } });
+    auto other = BuildSnapshot({ { 4, { 1, Bytes({ 1, 2, 4 }) } } });
+    auto current = BuildSnapshot({ { 4, { 1, Bytes({ 5, 2, 3 }) } } });
+
+    std::vector<uint8_t> delta, rebuilt;
+    MOCHI_CHECK(EncodeSnapshotDelta(baseline.data(), baseline.size(), current.data(), current.size(), delta));
+    MOCHI_CHECK(!ApplySnapshotDelta(other.data(), other.size(), delta.data(), delta.size(), rebuilt));
+    MOCHI_CHECK(!ApplySnapshotDelta(nullptr, 0, delta.data(), delta.size(), rebuilt));
+}
+
+MOCHI_TEST(SnapshotDeltaRejectsTruncatedPackets)
+{
+    auto baseline = BuildSnapshot({ { 1, { 1, Bytes({ 1, 2, 3, 4 }) } }, { 2, { 1, Bytes({ 5, 6, 7, 8 }) } } });
+    auto current = BuildSnapshot({ { 1, { 1, Bytes({ 1, 2, 9, 4 }) } }, { 3, { 1, Bytes({ 5, 6, 7, 8 }) } } });
+
+    std::vector<uint8_t> delta, rebuilt;
+    MOCHI_CHECK(EncodeSnapshotDelta(baseline.data(), baseline.size(), current.data(), current.size(), delta));
+    for (size_t size = 0; size < delta.size(); size++)
+    {
+        MOCHI_CHECK(!ApplySnapshotDelta(baseline.data(), baseline.size(), delta.data(), size, rebuilt));
+    }
+}
+
+MOCHI_TEST(SnapshotDeltaRejectsOversizedAddedRecord)
+{
+    for (uint64_t size : { (uint64_t)ScriptSnapshotMaxRecordSize + 1, (uint64_t)1 << 30 })
+    {
+        // One added record with no runs: a few bytes that would describe a huge zeroed record.
+        std::vector<uint8_t> delta(sizeof(ScriptSnapshotDeltaHeader));
+        ScriptSnapshotDeltaHeader header{ ScriptSnapshotDeltaMagic, ScriptSnapshotVersion, 0, 1 };
+        std::memcpy(delta.data(), &header, sizeof(header));
+        WriteVarint(delta, 1);
+        delta.push_back(2);
+        WriteVarint(delta, 7);
+        WriteVarint(delta, size);
+        WriteVarint(delta, 0);
+
+        std::vector<uint8_t> rebuilt;
+        MOCHI_CHECK(!ApplySnapshotDelta(nullptr, 0, delta.data(), delta.size(), rebuilt));
+    }
+
+    auto tooLarge = BuildSnapshot({ { 1, { 1, std::vector<uint8_t>(ScriptSnapshotMaxRecordSize + 1, 1) } } });
+    std::vector<uint8_t> delta;
+    MOCHI_CHECK(!EncodeSnapshotDelta(nullptr, 0, tooLarge.data(), tooLarge.size(), delta));
+}
+
+MOCHI_TEST(RandomSnapshotDeltasRoundTrip)
+{
+    std::mt19937_64 rng(7);
+    for (int iteration = 0; iteration < 2000; iteration++)
+    {
+        std::map<uint64_t, Record> before;
+        for (int i = (int)(rng() % 20); i > 0; i--)
+        {
+            std::vector<uint8_t> data(1 + rng() % 300);
+            for (auto &byte : data)
+            {
+                byte = rng() % 3 ? 0 : (uint8_t)rng();
+            }
+            before[rng() % 4 == 0 ? rng() : rng() % 64] = { (uint32_t)(rng() % 3), std::move(data) };
+        }
+
+        auto after = before;
+        for (auto it = after.begin(); it != after.end();)
+        {
+            int roll = (int)(rng() % 6);
+            if (roll == 0)
+            {
+                it = after.erase(it);
+                continue;
+            }
+            for (int k = roll < 3 ? (int)(rng() % 5) : 0; k > 0; k--)
+            {
+                it->second.Data[rng() % it->second.Data.size()] ^= (uint8_t)(rng() | 1);
+            }
+            ++it;
+        }
+        for (int i = (int)(rng() % 3); i > 0; i--)
+        {
+            after[rng() % 100] = { 1, std::vector<uint8_t>(1 + rng() % 40, (uint8_t)rng()) };
+        }
+
+        auto baseline = rng() % 4 ? BuildSnapshot(before) : std::vector<uint8_t>();
+        auto current = BuildSnapshot(after);
+        MOCHI_CHECK(RoundTrips(baseline, current));
+
+        // Corrupted packets must be rejected or decode to something; never read out of bounds.
+        std::vector<uint8_t> delta, rebuilt;
+        EncodeSnapshotDelta(baseline.data(), baseline.size(), current.data(), current.size(), delta);
+        if (delta.size() > sizeof(ScriptSnapshotDeltaHeader))
+        {
+            delta[sizeof(ScriptSnapshotDeltaHeader) + rng() % (delta.size() - sizeof(ScriptSnapshotDeltaHeader))] ^= (uint8_t)(1 << (rng() % 8));
+            ApplySnapshotDelta(baseline.data(), baseline.size(), delta.data(), delta.size(), rebuilt);
+        }
+    }
+}
+
+MOCHI_TEST(ForEachSnapshotEntryVisitsRecordsInOrder)
+{
+    auto snapshot = BuildSnapshot({ { 3, { 1, Bytes({ 3 }) } }, { 8, { 2, Bytes({ 8, 8 }) } } });
+    std::vector<uint64_t> ids;
+    size_t bytes = 0;
+    ForEachSnapshotEntry(snapshot.data(), snapshot.size(), [&](const ScriptSnapshotEntry &entry, const uint8_t *record)
+    {
+        ids.push_back(entry.InstanceId);
+        bytes += (size_t)entry.Size;
+        MOCHI_CHECK(record[0] == (uint8_t)entry.InstanceId);
+    });
+    MOCHI_CHECK((ids == std::vector<uint64_t>{ 3, 8 }));
+    MOCHI_CHECK(bytes == 3);
+}
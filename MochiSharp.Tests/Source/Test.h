@@ -0,0 +1,47 @@
+// Copyright (c) 2025 Evangelion Manuhutu
+
+#ifndef MOCHI_TEST_H
+#define MOCHI_TEST_H
+
+#include <vector>
+
+// Self-registering checks for the parts of MochiSharp.Native that need no .NET runtime (wire
+// formats, ring buffers, codecs):
+//
+//   MOCHI_TEST(SnapshotDeltaRoundTrips)
+//   {
+//       MOCHI_CHECK(MochiSharp::ApplySnapshotDelta(...));
+//   }
+//
+// A failed check is reported and the test keeps running. MochiSharp.Tests runs every test, or the
+// ones whose name contains its first argument, and exits with 1 if any failed.
+
+namespace MochiSharp::Tests
+{
+    struct TestCase
+    {
+        const char *Name;
+        void (*Run)();
+    };
+
+    std::vector<TestCase> &GetTests();
+    void ReportFailure(const char *file, int line, const char *expression);
+
+    struct TestRegistrar
+    {
+        TestRegistrar(const char *name, void (*run)())
+        {
+            GetTests().push_back({ name, run });
+        }
+    };
+}
+
+#define MOCHI_TEST(name) \
+    static void name(); \
+    static MochiSharp::Tests::TestRegistrar name##Registrar(#name, &name); \
+    static void name()
+
+#define MOCHI_CHECK(expression) \
+    ((expression) ? (void)0 : MochiSharp::Tests::ReportFailure(__FILE__, __LINE__, #expression))
+
+#endif // !MOCHI_TEST_H
@@ -0,0 +1,49 @@
+project "MochiSharp.Tests"
+    location "%{wks.location}/MochiSharp.Tests"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "c++23"
+    architecture "x64"
+
+    targetdir (OUTPUT_DIR)
+    objdir (INTOUTPUT_DIR)
+
+    files {
+        "Source/**.cpp",
+        "Source/**.h"
+    }
+
+    includedirs {
+        "%{wks.location}/MochiSharp.Native/Source",
+        "%{IncludeDirs.Hostfxr}"
+    }
+
+    links {
+        "MochiSharp.Native"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+        buildoptions { "/utf-8" }
+        defines {
+            "_WINDOWS",
+            "WIN32",
+            "WIN32_LEAN_AND_MEAN",
+            "_CRT_SECURE_NO_WARNINGS",
+            "_CONSOLE"
+        }
+
+    filter "system:linux"
+        links { "pthread" }
+
+    filter "configurations:Debug"
+        runtime "Debug"
+        optimize "off"
+        symbols "on"
+        defines { "_DEBUG" }
+
+    filter "configurations:Release"
+        runtime "Release"
+        optimize "speed"
+        symbols "off"
+        defines { "NDEBUG" }
@@ -13,6 +13,15 @@ workspace "MochiSharp-Managed"
 
     -- Projects
     include "MochiSharp.Managed/mochisharp-managed.lua"
+    include "MochiSharp.HeaderGen/mochisharp-headergen.lua"
+
+    group "Tools"
+    include "MochiSharp.MathBench/mochisharp-mathbench.lua"
+    group ""
+
+    group "Tests"
+    include "MochiSharp.Managed.Tests/mochisharp-managed-tests.lua"
+    group ""
     
     group "Example"
     include "Example/Managed/example-managed.lua"
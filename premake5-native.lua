@@ -17,9 +17,26 @@ workspace "MochiSharp"
     IncludeDirs = {}
     IncludeDirs["Hostfxr"] = "%{wks.location}/NetCore/include"
 
+    -- Linux links the static libnethost.a from the .NET SDK:
+    -- <dotnet>/packs/Microsoft.NETCore.App.Host.linux-x64/<version>/runtimes/linux-x64/native
+    -- Point NETHOST_DIR there, or copy it to ThirdParty/dotnet/host/fxr/9.0.11/linux-x64.
+    NETHOST_LINUX_DIR = os.getenv("NETHOST_DIR") or path.join(_MAIN_SCRIPT_DIR, "ThirdParty/dotnet/host/fxr/9.0.11/linux-x64")
+    if os.target() == "linux" and not os.isfile(path.join(NETHOST_LINUX_DIR, "libnethost.a")) then
+        error("libnethost.a not found in " .. NETHOST_LINUX_DIR .. "; set NETHOST_DIR to the runtimes/linux-x64/native directory of the .NET SDK's Microsoft.NETCore.App.Host.linux-x64 pack", 0)
+    end
+
     -- Projects
     include "MochiSharp.Native/mochisharp-native.lua"
 
+    group "Tools"
+    include "MochiSharp.Replay/mochisharp-replay.lua"
+    include "MochiSharp.Server/mochisharp-server.lua"
+    group ""
+
+    group "Tests"
+    include "MochiSharp.Tests/mochisharp-tests.lua"
+    group ""
+
     group "Example"
     include "Example/Native/example-native.lua"
     group ""
\ No newline at end of file